@@ -17,7 +17,7 @@
 
 #ifndef FREESURROUND_DECODER_H
 #define FREESURROUND_DECODER_H
-#include "KissFFTR.h"
+#include "SimdFFT.h"
 #include <complex>
 #include <vector>
 
@@ -75,8 +75,13 @@ public:
   DPL2FSDecoder();
   ~DPL2FSDecoder();
 
+  // @param hopsize If not 0, the input is decoded in hops of hopsize samples
+  // with decode_hop() instead of decode(). Must divide blocksize and be at most
+  // a quarter of it. Asymmetric analysis and synthesis windows are then used,
+  // so that the output is delayed by hopsize to 2*hopsize samples while the
+  // frequency resolution stays the one of blocksize.
   void Init(channel_setup setup = cs_5point1, unsigned int blocksize = 4096,
-            unsigned int samplerate = 48000);
+            unsigned int samplerate = 48000, unsigned int hopsize = 0);
 
   // Decode a chunk of stereo sound. The output is delayed by half of the
   // blocksize. This function is the only one needed for straightforward
@@ -88,6 +93,12 @@ public:
   // output channels in the chosen channel setup.
   float *decode(float *input);
 
+  // Decode a hop of stereo sound, when a hopsize was given to Init().
+  // @param input Contains exactly hopsize (multiplexed) stereo samples.
+  // @return A pointer to an internal buffer of exactly hopsize (multiplexed)
+  // multichannel samples.
+  float *decode_hop(const float *input);
+
   // Flush the internal buffer.
   void flush();
 
@@ -114,10 +125,19 @@ private:
 
   // number of samples per input/output block, number of output channels
   unsigned int N, C;
+
+  // number of samples between two processed blocks, number of samples at the
+  // end of a block which the synthesis window keeps
+  unsigned int H, S;
   unsigned int samplerate;
 
   // the channel setup
   channel_setup setup;
+
+  // the channel allocation maps of the setup, and which of the L/C/R phases
+  // each channel takes
+  std::vector<std::vector<float *>> alloc;
+  std::vector<int> phase_src;
   bool initialized;
 
   // parameters
@@ -149,15 +169,13 @@ private:
   bool use_lfe;
 
   // FFT data structures
-  // left total, right total (source arrays), time-domain destination buffer
-  // array
-  std::vector<double> lt, rt, dst;
-
   // left total / right total in frequency domain
   std::vector<cplx> lf, rf;
 
-  // FFT buffers
-  kiss_fftr_cfg forward, inverse;
+  // the FFT, and its buffers for the forward transform of Lt + i*Rt and for
+  // the inverse transforms of pairs of channels
+  SimdFFT *fft;
+  std::vector<float> fwd_re, fwd_im, inv_re, inv_im;
 
   // buffers
   // whether the buffer is currently empty or dirty
@@ -169,19 +187,19 @@ private:
   // multichannel output buffer (multiplexed)
   std::vector<float> outbuf;
 
-  // the window function, precomputed
-  std::vector<double> wnd;
+  // the analysis and synthesis window functions, precomputed
+  std::vector<double> wnd, swnd;
 
-  // the signal to be constructed in every channel, in the frequency domain
-  // instantiate the decoder with a given channel setup and processing block
-  // size (in samples)
-  std::vector<std::vector<cplx>> signal;
+  // the signal to be constructed in every channel, in the frequency domain,
+  // at the frequency being decoded
+  std::vector<cplx> signal;
 
   // helper functions
   inline float sqr(double x);
   inline double amplitude(const cplx &x);
   inline double phase(const cplx &x);
   inline cplx polar(double a, double p);
+  inline cplx unit(const cplx &x, double amp);
   inline float min(double a, double b);
   inline float max(double a, double b);
   inline float clamp(double x);
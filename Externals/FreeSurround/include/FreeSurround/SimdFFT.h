@@ -0,0 +1,30 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifndef FREESURROUND_SIMDFFT_H
+#define FREESURROUND_SIMDFFT_H
+#include <utility>
+#include <vector>
+
+// Complex FFTs of a power-of-two size, computed four at a time with SIMD
+// instructions. The four transforms are interleaved: element k of transform l
+// is at index 4*k+l of the real and imaginary arrays.
+class SimdFFT {
+public:
+  explicit SimdFFT(unsigned int n);
+
+  // Transform 4*n real and 4*n imaginary values in place. Neither direction is
+  // normalized; the inverse transform uses positive exponents.
+  void transform(float *re, float *im, bool inverse) const;
+
+private:
+  unsigned int n;
+
+  // the element pairs which the bit reversal permutation swaps
+  std::vector<std::pair<unsigned int, unsigned int>> swaps;
+
+  // exp(-i*pi*j/h) for j < h at index h+j, for every stage of half size h
+  std::vector<float> twiddle_re, twiddle_im;
+};
+
+#endif
@@ -19,6 +19,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "FreeSurround/FreeSurroundDecoder.h"
 #include "FreeSurround/ChannelMaps.h"
 #include <cmath>
+#include <cstring>
 
 #undef min
 #undef max
@@ -28,41 +29,57 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 DPL2FSDecoder::DPL2FSDecoder() {
   initialized = false;
   buffer_empty = true;
+  fft = 0;
 }
 
-DPL2FSDecoder::~DPL2FSDecoder() {
-#pragma warning(suppress : 4150)
-  delete forward;
-#pragma warning(suppress : 4150)
-  delete inverse;
-}
+DPL2FSDecoder::~DPL2FSDecoder() { delete fft; }
 
 void DPL2FSDecoder::Init(channel_setup chsetup, unsigned int blsize,
-                         unsigned int sample_rate) {
+                         unsigned int sample_rate, unsigned int hopsize) {
   if (!initialized) {
     setup = chsetup;
     N = blsize;
     samplerate = sample_rate;
+    H = hopsize ? hopsize : N / 2;
+    S = hopsize ? 2 * H : N;
 
     // Initialize the parameters
     wnd = std::vector<double>(N);
+    swnd = std::vector<double>(N);
     inbuf = std::vector<float>(3 * N);
-    lt = std::vector<double>(N);
-    rt = std::vector<double>(N);
-    dst = std::vector<double>(N);
     lf = std::vector<cplx>(N / 2 + 1);
     rf = std::vector<cplx>(N / 2 + 1);
-    forward = kiss_fftr_alloc(N, 0, 0, 0);
-    inverse = kiss_fftr_alloc(N, 1, 0, 0);
+    fft = new SimdFFT(N);
+    fwd_re = std::vector<float>(4 * N);
+    fwd_im = std::vector<float>(4 * N);
+    inv_re = std::vector<float>(4 * N);
+    inv_im = std::vector<float>(4 * N);
     C = static_cast<unsigned int>(chn_alloc[setup].size());
+    alloc = chn_alloc[setup];
+    for (unsigned int c = 0; c < C; c++)
+      phase_src.push_back(1 + static_cast<int>(sign(chn_xsf[setup][c])));
 
     // Allocate per-channel buffers
-    outbuf.resize((N + N / 2) * C);
-    signal.resize(C, std::vector<cplx>(N));
+    outbuf.resize((S + H) * C);
+    // (with a silent channel to pair the last one with, for an odd count)
+    signal.resize(C + C % 2);
 
-    // Init the window function
-    for (unsigned int k = 0; k < N; k++)
-      wnd[k] = sqrt(0.5 * (1 - cos(2 * pi * k / N)) / N);
+    // Init the window functions
+    if (!hopsize) {
+      for (unsigned int k = 0; k < N; k++)
+        wnd[k] = sqrt(0.5 * (1 - cos(2 * pi * k / N)) / N);
+      swnd = wnd;
+    } else {
+      // the analysis window rises over N-H samples and falls over the last H
+      // samples; the synthesis window only covers the last 2*H samples, where
+      // the product of both windows is a Hann window which overlap-adds to 1
+      for (unsigned int k = 0; k < N - H; k++)
+        wnd[k] = sqrt(0.5 * (1 - cos(pi * k / (N - H))) / N);
+      for (unsigned int k = N - H; k < N; k++)
+        wnd[k] = sqrt(0.5 * (1 + cos(pi * (k - (N - H)) / H)) / N);
+      for (unsigned int k = N - S; k < N; k++)
+        swnd[k] = 0.5 * (1 - cos(pi * (k - (N - S)) / H)) / N / wnd[k];
+    }
 
     // set default parameters
     set_circular_wrap(90);
@@ -98,6 +115,20 @@ float *DPL2FSDecoder::decode(float *input) {
   return 0;
 }
 
+// decode a stereo hop, produces a multichannel hop of the same size (lagged)
+float *DPL2FSDecoder::decode_hop(const float *input) {
+  if (initialized) {
+    // shift the input buffer by one hop and append the incoming data
+    memmove(&inbuf[0], &inbuf[2 * H], 8 * (N - H));
+    memcpy(&inbuf[2 * (N - H)], &input[0], 8 * H);
+    buffered_decode(&inbuf[0]);
+    buffer_empty = false;
+    // return the samples which no later block overlaps with
+    return &outbuf[C * (S - H)];
+  }
+  return 0;
+}
+
 // flush the internal buffers
 void DPL2FSDecoder::flush() {
   memset(&outbuf[0], 0, outbuf.size() * 4);
@@ -106,7 +137,7 @@ void DPL2FSDecoder::flush() {
 }
 
 // number of samples currently held in the buffer
-unsigned int DPL2FSDecoder::buffered() { return buffer_empty ? 0 : N / 2; }
+unsigned int DPL2FSDecoder::buffered() { return buffer_empty ? 0 : S - H; }
 
 // set soundfield & rendering parameters
 void DPL2FSDecoder::set_circular_wrap(float v) { circular_wrap = v; }
@@ -131,6 +162,10 @@ inline double DPL2FSDecoder::phase(const cplx &x) {
 inline cplx DPL2FSDecoder::polar(double a, double p) {
   return cplx(a * cos(p), a * sin(p));
 }
+// the phasor of x, knowing its amplitude
+inline cplx DPL2FSDecoder::unit(const cplx &x, double amp) {
+  return amp > 0 ? x / amp : cplx(1, 0);
+}
 inline float DPL2FSDecoder::min(double a, double b) {
   return static_cast<float>(a < b ? a : b);
 }
@@ -156,27 +191,41 @@ int DPL2FSDecoder::map_to_grid(double &x) {
 
 // decode a block of data and overlap-add it into outbuf
 void DPL2FSDecoder::buffered_decode(float *input) {
-  // demultiplex and apply window function
+  // demultiplex and apply window function, into the first transform of the
+  // FFT as Lt + i*Rt (the others are left at zero)
   for (unsigned int k = 0; k < N; k++) {
-    lt[k] = wnd[k] * input[k * 2 + 0];
-    rt[k] = wnd[k] * input[k * 2 + 1];
+    fwd_re[4 * k] = static_cast<float>(wnd[k] * input[k * 2 + 0]);
+    fwd_im[4 * k] = static_cast<float>(wnd[k] * input[k * 2 + 1]);
   }
 
-  // map into spectral domain
-  kiss_fftr(forward, &lt[0], (kiss_fft_cpx *)&lf[0]);
-  kiss_fftr(forward, &rt[0], (kiss_fft_cpx *)&rf[0]);
+  // map into spectral domain, and separate the spectra of Lt and Rt using
+  // their conjugate symmetry
+  fft->transform(&fwd_re[0], &fwd_im[0], false);
+  for (unsigned int f = 1; f < N / 2; f++) {
+    double zr = fwd_re[4 * f], zi = fwd_im[4 * f];
+    double cr = fwd_re[4 * (N - f)], ci = fwd_im[4 * (N - f)];
+    lf[f] = cplx(0.5 * (zr + cr), 0.5 * (zi - ci));
+    rf[f] = cplx(0.5 * (zi + ci), 0.5 * (cr - zr));
+  }
 
   // compute multichannel output signal in the spectral domain
   for (unsigned int f = 1; f < N / 2; f++) {
     // get Lt/Rt amplitudes & phases
     double ampL = amplitude(lf[f]), ampR = amplitude(rf[f]);
-    double phaseL = phase(lf[f]), phaseR = phase(rf[f]);
     // calculate the amplitude & phase differences
     double ampDiff =
         clamp((ampL + ampR < epsilon) ? 0 : (ampR - ampL) / (ampR + ampL));
-    double phaseDiff = abs(phaseL - phaseR);
-    if (phaseDiff > pi)
-      phaseDiff = 2 * pi - phaseDiff;
+    double phaseDiff;
+    if (ampL > 0 && ampR > 0) {
+      // the angle between Lt and Rt, without computing both phases
+      double re = lf[f].real() * rf[f].real() + lf[f].imag() * rf[f].imag();
+      double im = lf[f].imag() * rf[f].real() - lf[f].real() * rf[f].imag();
+      phaseDiff = atan2(std::abs(im), re);
+    } else {
+      phaseDiff = std::abs(phase(lf[f]) - phase(rf[f]));
+      if (phaseDiff > pi)
+        phaseDiff = 2 * pi - phaseDiff;
+    }
 
     // decode into x/y soundfield position
     double x, y;
@@ -195,10 +244,10 @@ void DPL2FSDecoder::buffered_decode(float *input) {
 
     // get total signal amplitude
     double amp_total = sqrt(ampL * ampL + ampR * ampR);
-    // and total L/C/R signal phases
-    double phase_of[] = {
-        phaseL, atan2(lf[f].imag() + rf[f].imag(), lf[f].real() + rf[f].real()),
-        phaseR};
+    // and total L/C/R signal phases, as unit phasors
+    cplx center = lf[f] + rf[f];
+    cplx phase_of[] = {unit(lf[f], ampL), unit(center, sqrt(norm(center))),
+                       unit(rf[f], ampR)};
     // compute 2d channel map indexes p/q and update x/y to fractional offsets
     // in the map grid
     int p = map_to_grid(x), q = map_to_grid(y);
@@ -207,11 +256,12 @@ void DPL2FSDecoder::buffered_decode(float *input) {
       // look up channel map at respective position (with bilinear
       // interpolation) and build the
       // signal
-      std::vector<float *> &a = chn_alloc[setup][c];
-      signal[c][f] = polar(
-          amp_total * ((1 - x) * (1 - y) * a[q][p] + x * (1 - y) * a[q][p + 1] +
-                       (1 - x) * y * a[q + 1][p] + x * y * a[q + 1][p + 1]),
-          phase_of[1 + static_cast<int>(sign(chn_xsf[setup][c]))]);
+      std::vector<float *> &a = alloc[c];
+      signal[c] =
+          amp_total *
+          ((1 - x) * (1 - y) * a[q][p] + x * (1 - y) * a[q][p + 1] +
+           (1 - x) * y * a[q + 1][p] + x * y * a[q + 1][p + 1]) *
+          phase_of[phase_src[c]];
     }
 
     // optionally redirect bass
@@ -221,53 +271,68 @@ void DPL2FSDecoder::buffered_decode(float *input) {
           f < lo_cut ? 1
                      : 0.5 * (1 + cos(pi * (f - lo_cut) / (hi_cut - lo_cut)));
       // assign LFE channel
-      signal[C - 1][f] = lfe_level * polar(amp_total, phase_of[1]);
+      signal[C - 1] = lfe_level * amp_total * phase_of[1];
       // subtract the signal from the other channels
       for (unsigned int c = 0; c < C - 1; c++)
-        signal[c][f] *= (1 - lfe_level);
+        signal[c] *= (1 - lfe_level);
+    } else {
+      // the LFE channel is silent outside of the bass range (signal only holds
+      // the current bin, so it has to be cleared explicitly)
+      signal[C - 1] = 0;
+    }
+
+    // store the spectra of pairs of channels c and c+1 as the spectrum of
+    // channel c + i*channel c+1, in the transform c/2 of the inverse FFT (at
+    // most 8 channels fit into the four transforms)
+    for (unsigned int c = 0; c < C; c += 2) {
+      const cplx x = signal[c], y = signal[c + 1];
+      const unsigned int l = c / 2;
+      inv_re[4 * f + l] = static_cast<float>(x.real() - y.imag());
+      inv_im[4 * f + l] = static_cast<float>(x.imag() + y.real());
+      inv_re[4 * (N - f) + l] = static_cast<float>(x.real() + y.imag());
+      inv_im[4 * (N - f) + l] = static_cast<float>(y.real() - x.imag());
     }
   }
+  // (the DC and Nyquist frequencies are left silent)
+  for (unsigned int l = 0; l < 4; l++) {
+    inv_re[l] = inv_im[l] = 0;
+    inv_re[4 * (N / 2) + l] = inv_im[4 * (N / 2) + l] = 0;
+  }
 
-  // shift the last 2/3 to the first 2/3 of the output buffer
-  memcpy(&outbuf[0], &outbuf[C * N / 2], N * C * 4);
+  // shift the output buffer by one hop
+  memmove(&outbuf[0], &outbuf[C * H], S * C * 4);
   // and clear the rest
-  memset(&outbuf[C * N], 0, C * 4 * N / 2);
-  // backtransform each channel and overlap-add
+  memset(&outbuf[C * S], 0, C * 4 * H);
+  // backtransform all channels
+  fft->transform(&inv_re[0], &inv_im[0], true);
+
+  // add the part of the result covered by the synthesis window to the end of
+  // the output buffer, windowed (and remultiplex)
   for (unsigned int c = 0; c < C; c++) {
-    // back-transform into time domain
-    kiss_fftri(inverse, (kiss_fft_cpx *)&signal[c][0], &dst[0]);
-    // add the result to the last 2/3 of the output buffer, windowed (and
-    // remultiplex)
-    for (unsigned int k = 0; k < N; k++)
-      outbuf[C * (k + N / 2) + c] += static_cast<float>(wnd[k] * dst[k]);
+    const std::vector<float> &dst = c % 2 ? inv_im : inv_re;
+    for (unsigned int k = N - S; k < N; k++)
+      outbuf[C * (k - (N - S) + H) + c] +=
+          static_cast<float>(swnd[k] * dst[4 * k + c / 2]);
   }
 }
 
 // transform amp/phase difference space into x/y soundfield space
 void DPL2FSDecoder::transform_decode(double a, double p, double &x, double &y) {
-  x = clamp(1.0047 * a + 0.46804 * a * p * p * p - 0.2042 * a * p * p * p * p +
-            0.0080586 * a * p * p * p * p * p * p * p -
-            0.0001526 * a * p * p * p * p * p * p * p * p * p * p -
-            0.073512 * a * a * a * p - 0.2499 * a * a * a * p * p * p * p +
-            0.016932 * a * a * a * p * p * p * p * p * p * p -
-            0.00027707 * a * a * a * p * p * p * p * p * p * p * p * p * p +
-            0.048105 * a * a * a * a * a * p * p * p * p * p * p * p -
-            0.0065947 * a * a * a * a * a * p * p * p * p * p * p * p * p * p *
-                p +
-            0.0016006 * a * a * a * a * a * p * p * p * p * p * p * p * p * p *
-                p * p -
-            0.0071132 * a * a * a * a * a * a * a * p * p * p * p * p * p * p *
-                p * p +
-            0.0022336 * a * a * a * a * a * a * a * p * p * p * p * p * p * p *
-                p * p * p * p -
-            0.0004804 * a * a * a * a * a * a * a * p * p * p * p * p * p * p *
-                p * p * p * p * p);
-  y = clamp(
-      0.98592 - 0.62237 * p + 0.077875 * p * p - 0.0026929 * p * p * p * p * p +
-      0.4971 * a * a * p - 0.00032124 * a * a * p * p * p * p * p * p +
-      9.2491e-006 * a * a * a * a * p * p * p * p * p * p * p * p * p * p +
-      0.051549 * a * a * a * a * a * a * a * a +
-      1.0727e-014 * a * a * a * a * a * a * a * a * a * a);
+  // (the powers are computed once, and the terms grouped by powers of a)
+  double a2 = a * a, a3 = a2 * a, a4 = a2 * a2, a5 = a4 * a, a7 = a5 * a2,
+         a8 = a4 * a4;
+  double p2 = p * p, p3 = p2 * p, p4 = p2 * p2, p5 = p4 * p, p6 = p3 * p3,
+         p7 = p6 * p, p9 = p7 * p2, p10 = p5 * p5, p11 = p10 * p,
+         p12 = p6 * p6;
+  x = clamp(a * (1.0047 + 0.46804 * p3 - 0.2042 * p4 + 0.0080586 * p7 -
+                 0.0001526 * p10) +
+            a3 * (-0.073512 * p - 0.2499 * p4 + 0.016932 * p7 -
+                  0.00027707 * p10) +
+            a5 * (0.048105 * p7 - 0.0065947 * p10 + 0.0016006 * p11) +
+            a7 * (-0.0071132 * p9 + 0.0022336 * p11 - 0.0004804 * p12));
+  y = clamp(0.98592 - 0.62237 * p + 0.077875 * p2 - 0.0026929 * p5 +
+            a2 * (0.4971 * p - 0.00032124 * p6) + 9.2491e-006 * a4 * p10 +
+            0.051549 * a8 + 1.0727e-014 * a8 * a2);
 }
 
 // apply a circular_wrap transformation to some position
@@ -281,12 +346,12 @@ void DPL2FSDecoder::transform_circular_wrap(double &x, double &y,
   double ang = atan2(x, y), len = sqrt(x * x + y * y);
   len = len / edgedistance(ang);
   // apply circular_wrap transform
-  if (abs(ang) < baseangle / 2)
+  if (std::abs(ang) < baseangle / 2)
     // angle falls within the front region (to be enlarged)
     ang *= refangle / baseangle;
   else
     // angle falls within the rear region (to be shrunken)
-    ang = pi - (-(((refangle - 2 * pi) * (pi - abs(ang)) * sign(ang)) /
+    ang = pi - (-(((refangle - 2 * pi) * (pi - std::abs(ang)) * sign(ang)) /
                   (2 * pi - baseangle)));
   // translate back into soundfield position
   len = len * edgedistance(ang);
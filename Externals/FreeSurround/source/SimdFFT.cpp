@@ -0,0 +1,156 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "FreeSurround/SimdFFT.h"
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>
+typedef __m128 v4;
+static inline v4 v4_load(const float *p) { return _mm_loadu_ps(p); }
+static inline void v4_store(float *p, v4 a) { _mm_storeu_ps(p, a); }
+static inline v4 v4_set1(float x) { return _mm_set1_ps(x); }
+static inline v4 v4_add(v4 a, v4 b) { return _mm_add_ps(a, b); }
+static inline v4 v4_sub(v4 a, v4 b) { return _mm_sub_ps(a, b); }
+static inline v4 v4_mul(v4 a, v4 b) { return _mm_mul_ps(a, b); }
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+typedef float32x4_t v4;
+static inline v4 v4_load(const float *p) { return vld1q_f32(p); }
+static inline void v4_store(float *p, v4 a) { vst1q_f32(p, a); }
+static inline v4 v4_set1(float x) { return vdupq_n_f32(x); }
+static inline v4 v4_add(v4 a, v4 b) { return vaddq_f32(a, b); }
+static inline v4 v4_sub(v4 a, v4 b) { return vsubq_f32(a, b); }
+static inline v4 v4_mul(v4 a, v4 b) { return vmulq_f32(a, b); }
+#else
+struct v4 {
+  float x[4];
+};
+static inline v4 v4_load(const float *p) {
+  v4 r;
+  for (int l = 0; l < 4; l++)
+    r.x[l] = p[l];
+  return r;
+}
+static inline void v4_store(float *p, v4 a) {
+  for (int l = 0; l < 4; l++)
+    p[l] = a.x[l];
+}
+static inline v4 v4_set1(float x) {
+  v4 r;
+  for (int l = 0; l < 4; l++)
+    r.x[l] = x;
+  return r;
+}
+static inline v4 v4_add(v4 a, v4 b) {
+  for (int l = 0; l < 4; l++)
+    a.x[l] += b.x[l];
+  return a;
+}
+static inline v4 v4_sub(v4 a, v4 b) {
+  for (int l = 0; l < 4; l++)
+    a.x[l] -= b.x[l];
+  return a;
+}
+static inline v4 v4_mul(v4 a, v4 b) {
+  for (int l = 0; l < 4; l++)
+    a.x[l] *= b.x[l];
+  return a;
+}
+#endif
+
+SimdFFT::SimdFFT(unsigned int size)
+    : n(size), twiddle_re(size), twiddle_im(size) {
+  // bit reversal permutation
+  for (unsigned int i = 0, j = 0; i < n; i++) {
+    if (i < j)
+      swaps.push_back(std::make_pair(i, j));
+    unsigned int bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j |= bit;
+  }
+
+  const double pi = 3.14159265358979323846;
+  for (unsigned int h = 1; h < n; h *= 2) {
+    for (unsigned int j = 0; j < h; j++) {
+      twiddle_re[h + j] = static_cast<float>(cos(pi * j / h));
+      twiddle_im[h + j] = static_cast<float>(-sin(pi * j / h));
+    }
+  }
+}
+
+void SimdFFT::transform(float *re, float *im, bool inverse) const {
+  for (size_t s = 0; s < swaps.size(); s++) {
+    const unsigned int a = 4 * swaps[s].first, b = 4 * swaps[s].second;
+    const v4 r = v4_load(&re[a]), i = v4_load(&im[a]);
+    v4_store(&re[a], v4_load(&re[b]));
+    v4_store(&im[a], v4_load(&im[b]));
+    v4_store(&re[b], r);
+    v4_store(&im[b], i);
+  }
+
+  // decimation in time butterflies, two radix-2 stages of half sizes h and
+  // 2*h at a time (after a single one if the number of stages is odd)
+  const float sign = inverse ? -1.0f : 1.0f;
+  unsigned int stages = 0;
+  while ((1u << stages) < n)
+    stages++;
+  unsigned int h = 1;
+  if (stages % 2) {
+    for (unsigned int k = 0; k < n; k += 2) {
+      const v4 ar = v4_load(&re[4 * k]), ai = v4_load(&im[4 * k]);
+      const v4 br = v4_load(&re[4 * k + 4]), bi = v4_load(&im[4 * k + 4]);
+      v4_store(&re[4 * k], v4_add(ar, br));
+      v4_store(&im[4 * k], v4_add(ai, bi));
+      v4_store(&re[4 * k + 4], v4_sub(ar, br));
+      v4_store(&im[4 * k + 4], v4_sub(ai, bi));
+    }
+    h = 2;
+  }
+  for (; h < n; h *= 4) {
+    for (unsigned int b = 0; b < n; b += 4 * h) {
+      for (unsigned int j = 0; j < h; j++) {
+        float *r0 = &re[4 * (b + j)], *i0 = &im[4 * (b + j)];
+        float *r1 = r0 + 4 * h, *i1 = i0 + 4 * h;
+        float *r2 = r1 + 4 * h, *i2 = i1 + 4 * h;
+        float *r3 = r2 + 4 * h, *i3 = i2 + 4 * h;
+
+        // stage h: (0, 1) and (2, 3), with the same twiddle factor
+        const v4 w1r = v4_set1(twiddle_re[h + j]);
+        const v4 w1i = v4_set1(sign * twiddle_im[h + j]);
+        const v4 x1r = v4_load(r1), x1i = v4_load(i1);
+        const v4 x3r = v4_load(r3), x3i = v4_load(i3);
+        const v4 t1r = v4_sub(v4_mul(x1r, w1r), v4_mul(x1i, w1i));
+        const v4 t1i = v4_add(v4_mul(x1r, w1i), v4_mul(x1i, w1r));
+        const v4 t3r = v4_sub(v4_mul(x3r, w1r), v4_mul(x3i, w1i));
+        const v4 t3i = v4_add(v4_mul(x3r, w1i), v4_mul(x3i, w1r));
+        const v4 x0r = v4_load(r0), x0i = v4_load(i0);
+        const v4 x2r = v4_load(r2), x2i = v4_load(i2);
+        const v4 a0r = v4_add(x0r, t1r), a0i = v4_add(x0i, t1i);
+        const v4 a1r = v4_sub(x0r, t1r), a1i = v4_sub(x0i, t1i);
+        const v4 a2r = v4_add(x2r, t3r), a2i = v4_add(x2i, t3i);
+        const v4 a3r = v4_sub(x2r, t3r), a3i = v4_sub(x2i, t3i);
+
+        // stage 2*h: (0, 2) with w, and (1, 3) with w times -i (or i for
+        // the inverse transform)
+        const float wr = twiddle_re[2 * h + j];
+        const float wi = sign * twiddle_im[2 * h + j];
+        const v4 w2r = v4_set1(wr), w2i = v4_set1(wi);
+        const v4 w3r = v4_set1(sign * wi), w3i = v4_set1(-sign * wr);
+        const v4 t2r = v4_sub(v4_mul(a2r, w2r), v4_mul(a2i, w2i));
+        const v4 t2i = v4_add(v4_mul(a2r, w2i), v4_mul(a2i, w2r));
+        const v4 u3r = v4_sub(v4_mul(a3r, w3r), v4_mul(a3i, w3i));
+        const v4 u3i = v4_add(v4_mul(a3r, w3i), v4_mul(a3i, w3r));
+        v4_store(r0, v4_add(a0r, t2r));
+        v4_store(i0, v4_add(a0i, t2i));
+        v4_store(r2, v4_sub(a0r, t2r));
+        v4_store(i2, v4_sub(a0i, t2i));
+        v4_store(r1, v4_add(a1r, u3r));
+        v4_store(i1, v4_add(a1i, u3i));
+        v4_store(r3, v4_sub(a1r, u3r));
+        v4_store(i3, v4_sub(a1i, u3i));
+      }
+    }
+  }
+}
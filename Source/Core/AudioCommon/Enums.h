@@ -12,4 +12,10 @@ enum class DPL2Quality
   High = 2,
   Highest = 3
 };
+
+enum class ResamplingQuality
+{
+  Linear = 0,
+  Sinc = 1
+};
 }  // namespace AudioCommon
@@ -12,6 +12,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 
@@ -33,16 +34,30 @@ static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
 Mixer::Mixer(unsigned int BackendSampleRate)
     : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate),
       m_surround_decoder(BackendSampleRate,
-                         DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY)))
+                         DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY)),
+                         Config::Get(Config::MAIN_DPL2_LOW_LATENCY))
 {
   m_config_changed_callback_id = Config::AddConfigChangedCallback([this] { RefreshConfig(); });
   RefreshConfig();
 
+  if (Config::Get(Config::MAIN_AUDIO_MIXER_THREAD))
+  {
+    m_mixer_thread_running.Set();
+    m_mixer_thread = std::thread(&Mixer::MixerThread, this);
+  }
+
   INFO_LOG_FMT(AUDIO_INTERFACE, "Mixer is initialized");
 }
 
 Mixer::~Mixer()
 {
+  if (m_mixer_thread.joinable())
+  {
+    m_mixer_thread_running.Clear();
+    m_mixer_thread_event.Set();
+    m_mixer_thread.join();
+  }
+
   Config::RemoveConfigChangedCallback(m_config_changed_callback_id);
 }
 
@@ -101,50 +116,87 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   s32 lvolume = m_LVolume.load();
   s32 rvolume = m_RVolume.load();
 
-  const auto read_buffer = [this](auto index) {
-    return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
-  };
+  const bool sinc = m_mixer->m_config_resampling_quality == AudioCommon::ResamplingQuality::Sinc;
+  // The resampler reads this many frames after the current one, which have to be available.
+  const u32 frames_after = sinc ? AudioCommon::Resampler::SINC_FRAMES_AFTER : 1;
+
+  // Copy the frames that may be needed after the last frames that were read, so that the
+  // resampler can read them without wrapping around or swapping them.
+  const u32 available_frames = ((indexW - indexR) & INDEX_MASK) / 2;
+  const u32 frame_count = static_cast<u32>(std::min<u64>(
+      available_frames, ((u64{numSamples} * ratio + m_frac) >> 16) + frames_after + 1));
+  short* input = &m_linear_buffer[HISTORY_FRAMES * 2];
+  const u32 start = indexR & INDEX_MASK;
+  const u32 first_part = std::min(frame_count * 2, MAX_SAMPLES * 2 - start);
+  std::copy_n(&m_buffer[start], first_part, input);
+  std::copy_n(&m_buffer[0], frame_count * 2 - first_part, input + first_part);
+  if (!m_little_endian)
+  {
+    for (u32 i = 0; i < frame_count * 2; ++i)
+      input[i] = Common::swap16(input[i]);
+  }
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  constexpr u32 CHUNK_SIZE = 256;
+  std::array<u32, CHUNK_SIZE> positions;
+  std::array<u16, CHUNK_SIZE> fracs;
+  u32 position = 0;
+  while (currentSample < numSamples)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    u32 count = 0;
+    for (; count < CHUNK_SIZE && currentSample + count < numSamples &&
+           position + frames_after < frame_count;
+         ++count)
+    {
+      positions[count] = position;
+      fracs[count] = static_cast<u16>(m_frac);
+      m_frac += ratio;
+      position += m_frac >> 16;
+      m_frac &= 0xffff;
+    }
+    if (count == 0)
+      break;
+
+    short* out = &samples[currentSample * 2];
+    if (sinc)
+    {
+      AudioCommon::Resampler::MixSinc(input, positions.data(), fracs.data(), count, lvolume,
+                                      rvolume, out);
+    }
+    else
+    {
+      AudioCommon::Resampler::MixLinear(input, positions.data(), fracs.data(), count, lvolume,
+                                        rvolume, out);
+    }
+    currentSample += count;
   }
 
+  // Never read past the frames that were written.
+  position = std::min(position, frame_count);
+  indexR += position * 2;
+  // Keep the last frames that were read for the next call, as the sinc filter reads them again.
+  std::memmove(m_linear_buffer.data(), &m_linear_buffer[position * 2],
+               HISTORY_FRAMES * 2 * sizeof(short));
+
   // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
+  const unsigned int actual_sample_count = currentSample;
 
   // Padding
   short s[2];
-  s[0] = read_buffer((indexR - 1) & INDEX_MASK);
-  s[1] = read_buffer((indexR - 2) & INDEX_MASK);
+  s[0] = m_linear_buffer[HISTORY_FRAMES * 2 - 1];
+  s[1] = m_linear_buffer[HISTORY_FRAMES * 2 - 2];
   s[0] = (s[0] * rvolume) >> 8;
   s[1] = (s[1] * lvolume) >> 8;
-  for (; currentSample < numSamples * 2; currentSample += 2)
+  // Mixed samples are already clamped, so padding with silence wouldn't change them. This is the
+  // case for every fifo which isn't in use.
+  if (s[0] == 0 && s[1] == 0)
+    currentSample = numSamples;
+  for (; currentSample < numSamples; ++currentSample)
   {
-    int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
-    int sampleL = std::clamp(s[1] + samples[currentSample + 1], -32767, 32767);
+    int sampleR = std::clamp(s[0] + samples[currentSample * 2 + 0], -32767, 32767);
+    int sampleL = std::clamp(s[1] + samples[currentSample * 2 + 1], -32767, 32767);
 
-    samples[currentSample + 0] = sampleR;
-    samples[currentSample + 1] = sampleL;
+    samples[currentSample * 2 + 0] = sampleR;
+    samples[currentSample * 2 + 1] = sampleL;
   }
 
   // Flush cached variable
@@ -158,6 +210,62 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   if (!samples)
     return 0;
 
+  if (!m_mixer_thread.joinable())
+    return MixFifos(samples, num_samples);
+
+  ReadMixedFrames(m_mixed_samples.data(), samples, num_samples, m_last_mixed_frame);
+  return num_samples;
+}
+
+template <typename T, size_t Channels>
+void Mixer::ReadMixedFrames(const T* ring, T* samples, u32 num_samples,
+                            std::array<T, Channels>& last_frame)
+{
+  // Only copy the samples mixed by the mixer thread, and have it mix as many for the next call.
+  m_mix_ahead.store(std::min(num_samples, MAX_SAMPLES));
+  const u32 read = m_mixed_read.load(std::memory_order_relaxed);
+  const u32 count = std::min(m_mixed_write.load(std::memory_order_acquire) - read, num_samples);
+  const u32 offset = read % MAX_SAMPLES;
+  const u32 first_part = std::min(count, MAX_SAMPLES - offset);
+  std::copy_n(&ring[offset * Channels], first_part * Channels, samples);
+  std::copy_n(&ring[0], (count - first_part) * Channels, &samples[first_part * Channels]);
+  m_mixed_read.store(read + count, std::memory_order_release);
+  m_mixer_thread_event.Set();
+
+  // If the mixer thread is late, repeat the last frame instead of causing a click.
+  if (count != 0)
+    std::copy_n(&samples[(count - 1) * Channels], Channels, last_frame.begin());
+  for (u32 i = count; i < num_samples; ++i)
+    std::copy_n(last_frame.begin(), Channels, &samples[i * Channels]);
+}
+
+void Mixer::MixerThread()
+{
+  Common::SetCurrentThreadName("Audio mixer");
+
+  while (m_mixer_thread_running.IsSet())
+  {
+    const u32 write = m_mixed_write.load(std::memory_order_relaxed);
+    const u32 mixed = write - m_mixed_read.load(std::memory_order_acquire);
+    const u32 target = m_mix_ahead.load();
+    if (mixed >= target)
+    {
+      m_mixer_thread_event.Wait();
+      continue;
+    }
+
+    const u32 offset = write % MAX_SAMPLES;
+    const u32 count = std::min(target - mixed, MAX_SAMPLES - offset);
+    if (m_mix_surround.load())
+      DecodeSurround(&m_mixed_surround_samples[offset * SURROUND_CHANNELS], count);
+    else
+      MixFifos(&m_mixed_samples[offset * 2], count);
+    m_mixed_write.store(write + count, std::memory_order_release);
+  }
+}
+
+unsigned int Mixer::MixFifos(short* samples, unsigned int num_samples)
+{
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
   const float emulation_speed = m_config_emulation_speed;
@@ -207,20 +315,28 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
   if (!num_samples)
     return 0;
 
+  if (!m_mixer_thread.joinable())
+    return DecodeSurround(samples, num_samples);
+
+  m_mix_surround.store(true);
+  ReadMixedFrames(m_mixed_surround_samples.data(), samples, num_samples, m_last_surround_frame);
+  return num_samples;
+}
+
+unsigned int Mixer::DecodeSurround(float* samples, unsigned int num_samples)
+{
   memset(samples, 0, num_samples * SURROUND_CHANNELS * sizeof(float));
 
   size_t needed_frames = m_surround_decoder.QueryFramesNeededForSurroundOutput(num_samples);
 
-  // Mix() may also use m_scratch_buffer internally, but is safe because it alternates reads
-  // and writes.
-  size_t available_frames = Mix(m_scratch_buffer.data(), static_cast<u32>(needed_frames));
+  size_t available_frames = MixFifos(m_surround_buffer.data(), static_cast<u32>(needed_frames));
   if (available_frames != needed_frames)
   {
     ERROR_LOG_FMT(AUDIO, "Error decoding surround frames.");
     return 0;
   }
 
-  m_surround_decoder.PutFrames(m_scratch_buffer.data(), needed_frames);
+  m_surround_decoder.PutFrames(m_surround_buffer.data(), needed_frames);
   m_surround_decoder.ReceiveFrames(samples, num_samples);
 
   return num_samples;
@@ -412,6 +528,7 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_resampling_quality = Config::Get(Config::MAIN_AUDIO_RESAMPLING_QUALITY);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
@@ -5,11 +5,16 @@
 
 #include <array>
 #include <atomic>
+#include <thread>
 
 #include "AudioCommon/AudioStretcher.h"
+#include "AudioCommon/Enums.h"
+#include "AudioCommon/Resampler.h"
 #include "AudioCommon/SurroundDecoder.h"
 #include "AudioCommon/WaveFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 
 class PointerWrap;
 
@@ -61,7 +66,7 @@ private:
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
 
-  const unsigned int SURROUND_CHANNELS = 6;
+  static constexpr u32 SURROUND_CHANNELS = 6;
 
   class MixerFifo final
   {
@@ -82,10 +87,15 @@ private:
     unsigned int AvailableSamples() const;
 
   private:
+    static constexpr u32 HISTORY_FRAMES = AudioCommon::Resampler::SINC_FRAMES_BEFORE;
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate_divisor;
     bool m_little_endian;
     std::array<short, MAX_SAMPLES * 2> m_buffer{};
+    // The last frames that were read followed by the frames being resampled, in host byte order.
+    // Only used while mixing.
+    std::array<short, (HISTORY_FRAMES + MAX_SAMPLES) * 2> m_linear_buffer{};
     std::atomic<u32> m_indexW{0};
     std::atomic<u32> m_indexR{0};
     // Volume ranges from 0-256
@@ -95,6 +105,16 @@ private:
     u32 m_frac = 0;
   };
 
+  // Mixes all fifos into <samples>, on the audio thread or on the mixer thread.
+  unsigned int MixFifos(short* samples, unsigned int num_samples);
+  // Mixes all fifos and decodes them to surround frames, on the audio or the mixer thread.
+  unsigned int DecodeSurround(float* samples, unsigned int num_samples);
+  void MixerThread();
+  // Copies the frames mixed by the mixer thread from <ring>, repeating <last_frame> if it is late.
+  template <typename T, size_t Channels>
+  void ReadMixedFrames(const T* ring, T* samples, u32 num_samples,
+                       std::array<T, Channels>& last_frame);
+
   void RefreshConfig();
 
   MixerFifo m_dma_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
@@ -110,6 +130,23 @@ private:
   AudioCommon::AudioStretcher m_stretcher;
   AudioCommon::SurroundDecoder m_surround_decoder;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
+  std::array<short, MAX_SAMPLES * 2> m_surround_buffer{};
+
+  // When the mixer thread is used, it keeps m_mix_ahead frames mixed in m_mixed_samples, so that
+  // Mix() only has to copy them.
+  std::thread m_mixer_thread;
+  Common::Flag m_mixer_thread_running;
+  Common::Event m_mixer_thread_event;
+  std::array<short, MAX_SAMPLES * 2> m_mixed_samples{};
+  std::atomic<u32> m_mixed_write{0};
+  std::atomic<u32> m_mixed_read{0};
+  std::atomic<u32> m_mix_ahead{0};
+  std::array<short, 2> m_last_mixed_frame{};
+  // Set by MixSurround(), to have the mixer thread decode surround frames into
+  // m_mixed_surround_samples instead. A backend only ever uses one of Mix() and MixSurround().
+  std::atomic<bool> m_mix_surround{false};
+  std::array<float, MAX_SAMPLES * SURROUND_CHANNELS> m_mixed_surround_samples{};
+  std::array<float, SURROUND_CHANNELS> m_last_surround_frame{};
 
   WaveFileWriter m_wave_writer_dtk;
   WaveFileWriter m_wave_writer_dsp;
@@ -123,6 +160,7 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  AudioCommon::ResamplingQuality m_config_resampling_quality;
 
   size_t m_config_changed_callback_id;
 };
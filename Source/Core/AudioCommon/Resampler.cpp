@@ -0,0 +1,197 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/Resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef _M_X86
+#include <emmintrin.h>
+#endif
+
+#include "Common/MathUtil.h"
+
+namespace AudioCommon::Resampler
+{
+namespace
+{
+// The fraction of the input bandwidth which is kept. Lower values reduce ringing and aliasing.
+constexpr double SINC_CUTOFF = 0.9;
+
+SincTable CreateSincTable()
+{
+  SincTable table;
+  for (u32 phase = 0; phase < SINC_PHASES; ++phase)
+  {
+    std::array<double, SINC_TAPS> taps;
+    double sum = 0.0;
+    for (u32 i = 0; i < SINC_TAPS; ++i)
+    {
+      const double x = static_cast<double>(i) - SINC_FRAMES_BEFORE - double(phase) / SINC_PHASES;
+      const double t = MathUtil::PI * SINC_CUTOFF * x;
+      const double sinc = x == 0.0 ? 1.0 : std::sin(t) / t;
+      // Blackman window over the 8 taps of the filter.
+      const double w = MathUtil::PI * x / (SINC_TAPS / 2);
+      taps[i] = sinc * (0.42 + 0.5 * std::cos(w) + 0.08 * std::cos(2 * w));
+      sum += taps[i];
+    }
+
+    // Normalize the coefficients so that the gain is exactly 1, putting the rounding error on the
+    // largest coefficient.
+    s32 total = 0;
+    for (u32 i = 0; i < SINC_TAPS; ++i)
+    {
+      table[phase][i] = static_cast<s16>(std::lround(taps[i] / sum * (1 << 14)));
+      total += table[phase][i];
+    }
+    auto& largest = *std::max_element(table[phase].begin(), table[phase].end());
+    largest += static_cast<s16>((1 << 14) - total);
+  }
+  return table;
+}
+
+// Mixes one frame which was resampled with 14 fractional bits.
+void MixFrame(s32 left, s32 right, s32 lvolume, s32 rvolume, s16* output)
+{
+  left = std::clamp(left >> 14, -32768, 32767);
+  right = std::clamp(right >> 14, -32768, 32767);
+  output[0] = static_cast<s16>(std::clamp(output[0] + ((right * rvolume) >> 8), -32767, 32767));
+  output[1] = static_cast<s16>(std::clamp(output[1] + ((left * lvolume) >> 8), -32767, 32767));
+}
+
+#ifdef _M_X86
+// Mixes four frames which were resampled with 14 fractional bits, as left/right pairs of 32 bit
+// values. <volumes> holds the right and left volume in alternating 16 bit lanes.
+void MixFourFrames(__m128i frames01, __m128i frames23, __m128i volumes, s16* output)
+{
+  __m128i samples = _mm_packs_epi32(_mm_srai_epi32(frames01, 14), _mm_srai_epi32(frames23, 14));
+  // Swap the channels to the output order.
+  samples = _mm_shufflehi_epi16(_mm_shufflelo_epi16(samples, 0xB1), 0xB1);
+
+  const __m128i products_lo = _mm_mullo_epi16(samples, volumes);
+  const __m128i products_hi = _mm_mulhi_epi16(samples, volumes);
+  const __m128i scaled_lo = _mm_srai_epi32(_mm_unpacklo_epi16(products_lo, products_hi), 8);
+  const __m128i scaled_hi = _mm_srai_epi32(_mm_unpackhi_epi16(products_lo, products_hi), 8);
+
+  __m128i* out = reinterpret_cast<__m128i*>(output);
+  const __m128i mixed = _mm_loadu_si128(out);
+  const __m128i mixed_lo = _mm_srai_epi32(_mm_unpacklo_epi16(mixed, mixed), 16);
+  const __m128i mixed_hi = _mm_srai_epi32(_mm_unpackhi_epi16(mixed, mixed), 16);
+  const __m128i result = _mm_packs_epi32(_mm_add_epi32(mixed_lo, scaled_lo),
+                                         _mm_add_epi32(mixed_hi, scaled_hi));
+  _mm_storeu_si128(out, _mm_max_epi16(result, _mm_set1_epi16(-32767)));
+}
+
+__m128i LoadFrame(const s16* input, u32 position)
+{
+  s32 frame;
+  std::memcpy(&frame, &input[position * 2], sizeof(frame));
+  return _mm_cvtsi32_si128(frame);
+}
+
+// Returns the left and right sums of a frame in the two low 32 bit lanes.
+__m128i FilterFrame(const s16* input, u32 position, const std::array<s16, SINC_TAPS>& coeffs)
+{
+  const s16* taps = input + position * 2 - SINC_FRAMES_BEFORE * 2;
+  const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coeffs.data()));
+
+  // Group the samples of each channel in pairs, to match the coefficients pairs.
+  const auto load = [&](size_t offset) {
+    const __m128i frames = _mm_loadu_si128(reinterpret_cast<const __m128i*>(taps + offset));
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(frames, 0xD8), 0xD8);
+  };
+  const __m128i sums = _mm_add_epi32(_mm_madd_epi16(load(0), _mm_unpacklo_epi32(c, c)),
+                                     _mm_madd_epi16(load(8), _mm_unpackhi_epi32(c, c)));
+  return _mm_add_epi32(sums, _mm_unpackhi_epi64(sums, sums));
+}
+#endif
+}  // namespace
+
+const SincTable& GetSincTable()
+{
+  static const SincTable table = CreateSincTable();
+  return table;
+}
+
+void MixLinear(const s16* input, const u32* positions, const u16* fracs, size_t count,
+               s32 lvolume, s32 rvolume, s16* output)
+{
+  size_t i = 0;
+#ifdef _M_X86
+  const __m128i volumes = _mm_unpacklo_epi16(_mm_set1_epi16(static_cast<s16>(rvolume)),
+                                             _mm_set1_epi16(static_cast<s16>(lvolume)));
+  const auto weights = [&](size_t j) {
+    const s32 w = fracs[j] >> 2;
+    return (w << 16) | (0x4000 - w);
+  };
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i current[4], next[4];
+    for (size_t j = 0; j < 4; ++j)
+    {
+      current[j] = LoadFrame(input, positions[i + j]);
+      next[j] = LoadFrame(input, positions[i + j] + 1);
+    }
+    const auto gather = [](const __m128i* frames) {
+      return _mm_unpacklo_epi64(_mm_unpacklo_epi32(frames[0], frames[1]),
+                                _mm_unpacklo_epi32(frames[2], frames[3]));
+    };
+    // Pairs of consecutive samples of each channel, weighted by (1 - frac, frac).
+    const __m128i current_frames = gather(current);
+    const __m128i next_frames = gather(next);
+    const __m128i frames01 =
+        _mm_madd_epi16(_mm_unpacklo_epi16(current_frames, next_frames),
+                       _mm_setr_epi32(weights(i), weights(i), weights(i + 1), weights(i + 1)));
+    const __m128i frames23 = _mm_madd_epi16(
+        _mm_unpackhi_epi16(current_frames, next_frames),
+        _mm_setr_epi32(weights(i + 2), weights(i + 2), weights(i + 3), weights(i + 3)));
+    MixFourFrames(frames01, frames23, volumes, &output[i * 2]);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s16* frame = &input[positions[i] * 2];
+    const s32 w = fracs[i] >> 2;
+    const s32 left = frame[0] * (0x4000 - w) + frame[2] * w;
+    const s32 right = frame[1] * (0x4000 - w) + frame[3] * w;
+    MixFrame(left, right, lvolume, rvolume, &output[i * 2]);
+  }
+}
+
+void MixSinc(const s16* input, const u32* positions, const u16* fracs, size_t count, s32 lvolume,
+             s32 rvolume, s16* output)
+{
+  const SincTable& table = GetSincTable();
+  size_t i = 0;
+#ifdef _M_X86
+  const __m128i volumes = _mm_unpacklo_epi16(_mm_set1_epi16(static_cast<s16>(rvolume)),
+                                             _mm_set1_epi16(static_cast<s16>(lvolume)));
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto filter = [&](size_t j) {
+      return FilterFrame(input, positions[j], table[fracs[j] >> 10]);
+    };
+    const __m128i frames01 = _mm_unpacklo_epi64(filter(i), filter(i + 1));
+    const __m128i frames23 = _mm_unpacklo_epi64(filter(i + 2), filter(i + 3));
+    MixFourFrames(frames01, frames23, volumes, &output[i * 2]);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s16* taps = input + positions[i] * 2 - SINC_FRAMES_BEFORE * 2;
+    const auto& c = table[fracs[i] >> 10];
+    s32 left = 0;
+    s32 right = 0;
+    for (size_t j = 0; j < SINC_TAPS; ++j)
+    {
+      left += taps[j * 2] * c[j];
+      right += taps[j * 2 + 1] * c[j];
+    }
+    MixFrame(left, right, lvolume, rvolume, &output[i * 2]);
+  }
+}
+}  // namespace AudioCommon::Resampler
@@ -0,0 +1,37 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+// Resampling kernels used by the mixer. Input samples are interleaved stereo frames (left first),
+// output samples are interleaved stereo frames with the channels swapped (right first), which is
+// the order the mixer outputs.
+//
+// Every output frame i is computed from the input frames around positions[i], with fracs[i] being
+// the 16 bit fractional part of the position. The resampled sample is scaled by the channel volume
+// (0-256, 8 bit fractional part) and added to the output, which is clamped to [-32767, 32767].
+namespace AudioCommon::Resampler
+{
+// The number of frames before and after the current frame that are read by the sinc filter.
+constexpr u32 SINC_FRAMES_BEFORE = 3;
+constexpr u32 SINC_FRAMES_AFTER = 4;
+constexpr u32 SINC_TAPS = SINC_FRAMES_BEFORE + 1 + SINC_FRAMES_AFTER;
+constexpr u32 SINC_PHASES = 64;
+
+// Coefficients of the windowed sinc filter for each phase, with 14 fractional bits.
+using SincTable = std::array<std::array<s16, SINC_TAPS>, SINC_PHASES>;
+const SincTable& GetSincTable();
+
+// Interpolates linearly between positions[i] and positions[i] + 1.
+void MixLinear(const s16* input, const u32* positions, const u16* fracs, size_t count,
+               s32 lvolume, s32 rvolume, s16* output);
+
+// Filters the frames from positions[i] - SINC_FRAMES_BEFORE to positions[i] + SINC_FRAMES_AFTER.
+void MixSinc(const s16* input, const u32* positions, const u16* fracs, size_t count, s32 lvolume,
+             s32 rvolume, s16* output);
+}  // namespace AudioCommon::Resampler
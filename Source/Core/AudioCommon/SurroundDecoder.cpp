@@ -3,19 +3,25 @@
 
 #include "AudioCommon/SurroundDecoder.h"
 
-#include <FreeSurround/FreeSurroundDecoder.h>
+#include <algorithm>
 #include <limits>
 
+#include <FreeSurround/FreeSurroundDecoder.h>
+
 namespace AudioCommon
 {
 constexpr size_t STEREO_CHANNELS = 2;
 constexpr size_t SURROUND_CHANNELS = 6;
 
-SurroundDecoder::SurroundDecoder(u32 sample_rate, u32 frame_block_size)
-    : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size)
+SurroundDecoder::SurroundDecoder(u32 sample_rate, u32 frame_block_size, bool low_latency)
+    : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size),
+      m_hop_size(low_latency ? std::min(LOW_LATENCY_HOP_SIZE, frame_block_size / 4) :
+                               frame_block_size),
+      m_low_latency(low_latency)
 {
   m_fsdecoder = std::make_unique<DPL2FSDecoder>();
-  m_fsdecoder->Init(cs_5point1, m_frame_block_size, m_sample_rate);
+  m_fsdecoder->Init(cs_5point1, m_frame_block_size, m_sample_rate,
+                    m_low_latency ? m_hop_size : 0);
 }
 
 SurroundDecoder::~SurroundDecoder() = default;
@@ -33,7 +39,7 @@ size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_f
   {
     // Output stereo frames needed to have at least the desired number of surround frames
     size_t frames_needed = output_frames - m_decoded_fifo.size() / SURROUND_CHANNELS;
-    return frames_needed + m_frame_block_size - frames_needed % m_frame_block_size;
+    return (frames_needed + m_hop_size - 1) / m_hop_size * m_hop_size;
   }
 
   return 0;
@@ -49,14 +55,16 @@ void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
   while (remaining_frames > 0)
   {
     // Convert to float
-    for (size_t i = 0, end = m_frame_block_size * STEREO_CHANNELS; i < end; ++i)
+    for (size_t i = 0, end = m_hop_size * STEREO_CHANNELS; i < end; ++i)
     {
       m_float_conversion_buffer[i] = in[i + frame_index * STEREO_CHANNELS] /
                                      static_cast<float>(std::numeric_limits<short>::max());
     }
 
     // Decode
-    const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
+    const float* dpl2_fs = m_low_latency ?
+                               m_fsdecoder->decode_hop(m_float_conversion_buffer.data()) :
+                               m_fsdecoder->decode(m_float_conversion_buffer.data());
 
     // Add to ring buffer and fix channel mapping
     // Maybe modify FreeSurround to output the correct mapping?
@@ -64,7 +72,7 @@ void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
     // FL | FC | FR | BL | BR | LFE
     // Most backends:
     // FL | FR | FC | LFE | BL | BR
-    for (size_t i = 0; i < m_frame_block_size; ++i)
+    for (size_t i = 0; i < m_hop_size; ++i)
     {
       m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 0]);  // LEFTFRONT
       m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 2]);  // RIGHTFRONT
@@ -74,8 +82,8 @@ void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
       m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 4]);  // RIGHTREAR
     }
 
-    remaining_frames = remaining_frames - static_cast<int>(m_frame_block_size);
-    frame_index = frame_index + m_frame_block_size;
+    remaining_frames = remaining_frames - static_cast<int>(m_hop_size);
+    frame_index = frame_index + m_hop_size;
   }
 }
 
@@ -16,7 +16,11 @@ namespace AudioCommon
 class SurroundDecoder
 {
 public:
-  explicit SurroundDecoder(u32 sample_rate, u32 frame_block_size);
+  // In low latency mode, the frames are decoded in hops of LOW_LATENCY_HOP_SIZE frames instead of
+  // blocks of frame_block_size frames, which only delays them by one to two hops.
+  static constexpr u32 LOW_LATENCY_HOP_SIZE = 128;
+
+  SurroundDecoder(u32 sample_rate, u32 frame_block_size, bool low_latency);
   ~SurroundDecoder();
   size_t QueryFramesNeededForSurroundOutput(const size_t output_frames) const;
   void PutFrames(const short* in, const size_t num_frames_in);
@@ -26,6 +30,9 @@ public:
 private:
   u32 m_sample_rate;
   u32 m_frame_block_size;
+  // The number of frames decoded at once.
+  u32 m_hop_size;
+  bool m_low_latency;
 
   std::unique_ptr<DPL2FSDecoder> m_fsdecoder;
   std::array<float, 32768> m_float_conversion_buffer;
@@ -12,6 +12,7 @@
 // - Zero backwards/forwards compatibility
 // - Serialization code for anything complex has to be manually written.
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
@@ -49,6 +50,7 @@ public:
 private:
   u8** m_ptr_current;
   u8* m_ptr_end;
+  std::vector<u8>* m_growable_buffer = nullptr;
   Mode m_mode;
 
 public:
@@ -57,6 +59,18 @@ public:
   {
   }
 
+  // Creates a PointerWrap in write mode that writes from the start of buffer and grows it whenever
+  // it runs out of space, so the data doesn't have to be measured in a separate pass first. *ptr
+  // is kept pointing into buffer, and the written size is *ptr - buffer->data() afterwards.
+  // Existing contents and capacity of buffer are reused, so reusing one buffer for repeated
+  // writes of similar size needs no allocations.
+  PointerWrap(u8** ptr, std::vector<u8>* buffer)
+      : m_ptr_current(ptr), m_growable_buffer(buffer), m_mode(Mode::Write)
+  {
+    *m_ptr_current = buffer->data();
+    m_ptr_end = *m_ptr_current + buffer->size();
+  }
+
   void SetMeasureMode() { m_mode = Mode::Measure; }
   void SetVerifyMode() { m_mode = Mode::Verify; }
   bool IsReadMode() const { return m_mode == Mode::Read; }
@@ -219,13 +233,10 @@ public:
   [[nodiscard]] u8* DoExternal(u32& count)
   {
     Do(count);
+    if (!IsMeasureMode() && (*m_ptr_current + count) > m_ptr_end)
+      HandleOverflow(count);
     u8* current = *m_ptr_current;
     *m_ptr_current += count;
-    if (!IsMeasureMode() && *m_ptr_current > m_ptr_end)
-    {
-      // trying to read/write past the end of the buffer, prevent this
-      SetMeasureMode();
-    }
     return current;
   }
 
@@ -333,14 +344,28 @@ private:
     DoEachElement(x, [](PointerWrap& p, typename T::value_type& elem) { p.Do(elem); });
   }
 
-  DOLPHIN_FORCE_INLINE void DoVoid(void* data, u32 size)
+  // Called when size more bytes don't fit in the buffer.
+  void HandleOverflow(size_t size)
   {
-    if (!IsMeasureMode() && (*m_ptr_current + size) > m_ptr_end)
+    if (!m_growable_buffer || !IsWriteMode())
     {
       // trying to read/write past the end of the buffer, prevent this
       SetMeasureMode();
+      return;
     }
 
+    const size_t offset = *m_ptr_current - m_growable_buffer->data();
+    const size_t required_size = offset + size;
+    m_growable_buffer->resize(std::max(required_size, m_growable_buffer->size() * 2));
+    *m_ptr_current = m_growable_buffer->data() + offset;
+    m_ptr_end = m_growable_buffer->data() + m_growable_buffer->size();
+  }
+
+  DOLPHIN_FORCE_INLINE void DoVoid(void* data, u32 size)
+  {
+    if (!IsMeasureMode() && (*m_ptr_current + size) > m_ptr_end)
+      HandleOverflow(size);
+
     switch (m_mode)
     {
     case Mode::Read:
@@ -53,10 +53,6 @@ public:
   // return number of read entries
   u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
   {
-    // Since we're reading/writing directly to the storage of K instances,
-    // K must be trivially copyable.
-    static_assert(std::is_trivially_copyable<K>::value, "K must be a trivially copyable type");
-
     // close any currently opened file
     Close();
     m_num_entries = 0;
@@ -64,42 +60,12 @@ public:
     // try opening for reading/writing
     m_file.Open(filename, "r+b");
 
-    const u64 file_size = m_file.GetSize();
-
     m_header.Init();
-    if (m_file.IsOpen() && ValidateHeader())
+    if (m_file.IsOpen() && ValidateHeader(m_file))
     {
       // good header, read some key/value pairs
-      K key;
-
-      std::unique_ptr<V[]> value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-      u64 last_valid_value_start = m_file.Tell();
-
-      while (m_file.ReadArray(&value_size, 1))
-      {
-        const u64 next_extent = m_file.Tell() + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
-
-        // TODO: use make_unique_for_overwrite in C++20
-        value = std::unique_ptr<V[]>(new V[value_size]);
-
-        // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
-        {
-          last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
-        }
-        else
-        {
-          break;
-        }
-
-        m_num_entries++;
-      }
+      u64 last_valid_value_start;
+      m_num_entries = ReadEntries(m_file, reader, &last_valid_value_start);
       m_file.ClearError();
       m_file.Seek(last_valid_value_start, File::SeekOrigin::Begin);
 
@@ -114,6 +80,18 @@ public:
     return 0;
   }
 
+  // Reads a cache without opening it for writing, e.g. one that is shared with other instances.
+  // A missing or invalid file is left alone. Returns the number of read entries.
+  static u32 Read(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  {
+    File::IOFile file(filename, "rb");
+    if (!file.IsOpen() || !ValidateHeader(file))
+      return 0;
+
+    u64 last_valid_value_start;
+    return ReadEntries(file, reader, &last_valid_value_start);
+  }
+
   void Sync() { m_file.Flush(); }
   void Close()
   {
@@ -135,12 +113,59 @@ public:
 
 private:
   void WriteHeader() { m_file.WriteArray(&m_header, 1); }
-  bool ValidateHeader()
+
+  static bool ValidateHeader(File::IOFile& file)
   {
+    Header header;
+    header.Init();
     char file_header[sizeof(Header)];
 
-    return (m_file.ReadArray(file_header, sizeof(Header)) &&
-            !memcmp((const char*)&m_header, file_header, sizeof(Header)));
+    return (file.ReadArray(file_header, sizeof(Header)) &&
+            !memcmp((const char*)&header, file_header, sizeof(Header)));
+  }
+
+  // Reads key/value pairs up to the first incomplete or corrupted one, and returns their number.
+  static u32 ReadEntries(File::IOFile& file, LinearDiskCacheReader<K, V>& reader,
+                         u64* last_valid_value_start)
+  {
+    // Since we're reading/writing directly to the storage of K instances,
+    // K must be trivially copyable.
+    static_assert(std::is_trivially_copyable<K>::value, "K must be a trivially copyable type");
+
+    const u64 file_size = file.GetSize();
+    K key;
+
+    std::unique_ptr<V[]> value = nullptr;
+    u32 value_size = 0;
+    u32 entry_number = 0;
+    u32 num_entries = 0;
+    *last_valid_value_start = file.Tell();
+
+    while (file.ReadArray(&value_size, 1))
+    {
+      const u64 next_extent = file.Tell() + sizeof(value_size) + value_size;
+      if (next_extent > file_size)
+        break;
+
+      // TODO: use make_unique_for_overwrite in C++20
+      value = std::unique_ptr<V[]>(new V[value_size]);
+
+      // read key/value and pass to reader
+      if (file.ReadArray(&key, 1) && file.ReadArray(value.get(), value_size) &&
+          file.ReadArray(&entry_number, 1) && entry_number == num_entries + 1)
+      {
+        *last_valid_value_start = file.Tell();
+        reader.Read(key, value.get(), value_size);
+      }
+      else
+      {
+        break;
+      }
+
+      num_entries++;
+    }
+
+    return num_entries;
   }
 
   struct Header
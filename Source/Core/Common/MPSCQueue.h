@@ -0,0 +1,81 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a lockless thread-safe,
+// multiple producer, single consumer queue
+//
+// Push() may be called from any number of threads at once and never blocks or spins.
+// Empty() and Pop() must only be called from a single consumer thread.
+
+#include <atomic>
+#include <utility>
+
+namespace Common
+{
+template <typename T>
+class MPSCQueue
+{
+public:
+  MPSCQueue()
+  {
+    m_read_ptr = new Node();
+    m_write_ptr.store(m_read_ptr, std::memory_order_relaxed);
+  }
+  ~MPSCQueue()
+  {
+    Clear();
+    delete m_read_ptr;
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    Node* const new_ptr = new Node();
+    new_ptr->current = std::forward<Arg>(t);
+
+    // Claim the end of the queue, then link the previous end to the new element. A consumer that
+    // runs in between these two steps sees the queue as ending at the previous element, and will
+    // pick up the new one on its next Pop().
+    Node* const prev_ptr = m_write_ptr.exchange(new_ptr, std::memory_order_acq_rel);
+    prev_ptr->next.store(new_ptr, std::memory_order_release);
+  }
+
+  bool Empty() const { return !m_read_ptr->next.load(std::memory_order_acquire); }
+
+  bool Pop(T& t)
+  {
+    Node* const next_ptr = m_read_ptr->next.load(std::memory_order_acquire);
+    if (!next_ptr)
+      return false;
+
+    // The element after the current read position becomes the new dummy head.
+    t = std::move(next_ptr->current);
+    delete m_read_ptr;
+    m_read_ptr = next_ptr;
+    return true;
+  }
+
+  // Only safe to call while no other thread is pushing.
+  void Clear()
+  {
+    for (T t; Pop(t);)
+      ;
+  }
+
+private:
+  struct Node
+  {
+    T current{};
+    std::atomic<Node*> next{nullptr};
+  };
+
+  // Only touched by the consumer.
+  Node* m_read_ptr;
+  alignas(64) std::atomic<Node*> m_write_ptr;
+};
+}  // namespace Common
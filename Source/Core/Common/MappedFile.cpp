@@ -0,0 +1,171 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <utility>
+
+#include "Common/CommonFuncs.h"
+#include "Common/Logging/Log.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace File
+{
+MappedFile::MappedFile() = default;
+
+MappedFile::MappedFile(const std::string& filename)
+{
+  Open(filename);
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+#ifdef _WIN32
+      ,
+      m_mapping_handle(std::exchange(other.m_mapping_handle, nullptr))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this != &other)
+  {
+    Close();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+    m_mapping_handle = std::exchange(other.m_mapping_handle, nullptr);
+#endif
+  }
+  return *this;
+}
+
+bool MappedFile::Open(const std::string& filename)
+{
+  Close();
+
+#ifdef _WIN32
+  const HANDLE file = CreateFileW(UTF8ToWString(filename).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  // The mapping keeps its own reference to the file, so the file handle can be closed right away.
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to create file mapping for {}: {}", filename,
+                  GetLastErrorString());
+    return false;
+  }
+
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!data)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to map {}: {}", filename, GetLastErrorString());
+    CloseHandle(mapping);
+    return false;
+  }
+
+  m_mapping_handle = mapping;
+  m_data = static_cast<const u8*>(data);
+  m_size = static_cast<u64>(size.QuadPart);
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  // As with Windows, the mapping stays valid after the file descriptor is closed.
+  void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to map {}: {}", filename, LastStrerrorString());
+    return false;
+  }
+
+  m_data = static_cast<const u8*>(data);
+  m_size = static_cast<u64>(st.st_size);
+#endif
+
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mapping_handle);
+  m_mapping_handle = nullptr;
+#else
+  munmap(const_cast<u8*>(m_data), static_cast<size_t>(m_size));
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+const u8* MappedFile::GetPointer(u64 offset, u64 size) const
+{
+  if (offset > m_size || size > m_size - offset)
+    return nullptr;
+
+  return m_data + offset;
+}
+
+void MappedFile::PrefetchRange(u64 offset, u64 size) const
+{
+  if (offset >= m_size)
+    return;
+  if (size > m_size - offset)
+    size = m_size - offset;
+
+#ifdef _WIN32
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = const_cast<u8*>(m_data + offset);
+  range.NumberOfBytes = static_cast<SIZE_T>(size);
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  // madvise requires a page-aligned address.
+  const uintptr_t page_mask = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)) - 1;
+  const uintptr_t start = reinterpret_cast<uintptr_t>(m_data + offset);
+  const uintptr_t aligned_start = start & ~page_mask;
+  madvise(reinterpret_cast<void*>(aligned_start), static_cast<size_t>(size + start - aligned_start),
+          MADV_WILLNEED);
+#endif
+}
+
+}  // namespace File
@@ -0,0 +1,48 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+// A read-only view of an entire file, mapped into the address space of the process.
+// Pages are faulted in by the OS on demand, so opening even very large files is cheap.
+class MappedFile
+{
+public:
+  MappedFile();
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  bool Open(const std::string& filename);
+  void Close();
+
+  bool IsOpen() const { return m_data != nullptr; }
+  const u8* GetData() const { return m_data; }
+  u64 GetSize() const { return m_size; }
+
+  // Returns nullptr if the given range is not entirely contained within the file.
+  const u8* GetPointer(u64 offset, u64 size) const;
+
+  // Hints that the given range will be read soon. This is purely an optimization.
+  void PrefetchRange(u64 offset, u64 size) const;
+
+private:
+  const u8* m_data = nullptr;
+  u64 m_size = 0;
+#ifdef _WIN32
+  void* m_mapping_handle = nullptr;
+#endif
+};
+
+}  // namespace File
@@ -25,6 +25,10 @@
 #pragma comment(lib, "libittnotify.lib")
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/StringUtil.h"
@@ -187,4 +191,22 @@ void SetCurrentThreadName(const char* name)
 
 #endif
 
+void ParallelFor(size_t count, const std::function<void(size_t)>& function)
+{
+  const size_t thread_count =
+      std::min<size_t>(count, std::max(std::thread::hardware_concurrency(), 1u));
+  std::atomic<size_t> next_index = 0;
+  const auto worker = [&] {
+    for (size_t i = next_index++; i < count; i = next_index++)
+      function(i);
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
 }  // namespace Common
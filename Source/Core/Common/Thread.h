@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <thread>
 
 // Don't include Common.h here as it will break LogManager
@@ -35,4 +37,7 @@ inline void YieldCPU()
 
 void SetCurrentThreadName(const char* name);
 
+// Calls function with every index from 0 to count - 1, spread across all available threads.
+void ParallelFor(size_t count, const std::function<void(size_t)>& function);
+
 }  // namespace Common
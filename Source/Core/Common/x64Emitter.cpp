@@ -1858,12 +1858,11 @@ static int GetVEXpp(u8 opPrefix)
 }
 
 void XEmitter::WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
-                          int W, int extrabytes)
+                          int W, int extrabytes, int L)
 {
   int mmmmm = GetVEXmmmmm(op);
   int pp = GetVEXpp(opPrefix);
-  // FIXME: we currently don't support 256-bit instructions, and "size" is not the vector size here
-  arg.WriteVEX(this, regOp1, regOp2, 0, pp, mmmmm, W);
+  arg.WriteVEX(this, regOp1, regOp2, L, pp, mmmmm, W);
   Write8(op & 0xFF);
   arg.WriteRest(this, extrabytes, regOp1);
 }
@@ -1891,6 +1890,16 @@ void XEmitter::WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, co
   WriteVEXOp4(opPrefix, op, regOp1, regOp2, arg, regOp3, W);
 }
 
+void XEmitter::WriteAVX2Op(int bits, u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2,
+                           const OpArg& arg, int extrabytes)
+{
+  if (!cpu_info.bAVX2)
+    PanicAlertFmt("Trying to use AVX2 on a system that doesn't support it. Bad programmer.");
+  if (bits != 128 && bits != 256)
+    PanicAlertFmt("AVX2 instructions only support 128-bit and 256-bit vectors");
+  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, 0, extrabytes, bits == 256 ? 1 : 0);
+}
+
 void XEmitter::WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W)
 {
   if (!cpu_info.bFMA)
@@ -3047,6 +3056,48 @@ void XEmitter::VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
   WriteAVXOp(0x66, 0xEF, regOp1, regOp2, arg);
 }
 
+void XEmitter::VEXTRACTPS(const OpArg& arg, X64Reg regOp, u8 subreg)
+{
+  WriteAVXOp(0x66, 0x3A17, regOp, INVALID_REG, arg, 0, 1);
+  Write8(subreg);
+}
+void XEmitter::VZEROUPPER()
+{
+  if (!cpu_info.bAVX)
+    PanicAlertFmt("Trying to use AVX on a system that doesn't support it. Bad programmer.");
+  Write8(0xC5);
+  Write8(0xF8);
+  Write8(0x77);
+}
+
+void XEmitter::VPSHUFB(int bits, X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVX2Op(bits, 0x66, 0x3800, regOp1, regOp2, arg);
+}
+void XEmitter::VPSRAD(int bits, X64Reg regOp1, X64Reg regOp2, u8 shift)
+{
+  WriteAVX2Op(bits, 0x66, 0x72, (X64Reg)4, regOp1, R(regOp2), 1);
+  Write8(shift);
+}
+void XEmitter::VCVTDQ2PS(int bits, X64Reg regOp1, const OpArg& arg)
+{
+  WriteAVX2Op(bits, 0x00, 0x5B, regOp1, INVALID_REG, arg);
+}
+void XEmitter::VMULPS(int bits, X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVX2Op(bits, 0x00, sseMUL, regOp1, regOp2, arg);
+}
+void XEmitter::VINSERTI128(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 lane)
+{
+  WriteAVX2Op(256, 0x66, 0x3A38, regOp1, regOp2, arg, 1);
+  Write8(lane);
+}
+void XEmitter::VEXTRACTI128(const OpArg& arg, X64Reg regOp, u8 lane)
+{
+  WriteAVX2Op(256, 0x66, 0x3A39, regOp, INVALID_REG, arg, 1);
+  Write8(lane);
+}
+
 void XEmitter::VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
 {
   WriteFMA3Op(0x98, regOp1, regOp2, arg);
@@ -357,13 +357,15 @@ private:
   void WriteSSSE3Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteSSE41Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
   void WriteVEXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
   void WriteAVXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
                   int extrabytes = 0);
   void WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
+  void WriteAVX2Op(int bits, u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
+                   int extrabytes = 0);
   void WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0);
   void WriteFMA4Op(u8 op, X64Reg dest, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0);
   void WriteBMIOp(int size, u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
@@ -871,6 +873,18 @@ public:
   void VPOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
 
+  void VEXTRACTPS(const OpArg& arg, X64Reg regOp, u8 subreg);
+  void VZEROUPPER();
+
+  // AVX2
+  // The instructions taking a size operate on either 128-bit (XMM) or 256-bit (YMM) registers.
+  void VPSHUFB(int bits, X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VPSRAD(int bits, X64Reg regOp1, X64Reg regOp2, u8 shift);
+  void VCVTDQ2PS(int bits, X64Reg regOp1, const OpArg& arg);
+  void VMULPS(int bits, X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VINSERTI128(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 lane);
+  void VEXTRACTI128(const OpArg& arg, X64Reg regOp, u8 lane);
+
   // FMA3
   void VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VFMADD213PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
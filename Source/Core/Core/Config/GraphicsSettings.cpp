@@ -54,6 +54,8 @@ const Info<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS{
 const Info<int> GFX_PNG_COMPRESSION_LEVEL{{System::GFX, "Settings", "PNGCompressionLevel"}, 6};
 const Info<bool> GFX_ENABLE_GPU_TEXTURE_DECODING{
     {System::GFX, "Settings", "EnableGPUTextureDecoding"}, false};
+const Info<bool> GFX_ASYNC_VERTEX_LOADING{{System::GFX, "Settings", "AsyncVertexLoading"}, false};
+const Info<bool> GFX_VERTEX_LOADER_CACHE{{System::GFX, "Settings", "VertexLoaderCache"}, false};
 const Info<bool> GFX_ENABLE_PIXEL_LIGHTING{{System::GFX, "Settings", "EnablePixelLighting"}, false};
 const Info<bool> GFX_FAST_DEPTH_CALC{{System::GFX, "Settings", "FastDepthCalc"}, true};
 const Info<u32> GFX_MSAA{{System::GFX, "Settings", "MSAA"}, 1};
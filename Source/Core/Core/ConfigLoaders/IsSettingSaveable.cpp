@@ -61,9 +61,12 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_ALLOW_SD_WRITES.GetLocation(),
       &Config::MAIN_DPL2_DECODER.GetLocation(),
       &Config::MAIN_DPL2_QUALITY.GetLocation(),
+      &Config::MAIN_DPL2_LOW_LATENCY.GetLocation(),
       &Config::MAIN_AUDIO_LATENCY.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH_LATENCY.GetLocation(),
+      &Config::MAIN_AUDIO_RESAMPLING_QUALITY.GetLocation(),
+      &Config::MAIN_AUDIO_MIXER_THREAD.GetLocation(),
       &Config::MAIN_OVERCLOCK.GetLocation(),
       &Config::MAIN_OVERCLOCK_ENABLE.GetLocation(),
       &Config::MAIN_RAM_OVERRIDE_ENABLE.GetLocation(),
@@ -71,6 +74,9 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_MEM2_SIZE.GetLocation(),
       &Config::MAIN_GFX_BACKEND.GetLocation(),
       &Config::MAIN_ENABLE_SAVESTATES.GetLocation(),
+      &Config::MAIN_REWIND_ENABLE.GetLocation(),
+      &Config::MAIN_REWIND_INTERVAL.GetLocation(),
+      &Config::MAIN_REWIND_MEMORY_MB.GetLocation(),
       &Config::MAIN_FALLBACK_REGION.GetLocation(),
       &Config::MAIN_REAL_WII_REMOTE_REPEAT_REPORTS.GetLocation(),
       &Config::MAIN_DSP_HLE.GetLocation(),
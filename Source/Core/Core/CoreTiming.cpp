@@ -4,7 +4,6 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,7 +13,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
@@ -44,24 +43,22 @@ static bool operator>(const Event& left, const Event& right)
 {
   return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
 }
-static bool operator<(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
-}
 
 // unordered_map stores each element separately as a linked list node so pointers to elements
 // remain stable regardless of rehashes/resizing.
 static std::unordered_map<std::string, EventType> s_event_types;
 
 // STATE_TO_SAVE
-// The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-// We don't use std::priority_queue because we need to be able to serialize, unserialize and
-// erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-// by the standard adaptor class.
+// The queue is kept sorted from the latest to the earliest event, so the next event to run is at
+// the back and can be popped in O(1). Only a few dozen events are ever pending, and new events are
+// mostly scheduled into the near future, so inserting by scanning from the back is cheaper than
+// sifting through a binary heap on every push and pop.
 static std::vector<Event> s_event_queue;
 static u64 s_event_fifo_id;
-static std::mutex s_ts_write_lock;
-static Common::SPSCQueue<Event, false> s_ts_queue;
+
+// Events scheduled from other threads. This is lock-free so that the GPU, DVD and audio threads
+// never wait on each other (or on the CPU thread) to schedule an event.
+static Common::MPSCQueue<Event> s_ts_queue;
 
 static float s_last_OC_factor;
 static constexpr int MAX_SLICE_LENGTH = 20000;
@@ -86,6 +83,14 @@ static void EmptyTimedCallback(u64 userdata, s64 cyclesLate)
 {
 }
 
+static void PushEvent(const Event& ev)
+{
+  auto itr = s_event_queue.end();
+  while (itr != s_event_queue.begin() && ev > *(itr - 1))
+    --itr;
+  s_event_queue.insert(itr, ev);
+}
+
 // Changing the CPU speed in Dolphin isn't actually done by changing the physical clock rate,
 // but by changing the amount of work done in a particular amount of time. This tends to be more
 // compatible because it stops the games from actually knowing directly that the clock rate has
@@ -149,7 +154,6 @@ void Init()
 
 void Shutdown()
 {
-  std::lock_guard lk(s_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
@@ -166,7 +170,6 @@ void RefreshConfig()
 
 void DoState(PointerWrap& p)
 {
-  std::lock_guard lk(s_ts_write_lock);
   p.Do(g.slice_length);
   p.Do(g.global_timer);
   p.Do(s_idled_cycles);
@@ -215,10 +218,10 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingEvents");
 
   // When loading from a save state, we must assume the Event order is random and meaningless.
-  // The exact layout of the heap in memory is implementation defined, therefore it is platform
-  // and library version specific.
+  // Older versions saved the queue as a heap, whose exact layout in memory is implementation
+  // defined, therefore it is platform and library version specific.
   if (p.IsReadMode())
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    std::sort(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
 }
 
 // This should only be called from the CPU thread. If you are calling
@@ -269,8 +272,7 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
     if (!s_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    s_event_queue.emplace_back(Event{timeout, s_event_fifo_id++, userdata, event_type});
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    PushEvent(Event{timeout, s_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -282,22 +284,16 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
                     *event_type->name);
     }
 
-    std::lock_guard lk(s_ts_write_lock);
     s_ts_queue.Push(Event{g.global_timer + cycles_into_future, 0, userdata, event_type});
   }
 }
 
 void RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(s_event_queue.begin(), s_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != s_event_queue.end())
-  {
-    s_event_queue.erase(itr, s_event_queue.end());
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-  }
+  // Removing elements keeps the remaining ones sorted.
+  s_event_queue.erase(std::remove_if(s_event_queue.begin(), s_event_queue.end(),
+                                     [&](const Event& e) { return e.type == event_type; }),
+                      s_event_queue.end());
 }
 
 void RemoveAllEvents(EventType* event_type)
@@ -320,11 +316,19 @@ void ForceExceptionCheck(s64 cycles)
 
 void MoveEvents()
 {
+  const size_t old_size = s_event_queue.size();
   for (Event ev; s_ts_queue.Pop(ev);)
   {
     ev.fifo_order = s_event_fifo_id++;
     s_event_queue.emplace_back(std::move(ev));
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+  }
+
+  // Merge the new events in all at once, so that a burst of them doesn't cost one scan each.
+  if (s_event_queue.size() != old_size)
+  {
+    const auto middle = s_event_queue.begin() + old_size;
+    std::sort(middle, s_event_queue.end(), std::greater<Event>());
+    std::inplace_merge(s_event_queue.begin(), middle, s_event_queue.end(), std::greater<Event>());
   }
 }
 
@@ -340,10 +344,9 @@ void Advance()
 
   s_is_global_timer_sane = true;
 
-  while (!s_event_queue.empty() && s_event_queue.front().time <= g.global_timer)
+  while (!s_event_queue.empty() && s_event_queue.back().time <= g.global_timer)
   {
-    Event evt = std::move(s_event_queue.front());
-    std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    Event evt = std::move(s_event_queue.back());
     s_event_queue.pop_back();
     evt.type->callback(evt.userdata, g.global_timer - evt.time);
   }
@@ -354,7 +357,7 @@ void Advance()
   if (!s_event_queue.empty())
   {
     g.slice_length = static_cast<int>(
-        std::min<s64>(s_event_queue.front().time - g.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(s_event_queue.back().time - g.global_timer, MAX_SLICE_LENGTH));
   }
 
   PowerPC::ppcState.downcount = CyclesToDowncount(g.slice_length);
@@ -368,10 +371,9 @@ void Advance()
 
 void LogPendingEvents()
 {
-  auto clone = s_event_queue;
-  std::sort(clone.begin(), clone.end());
-  for (const Event& ev : clone)
+  for (auto itr = s_event_queue.rbegin(); itr != s_event_queue.rend(); ++itr)
   {
+    const Event& ev = *itr;
     INFO_LOG_FMT(POWERPC, "PENDING: Now: {} Pending: {} Type: {}", g.global_timer, ev.time,
                  *ev.type->name);
   }
@@ -385,6 +387,9 @@ void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock)
     const s64 ticks = (ev.time - g.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = g.global_timer + ticks;
   }
+
+  // Rounding can give events the same time, after which they are ordered by fifo_order instead.
+  std::sort(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
 }
 
 void Idle()
@@ -407,10 +412,9 @@ std::string GetScheduledEventsSummary()
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = s_event_queue;
-  std::sort(clone.begin(), clone.end());
-  for (const Event& ev : clone)
+  for (auto itr = s_event_queue.rbegin(); itr != s_event_queue.rend(); ++itr)
   {
+    const Event& ev = *itr;
     text += fmt::format("{} : {} {:016x}\n", *ev.type->name, ev.time, ev.userdata);
   }
   return text;
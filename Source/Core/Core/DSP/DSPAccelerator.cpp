@@ -160,6 +160,73 @@ u16 Accelerator::Read(const s16* coefs)
   return val;
 }
 
+u32 Accelerator::GetADPCMRunLength(u32 max_count) const
+{
+  // Reading a sample at address A increments the address to A + 1, which has side effects if it
+  // starts a new frame (and the pred scale is read) or if it is within one of the end address.
+  const u64 next_address = u64(m_current_address) + 1;
+  const u64 end_address = m_end_address;
+  u64 count = 15 - (m_current_address & 15);
+
+  if (next_address + 1 >= end_address && next_address <= end_address + 1)
+    return 0;
+  if (next_address < end_address)
+    count = std::min<u64>(count, end_address - 1 - next_address);
+
+  return static_cast<u32>(std::min<u64>(count, max_count));
+}
+
+void Accelerator::DecodeADPCM(const s16* coefs, s16* samples, u32 count)
+{
+  const s32 scale = 1 << (m_pred_scale & 0xF);
+  const int coef_idx = (m_pred_scale >> 4) & 0x7;
+  const s32 coef1 = coefs[coef_idx * 2 + 0];
+  const s32 coef2 = coefs[coef_idx * 2 + 1];
+
+  s32 yn1 = m_yn1;
+  s32 yn2 = m_yn2;
+  u32 address = m_current_address;
+  u8 byte = ReadMemory(address >> 1);
+  for (u32 i = 0; i < count; ++i, ++address)
+  {
+    if (i != 0 && (address & 1) == 0)
+      byte = ReadMemory(address >> 1);
+
+    int nibble = (address & 1) ? (byte & 0xF) : (byte >> 4);
+    if (nibble >= 8)
+      nibble -= 16;
+
+    const s32 val32 = (scale * nibble) + ((0x400 + coef1 * yn1 + coef2 * yn2) >> 11);
+    yn2 = yn1;
+    yn1 = std::clamp<s32>(val32, -0x7FFF, 0x7FFF);
+    samples[i] = static_cast<s16>(yn1);
+  }
+
+  m_yn1 = static_cast<s16>(yn1);
+  m_yn2 = static_cast<s16>(yn2);
+  SetCurrentAddress(address);
+}
+
+void Accelerator::ReadSamples(const s16* coefs, s16* samples, u32 count)
+{
+  u32 i = 0;
+  while (i < count)
+  {
+    // Samples which have side effects go through Read, everything else is decoded in bulk.
+    const u32 run = (m_sample_format == 0x00 && !m_reads_stopped) ?
+                        GetADPCMRunLength(count - i) :
+                        0;
+    if (run == 0)
+    {
+      samples[i++] = static_cast<s16>(Read(coefs));
+      continue;
+    }
+
+    DecodeADPCM(coefs, &samples[i], run);
+    i += run;
+  }
+}
+
 void Accelerator::DoState(PointerWrap& p)
 {
   p.Do(m_start_address);
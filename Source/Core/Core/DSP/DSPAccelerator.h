@@ -15,6 +15,8 @@ public:
   virtual ~Accelerator() = default;
 
   u16 Read(const s16* coefs);
+  // Same as calling Read count times, but ADPCM samples are decoded a block at a time.
+  void ReadSamples(const s16* coefs, s16* samples, u32 count);
   // Zelda ucode reads ARAM through 0xffd3.
   u16 ReadD3();
   void WriteD3(u16 value);
@@ -37,6 +39,11 @@ public:
   void DoState(PointerWrap& p);
 
 protected:
+  // Returns how many ADPCM samples can be read without reaching the end of the current frame or
+  // the end address, capped to max_count.
+  u32 GetADPCMRunLength(u32 max_count) const;
+  void DecodeADPCM(const s16* coefs, s16* samples, u32 count);
+
   virtual void OnEndException() = 0;
   virtual u8 ReadMemory(u32 address) = 0;
   virtual void WriteMemory(u32 address, u8 value) = 0;
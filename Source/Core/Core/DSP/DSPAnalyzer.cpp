@@ -110,13 +110,14 @@ void Analyzer::FindInstructionStarts(const SDSP& dsp, u16 start_addr, u16 end_ad
       // BLOOP, BLOOPI
       const u16 loop_end = dsp.ReadIMEM(addr + 1);
       m_code_flags[addr] |= CODE_LOOP_START;
+      m_code_flags[static_cast<u16>(addr + 2u)] |= CODE_LOOP_BODY_START;
       m_code_flags[loop_end] |= CODE_LOOP_END;
     }
     else if ((inst & 0xffe0) == 0x0040 || (inst & 0xff00) == 0x1000)
     {
       // LOOP, LOOPI
       m_code_flags[addr] |= CODE_LOOP_START;
-      m_code_flags[static_cast<u16>(addr + 1u)] |= CODE_LOOP_END;
+      m_code_flags[static_cast<u16>(addr + 1u)] |= CODE_LOOP_BODY_START | CODE_LOOP_END;
     }
 
 #ifndef DISABLE_UPDATE_SR_ANALYSIS
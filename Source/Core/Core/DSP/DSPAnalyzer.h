@@ -61,6 +61,12 @@ public:
     return (GetCodeFlags(address) & CODE_LOOP_START) != 0;
   }
 
+  // Whether or not the address indicates the first instruction of a loop body.
+  [[nodiscard]] bool IsLoopBodyStart(u16 address) const
+  {
+    return (GetCodeFlags(address) & CODE_LOOP_BODY_START) != 0;
+  }
+
   // Whether or not the address indicates the end of a loop.
   [[nodiscard]] bool IsLoopEnd(u16 address) const
   {
@@ -93,6 +99,7 @@ private:
     CODE_LOOP_END = 8,
     CODE_UPDATE_SR = 16,
     CODE_CHECK_EXC = 32,
+    CODE_LOOP_BODY_START = 64,
   };
 
   // Flushes all analyzed state.
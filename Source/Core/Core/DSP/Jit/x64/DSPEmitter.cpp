@@ -224,6 +224,67 @@ void DSPEmitter::EmitInstruction(UDSPInstruction inst)
   }
 }
 
+// LOOPI repeating a single instruction is the most common loop in ucodes, for example to clear
+// or copy a buffer. If the instruction can't branch or look at the loop stacks, the loop can run
+// on the host without handling the loop stacks after every iteration.
+bool DSPEmitter::IsInlinableLoop(UDSPInstruction inst) const
+{
+  if ((inst & 0xff00) != 0x1000)
+    return false;
+
+  // Keep the number of cycles a block accounts for under the usual limit.
+  const u16 count = inst & 0xff;
+  if (count == 0 || size_t{m_block_size[m_start_address]} + 1 + count > MAX_BLOCK_SIZE)
+    return false;
+
+  const auto& state = m_dsp_core.DSPState();
+  const u16 loop_pc = m_compile_pc + 1;
+  const UDSPInstruction body = state.ReadIMEM(loop_pc);
+  const DSPOPCTemplate* body_opcode = GetOpTemplate(body);
+  if (body_opcode->size != 1 || body_opcode->branch ||
+      state.GetAnalyzer().IsCheckExceptions(loop_pc))
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < body_opcode->param_count; i++)
+  {
+    const param2_t& param = body_opcode->params[i];
+    if (param.type != P_REG)
+      continue;
+    const u16 reg = (body & param.mask) >> param.lshift;
+    if (reg >= DSP_REG_ST0 && reg <= DSP_REG_ST3)
+      return false;
+  }
+  return true;
+}
+
+void DSPEmitter::CompileInlineLoop(UDSPInstruction inst)
+{
+  const u16 count = inst & 0xff;
+  const u16 loop_pc = m_compile_pc + 1;
+  const UDSPInstruction body = m_dsp_core.DSPState().ReadIMEM(loop_pc);
+
+  // Every iteration starts with the guest registers written back, so that fallbacks to the
+  // interpreter in the loop body see the values from the previous iteration.
+  m_gpr.FlushRegs();
+  m_gpr.LoadRegs(false);
+  MOV(64, R(RAX), ImmPtr(&m_inline_loop_counter));
+  MOV(16, MatR(RAX), Imm16(count));
+
+  m_compile_pc = loop_pc;
+  const u8* loop_start = GetCodePtr();
+  EmitInstruction(body);
+  m_gpr.FlushRegs();
+  m_gpr.LoadRegs(false);
+  MOV(64, R(RAX), ImmPtr(&m_inline_loop_counter));
+  SUB(16, MatR(RAX), Imm16(1));
+  J_CC(CC_NZ, loop_start);
+
+  m_compile_pc = loop_pc + 1;
+  m_block_size[m_start_address] += 1 + count;
+}
+
 void DSPEmitter::Compile(u16 start_addr)
 {
   // Remember the current block address for later
@@ -249,6 +310,16 @@ void DSPEmitter::Compile(u16 start_addr)
     const UDSPInstruction inst = m_dsp_core.DSPState().ReadIMEM(m_compile_pc);
     const DSPOPCTemplate* opcode = GetOpTemplate(inst);
 
+    if (IsInlinableLoop(inst))
+    {
+      // The loop doesn't use the loop stacks, so there is no loop end to handle.
+      CompileInlineLoop(inst);
+      fixup_pc = true;
+      if (analyzer.IsIdleSkip(m_compile_pc))
+        break;
+      continue;
+    }
+
     EmitInstruction(inst);
 
     m_block_size[start_addr]++;
@@ -281,6 +352,8 @@ void DSPEmitter::Compile(u16 start_addr)
       // end of each block and in this order
       DSPJitRegCache c(m_gpr);
       HandleLoop();
+      if (analyzer.IsLoopBodyStart(start_addr) && !analyzer.IsIdleSkip(start_addr))
+        WriteLoopLink();
       m_gpr.SaveRegs();
       if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
       {
@@ -206,6 +206,8 @@ private:
   void CompileDispatcher();
   Block CompileStub();
   void Compile(u16 start_addr);
+  bool IsInlinableLoop(UDSPInstruction inst) const;
+  void CompileInlineLoop(UDSPInstruction inst);
 
   bool FlagsNeeded() const;
 
@@ -213,6 +215,7 @@ private:
 
   void WriteBranchExit();
   void WriteBlockLink(u16 dest);
+  void WriteLoopLink();
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
@@ -324,6 +327,8 @@ private:
   std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
 
   u16 m_cycles_left = 0;
+  // Iterations left in the loop compiled by CompileInlineLoop (run time).
+  u16 m_inline_loop_counter = 0;
 
   // The index of the last stored ext value (compile time).
   int m_store_index = -1;
@@ -7,6 +7,7 @@
 
 #include "Core/DSP/DSPAnalyzer.h"
 #include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPHost.h"
 #include "Core/DSP/DSPTables.h"
 
 using namespace Gen;
@@ -142,6 +143,44 @@ void DSPEmitter::WriteBlockLink(u16 dest)
   }
 }
 
+// Jumps back to the start of the block if the loop that was just handled continues there, so
+// that the iterations of a loop run without going through the dispatcher. The accumulators stay
+// in their host registers from one iteration to the next.
+void DSPEmitter::WriteLoopLink()
+{
+  CMP(16, M_SDSP_pc(), Imm16(m_start_address));
+  FixupBranch notLooping = J_CC(CC_NE, true);
+
+  // Leave the block in the same cases as the dispatcher would.
+  TEST(8, M_SDSP_control_reg(), Imm8(CR_HALT));
+  FixupBranch halted = J_CC(CC_NZ, true);
+  FixupBranch interrupted;
+  if (Host::OnThread())
+  {
+    CMP(8, M_SDSP_external_interrupt_waiting(), Imm8(0));
+    interrupted = J_CC(CC_NE, true);
+  }
+
+  MOV(64, R(RAX), ImmPtr(&m_cycles_left));
+  MOV(16, R(ECX), MatR(RAX));
+  CMP(16, R(ECX), Imm16(m_block_size[m_start_address]));
+  FixupBranch notEnoughCycles = J_CC(CC_BE, true);
+
+  SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
+  MOV(16, MatR(RAX), R(ECX));
+  DSPJitRegCache c(m_gpr);
+  m_gpr.FlushRegs();
+  JMP(m_block_link_entry, true);
+  m_gpr.LoadRegs(false);
+  m_gpr.FlushRegs(c, false);
+
+  SetJumpTarget(notLooping);
+  SetJumpTarget(halted);
+  if (Host::OnThread())
+    SetJumpTarget(interrupted);
+  SetJumpTarget(notEnoughCycles);
+}
+
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
 {
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
@@ -7,23 +7,32 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <zstd.h>
+
+#include "Common/Assert.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 
 enum
 {
   FILE_ID = 0x0d01f1f0,
-  VERSION_NUMBER = 5,
-  MIN_LOADER_VERSION = 1,
-  // This value is only used if the DFF file was created with overridden RAM sizes.
-  // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
-  MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5,
+  VERSION_NUMBER = 6,
+  // Frames are stored compressed since version 6, which older loaders can't read.
+  MIN_LOADER_VERSION = 6,
+  FIRST_COMPRESSED_VERSION = 6,
 };
 
+// Recording happens in the middle of gameplay, so speed matters more than size.
+constexpr int FIFO_ZSTD_LEVEL = 1;
+
 #pragma pack(push, 1)
 
 struct FileHeader
@@ -64,6 +73,24 @@ struct FileFrameInfo
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
+// Used since version 6. The data of a frame consists of two sections that are compressed
+// independently of each other and of other frames: the FIFO data, followed by a list of
+// FileMemoryUpdates (with dataOffset relative to the start of the section) and their data.
+// A section whose compressed size equals its size is stored uncompressed.
+struct FileCompressedFrameInfo
+{
+  u64 dataOffset;
+  u32 fifoDataSize;
+  u32 fifoDataCompressedSize;
+  u32 memoryUpdatesSize;
+  u32 memoryUpdatesCompressedSize;
+  u32 fifoStart;
+  u32 fifoEnd;
+  u32 numMemoryUpdates;
+  u8 reserved[28];
+};
+static_assert(sizeof(FileCompressedFrameInfo) == 64, "FileCompressedFrameInfo should be 64 bytes");
+
 struct FileMemoryUpdate
 {
   u32 fifoPosition;
@@ -77,9 +104,78 @@ static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 byt
 
 #pragma pack(pop)
 
+struct FifoDataFile::Recording
+{
+  File::IOFile file;
+  // Only accessed by the write thread until it is stopped.
+  std::vector<FileCompressedFrameInfo> frames;
+  bool write_failed = false;
+  std::unique_ptr<Common::WorkQueueThread<FifoFrameInfo>> write_thread;
+};
+
+static std::vector<u8> CompressSection(const u8* data, size_t size)
+{
+  std::vector<u8> compressed(ZSTD_compressBound(size));
+  const size_t compressed_size =
+      ZSTD_compress(compressed.data(), compressed.size(), data, size, FIFO_ZSTD_LEVEL);
+
+  // Store the section as is if compressing it doesn't save anything.
+  if (ZSTD_isError(compressed_size) || compressed_size >= size)
+    return std::vector<u8>(data, data + size);
+
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
+static bool DecompressSection(const u8* data, u32 compressed_size, u8* out, u32 size)
+{
+  if (compressed_size == size)
+  {
+    std::memcpy(out, data, size);
+    return true;
+  }
+
+  return ZSTD_decompress(out, size, data, compressed_size) == size;
+}
+
+// Reads numUpdates FileMemoryUpdates from updateList, with dataOffset relative to data.
+static bool ReadMemoryUpdates(const u8* updateList, u32 numUpdates, const u8* data, u64 dataSize,
+                              std::vector<MemoryUpdate>& memUpdates)
+{
+  memUpdates.resize(numUpdates);
+
+  for (u32 i = 0; i < numUpdates; ++i)
+  {
+    FileMemoryUpdate srcUpdate;
+    std::memcpy(&srcUpdate, updateList + i * sizeof(FileMemoryUpdate), sizeof(FileMemoryUpdate));
+    if (srcUpdate.dataOffset > dataSize || srcUpdate.dataSize > dataSize - srcUpdate.dataOffset)
+      return false;
+
+    MemoryUpdate& dstUpdate = memUpdates[i];
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+
+    const u8* const updateData = data + srcUpdate.dataOffset;
+    dstUpdate.data.assign(updateData, updateData + srcUpdate.dataSize);
+  }
+
+  return true;
+}
+
 FifoDataFile::FifoDataFile() = default;
 
-FifoDataFile::~FifoDataFile() = default;
+FifoDataFile::~FifoDataFile()
+{
+  if (m_recording)
+  {
+    m_recording->write_thread.reset();
+    m_recording->file.Close();
+  }
+
+  if (m_path_is_temporary)
+    File::Delete(m_path);
+}
 
 bool FifoDataFile::ShouldGenerateFakeVIUpdates() const
 {
@@ -101,23 +197,100 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
-void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
+std::unique_ptr<FifoDataFile> FifoDataFile::CreateForRecording()
 {
-  m_Frames.push_back(frameInfo);
+  const std::string path = File::GetUserPath(D_CACHE_IDX) + "FifoRecording.dff.tmp";
+  File::CreateFullPath(path);
+
+  auto recording = std::make_unique<Recording>();
+  if (!recording->file.Open(path, "wb"))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to create {} for the FIFO recording", path);
+    return nullptr;
+  }
+
+  auto dataFile = std::make_unique<FifoDataFile>();
+  dataFile->m_Version = VERSION_NUMBER;
+  dataFile->m_path = path;
+  dataFile->m_path_is_temporary = true;
+
+  // Add space for header
+  dataFile->PadFile(sizeof(FileHeader), recording->file);
+
+  FifoDataFile* const data_file_ptr = dataFile.get();
+  recording->write_thread = std::make_unique<Common::WorkQueueThread<FifoFrameInfo>>(
+      [data_file_ptr](FifoFrameInfo frame) { data_file_ptr->WriteCompressedFrame(frame); });
+
+  dataFile->m_recording = std::move(recording);
+  return dataFile;
 }
 
-bool FifoDataFile::Save(const std::string& filename)
+void FifoDataFile::AddFrame(FifoFrameInfo frameInfo)
 {
-  File::IOFile file;
-  if (!file.Open(filename, "wb"))
-    return false;
+  ASSERT(m_recording);
 
-  // Add space for header
-  PadFile(sizeof(FileHeader), file);
+  m_frame_count++;
+  m_fifo_data_size += frameInfo.fifoData.size();
+  for (const MemoryUpdate& update : frameInfo.memoryUpdates)
+    m_memory_update_data_size += update.data.size();
+
+  m_recording->write_thread->EmplaceItem(std::move(frameInfo));
+}
+
+void FifoDataFile::WriteCompressedFrame(const FifoFrameInfo& frame)
+{
+  std::vector<u8> memoryUpdates(frame.memoryUpdates.size() * sizeof(FileMemoryUpdate));
+  for (size_t i = 0; i < frame.memoryUpdates.size(); ++i)
+  {
+    const MemoryUpdate& srcUpdate = frame.memoryUpdates[i];
+
+    FileMemoryUpdate dstUpdate{};
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.dataOffset = memoryUpdates.size();
+    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = srcUpdate.type;
+
+    std::memcpy(&memoryUpdates[i * sizeof(FileMemoryUpdate)], &dstUpdate, sizeof(dstUpdate));
+    memoryUpdates.insert(memoryUpdates.end(), srcUpdate.data.begin(), srcUpdate.data.end());
+  }
+
+  const std::vector<u8> fifoData = CompressSection(frame.fifoData.data(), frame.fifoData.size());
+  const std::vector<u8> memoryUpdateData =
+      CompressSection(memoryUpdates.data(), memoryUpdates.size());
+
+  File::IOFile& file = m_recording->file;
+
+  FileCompressedFrameInfo dstFrame{};
+  dstFrame.dataOffset = file.Tell();
+  dstFrame.fifoDataSize = static_cast<u32>(frame.fifoData.size());
+  dstFrame.fifoDataCompressedSize = static_cast<u32>(fifoData.size());
+  dstFrame.memoryUpdatesSize = static_cast<u32>(memoryUpdates.size());
+  dstFrame.memoryUpdatesCompressedSize = static_cast<u32>(memoryUpdateData.size());
+  dstFrame.fifoStart = frame.fifoStart;
+  dstFrame.fifoEnd = frame.fifoEnd;
+  dstFrame.numMemoryUpdates = static_cast<u32>(frame.memoryUpdates.size());
+
+  if (!file.WriteBytes(fifoData.data(), fifoData.size()) ||
+      !file.WriteBytes(memoryUpdateData.data(), memoryUpdateData.size()))
+  {
+    m_recording->write_failed = true;
+  }
+
+  m_recording->frames.push_back(dstFrame);
+}
+
+bool FifoDataFile::FinishRecording()
+{
+  // Wait for the frames that are still queued to be written.
+  m_recording->write_thread.reset();
+
+  const std::unique_ptr<Recording> recording = std::move(m_recording);
+
+  File::IOFile& file = recording->file;
 
-  // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  file.WriteArray(recording->frames.data(), recording->frames.size());
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
@@ -135,14 +308,10 @@ bool FifoDataFile::Save(const std::string& filename)
   file.WriteArray(m_TexMem);
 
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
-    header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
-  else
-    header.min_loader_version = MIN_LOADER_VERSION;
+  header.min_loader_version = MIN_LOADER_VERSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -160,7 +329,7 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = static_cast<u32>(recording->frames.size());
 
   header.flags = m_Flags;
 
@@ -170,36 +339,28 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
 
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
-  {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
-
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
-  }
+  const bool good = file.IsGood();
+  return file.Close() && good && !recording->write_failed;
+}
 
-  if (!file.Close())
+bool FifoDataFile::Save(const std::string& filename)
+{
+  if (m_recording && !FinishRecording())
     return false;
 
-  return true;
+  if (m_path.empty())
+    return false;
+
+  // Moving the recording out of the temporary file avoids copying what may be gigabytes of data.
+  // Renaming fails if the destination is on another drive, in which case the file is copied.
+  if (m_path_is_temporary && File::Rename(m_path, filename))
+  {
+    m_path = filename;
+    m_path_is_temporary = false;
+    return true;
+  }
+
+  return File::Copy(m_path, filename);
 }
 
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
@@ -315,104 +476,181 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
-  for (u32 i = 0; i < header.frameCount; ++i)
-  {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
-      return panic_failed_to_read();
-
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-
-    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
+  // Frames are read on demand from the mapped file.
+  if (!dataFile->m_mapped_file.Open(filename))
+    return panic_failed_to_read();
 
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+  dataFile->m_path = filename;
+  dataFile->m_frame_list_offset = header.frameListOffset;
+  dataFile->m_frame_count = header.frameCount;
 
-    if (!file.IsGood())
-      return panic_failed_to_read();
+  const bool compressed = dataFile->m_Version >= FIRST_COMPRESSED_VERSION;
+  const u64 frameInfoSize = compressed ? sizeof(FileCompressedFrameInfo) : sizeof(FileFrameInfo);
+  const u8* const frameList =
+      dataFile->m_mapped_file.GetPointer(header.frameListOffset, header.frameCount * frameInfoSize);
+  if (!frameList)
+    return panic_failed_to_read();
 
-    dataFile->AddFrame(dstFrame);
+  for (u32 i = 0; i < header.frameCount; ++i)
+  {
+    const u8* const frameInfo = frameList + i * frameInfoSize;
+    if (compressed)
+    {
+      FileCompressedFrameInfo srcFrame;
+      std::memcpy(&srcFrame, frameInfo, sizeof(srcFrame));
+      dataFile->m_fifo_data_size += srcFrame.fifoDataSize;
+      dataFile->m_memory_update_data_size +=
+          srcFrame.memoryUpdatesSize - u64{srcFrame.numMemoryUpdates} * sizeof(FileMemoryUpdate);
+    }
+    else
+    {
+      FileFrameInfo srcFrame;
+      std::memcpy(&srcFrame, frameInfo, sizeof(srcFrame));
+      dataFile->m_fifo_data_size += srcFrame.fifoDataSize;
+
+      const u8* const updates = dataFile->m_mapped_file.GetPointer(
+          srcFrame.memoryUpdatesOffset, u64{srcFrame.numMemoryUpdates} * sizeof(FileMemoryUpdate));
+      if (!updates)
+        return panic_failed_to_read();
+      for (u32 j = 0; j < srcFrame.numMemoryUpdates; ++j)
+      {
+        FileMemoryUpdate srcUpdate;
+        std::memcpy(&srcUpdate, updates + j * sizeof(FileMemoryUpdate), sizeof(srcUpdate));
+        dataFile->m_memory_update_data_size += srcUpdate.dataSize;
+      }
+    }
   }
 
   return dataFile;
 }
 
-void FifoDataFile::PadFile(size_t numBytes, File::IOFile& file)
+std::unique_ptr<FifoFrameInfo> FifoDataFile::ReadFrame(u32 frame) const
 {
-  for (size_t i = 0; i < numBytes; ++i)
-    fputc(0, file.GetHandle());
-}
+  if (!m_mapped_file.IsOpen() || frame >= m_frame_count)
+    return nullptr;
 
-void FifoDataFile::SetFlag(u32 flag, bool set)
-{
-  if (set)
-    m_Flags |= flag;
+  if (m_Version >= FIRST_COMPRESSED_VERSION)
+    return ReadCompressedFrame(frame);
   else
-    m_Flags &= ~flag;
+    return ReadUncompressedFrame(frame);
 }
 
-bool FifoDataFile::GetFlag(u32 flag) const
+void FifoDataFile::PrefetchFrame(u32 frame) const
 {
-  return !!(m_Flags & flag);
+  if (!m_mapped_file.IsOpen() || frame >= m_frame_count)
+    return;
+
+  if (m_Version >= FIRST_COMPRESSED_VERSION)
+  {
+    const u8* const frameInfo = m_mapped_file.GetPointer(
+        m_frame_list_offset + u64{frame} * sizeof(FileCompressedFrameInfo),
+        sizeof(FileCompressedFrameInfo));
+    FileCompressedFrameInfo srcFrame;
+    std::memcpy(&srcFrame, frameInfo, sizeof(srcFrame));
+    m_mapped_file.PrefetchRange(srcFrame.dataOffset, u64{srcFrame.fifoDataCompressedSize} +
+                                                         srcFrame.memoryUpdatesCompressedSize);
+  }
+  else
+  {
+    const u8* const frameInfo =
+        m_mapped_file.GetPointer(m_frame_list_offset + u64{frame} * sizeof(FileFrameInfo),
+                                 sizeof(FileFrameInfo));
+    FileFrameInfo srcFrame;
+    std::memcpy(&srcFrame, frameInfo, sizeof(srcFrame));
+    m_mapped_file.PrefetchRange(srcFrame.fifoDataOffset, srcFrame.fifoDataSize);
+  }
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
+std::unique_ptr<FifoFrameInfo> FifoDataFile::ReadCompressedFrame(u32 frame) const
 {
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
-
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
-  {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
+  // The frame list was checked to be in bounds when loading.
+  FileCompressedFrameInfo srcFrame;
+  std::memcpy(&srcFrame,
+              m_mapped_file.GetPointer(
+                  m_frame_list_offset + u64{frame} * sizeof(FileCompressedFrameInfo),
+                  sizeof(FileCompressedFrameInfo)),
+              sizeof(srcFrame));
+
+  const u8* const fifoData =
+      m_mapped_file.GetPointer(srcFrame.dataOffset, srcFrame.fifoDataCompressedSize);
+  const u8* const memoryUpdates =
+      m_mapped_file.GetPointer(srcFrame.dataOffset + srcFrame.fifoDataCompressedSize,
+                               srcFrame.memoryUpdatesCompressedSize);
+  if (!fifoData || !memoryUpdates)
+    return nullptr;
 
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+  auto dstFrame = std::make_unique<FifoFrameInfo>();
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
 
-    FileMemoryUpdate dstUpdate;
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.type = srcUpdate.type;
+  dstFrame->fifoData.resize(srcFrame.fifoDataSize);
+  if (!DecompressSection(fifoData, srcFrame.fifoDataCompressedSize, dstFrame->fifoData.data(),
+                         srcFrame.fifoDataSize))
+  {
+    return nullptr;
+  }
 
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
+  std::vector<u8> memoryUpdateData(srcFrame.memoryUpdatesSize);
+  if (u64{srcFrame.numMemoryUpdates} * sizeof(FileMemoryUpdate) > memoryUpdateData.size() ||
+      !DecompressSection(memoryUpdates, srcFrame.memoryUpdatesCompressedSize,
+                         memoryUpdateData.data(), srcFrame.memoryUpdatesSize) ||
+      !ReadMemoryUpdates(memoryUpdateData.data(), srcFrame.numMemoryUpdates,
+                         memoryUpdateData.data(), memoryUpdateData.size(),
+                         dstFrame->memoryUpdates))
+  {
+    return nullptr;
   }
 
-  return updateListOffset;
+  return dstFrame;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
+std::unique_ptr<FifoFrameInfo> FifoDataFile::ReadUncompressedFrame(u32 frame) const
 {
-  memUpdates.resize(numUpdates);
+  // The frame list was checked to be in bounds when loading.
+  FileFrameInfo srcFrame;
+  std::memcpy(&srcFrame,
+              m_mapped_file.GetPointer(m_frame_list_offset + u64{frame} * sizeof(FileFrameInfo),
+                                       sizeof(FileFrameInfo)),
+              sizeof(srcFrame));
+
+  const u8* const fifoData =
+      m_mapped_file.GetPointer(srcFrame.fifoDataOffset, srcFrame.fifoDataSize);
+  if (!fifoData)
+    return nullptr;
 
-  for (u32 i = 0; i < numUpdates; ++i)
+  auto dstFrame = std::make_unique<FifoFrameInfo>();
+  dstFrame->fifoData.assign(fifoData, fifoData + srcFrame.fifoDataSize);
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
+
+  // The offsets of the memory update data are relative to the start of the file in these versions.
+  const u8* const updateList = m_mapped_file.GetPointer(
+      srcFrame.memoryUpdatesOffset, u64{srcFrame.numMemoryUpdates} * sizeof(FileMemoryUpdate));
+  if (!updateList ||
+      !ReadMemoryUpdates(updateList, srcFrame.numMemoryUpdates, m_mapped_file.GetData(),
+                         m_mapped_file.GetSize(), dstFrame->memoryUpdates))
   {
-    u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
+    return nullptr;
+  }
 
-    MemoryUpdate& dstUpdate = memUpdates[i];
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
-    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+  return dstFrame;
+}
 
-    file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
-  }
+void FifoDataFile::PadFile(size_t numBytes, File::IOFile& file)
+{
+  for (size_t i = 0; i < numBytes; ++i)
+    fputc(0, file.GetHandle());
+}
+
+void FifoDataFile::SetFlag(u32 flag, bool set)
+{
+  if (set)
+    m_Flags |= flag;
+  else
+    m_Flags &= ~flag;
+}
+
+bool FifoDataFile::GetFlag(u32 flag) const
+{
+  return !!(m_Flags & flag);
 }
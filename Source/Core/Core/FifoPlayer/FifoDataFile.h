@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace File
@@ -72,11 +73,28 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
-  void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Creates an empty file for recording into. Frames passed to AddFrame() are compressed and
+  // written to a temporary file in the background rather than being kept in memory, and Save()
+  // finishes that file and moves it to its final location.
+  static std::unique_ptr<FifoDataFile> CreateForRecording();
+
+  void AddFrame(FifoFrameInfo frameInfo);
   bool Save(const std::string& filename);
 
+  u32 GetFrameCount() const { return m_frame_count; }
+
+  // Reads the given frame from the file. Only loaded files can be read from. The file is mapped
+  // into memory and frames are decoded on demand, so logs don't need to fit into RAM.
+  // May be called from any thread. Returns nullptr if the frame can't be read.
+  std::unique_ptr<FifoFrameInfo> ReadFrame(u32 frame) const;
+
+  // Hints that the given frame will be read soon, so that the OS can start reading it from disk.
+  void PrefetchFrame(u32 frame) const;
+
+  // The total size of the uncompressed FIFO data and memory updates of all frames.
+  u64 GetFifoDataSize() const { return m_fifo_data_size; }
+  u64 GetMemoryUpdateDataSize() const { return m_memory_update_data_size; }
+
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
@@ -85,14 +103,18 @@ private:
     FLAG_IS_WII = 1
   };
 
+  struct Recording;
+
   void PadFile(size_t numBytes, File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  void WriteCompressedFrame(const FifoFrameInfo& frame);
+  bool FinishRecording();
+
+  std::unique_ptr<FifoFrameInfo> ReadCompressedFrame(u32 frame) const;
+  std::unique_ptr<FifoFrameInfo> ReadUncompressedFrame(u32 frame) const;
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -105,5 +127,19 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  u32 m_frame_count = 0;
+  u64 m_fifo_data_size = 0;
+  u64 m_memory_update_data_size = 0;
+
+  // Set for loaded files.
+  File::MappedFile m_mapped_file;
+  u64 m_frame_list_offset = 0;
+
+  // Set while recording, until Save() is called.
+  std::unique_ptr<Recording> m_recording;
+
+  // The file the data of a recording is in, and whether it's a temporary file that should be
+  // deleted unless the recording gets saved.
+  std::string m_path;
+  bool m_path_is_temporary = false;
 };
@@ -5,7 +5,9 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
 #include <mutex>
+#include <optional>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -36,9 +38,11 @@ namespace
 class FifoPlaybackAnalyzer : public OpcodeDecoder::Callback
 {
 public:
-  static void AnalyzeFrames(FifoDataFile* file, std::vector<AnalyzedFrameInfo>& frame_info);
+  explicit FifoPlaybackAnalyzer(const CPState& cpmem) : m_cpmem(cpmem) {}
 
-  explicit FifoPlaybackAnalyzer(const u32* cpmem) : m_cpmem(cpmem) {}
+  // Analyzes a frame that starts with the current CP state, which is updated to the state at its
+  // end. Frames can be analyzed one after another with the same analyzer.
+  void AnalyzeFrame(const FifoFrameInfo& frame, AnalyzedFrameInfo& analyzed);
 
   OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data)) {}
   OPCODE_CALLBACK(void OnCP(u8 command, u32 value)) { GetCPState().LoadCPReg(command, value); }
@@ -66,58 +70,56 @@ public:
   CPState m_cpmem;
 };
 
-void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
-                                         std::vector<AnalyzedFrameInfo>& frame_info)
+void FifoPlaybackAnalyzer::AnalyzeFrame(const FifoFrameInfo& frame, AnalyzedFrameInfo& analyzed)
 {
-  FifoPlaybackAnalyzer analyzer(file->GetCPMem());
-  frame_info.clear();
-  frame_info.resize(file->GetFrameCount());
+  m_start_of_primitives = false;
+  m_end_of_primitives = false;
+  m_efb_copy = false;
+  m_was_primitive = false;
+  m_is_primitive = false;
+  m_is_copy = false;
+  m_is_nop = false;
 
-  for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
-  {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
-    AnalyzedFrameInfo& analyzed = frame_info[frame_no];
+  u32 offset = 0;
 
-    u32 offset = 0;
+  u32 part_start = 0;
+  std::optional<CPState> part_cpmem;
 
-    u32 part_start = 0;
-    CPState cpmem;
+  while (offset < frame.fifoData.size())
+  {
+    const u32 cmd_size = OpcodeDecoder::RunCommand(&frame.fifoData[offset],
+                                                   u32(frame.fifoData.size()) - offset, *this);
 
-    while (offset < frame.fifoData.size())
+    if (m_start_of_primitives)
     {
-      const u32 cmd_size = OpcodeDecoder::RunCommand(&frame.fifoData[offset],
-                                                     u32(frame.fifoData.size()) - offset, analyzer);
-
-      if (analyzer.m_start_of_primitives)
-      {
-        // Start of primitive data for an object
-        analyzed.AddPart(FramePartType::Commands, part_start, offset, analyzer.m_cpmem);
-        part_start = offset;
-        // Copy cpmem now, because end_of_primitives isn't triggered until the first opcode after
-        // primitive data, and the first opcode might update cpmem
-        std::memcpy(&cpmem, &analyzer.m_cpmem, sizeof(CPState));
-      }
-      if (analyzer.m_end_of_primitives)
-      {
-        // End of primitive data for an object, and thus end of the object
-        analyzed.AddPart(FramePartType::PrimitiveData, part_start, offset, cpmem);
-        part_start = offset;
-      }
+      // Start of primitive data for an object
+      analyzed.AddPart(FramePartType::Commands, part_start, offset, m_cpmem);
+      part_start = offset;
+      // Copy cpmem now, because end_of_primitives isn't triggered until the first opcode after
+      // primitive data, and the first opcode might update cpmem
+      part_cpmem.emplace(m_cpmem);
+    }
+    if (m_end_of_primitives)
+    {
+      // End of primitive data for an object, and thus end of the object
+      ASSERT(part_cpmem.has_value());
+      analyzed.AddPart(FramePartType::PrimitiveData, part_start, offset, *part_cpmem);
+      part_start = offset;
+    }
 
-      offset += cmd_size;
+    offset += cmd_size;
 
-      if (analyzer.m_efb_copy)
-      {
-        // We increase the offset beforehand, so that the trigger EFB copy command is included.
-        analyzed.AddPart(FramePartType::EFBCopy, part_start, offset, analyzer.m_cpmem);
-        part_start = offset;
-      }
+    if (m_efb_copy)
+    {
+      // We increase the offset beforehand, so that the trigger EFB copy command is included.
+      analyzed.AddPart(FramePartType::EFBCopy, part_start, offset, m_cpmem);
+      part_start = offset;
     }
-
-    // The frame should end with an EFB copy, so part_start should have been updated to the end.
-    ASSERT(part_start == frame.fifoData.size());
-    ASSERT(offset == frame.fifoData.size());
   }
+
+  // The frame should end with an EFB copy, so part_start should have been updated to the end.
+  ASSERT(part_start == frame.fifoData.size());
+  ASSERT(offset == frame.fifoData.size());
 }
 
 void FifoPlaybackAnalyzer::OnBP(u8 command, u32 value)
@@ -180,11 +182,16 @@ bool FifoPlayer::Open(const std::string& filename)
 
   m_File = FifoDataFile::Load(filename, false);
 
-  if (m_File)
+  if (m_File && !AnalyzeFrames())
   {
-    FifoPlaybackAnalyzer::AnalyzeFrames(m_File.get(), m_FrameInfo);
+    CriticalAlertFmtT("Failed to read DFF file.");
+    m_File.reset();
+  }
 
+  if (m_File)
+  {
     m_FrameRangeEnd = m_File->GetFrameCount() - 1;
+    m_read_ahead_thread.Reset([this](u32 frame) { ReadAhead(frame); });
   }
 
   if (m_FileLoadedCb)
@@ -195,6 +202,14 @@ bool FifoPlayer::Open(const std::string& filename)
 
 void FifoPlayer::Close()
 {
+  m_read_ahead_thread.Cancel();
+  {
+    std::lock_guard lk(m_frame_cache_lock);
+    m_frame_cache.clear();
+  }
+  m_frame_start_cpmem.clear();
+  m_frame_object_counts.clear();
+
   m_File.reset();
 
   m_FrameRangeStart = 0;
@@ -287,7 +302,15 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  const std::shared_ptr<const CachedFrame> frame = GetCachedFrame(m_CurrentFrame);
+  if (!frame)
+  {
+    PanicAlertFmtT("Failed to read DFF file.");
+    return CPU::State::PowerDown;
+  }
+
+  RequestReadAhead();
+  WriteFrame(frame->data, frame->info);
 
   ++m_CurrentFrame;
   return CPU::State::Running;
@@ -331,9 +354,8 @@ bool FifoPlayer::IsRunningWithFakeVideoInterfaceUpdates() const
 u32 FifoPlayer::GetMaxObjectCount() const
 {
   u32 result = 0;
-  for (auto& frame : m_FrameInfo)
+  for (const u32 count : m_frame_object_counts)
   {
-    const u32 count = frame.part_type_counts[FramePartType::PrimitiveData];
     if (count > result)
       result = count;
   }
@@ -342,9 +364,9 @@ u32 FifoPlayer::GetMaxObjectCount() const
 
 u32 FifoPlayer::GetFrameObjectCount(u32 frame) const
 {
-  if (frame < m_FrameInfo.size())
+  if (frame < m_frame_object_counts.size())
   {
-    return m_FrameInfo[frame].part_type_counts[FramePartType::PrimitiveData];
+    return m_frame_object_counts[frame];
   }
 
   return 0;
@@ -355,6 +377,138 @@ u32 FifoPlayer::GetCurrentFrameObjectCount() const
   return GetFrameObjectCount(m_CurrentFrame);
 }
 
+std::shared_ptr<const FifoFrameInfo> FifoPlayer::GetFrame(u32 frame)
+{
+  const std::shared_ptr<const CachedFrame> cached_frame = GetCachedFrame(frame);
+  if (!cached_frame)
+    return nullptr;
+  return std::shared_ptr<const FifoFrameInfo>(cached_frame, &cached_frame->data);
+}
+
+std::shared_ptr<const AnalyzedFrameInfo> FifoPlayer::GetAnalyzedFrameInfo(u32 frame)
+{
+  const std::shared_ptr<const CachedFrame> cached_frame = GetCachedFrame(frame);
+  if (!cached_frame)
+    return nullptr;
+  return std::shared_ptr<const AnalyzedFrameInfo>(cached_frame, &cached_frame->info);
+}
+
+bool FifoPlayer::AnalyzeFrames()
+{
+  // Analyzing a frame requires the CP state at its start, which depends on all earlier frames.
+  // Go through the whole file once to find it, and only keep what's needed to analyze any frame
+  // again later; the full analysis of a large file wouldn't fit into memory.
+  const u32 frame_count = m_File->GetFrameCount();
+  m_frame_start_cpmem.reserve(frame_count);
+  m_frame_object_counts.resize(frame_count);
+
+  FifoPlaybackAnalyzer analyzer(CPState(m_File->GetCPMem()));
+  for (u32 frame_no = 0; frame_no < frame_count; frame_no++)
+  {
+    m_File->PrefetchFrame(frame_no + 1);
+    const std::unique_ptr<FifoFrameInfo> frame = m_File->ReadFrame(frame_no);
+    if (!frame)
+      return false;
+
+    m_frame_start_cpmem.push_back(analyzer.m_cpmem);
+
+    AnalyzedFrameInfo analyzed;
+    analyzer.AnalyzeFrame(*frame, analyzed);
+    m_frame_object_counts[frame_no] = analyzed.part_type_counts[FramePartType::PrimitiveData];
+  }
+
+  return true;
+}
+
+std::shared_ptr<const FifoPlayer::CachedFrame> FifoPlayer::GetCachedFrame(u32 frame)
+{
+  if (std::shared_ptr<const CachedFrame> cached_frame = FindCachedFrame(frame))
+    return cached_frame;
+
+  std::shared_ptr<const CachedFrame> cached_frame = LoadFrame(frame);
+  if (cached_frame)
+    AddCachedFrame(cached_frame);
+  return cached_frame;
+}
+
+std::shared_ptr<const FifoPlayer::CachedFrame> FifoPlayer::FindCachedFrame(u32 frame)
+{
+  std::lock_guard lk(m_frame_cache_lock);
+  for (const std::shared_ptr<const CachedFrame>& cached_frame : m_frame_cache)
+  {
+    if (cached_frame->frame_number == frame)
+      return cached_frame;
+  }
+  return nullptr;
+}
+
+void FifoPlayer::AddCachedFrame(std::shared_ptr<const CachedFrame> cached_frame)
+{
+  std::lock_guard lk(m_frame_cache_lock);
+
+  // The frame may have been loaded by another thread in the meantime.
+  for (const std::shared_ptr<const CachedFrame>& other : m_frame_cache)
+  {
+    if (other->frame_number == cached_frame->frame_number)
+      return;
+  }
+
+  m_frame_cache.push_back(std::move(cached_frame));
+  while (m_frame_cache.size() > FRAME_CACHE_SIZE)
+    m_frame_cache.pop_front();
+}
+
+std::shared_ptr<const FifoPlayer::CachedFrame> FifoPlayer::LoadFrame(u32 frame) const
+{
+  if (!m_File || frame >= m_frame_start_cpmem.size())
+    return nullptr;
+
+  std::unique_ptr<FifoFrameInfo> data = m_File->ReadFrame(frame);
+  if (!data)
+    return nullptr;
+
+  auto cached_frame = std::make_shared<CachedFrame>();
+  cached_frame->frame_number = frame;
+  cached_frame->data = std::move(*data);
+
+  FifoPlaybackAnalyzer analyzer(m_frame_start_cpmem[frame]);
+  analyzer.AnalyzeFrame(cached_frame->data, cached_frame->info);
+  return cached_frame;
+}
+
+void FifoPlayer::RequestReadAhead()
+{
+  // Only the frames that are still needed are queued, so the queue never grows beyond this.
+  m_read_ahead_thread.Clear();
+
+  u32 frame = m_CurrentFrame;
+  for (u32 i = 0; i < READ_AHEAD_FRAMES; i++)
+  {
+    if (++frame > m_FrameRangeEnd)
+    {
+      if (!m_Loop)
+        break;
+      frame = m_FrameRangeStart;
+    }
+    if (frame == m_CurrentFrame)
+      break;
+
+    m_read_ahead_thread.EmplaceItem(frame);
+  }
+}
+
+void FifoPlayer::ReadAhead(u32 frame)
+{
+  if (FindCachedFrame(frame))
+    return;
+
+  // Let the OS start reading the frame after this one from disk while this one is decoded.
+  m_File->PrefetchFrame(frame + 1);
+
+  if (std::shared_ptr<const CachedFrame> cached_frame = LoadFrame(frame))
+    AddCachedFrame(std::move(cached_frame));
+}
+
 void FifoPlayer::SetFrameRangeStart(u32 start)
 {
   if (m_File)
@@ -476,10 +630,15 @@ void FifoPlayer::WriteAllMemoryUpdates()
 {
   ASSERT(m_File);
 
+  // This needs every frame once, so read them directly instead of going through the cache.
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
+    m_File->PrefetchFrame(frameNum + 1);
+    const std::unique_ptr<FifoFrameInfo> frame = m_File->ReadFrame(frameNum);
+    if (!frame)
+      continue;
+
+    for (auto& update : frame->memoryUpdates)
     {
       WriteMemory(update);
     }
@@ -537,7 +696,10 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const std::shared_ptr<const CachedFrame> cached_frame = GetCachedFrame(m_CurrentFrame);
+  if (!cached_frame)
+    return;
+  const FifoFrameInfo& frame = cached_frame->data;
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
@@ -3,13 +3,16 @@
 
 #pragma once
 
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "Common/Assert.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "VideoCommon/CPMemory.h"
@@ -109,7 +112,13 @@ public:
   u32 GetFrameObjectCount(u32 frame) const;
   u32 GetCurrentFrameObjectCount() const;
   u32 GetCurrentFrameNum() const { return m_CurrentFrame; }
-  const AnalyzedFrameInfo& GetAnalyzedFrameInfo(u32 frame) const { return m_FrameInfo[frame]; }
+
+  // Frames are read from the file and analyzed on demand, and only a few are kept in memory at a
+  // time. During playback, the frames after the current one are read ahead on another thread.
+  // Returns nullptr if the frame can't be read.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame);
+  std::shared_ptr<const AnalyzedFrameInfo> GetAnalyzedFrameInfo(u32 frame);
+
   // Frame range
   u32 GetFrameRangeStart() const { return m_FrameRangeStart; }
   void SetFrameRangeStart(u32 start);
@@ -132,8 +141,28 @@ public:
 
 private:
   class CPUCore;
+
+  struct CachedFrame
+  {
+    u32 frame_number = 0;
+    FifoFrameInfo data;
+    AnalyzedFrameInfo info;
+  };
+
+  static constexpr u32 READ_AHEAD_FRAMES = 4;
+  // The frame being played, the frames read ahead and one more, e.g. for the FIFO analyzer.
+  static constexpr size_t FRAME_CACHE_SIZE = READ_AHEAD_FRAMES + 2;
+
   FifoPlayer();
 
+  bool AnalyzeFrames();
+  std::shared_ptr<const CachedFrame> GetCachedFrame(u32 frame);
+  std::shared_ptr<const CachedFrame> FindCachedFrame(u32 frame);
+  void AddCachedFrame(std::shared_ptr<const CachedFrame> cached_frame);
+  std::shared_ptr<const CachedFrame> LoadFrame(u32 frame) const;
+  void RequestReadAhead();
+  void ReadAhead(u32 frame);
+
   CPU::State AdvanceFrame();
 
   void WriteFrame(const FifoFrameInfo& frame, const AnalyzedFrameInfo& info);
@@ -193,5 +222,13 @@ private:
 
   std::unique_ptr<FifoDataFile> m_File;
 
-  std::vector<AnalyzedFrameInfo> m_FrameInfo;
+  // The CP state at the start of each frame, which is needed to analyze it.
+  std::vector<CPState> m_frame_start_cpmem;
+  std::vector<u32> m_frame_object_counts;
+
+  std::mutex m_frame_cache_lock;
+  std::deque<std::shared_ptr<const CachedFrame>> m_frame_cache;
+
+  // Declared last, so that the thread is stopped before the other members are destroyed.
+  Common::WorkQueueThread<u32> m_read_ahead_thread;
 };
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <utility>
 
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
@@ -176,7 +177,14 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 {
   std::lock_guard lk(m_mutex);
 
-  m_File = std::make_unique<FifoDataFile>();
+  // The previous recording has to be closed first, as it may be using the same temporary file.
+  m_File.reset();
+  m_File = FifoDataFile::CreateForRecording();
+  if (!m_File)
+  {
+    PanicAlertFmtT("Failed to create a file for the FIFO recording.");
+    return;
+  }
 
   // TODO: This, ideally, would be deallocated when done recording.
   //       However, care needs to be taken since global state
@@ -253,15 +261,14 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
     {
       std::lock_guard lk(m_mutex);
 
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
+      // Hand the frame over to the file, which writes it to disk in the background
+      m_File->AddFrame(std::move(m_CurrentFrame));
 
       if (m_FinishedCb && m_RequestedRecordingEnd)
         m_FinishedCb();
     }
 
-    m_CurrentFrame.memoryUpdates.clear();
+    m_CurrentFrame = {};
     m_FifoData.clear();
     m_FrameEnded = false;
   }
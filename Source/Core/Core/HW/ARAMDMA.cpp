@@ -0,0 +1,59 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/ARAMDMA.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace DSP::ARAMDMA
+{
+constexpr u32 MIRROR_SIZE = 0x400000;
+
+u8* GetMRAMPointer(u8* ram, u32 ram_size, u32 address, u32 size)
+{
+  if (u64{address} + size > ram_size)
+    return nullptr;
+  return &ram[address];
+}
+
+u8* GetARAMPointer(const ARAMView& aram, u32 address, u32 size)
+{
+  const u32 offset = address & aram.mask;
+  if (u64{offset} + size > aram.size)
+    return nullptr;
+  return &aram.ptr[offset];
+}
+
+bool CopyFromARAM(const ARAMView& aram, u32 address, u8* mram, u32 count)
+{
+  const u8* const src = GetARAMPointer(aram, address, count);
+  if (!src)
+    return false;
+
+  std::memcpy(mram, src, count);
+  return true;
+}
+
+bool CopyToARAM(const ARAMView& aram, u32 address, const u8* mram, u32 count,
+                bool mirror_low_4mb)
+{
+  u8* const dest = GetARAMPointer(aram, address, count);
+  if (!dest)
+    return false;
+
+  if (mirror_low_4mb && address < MIRROR_SIZE)
+  {
+    // The 8 byte chunks write their mirror before themselves, so where the mirror and the
+    // transfer overlap, the transfer wins. Writing the whole mirror first gives the same result.
+    const u32 mirror_count = std::min(count, MIRROR_SIZE - address);
+    u8* const mirror = GetARAMPointer(aram, address + MIRROR_SIZE, mirror_count);
+    if (!mirror)
+      return false;
+    std::memcpy(mirror, mram, mirror_count);
+  }
+
+  std::memcpy(dest, mram, count);
+  return true;
+}
+}  // namespace DSP::ARAMDMA
@@ -0,0 +1,32 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Bulk copies for ARAM DMA transfers. These only work on the memories they are given, so they
+// can be used without an initialised core.
+namespace DSP::ARAMDMA
+{
+struct ARAMView
+{
+  u8* ptr = nullptr;
+  u32 size = 0;
+  u32 mask = 0;
+};
+
+// Returns a pointer to <size> bytes of MRAM at <address> if the whole range is within the
+// <ram_size> bytes at <ram>, or nullptr if the transfer has to go through the memory functions.
+u8* GetMRAMPointer(u8* ram, u32 ram_size, u32 address, u32 size);
+// Returns a pointer to <size> bytes of ARAM at <address>, or nullptr if the range wraps around.
+u8* GetARAMPointer(const ARAMView& aram, u32 address, u32 size);
+
+// Both memories hold big endian data, so a transfer which doesn't wrap around is a copy. These
+// return false without copying anything if the ARAM range wraps around.
+bool CopyFromARAM(const ARAMView& aram, u32 address, u8* mram, u32 count);
+// If <mirror_low_4mb> is set (ARAM mode 4), the part of the transfer below 4MB is also written
+// 4MB higher, with the same result as when the transfer is done 8 bytes at a time.
+bool CopyToARAM(const ARAMView& aram, u32 address, const u8* mram, u32 count,
+                bool mirror_low_4mb);
+}  // namespace DSP::ARAMDMA
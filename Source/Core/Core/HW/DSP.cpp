@@ -33,6 +33,7 @@
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
 
+#include "Core/HW/ARAMDMA.h"
 #include "Core/HW/HSP/HSP.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/Memmap.h"
@@ -501,6 +502,23 @@ void UpdateAudioDMA()
   }
 }
 
+static u8* GetMRAMPointerForDMA(u32 address, u32 size)
+{
+  return ARAMDMA::GetMRAMPointer(Memory::m_pRAM, Memory::GetRamSizeReal(), address, size);
+}
+
+static ARAMDMA::ARAMView GetARAMView()
+{
+  return {s_ARAM.ptr, s_ARAM.size, s_ARAM.mask};
+}
+
+static void AdvanceARAM_DMA(u32 size)
+{
+  s_arDMA.MMAddr += size;
+  s_arDMA.ARAddr += size;
+  s_arDMA.Cnt.count -= size;
+}
+
 static void Do_ARAM_DMA()
 {
   s_dspState.DMAState = 1;
@@ -522,6 +540,11 @@ static void Do_ARAM_DMA()
 
     if (s_arDMA.ARAddr < s_ARAM.size)
     {
+      const u32 count = s_arDMA.Cnt.count;
+      u8* const mram = GetMRAMPointerForDMA(s_arDMA.MMAddr, count);
+      if (mram && ARAMDMA::CopyFromARAM(GetARAMView(), s_arDMA.ARAddr, mram, count))
+        AdvanceARAM_DMA(count);
+
       while (s_arDMA.Cnt.count)
       {
         // These are logically separated in code to show that a memory map has been set up
@@ -567,6 +590,12 @@ static void Do_ARAM_DMA()
 
     if (s_arDMA.ARAddr < s_ARAM.size)
     {
+      const u32 count = s_arDMA.Cnt.count;
+      const u8* const mram = GetMRAMPointerForDMA(s_arDMA.MMAddr, count);
+      const bool mirrored = (s_ARAM_Info.Hex & 0xf) == 4;
+      if (mram && ARAMDMA::CopyToARAM(GetARAMView(), s_arDMA.ARAddr, mram, count, mirrored))
+        AdvanceARAM_DMA(count);
+
       while (s_arDMA.Cnt.count)
       {
         if ((s_ARAM_Info.Hex & 0xf) == 3)
@@ -12,8 +12,10 @@
 #endif
 
 #include <algorithm>
-#include <functional>
+#include <array>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/DSP/DSPAccelerator.h"
@@ -21,6 +23,7 @@
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceMath.h"
 #include "Core/HW/Memmap.h"
 
 namespace DSP::HLE
@@ -199,16 +202,17 @@ void AcceleratorSetup(PB_TYPE* pb)
   s_accelerator->SetPredScale(pb->adpcm.pred_scale);
 }
 
-// Reads a sample from the accelerator. Also handles looping and
+// Reads samples from the accelerator. Also handles looping and
 // disabling streams that reached the end (this is done by an exception raised
 // by the accelerator on real hardware).
-u16 AcceleratorGetSample()
+void AcceleratorGetSamples(s16* samples, u32 count)
 {
-  return s_accelerator->Read(acc_pb->adpcm.coefs);
+  s_accelerator->ReadSamples(acc_pb->adpcm.coefs, samples, count);
 }
 
-// Reads samples from the input callback, resamples them to <count> samples at
-// the wanted sample rate (computed from the ratio, see below).
+// Reads samples using the input callback, and resamples them to <count> samples
+// at the wanted sample rate (computed from the ratio, see below). The callback
+// is given a buffer and the number of samples to write to it.
 //
 // If srctype is SRCTYPE_POLYPHASE, coefficients need to be provided as well
 // (or the srctype will automatically be changed to LINEAR).
@@ -227,115 +231,47 @@ u16 AcceleratorGetSample()
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
+template <typename InputCallback>
+u32 ResampleAudio(InputCallback input_callback, s16* output, u32 count, s16* last_samples,
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
-  int read_samples_count = 0;
-
-  // If DSP DROM coefficients are available, support polyphase resampling.
-  if (coeffs && srctype == SRCTYPE_POLYPHASE)
+  if (srctype != SRCTYPE_LINEAR && srctype != SRCTYPE_POLYPHASE)
   {
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
-    {
-      curr_pos += ratio;
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
-      const s16* c = &coeffs[curr_pos_frac];
-
-      s64 t0 = temp[idx++ & 3];
-      s64 t1 = temp[idx++ & 3];
-      s64 t2 = temp[idx++ & 3];
-      s64 t3 = temp[idx++ & 3];
-
-      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
-
-      output[i] = MathUtil::SaturatingCast<s16>(samp);
-    }
-
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
+    // SRCTYPE_NEAREST: No sample rate conversion here: simply read samples
+    // to the output buffer.
+    input_callback(output, count);
+    memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
+    return curr_pos;
   }
-  else if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
-  {
-    // This is the circular buffer containing samples to use for the
-    // interpolation. It is initialized with the values from the PB, and it
-    // will be stored back to the PB at the end.
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
-    {
-      curr_pos += ratio;
-
-      // While our current position is >= 1.0, push new samples to the
-      // circular buffer.
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      // Get our current fractional position, used to know how much of
-      // curr0 and how much of curr1 the output sample should be.
-      u16 curr_frac = curr_pos & 0xFFFF;
-      u16 inv_curr_frac = -curr_frac;
-
-      // Interpolate! If curr_frac is 0, we can simply take the last
-      // sample without any multiplying.
-      s16 sample;
-      if (curr_frac)
-      {
-        s32 s0 = temp[idx++ & 3];
-        s32 s1 = temp[idx++ & 3];
 
-        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
-        idx += 2;
-      }
-      else
-      {
-        sample = temp[idx++ & 3];
-        idx += 3;
-      }
+  // Work out which input samples each output sample is interpolated from, so
+  // that all of the input can be read at once.
+  std::array<u32, MAX_SAMPLES_PER_FRAME> positions;
+  std::array<u16, MAX_SAMPLES_PER_FRAME> fracs;
+  const u32 input_count = AXVoiceMath::ComputeResamplePositions(&curr_pos, ratio, count,
+                                                                positions.data(), fracs.data());
+
+  // The input starts with the last four samples of the previous frame. Only
+  // extreme ratios need more than a few hundred samples.
+  static std::vector<s16> input;
+  if (input.size() < input_count + 4)
+    input.resize(input_count + 4);
+  memcpy(input.data(), last_samples, 4 * sizeof(u16));
+  input_callback(input.data() + 4, input_count);
 
-      output[i] = sample;
-    }
-
-    // Update the four last_samples values.
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
+  // If DSP DROM coefficients are available, support polyphase resampling.
+  if (coeffs && srctype == SRCTYPE_POLYPHASE)
+  {
+    AXVoiceMath::ResamplePolyphase(input.data(), output, count, positions.data(), fracs.data(),
+                                   coeffs);
   }
-  else  // SRCTYPE_NEAREST
+  else
   {
-    // No sample rate conversion here: simply read samples from the
-    // accelerator to the output buffer.
-    for (u32 i = 0; i < count; ++i)
-      output[i] = input_callback(i);
-
-    memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
+    AXVoiceMath::ResampleLinear(input.data(), output, count, positions.data(), fracs.data());
   }
 
+  // Update the four last_samples values.
+  memcpy(last_samples, input.data() + input_count, 4 * sizeof(u16));
   return curr_pos;
 }
 
@@ -347,9 +283,8 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+  u32 curr_pos = ResampleAudio(AcceleratorGetSamples, samples, count, pb.src.last_samples,
+                               pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -363,27 +298,19 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
 {
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
+  if (count == 0)
+    return;
 
   // If volume ramping is disabled, set volume_delta to 0. That way, the
-  // mixing loop can avoid testing if volume ramping is enabled at each step,
-  // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
-
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+  // volume is simply constant.
+  const u16 volume_delta = ramp ? vd->volume_delta : 0;
 
-    out[i] += (s16)sample;
-    volume += volume_delta;
+  s16 samples[MAX_SAMPLES_PER_FRAME];
+  AXVoiceMath::ApplyVolume(input, samples, count, vd->volume, volume_delta);
+  AXVoiceMath::AddSamples(out, samples, count);
 
-    *dpop = (s16)sample;
-  }
+  vd->volume += static_cast<u16>(count * volume_delta);
+  *dpop = samples[count - 1];
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -409,12 +336,9 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    const s32 sample = ((s32)samples[i] * pb.vol_env.cur_volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  const u16 volume_delta = static_cast<u16>(pb.vol_env.cur_volume_delta);
+  AXVoiceMath::ApplyVolume(samples, samples, count, pb.vol_env.cur_volume, volume_delta);
+  pb.vol_env.cur_volume += static_cast<u16>(count * volume_delta);
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
@@ -516,9 +440,10 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 
     // We use ratio 0x55555 == (5 * 65536 + 21845) / 65536 == 5.3333 which
     // is the nearest we can get to 96/18
-    u32 curr_pos = ResampleAudio([&samples](u32 i) { return samples[i]; }, wm_samples, wm_count,
-                                 pb.remote_src.last_samples, pb.remote_src.cur_addr_frac, 0x55555,
-                                 SRCTYPE_POLYPHASE, coeffs);
+    u32 curr_pos = ResampleAudio(
+        [&samples](s16* out, u32 n) { memcpy(out, samples, n * sizeof(s16)); }, wm_samples,
+        wm_count, pb.remote_src.last_samples, pb.remote_src.cur_addr_frac, 0x55555,
+        SRCTYPE_POLYPHASE, coeffs);
     pb.remote_src.cur_addr_frac = curr_pos & 0xFFFF;
 
 // Mix to main[0-3] and aux[0-3]
@@ -0,0 +1,228 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXVoiceMath.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Common/MathUtil.h"
+
+#ifdef _M_X86
+#include <emmintrin.h>
+#endif
+
+namespace DSP::HLE::AXVoiceMath
+{
+namespace
+{
+s16 InterpolateLinear(const s16* input, u32 position, u16 frac)
+{
+  const s32 s0 = input[position];
+  if (frac == 0)
+    return s0;
+
+  const s32 s1 = input[position + 1];
+  const u16 inv_frac = -frac;
+  return static_cast<s16>(((s0 * inv_frac) + (s1 * frac)) >> 16);
+}
+
+s16 InterpolatePolyphase(const s16* input, u32 position, u16 frac, const s16* coeffs)
+{
+  const s16* t = &input[position];
+  const s16* c = &coeffs[(frac >> 9) << 2];
+  const s64 sample =
+      (s64(t[0]) * c[0] + s64(t[1]) * c[1] + s64(t[2]) * c[2] + s64(t[3]) * c[3]) >> 15;
+  return MathUtil::SaturatingCast<s16>(sample);
+}
+
+s16 ScaleSample(s16 sample, u16 volume)
+{
+  const s32 scaled = (s32(sample) * volume) >> 15;
+  return static_cast<s16>(std::clamp(scaled, -32767, 32767));
+}
+
+#ifdef _M_X86
+// Multiplies signed by unsigned 16-bit values, giving the full 32-bit products of the low and
+// high four lanes.
+void MultiplyS16U16(__m128i a, __m128i b, __m128i* products_lo, __m128i* products_hi)
+{
+  const __m128i lo = _mm_mullo_epi16(a, b);
+  // _mm_mulhi_epi16 treats b as signed, which is off by a * 65536 when b >= 0x8000.
+  const __m128i hi =
+      _mm_add_epi16(_mm_mulhi_epi16(a, b), _mm_and_si128(a, _mm_srai_epi16(b, 15)));
+  *products_lo = _mm_unpacklo_epi16(lo, hi);
+  *products_hi = _mm_unpackhi_epi16(lo, hi);
+}
+
+__m128i LoadPair(const s16* a, const s16* b)
+{
+  return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a)),
+                            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(b)));
+}
+
+// Computes the dot products of two outputs in lanes 0 and 2, shifted right by 15. Returns false
+// if one of the products overflowed, in which case the outputs have to be computed separately.
+bool PolyphasePair(const s16* input, const s16* coeffs, const u32* positions, const u16* fracs,
+                   __m128i* result)
+{
+  const __m128i taps = LoadPair(&input[positions[0]], &input[positions[1]]);
+  const __m128i c =
+      LoadPair(&coeffs[(fracs[0] >> 9) << 2], &coeffs[(fracs[1] >> 9) << 2]);
+
+  // Lanes 0 and 2 hold t0 * c0 + t1 * c1, lanes 1 and 3 hold t2 * c2 + t3 * c3. This only
+  // overflows if both products are (-32768) * (-32768).
+  const __m128i sums = _mm_madd_epi16(taps, c);
+  const __m128i overflow = _mm_cmpeq_epi32(sums, _mm_set1_epi32(std::numeric_limits<s32>::min()));
+  if (_mm_movemask_epi8(overflow) != 0)
+    return false;
+
+  // Adding both sums can overflow too, so they're halved first. The low bits are added
+  // separately: (a + b) >> 15 == ((a >> 1) + (b >> 1) + (a & b & 1)) >> 14.
+  const __m128i halves = _mm_srai_epi32(sums, 1);
+  const __m128i low_bits = _mm_and_si128(sums, _mm_set1_epi32(1));
+  const __m128i swapped_halves = _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1));
+  const __m128i swapped_low_bits = _mm_shuffle_epi32(low_bits, _MM_SHUFFLE(2, 3, 0, 1));
+  const __m128i total = _mm_add_epi32(_mm_add_epi32(halves, swapped_halves),
+                                      _mm_and_si128(low_bits, swapped_low_bits));
+  *result = _mm_srai_epi32(total, 14);
+  return true;
+}
+#endif
+}  // namespace
+
+u32 ComputeResamplePositions(u32* curr_pos, u32 ratio, u32 count, u32* positions, u16* fracs)
+{
+  u32 pos = *curr_pos;
+  u32 consumed = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    pos += ratio;
+    consumed += pos >> 16;
+    pos &= 0xFFFF;
+    positions[i] = consumed;
+    fracs[i] = static_cast<u16>(pos);
+  }
+
+  *curr_pos = pos;
+  return consumed;
+}
+
+void ResampleLinear(const s16* input, s16* output, u32 count, const u32* positions,
+                    const u16* fracs)
+{
+  u32 i = 0;
+#ifdef _M_X86
+  // s0 * (65536 - frac) + s1 * frac always fits in 32 bits.
+  for (; i + 8 <= count; i += 8)
+  {
+    alignas(16) s16 s0[8];
+    alignas(16) s16 s1[8];
+    for (u32 j = 0; j < 8; ++j)
+    {
+      s0[j] = input[positions[i + j]];
+      s1[j] = input[positions[i + j] + 1];
+    }
+
+    const __m128i first = _mm_load_si128(reinterpret_cast<const __m128i*>(s0));
+    const __m128i second = _mm_load_si128(reinterpret_cast<const __m128i*>(s1));
+    const __m128i frac = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&fracs[i]));
+    const __m128i inv_frac = _mm_sub_epi16(_mm_setzero_si128(), frac);
+
+    __m128i first_lo, first_hi, second_lo, second_hi;
+    MultiplyS16U16(first, inv_frac, &first_lo, &first_hi);
+    MultiplyS16U16(second, frac, &second_lo, &second_hi);
+    const __m128i lo = _mm_srai_epi32(_mm_add_epi32(first_lo, second_lo), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_add_epi32(second_hi, first_hi), 16);
+    const __m128i interpolated = _mm_packs_epi32(lo, hi);
+
+    // A fractional position of 0 takes the first sample as is.
+    const __m128i is_whole = _mm_cmpeq_epi16(frac, _mm_setzero_si128());
+    const __m128i result = _mm_or_si128(_mm_and_si128(is_whole, first),
+                                        _mm_andnot_si128(is_whole, interpolated));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), result);
+  }
+#endif
+
+  for (; i < count; ++i)
+    output[i] = InterpolateLinear(input, positions[i], fracs[i]);
+}
+
+void ResamplePolyphase(const s16* input, s16* output, u32 count, const u32* positions,
+                       const u16* fracs, const s16* coeffs)
+{
+  u32 i = 0;
+#ifdef _M_X86
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i first, second;
+    if (!PolyphasePair(input, coeffs, &positions[i], &fracs[i], &first) ||
+        !PolyphasePair(input, coeffs, &positions[i + 2], &fracs[i + 2], &second))
+    {
+      for (u32 j = i; j < i + 4; ++j)
+        output[j] = InterpolatePolyphase(input, positions[j], fracs[j], coeffs);
+      continue;
+    }
+
+    const __m128i results = _mm_castps_si128(_mm_shuffle_ps(
+        _mm_castsi128_ps(first), _mm_castsi128_ps(second), _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&output[i]), _mm_packs_epi32(results, results));
+  }
+#endif
+
+  for (; i < count; ++i)
+    output[i] = InterpolatePolyphase(input, positions[i], fracs[i], coeffs);
+}
+
+void ApplyVolume(const s16* input, s16* output, u32 count, u16 volume, u16 volume_delta)
+{
+  u32 i = 0;
+#ifdef _M_X86
+  __m128i volumes = _mm_add_epi16(
+      _mm_set1_epi16(static_cast<s16>(volume)),
+      _mm_mullo_epi16(_mm_set1_epi16(static_cast<s16>(volume_delta)),
+                      _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7)));
+  const __m128i volume_step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i]));
+    __m128i lo, hi;
+    MultiplyS16U16(samples, volumes, &lo, &hi);
+
+    // Packing saturates to [-32768, 32767].
+    const __m128i packed = _mm_packs_epi32(_mm_srai_epi32(lo, 15), _mm_srai_epi32(hi, 15));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), _mm_max_epi16(packed, min_sample));
+    volumes = _mm_add_epi16(volumes, volume_step);
+  }
+  volume += static_cast<u16>(i * volume_delta);
+#endif
+
+  for (; i < count; ++i)
+  {
+    output[i] = ScaleSample(input[i], volume);
+    volume += volume_delta;
+  }
+}
+
+void AddSamples(int* output, const s16* input, u32 count)
+{
+  u32 i = 0;
+#ifdef _M_X86
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i]));
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+
+    __m128i* out = reinterpret_cast<__m128i*>(&output[i]);
+    _mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), lo));
+    _mm_storeu_si128(out + 1, _mm_add_epi32(_mm_loadu_si128(out + 1), hi));
+  }
+#endif
+
+  for (; i < count; ++i)
+    output[i] += input[i];
+}
+}  // namespace DSP::HLE::AXVoiceMath
@@ -0,0 +1,33 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Sample processing used by the AX voice pipeline. Every function processes a whole block of
+// samples, using SIMD where available, and gives the same results as the per-sample
+// computations done by the AX microcode.
+namespace DSP::HLE::AXVoiceMath
+{
+// Advances a resampling position, which is a 16.16 fixed point number, by <ratio> for each of
+// <count> output samples. For each output sample, <positions> receives how many new input samples
+// have been consumed so far and <fracs> the fractional part of the position. Returns the total
+// number of consumed input samples.
+u32 ComputeResamplePositions(u32* curr_pos, u32 ratio, u32 count, u32* positions, u16* fracs);
+
+// Resamples using positions computed by ComputeResamplePositions. <input> has to start with the
+// last four input samples of the previous block, followed by the new input samples.
+void ResampleLinear(const s16* input, s16* output, u32 count, const u32* positions,
+                    const u16* fracs);
+// <coeffs> is the table of 128 sets of 4 filter coefficients that is selected by the PB.
+void ResamplePolyphase(const s16* input, s16* output, u32 count, const u32* positions,
+                       const u16* fracs, const s16* coeffs);
+
+// output[i] = clamp((input[i] * volume) >> 15, -32767, 32767), where <volume_delta> is added to
+// <volume> after every sample. <input> and <output> can be the same buffer.
+void ApplyVolume(const s16* input, s16* output, u32 count, u16 volume, u16 volume_delta);
+
+// output[i] += input[i]
+void AddSamples(int* output, const s16* input, u32 count);
+}  // namespace DSP::HLE::AXVoiceMath
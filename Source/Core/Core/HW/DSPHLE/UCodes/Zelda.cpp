@@ -1077,14 +1077,7 @@ void ZeldaAudioRenderer::ApplyReverb(bool post_rendering)
 
       auto ApplyFilter = [&]() {
         // Filter the buffer using provided coefficients.
-        for (u16 i = 0; i < 0x50; ++i)
-        {
-          s32 sample = 0;
-          for (u16 j = 0; j < 8; ++j)
-            sample += (s32)buffer[i + j] * rpb.filter_coeffs[j];
-          sample >>= 15;
-          buffer[i] = std::clamp(sample, -0x8000, 0x7FFF);
-        }
+        ZeldaAudioMath::FilterReverb(buffer.data(), 0x50, rpb.filter_coeffs);
       };
 
       // LSB set -> pre-filtering.
@@ -1492,42 +1485,10 @@ u16 ZeldaAudioRenderer::NeededRawSamplesCount(const VPB& vpb)
 
 void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
 {
-  // Both in 20.12 format.
-  u32 ratio = vpb->resampling_ratio;
-  u32 pos = vpb->current_pos_frac;
-
-  // Check if we need to do some interpolation. If the resampling ratio is
-  // more than 4:1, it's not worth it.
-  if ((ratio >> 12) >= 4)
-  {
-    for (s16& dst_sample : *dst)
-    {
-      pos += ratio;
-      dst_sample = src[pos >> 12];
-    }
-  }
-  else
-  {
-    for (auto& dst_sample : *dst)
-    {
-      // We have 0x40 * 4 coeffs that need to be selected based on the
-      // most significant bits of the fractional part of the position. 12
-      // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
-      // consecutive coeffs.
-      u32 coeffs_idx = ((pos & 0xFFF) >> 6) * 4;
-      const s16* coeffs = &m_resampling_coeffs[coeffs_idx];
-      const s16* input = &src[pos >> 12];
-
-      s64 dst_sample_unclamped = 0;
-      for (size_t i = 0; i < 4; ++i)
-        dst_sample_unclamped += (s64)2 * coeffs[i] * input[i];
-      dst_sample_unclamped >>= 16;
-
-      dst_sample = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
-
-      pos += ratio;
-    }
-  }
+  // Both in 20.12 format. We have 0x40 * 4 coeffs that are selected based on
+  // the 6 most significant bits of the fractional part of the position.
+  u32 pos = ZeldaAudioMath::Resample(src, dst->data(), dst->size(), vpb->current_pos_frac,
+                                     vpb->resampling_ratio, m_resampling_coeffs.data());
 
   for (u32 i = 0; i < 4; ++i)
     vpb->resample_buffer[i] = src[(pos >> 12) + i];
@@ -1715,56 +1676,15 @@ void ZeldaAudioRenderer::DecodeAFC(VPB* vpb, s16* dst, size_t block_count)
   u8* src = (u8*)GetARAMPtr() + addr;
   vpb->SetCurrentARAMAddr(addr + (u32)block_count * vpb->samples_source_type);
 
+  // The samples source type is also the size of a block in bytes.
+  const bool high_quality = vpb->samples_source_type == VPB::SRC_AFC_HQ_FROM_ARAM;
   for (size_t b = 0; b < block_count; ++b)
   {
-    s16 nibbles[16];
-    s16 delta = 1 << ((*src >> 4) & 0xF);
-    s16 idx = (*src & 0xF);
-    src++;
-
-    if (vpb->samples_source_type == VPB::SRC_AFC_HQ_FROM_ARAM)
-    {
-      for (size_t i = 0; i < 16; i += 2)
-      {
-        nibbles[i + 0] = *src >> 4;
-        nibbles[i + 1] = *src & 0xF;
-        src++;
-      }
-      for (auto& nibble : nibbles)
-      {
-        if (nibble >= 8)
-          nibble -= 16;
-        nibble <<= 11;
-      }
-    }
-    else
-    {
-      for (size_t i = 0; i < 16; i += 4)
-      {
-        nibbles[i + 0] = (*src >> 6) & 3;
-        nibbles[i + 1] = (*src >> 4) & 3;
-        nibbles[i + 2] = (*src >> 2) & 3;
-        nibbles[i + 3] = (*src >> 0) & 3;
-        src++;
-      }
-      for (auto& nibble : nibbles)
-      {
-        if (nibble >= 2)
-          nibble -= 4;
-        nibble <<= 13;
-      }
-    }
-
+    // dst can overlap with the decoder history, so read it before decoding.
     s32 yn1 = *vpb->AFCYN1(), yn2 = *vpb->AFCYN2();
-    for (s16 nibble : nibbles)
-    {
-      s32 sample = delta * nibble + yn1 * m_afc_coeffs[idx * 2] + yn2 * m_afc_coeffs[idx * 2 + 1];
-      sample >>= 11;
-      sample = std::clamp(sample, -0x8000, 0x7fff);
-      *dst++ = (s16)sample;
-      yn2 = yn1;
-      yn1 = sample;
-    }
+    ZeldaAudioMath::DecodeAFCBlock(src, dst, high_quality, m_afc_coeffs.data(), &yn1, &yn2);
+    src += vpb->samples_source_type;
+    dst += 16;
 
     *vpb->AFCYN2() = yn2;
     *vpb->AFCYN1() = yn1;
@@ -0,0 +1,269 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/ZeldaAudioMath.h"
+
+#include <algorithm>
+#include <array>
+
+#include "Core/HW/DSPHLE/UCodes/AXVoiceMath.h"
+
+#ifdef _M_X86
+#include <emmintrin.h>
+#endif
+
+namespace DSP::HLE::ZeldaAudioMath
+{
+namespace
+{
+#ifdef _M_X86
+// Multiplies signed by unsigned 16-bit values, giving the full 32-bit products of the low and
+// high four lanes.
+void MultiplyS16U16(__m128i a, __m128i b, __m128i* products_lo, __m128i* products_hi)
+{
+  const __m128i lo = _mm_mullo_epi16(a, b);
+  // _mm_mulhi_epi16 treats b as signed, which is off by a * 65536 when b >= 0x8000.
+  const __m128i hi =
+      _mm_add_epi16(_mm_mulhi_epi16(a, b), _mm_and_si128(a, _mm_srai_epi16(b, 15)));
+  *products_lo = _mm_unpacklo_epi16(lo, hi);
+  *products_hi = _mm_unpackhi_epi16(lo, hi);
+}
+
+// Returns (a * volume) >> shift, saturated to 16 bits.
+__m128i ScaleSamples(__m128i samples, __m128i volume, __m128i shift)
+{
+  __m128i lo, hi;
+  MultiplyS16U16(samples, volume, &lo, &hi);
+  return _mm_packs_epi32(_mm_sra_epi32(lo, shift), _mm_sra_epi32(hi, shift));
+}
+
+// Sums the four lanes of each of the four vectors.
+__m128i HorizontalSum4(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+  const __m128i ab = _mm_add_epi32(_mm_unpacklo_epi32(a, b), _mm_unpackhi_epi32(a, b));
+  const __m128i cd = _mm_add_epi32(_mm_unpacklo_epi32(c, d), _mm_unpackhi_epi32(c, d));
+  return _mm_add_epi32(_mm_unpacklo_epi64(ab, cd), _mm_unpackhi_epi64(ab, cd));
+}
+#endif
+}  // namespace
+
+void ApplyVolume(s16* samples, size_t count, u16 volume, u32 shift)
+{
+  size_t i = 0;
+#ifdef _M_X86
+  const __m128i volumes = _mm_set1_epi16(static_cast<s16>(volume));
+  const __m128i shift_count = _mm_cvtsi32_si128(static_cast<int>(shift));
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i* ptr = reinterpret_cast<__m128i*>(&samples[i]);
+    _mm_storeu_si128(ptr, ScaleSamples(_mm_loadu_si128(ptr), volumes, shift_count));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s32 tmp = (s32(samples[i]) * volume) >> shift;
+    samples[i] = static_cast<s16>(std::clamp(tmp, -0x8000, 0x7FFF));
+  }
+}
+
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 volume)
+{
+  size_t i = 0;
+#ifdef _M_X86
+  const __m128i volumes = _mm_set1_epi16(static_cast<s16>(volume));
+  const __m128i shift_count = _mm_cvtsi32_si128(15);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+    __m128i* out = reinterpret_cast<__m128i*>(&dst[i]);
+    _mm_storeu_si128(
+        out, _mm_add_epi16(_mm_loadu_si128(out), ScaleSamples(samples, volumes, shift_count)));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s32 scaled = (s32(src[i]) * volume) >> 15;
+    dst[i] += std::clamp(scaled, -0x8000, 0x7FFF);
+  }
+}
+
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 volume, s32 step)
+{
+  // The volume is allowed to wrap around, so it's computed with unsigned arithmetic.
+  u32 current = static_cast<u32>(volume);
+  size_t i = 0;
+#ifdef _M_X86
+  if (count >= 8)
+  {
+    const u32 u_step = static_cast<u32>(step);
+    const __m128i offsets = _mm_setr_epi32(0, s32(u_step), s32(u_step * 2), s32(u_step * 3));
+    __m128i volumes_lo = _mm_add_epi32(_mm_set1_epi32(volume), offsets);
+    __m128i volumes_hi = _mm_add_epi32(volumes_lo, _mm_set1_epi32(s32(u_step * 4)));
+    const __m128i volume_step = _mm_set1_epi32(s32(u_step * 8));
+    for (; i + 8 <= count; i += 8)
+    {
+      // Only the integer part of the volume is used, which always fits in 16 bits.
+      const __m128i factors =
+          _mm_packs_epi32(_mm_srai_epi32(volumes_lo, 16), _mm_srai_epi32(volumes_hi, 16));
+      const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+      __m128i* out = reinterpret_cast<__m128i*>(&dst[i]);
+      _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), _mm_mulhi_epi16(factors, samples)));
+
+      volumes_lo = _mm_add_epi32(volumes_lo, volume_step);
+      volumes_hi = _mm_add_epi32(volumes_hi, volume_step);
+    }
+    current += static_cast<u32>(i) * static_cast<u32>(step);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    dst[i] += ((static_cast<s32>(current) >> 16) * src[i]) >> 16;
+    current += static_cast<u32>(step);
+  }
+
+  return static_cast<s32>(current);
+}
+
+u32 Resample(const s16* src, s16* dst, size_t count, u32 pos, u32 ratio, const s16* coeffs)
+{
+  // If the resampling ratio is more than 4:1, interpolating is not worth it.
+  if ((ratio >> 12) >= 4)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      pos += ratio;
+      dst[i] = src[pos >> 12];
+    }
+    return pos;
+  }
+
+  // This is the same filter as the AX polyphase resampler, with 0x40 instead of 0x80 sets of
+  // coefficients. Scaling the 12 bit fractional part to 15 bits selects the right set.
+  constexpr size_t CHUNK_SIZE = 0x50;
+  std::array<u32, CHUNK_SIZE> positions;
+  std::array<u16, CHUNK_SIZE> fracs;
+  for (size_t offset = 0; offset < count; offset += CHUNK_SIZE)
+  {
+    const size_t chunk = std::min(count - offset, CHUNK_SIZE);
+    for (size_t i = 0; i < chunk; ++i)
+    {
+      positions[i] = pos >> 12;
+      fracs[i] = static_cast<u16>((pos & 0xFFF) << 3);
+      pos += ratio;
+    }
+    AXVoiceMath::ResamplePolyphase(src, dst + offset, static_cast<u32>(chunk), positions.data(),
+                                   fracs.data(), coeffs);
+  }
+  return pos;
+}
+
+void FilterReverb(s16* samples, size_t count, const s16* coeffs)
+{
+  size_t i = 0;
+#ifdef _M_X86
+  // The filter only reads samples at or after the one it writes, so filtering in place is fine as
+  // long as a group of outputs is computed before being stored. The sums wrap around on overflow.
+  const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coeffs));
+  const auto filter_four = [&](const s16* taps) {
+    const auto madd = [&](int j) {
+      return _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(taps + j)), c);
+    };
+    return _mm_srai_epi32(HorizontalSum4(madd(0), madd(1), madd(2), madd(3)), 15);
+  };
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i result = _mm_packs_epi32(filter_four(&samples[i]), filter_four(&samples[i + 4]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&samples[i]), result);
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    u32 sample = 0;
+    for (size_t j = 0; j < 8; ++j)
+      sample += static_cast<u32>(s32(samples[i + j]) * coeffs[j]);
+    samples[i] = static_cast<s16>(std::clamp(static_cast<s32>(sample) >> 15, -0x8000, 0x7FFF));
+  }
+}
+
+void DecodeAFCBlock(const u8* src, s16* dst, bool high_quality, const s16* afc_coeffs, s32* yn1,
+                    s32* yn2)
+{
+  const s16 delta = static_cast<s16>(1 << ((*src >> 4) & 0xF));
+  const s16 idx = *src & 0xF;
+  src++;
+
+  // Scaled nibbles, which don't depend on the decoder history.
+  alignas(16) std::array<s32, 16> scaled;
+#ifdef _M_X86
+  if (high_quality)
+  {
+    const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+    const __m128i mask = _mm_set1_epi8(0xF);
+    // The high nibble of each byte comes first.
+    __m128i nibbles = _mm_unpacklo_epi8(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask),
+                                        _mm_and_si128(bytes, mask));
+    // Sign extend the nibbles, then scale them like the ucode does.
+    nibbles = _mm_sub_epi8(_mm_xor_si128(nibbles, _mm_set1_epi8(8)), _mm_set1_epi8(8));
+    const auto widen = [](__m128i bytes_in_both_halves) {
+      return _mm_slli_epi16(_mm_srai_epi16(bytes_in_both_halves, 8), 11);
+    };
+    const __m128i words_lo = widen(_mm_unpacklo_epi8(nibbles, nibbles));
+    const __m128i words_hi = widen(_mm_unpackhi_epi8(nibbles, nibbles));
+
+    const __m128i deltas = _mm_set1_epi16(delta);
+    const auto store = [&](size_t offset, __m128i words) {
+      const __m128i lo = _mm_mullo_epi16(words, deltas);
+      const __m128i hi = _mm_mulhi_epi16(words, deltas);
+      _mm_store_si128(reinterpret_cast<__m128i*>(&scaled[offset]), _mm_unpacklo_epi16(lo, hi));
+      _mm_store_si128(reinterpret_cast<__m128i*>(&scaled[offset + 4]), _mm_unpackhi_epi16(lo, hi));
+    };
+    store(0, words_lo);
+    store(8, words_hi);
+  }
+  else
+#endif
+  {
+    for (size_t i = 0; i < 16; ++i)
+    {
+      s16 nibble;
+      if (high_quality)
+      {
+        nibble = (src[i / 2] >> ((i & 1) ? 0 : 4)) & 0xF;
+        if (nibble >= 8)
+          nibble -= 16;
+        nibble <<= 11;
+      }
+      else
+      {
+        nibble = (src[i / 4] >> (6 - 2 * (i & 3))) & 3;
+        if (nibble >= 2)
+          nibble -= 4;
+        nibble <<= 13;
+      }
+      scaled[i] = delta * nibble;
+    }
+  }
+
+  // The predictor depends on the previous output, so this part has to stay sequential.
+  const s32 coef1 = afc_coeffs[idx * 2];
+  const s32 coef2 = afc_coeffs[idx * 2 + 1];
+  s32 history1 = *yn1;
+  s32 history2 = *yn2;
+  for (size_t i = 0; i < 16; ++i)
+  {
+    s32 sample = scaled[i] + history1 * coef1 + history2 * coef2;
+    sample >>= 11;
+    sample = std::clamp(sample, -0x8000, 0x7fff);
+    dst[i] = static_cast<s16>(sample);
+    history2 = history1;
+    history1 = sample;
+  }
+
+  *yn1 = history1;
+  *yn2 = history2;
+}
+}  // namespace DSP::HLE::ZeldaAudioMath
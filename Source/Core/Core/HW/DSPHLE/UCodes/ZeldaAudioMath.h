@@ -0,0 +1,38 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+// Sample processing used by the Zelda ucode audio renderer. Every function processes a whole
+// buffer, using SIMD where available, and gives the same results as the per-sample computations
+// done by the ucode.
+namespace DSP::HLE::ZeldaAudioMath
+{
+// samples[i] = clamp((samples[i] * volume) >> shift, -32768, 32767)
+void ApplyVolume(s16* samples, size_t count, u16 volume, u32 shift);
+
+// dst[i] += clamp((src[i] * volume) >> 15, -32768, 32767), wrapping around on overflow.
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 volume);
+
+// dst[i] += ((volume >> 16) * src[i]) >> 16, where <volume> is a 16.16 fixed point number that
+// increases by <step> after every sample. Returns the final volume.
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 volume, s32 step);
+
+// Resamples <count> output samples starting at position <pos>, which is a 20.12 fixed point
+// number, and advancing by <ratio> for each output sample. Uses the 4 tap filter from <coeffs>
+// (0x40 sets of 4 coefficients) unless the ratio is at least 4, in which case samples are simply
+// picked. Returns the final position.
+u32 Resample(const s16* src, s16* dst, size_t count, u32 pos, u32 ratio, const s16* coeffs);
+
+// Applies the 8 tap reverb filter in place. <samples> has to hold count + 7 samples.
+void FilterReverb(s16* samples, size_t count, const s16* coeffs);
+
+// Decodes one AFC block of 16 samples. High quality blocks are 9 bytes long (4 bit samples), low
+// quality blocks are 5 bytes long (2 bit samples). <yn1> and <yn2> hold the decoder history.
+void DecodeAFCBlock(const u8* src, s16* dst, bool high_quality, const s16* afc_coeffs, s32* yn1,
+                    s32* yn2);
+}  // namespace DSP::HLE::ZeldaAudioMath
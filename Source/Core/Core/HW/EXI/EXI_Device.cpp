@@ -47,6 +47,17 @@ void IEXIDevice::ImmReadWrite(u32& data, u32 size)
 
 void IEXIDevice::DMAWrite(u32 address, u32 size)
 {
+  // Look up the range once rather than for every byte when it is valid
+  if (const u8* data = size != 0 ? Memory::GetPointerForRange(address, size) : nullptr)
+  {
+    for (u32 i = 0; i < size; ++i)
+    {
+      u8 byte = data[i];
+      TransferByte(byte);
+    }
+    return;
+  }
+
   while (size--)
   {
     u8 byte = Memory::Read_U8(address++);
@@ -56,6 +67,16 @@ void IEXIDevice::DMAWrite(u32 address, u32 size)
 
 void IEXIDevice::DMARead(u32 address, u32 size)
 {
+  if (u8* data = size != 0 ? Memory::GetPointerForRange(address, size) : nullptr)
+  {
+    for (u32 i = 0; i < size; ++i)
+    {
+      data[i] = 0;
+      TransferByte(data[i]);
+    }
+    return;
+  }
+
   while (size--)
   {
     u8 byte = 0;
@@ -521,7 +521,9 @@ void CEXIMemoryCard::DoState(PointerWrap& p)
 // read all at once instead of single byte at a time as done by IEXIDevice::DMARead
 void CEXIMemoryCard::DMARead(u32 addr, u32 size)
 {
-  m_memory_card->Read(m_address, size, Memory::GetPointer(addr));
+  u8* const pointer = Memory::GetPointerForRange(addr, size);
+  if (pointer)
+    m_memory_card->Read(m_address, size, pointer);
 
   if ((m_address + size) % Memcard::BLOCK_SIZE == 0)
   {
@@ -537,7 +539,9 @@ void CEXIMemoryCard::DMARead(u32 addr, u32 size)
 // write all at once instead of single byte at a time as done by IEXIDevice::DMAWrite
 void CEXIMemoryCard::DMAWrite(u32 addr, u32 size)
 {
-  m_memory_card->Write(m_address, size, Memory::GetPointer(addr));
+  u8* const pointer = Memory::GetPointerForRange(addr, size);
+  if (pointer)
+    m_memory_card->Write(m_address, size, pointer);
 
   if (((m_address + size) % Memcard::BLOCK_SIZE) == 0)
   {
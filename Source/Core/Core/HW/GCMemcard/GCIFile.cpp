@@ -85,6 +85,14 @@ int GCIFile::UsesBlock(u16 block_num)
   return -1;
 }
 
+void GCIFile::MarkBlockDirty(u16 block_index)
+{
+  if (m_dirty_blocks.size() < m_save_data.size())
+    m_dirty_blocks.resize(m_save_data.size());
+  m_dirty_blocks[block_index] = true;
+  m_dirty = true;
+}
+
 void GCIFile::DoState(PointerWrap& p)
 {
   p.DoPOD<DEntry>(m_gci_header);
@@ -98,5 +106,9 @@ void GCIFile::DoState(PointerWrap& p)
     p.DoPOD<GCMBlock>(*itr);
   }
   p.Do(m_used_blocks);
+
+  // Which blocks changed isn't known after loading a state, so a dirty save is written entirely.
+  if (p.IsReadMode())
+    m_dirty_blocks.assign(m_save_data.size(), m_dirty);
 }
 }  // namespace Memcard
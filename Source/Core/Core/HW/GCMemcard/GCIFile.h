@@ -21,10 +21,14 @@ public:
   bool HasCopyProtection() const;
   void DoState(PointerWrap& p);
   int UsesBlock(u16 blocknum);
+  // Marks a block of m_save_data as modified, so that the next flush writes it to disk.
+  void MarkBlockDirty(u16 block_index);
 
   DEntry m_gci_header;
   std::vector<GCMBlock> m_save_data;
   std::vector<u16> m_used_blocks;
+  // Which blocks of m_save_data have been modified since the last flush.
+  std::vector<bool> m_dirty_blocks;
   bool m_dirty = false;
   std::string m_filename;
 };
@@ -67,7 +67,21 @@ bool GCMemcardDirectory::LoadGCI(Memcard::GCIFile gci)
     return false;
   }
 
-  if (!gci.LoadSaveBlocks())
+  const u64 file_size = File::GetSize(gci.m_filename);
+  const u32 expected_size = num_blocks * Memcard::BLOCK_SIZE + Memcard::DENTRY_SIZE;
+  if (file_size != expected_size)
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE,
+                  "{}\nwas not loaded because it is an invalid GCI.\n File size ({:#x}) does not "
+                  "match the size recorded in the header ({:#x})",
+                  gci.m_filename, file_size, expected_size);
+    return false;
+  }
+
+  // Only the save data of the current game is read now, so that it is part of savestates.
+  // Saves of other games are read from disk when they are first accessed.
+  const bool is_current_game = m_game_id == Common::swap32(gci.m_gci_header.m_gamecode.data());
+  if ((is_current_game || gci.HasCopyProtection()) && !gci.LoadSaveBlocks())
   {
     ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to load data of {}", gci.m_filename);
     return false;
@@ -158,6 +172,8 @@ GCMemcardDirectory::GCMemcardDirectory(const std::string& directory, ExpansionIn
       m_hdr(header_data), m_bat1(header_data.m_size_mb), m_saves(0), m_save_directory(directory),
       m_exiting(false)
 {
+  const u64 start_time = Common::Timer::GetTimeUs();
+
   // Use existing header data if available
   {
     File::IOFile((m_save_directory + MC_HDR), "rb").ReadBytes(&m_hdr, Memcard::BLOCK_SIZE);
@@ -230,6 +246,9 @@ GCMemcardDirectory::GCMemcardDirectory(const std::string& directory, ExpansionIn
   m_dir2 = m_dir1;
   m_bat2 = m_bat1;
 
+  INFO_LOG_FMT(EXPANSIONINTERFACE, "Loaded {} of {} GCI files from {} in {} us", m_saves.size(),
+               filenames.size(), m_save_directory, Common::Timer::GetTimeUs() - start_time);
+
   m_flush_thread = std::thread(&GCMemcardDirectory::FlushThread, this);
 }
 
@@ -243,6 +262,8 @@ void GCMemcardDirectory::FlushThread()
   Common::SetCurrentThreadName(fmt::format("Memcard {} flushing thread", m_card_slot).c_str());
 
   constexpr std::chrono::seconds flush_interval{1};
+  // Games which keep writing still get their saves flushed at least this often.
+  constexpr std::chrono::seconds max_flush_delay{5};
   while (true)
   {
     // no-op until signalled
@@ -250,9 +271,17 @@ void GCMemcardDirectory::FlushThread()
 
     if (m_exiting.TestAndClear())
       return;
-    // no-op as long as signalled within flush_interval
-    while (m_flush_trigger.WaitFor(flush_interval))
+    // no-op as long as signalled within flush_interval, up to max_flush_delay
+    const auto deadline = std::chrono::steady_clock::now() + max_flush_delay;
+    while (true)
     {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline)
+        break;
+      const auto wait_time =
+          std::min<std::chrono::steady_clock::duration>(flush_interval, deadline - now);
+      if (!m_flush_trigger.WaitFor(wait_time))
+        break;
       if (m_exiting.TestAndClear())
         return;
     }
@@ -386,6 +415,8 @@ s32 GCMemcardDirectory::Write(u32 dest_address, s32 length, const u8* src_addres
   }
 
   memcpy(m_last_block_address + offset, src_address, length);
+  if (block >= static_cast<s32>(Memcard::MC_FST_BLOCKS))
+    m_saves[m_last_save_index].MarkBlockDirty(m_last_save_block_index);
 
   l.unlock();
   if (extra)
@@ -481,6 +512,7 @@ inline void GCMemcardDirectory::SyncSaves()
           INFO_LOG_FMT(EXPANSIONINTERFACE, "Save moved from {:#x} to {:#x}", old_start, new_start);
           m_saves[i].m_used_blocks.clear();
           m_saves[i].m_save_data.clear();
+          m_saves[i].m_dirty_blocks.clear();
         }
         if (m_saves[i].m_used_blocks.empty())
         {
@@ -495,6 +527,7 @@ inline void GCMemcardDirectory::SyncSaves()
       m_saves[i].m_gci_header.m_gamecode = Memcard::DEntry::UNINITIALIZED_GAMECODE;
       m_saves[i].m_save_data.clear();
       m_saves[i].m_used_blocks.clear();
+      m_saves[i].m_dirty_blocks.clear();
       m_saves[i].m_dirty = true;
     }
   }
@@ -524,12 +557,12 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
         }
 
         if (writing)
-        {
-          m_saves[i].m_dirty = true;
-        }
+          m_saves[i].MarkBlockDirty(idx);
 
         m_last_block = block;
         m_last_block_address = m_saves[i].m_save_data[idx].m_block.data();
+        m_last_save_index = i;
+        m_last_save_block_index = static_cast<u16>(idx);
         return m_last_block;
       }
     }
@@ -592,89 +625,133 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
   return true;
 }
 
+GCMemcardDirectory::GCIFileUpdate GCMemcardDirectory::CreateUpdate(Memcard::GCIFile& save)
+{
+  GCIFileUpdate update;
+  update.filename = save.m_filename;
+  update.header = save.m_gci_header;
+
+  // Only the modified blocks are written, unless the file on disk doesn't match the save anymore.
+  const u64 file_size = u64{Memcard::DENTRY_SIZE} + save.m_save_data.size() * Memcard::BLOCK_SIZE;
+  update.whole_file = File::FileInfo(save.m_filename).GetSize() != file_size;
+  for (u16 i = 0; i < save.m_save_data.size(); ++i)
+  {
+    if (!update.whole_file && (i >= save.m_dirty_blocks.size() || !save.m_dirty_blocks[i]))
+      continue;
+
+    if (update.block_runs.empty() ||
+        update.block_runs.back().first + update.block_runs.back().second.size() != i)
+    {
+      update.block_runs.emplace_back(i, std::vector<Memcard::GCMBlock>());
+    }
+    update.block_runs.back().second.push_back(save.m_save_data[i]);
+  }
+  save.m_dirty_blocks.clear();
+  return update;
+}
+
 void GCMemcardDirectory::FlushToFile()
 {
-  std::unique_lock l(m_write_mutex);
-  int errors = 0;
-  Memcard::DEntry invalid;
-  for (Memcard::GCIFile& save : m_saves)
+  // The changes are collected while holding the write mutex, but written to disk without it, so
+  // that the emulated game doesn't have to wait for the disk when it writes to the card.
+  std::vector<GCIFileUpdate> updates;
   {
-    if (save.m_dirty)
+    std::unique_lock l(m_write_mutex);
+    for (u16 i = 0; i < m_saves.size(); ++i)
     {
-      if (save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
+      Memcard::GCIFile& save = m_saves[i];
+      if (save.m_dirty)
       {
-        save.m_dirty = false;
-        if (save.m_save_data.empty())
+        if (save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
         {
-          // The save's header has been changed but the actual save blocks haven't been read/written
-          // to
-          // skip flushing this file until actual save data is modified
-          ERROR_LOG_FMT(EXPANSIONINTERFACE,
-                        "GCI header modified without corresponding save data changes");
-          continue;
-        }
-        if (save.m_filename.empty())
-        {
-          std::string default_save_name = m_save_directory + save.m_gci_header.GCI_FileName();
-
-          // Check to see if another file is using the same name
-          // This seems unlikely except in the case of file corruption
-          // otherwise what user would name another file this way?
-          for (int j = 0; File::Exists(default_save_name) && j < 10; ++j)
+          save.m_dirty = false;
+          if (save.m_save_data.empty())
           {
-            default_save_name.insert(default_save_name.end() - 4, '0');
+            // The save's header has been changed but the actual save blocks haven't been
+            // read/written to
+            // skip flushing this file until actual save data is modified
+            ERROR_LOG_FMT(EXPANSIONINTERFACE,
+                          "GCI header modified without corresponding save data changes");
+            continue;
           }
-          if (File::Exists(default_save_name))
+          if (save.m_filename.empty())
           {
-            PanicAlertFmtT("Failed to find new filename.\n{0}\n will be overwritten",
-                           default_save_name);
+            std::string default_save_name = m_save_directory + save.m_gci_header.GCI_FileName();
+
+            // Check to see if another file is using the same name
+            // This seems unlikely except in the case of file corruption
+            // otherwise what user would name another file this way?
+            for (int j = 0; File::Exists(default_save_name) && j < 10; ++j)
+            {
+              default_save_name.insert(default_save_name.end() - 4, '0');
+            }
+            if (File::Exists(default_save_name))
+            {
+              PanicAlertFmtT("Failed to find new filename.\n{0}\n will be overwritten",
+                             default_save_name);
+            }
+            save.m_filename = default_save_name;
           }
-          save.m_filename = default_save_name;
+          updates.push_back(CreateUpdate(save));
         }
-        File::IOFile gci(save.m_filename, "wb");
-        if (gci)
+        else if (save.m_filename.length() != 0)
         {
-          gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
-          for (const Memcard::GCMBlock& block : save.m_save_data)
-            gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
-
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage(fmt::format("Wrote save contents to {}", save.m_filename), 4000);
-          }
-          else
-          {
-            ++errors;
-            Core::DisplayMessage(
-                fmt::format("Failed to write save contents to {}", save.m_filename), 4000);
-            ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", save.m_filename);
-          }
+          save.m_dirty = false;
+          std::string& old_name = save.m_filename;
+          std::string deleted_name = old_name + ".deleted";
+          if (File::Exists(deleted_name))
+            File::Delete(deleted_name);
+          File::Rename(old_name, deleted_name);
+          save.m_filename.clear();
+          save.m_save_data.clear();
+          save.m_used_blocks.clear();
+          save.m_dirty_blocks.clear();
         }
       }
-      else if (save.m_filename.length() != 0)
+
+      // Unload the save data for any game that is not running
+      // we could use !m_dirty, but some games have multiple gci files and may not write to them
+      // simultaneously
+      // this ensures that the save data for all of the current games gci files are stored in the
+      // savestate
+      const u32 gamecode = Common::swap32(save.m_gci_header.m_gamecode.data());
+      if (gamecode != m_game_id && gamecode != 0xFFFFFFFF && !save.m_save_data.empty())
       {
-        save.m_dirty = false;
-        std::string& old_name = save.m_filename;
-        std::string deleted_name = old_name + ".deleted";
-        if (File::Exists(deleted_name))
-          File::Delete(deleted_name);
-        File::Rename(old_name, deleted_name);
-        save.m_filename.clear();
+        INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushing savedata to disk for {}", save.m_filename);
         save.m_save_data.clear();
-        save.m_used_blocks.clear();
+        save.m_dirty_blocks.clear();
+        if (m_last_block >= static_cast<s32>(Memcard::MC_FST_BLOCKS) && m_last_save_index == i)
+          m_last_block = -1;
       }
     }
+  }
 
-    // Unload the save data for any game that is not running
-    // we could use !m_dirty, but some games have multiple gci files and may not write to them
-    // simultaneously
-    // this ensures that the save data for all of the current games gci files are stored in the
-    // savestate
-    const u32 gamecode = Common::swap32(save.m_gci_header.m_gamecode.data());
-    if (gamecode != m_game_id && gamecode != 0xFFFFFFFF && !save.m_save_data.empty())
+  for (const GCIFileUpdate& update : updates)
+  {
+    File::IOFile gci(update.filename, update.whole_file ? "wb" : "r+b");
+    if (!gci)
+      continue;
+
+    gci.WriteBytes(&update.header, Memcard::DENTRY_SIZE);
+    u64 bytes_written = Memcard::DENTRY_SIZE;
+    for (const auto& [first_block, blocks] : update.block_runs)
+    {
+      gci.Seek(Memcard::DENTRY_SIZE + u64{first_block} * Memcard::BLOCK_SIZE,
+               File::SeekOrigin::Begin);
+      gci.WriteBytes(blocks.data(), blocks.size() * Memcard::BLOCK_SIZE);
+      bytes_written += blocks.size() * Memcard::BLOCK_SIZE;
+    }
+
+    if (gci.IsGood())
+    {
+      INFO_LOG_FMT(EXPANSIONINTERFACE, "Wrote {} bytes to {}", bytes_written, update.filename);
+      Core::DisplayMessage(fmt::format("Wrote save contents to {}", update.filename), 4000);
+    }
+    else
     {
-      INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushing savedata to disk for {}", save.m_filename);
-      save.m_save_data.clear();
+      Core::DisplayMessage(fmt::format("Failed to write save contents to {}", update.filename),
+                           4000);
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", update.filename);
     }
   }
 #if _WRITE_MC_HEADER
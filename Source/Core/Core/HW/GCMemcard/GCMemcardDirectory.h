@@ -6,6 +6,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "Common/Event.h"
@@ -42,7 +43,18 @@ public:
   void DoState(PointerWrap& p) override;
 
 private:
+  // A save file write, which is prepared while holding the write mutex but done without it.
+  struct GCIFileUpdate
+  {
+    std::string filename;
+    Memcard::DEntry header;
+    bool whole_file = false;
+    // Runs of consecutive blocks to write, as the index of the first block and the block data.
+    std::vector<std::pair<u16, std::vector<Memcard::GCMBlock>>> block_runs;
+  };
+
   bool LoadGCI(Memcard::GCIFile gci);
+  static GCIFileUpdate CreateUpdate(Memcard::GCIFile& save);
   inline s32 SaveAreaRW(u32 block, bool writing = false);
   // s32 DirectoryRead(u32 offset, u32 length, u8* dest_address);
   s32 DirectoryWrite(u32 dest_address, u32 length, const u8* src_address);
@@ -52,6 +64,9 @@ private:
   u32 m_game_id;
   s32 m_last_block;
   u8* m_last_block_address;
+  // The save and the index in its save data of m_last_block, if it is in the save area.
+  u16 m_last_save_index = 0;
+  u16 m_last_save_block_index = 0;
 
   Memcard::Header m_hdr;
   Memcard::Directory m_dir1;
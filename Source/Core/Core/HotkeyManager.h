@@ -163,6 +163,7 @@ enum Hotkey
   HK_UNDO_SAVE_STATE,
   HK_SAVE_STATE_FILE,
   HK_LOAD_STATE_FILE,
+  HK_REWIND,
 
   HK_GBA_LOAD,
   HK_GBA_UNLOAD,
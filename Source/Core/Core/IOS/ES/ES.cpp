@@ -485,6 +485,9 @@ void ESDevice::DoState(PointerWrap& p)
     context.DoState(p);
 
   p.Do(m_pending_ppc_boot_content_path);
+
+  if (p.IsReadMode())
+    InvalidateMetadataCache();
 }
 
 ESDevice::ContextArray::iterator ESDevice::FindActiveContext(s32 fd)
@@ -799,7 +802,9 @@ ReturnCode ESDevice::DIVerify(const ES::TMDReader& tmd, const ES::TicketReader&
   const auto fs = m_ios.GetFS();
   if (!FindInstalledTMD(tmd.GetTitleId()).IsValid())
   {
-    if (const ReturnCode ret = WriteTmdForDiVerify(fs.get(), tmd))
+    const ReturnCode ret = WriteTmdForDiVerify(fs.get(), tmd);
+    InvalidateMetadataCache();
+    if (ret != IPC_SUCCESS)
     {
       ERROR_LOG_FMT(IOS_ES, "DiVerify failed to write disc TMD to NAND.");
       return ret;
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -100,6 +101,10 @@ public:
   // Get titles for which there is a ticket (in /ticket).
   std::vector<u64> GetTitlesWithTickets() const;
 
+  // Must be called whenever the installed titles, TMDs, tickets or shared contents change,
+  // including when they are changed without going through this ES.
+  void InvalidateMetadataCache() const;
+
   std::vector<ES::Content>
   GetStoredContentsFromTMD(const ES::TMDReader& tmd,
                            CheckContentHashes check_content_hashes = CheckContentHashes::No) const;
@@ -369,6 +374,7 @@ private:
   void FinishInit();
 
   std::string GetContentPath(u64 title_id, const ES::Content& content, Ticks ticks = {}) const;
+  const ES::SharedContentMap& GetSharedContentMap(Ticks ticks = {}) const;
 
   s32 WriteSystemFile(const std::string& path, const std::vector<u8>& data, Ticks ticks = {});
   s32 WriteLaunchFile(const ES::TMDReader& tmd, Ticks ticks = {});
@@ -386,6 +392,24 @@ private:
   using ContentTable = std::array<OpenedContent, 16>;
   ContentTable m_content_table;
 
+  // NAND metadata which is read whenever titles are enumerated or launched. Only ES modifies it,
+  // so it stays valid until ES installs or deletes something (or IOS is reloaded).
+  // The number of ticks the original reads took is kept so that cache hits take the same time.
+  struct CachedTMD
+  {
+    ES::TMDReader tmd;
+    u64 ticks = 0;
+  };
+  struct MetadataCache
+  {
+    std::optional<std::vector<u64>> installed_titles;
+    std::optional<std::vector<u64>> titles_with_tickets;
+    std::map<u64, CachedTMD> tmds;
+    std::map<u64, ES::TicketReader> tickets;
+    std::optional<ES::SharedContentMap> shared_content_map;
+  };
+  mutable MetadataCache m_metadata_cache;
+
   ContextArray m_contexts;
   TitleContext m_title_context{};
   std::string m_pending_ppc_boot_content_path;
@@ -46,13 +46,22 @@ ES::TMDReader ESDevice::FindImportTMD(u64 title_id, Ticks ticks) const
 
 ES::TMDReader ESDevice::FindInstalledTMD(u64 title_id, Ticks ticks) const
 {
-  return FindTMD(*m_ios.GetFSDevice(), Common::GetTMDFileName(title_id), ticks);
+  auto it = m_metadata_cache.tmds.find(title_id);
+  if (it == m_metadata_cache.tmds.end())
+  {
+    u64 read_ticks = 0;
+    ES::TMDReader tmd =
+        FindTMD(*m_ios.GetFSDevice(), Common::GetTMDFileName(title_id), &read_ticks);
+    it = m_metadata_cache.tmds.emplace(title_id, CachedTMD{std::move(tmd), read_ticks}).first;
+  }
+  ticks.Add(it->second.ticks);
+  return it->second.tmd;
 }
 
-ES::TicketReader ESDevice::FindSignedTicket(u64 title_id) const
+static ES::TicketReader ReadSignedTicket(FS::FileSystem* fs, u64 title_id)
 {
   const std::string path = Common::GetTicketFileName(title_id);
-  const auto ticket_file = m_ios.GetFS()->OpenFile(PID_KERNEL, PID_KERNEL, path, FS::Mode::Read);
+  const auto ticket_file = fs->OpenFile(PID_KERNEL, PID_KERNEL, path, FS::Mode::Read);
   if (!ticket_file)
     return {};
 
@@ -63,6 +72,17 @@ ES::TicketReader ESDevice::FindSignedTicket(u64 title_id) const
   return ES::TicketReader{std::move(signed_ticket)};
 }
 
+ES::TicketReader ESDevice::FindSignedTicket(u64 title_id) const
+{
+  auto it = m_metadata_cache.tickets.find(title_id);
+  if (it == m_metadata_cache.tickets.end())
+  {
+    ES::TicketReader ticket = ReadSignedTicket(m_ios.GetFS().get(), title_id);
+    it = m_metadata_cache.tickets.emplace(title_id, std::move(ticket)).first;
+  }
+  return it->second;
+}
+
 static bool IsValidPartOfTitleID(const std::string& string)
 {
   if (string.length() != 8)
@@ -115,7 +135,9 @@ static std::vector<u64> GetTitlesInTitleOrImport(FS::FileSystem* fs, const std::
 
 std::vector<u64> ESDevice::GetInstalledTitles() const
 {
-  return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/title");
+  if (!m_metadata_cache.installed_titles)
+    m_metadata_cache.installed_titles = GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/title");
+  return *m_metadata_cache.installed_titles;
 }
 
 std::vector<u64> ESDevice::GetTitleImports() const
@@ -123,9 +145,8 @@ std::vector<u64> ESDevice::GetTitleImports() const
   return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/import");
 }
 
-std::vector<u64> ESDevice::GetTitlesWithTickets() const
+static std::vector<u64> GetTitlesInTicketDirectory(FS::FileSystem* fs)
 {
-  const auto fs = m_ios.GetFS();
   const auto entries = fs->ReadDirectory(PID_KERNEL, PID_KERNEL, "/ticket");
   if (!entries)
   {
@@ -165,6 +186,13 @@ std::vector<u64> ESDevice::GetTitlesWithTickets() const
   return title_ids;
 }
 
+std::vector<u64> ESDevice::GetTitlesWithTickets() const
+{
+  if (!m_metadata_cache.titles_with_tickets)
+    m_metadata_cache.titles_with_tickets = GetTitlesInTicketDirectory(m_ios.GetFS().get());
+  return *m_metadata_cache.titles_with_tickets;
+}
+
 std::vector<ES::Content>
 ESDevice::GetStoredContentsFromTMD(const ES::TMDReader& tmd,
                                    CheckContentHashes check_content_hashes) const
@@ -217,8 +245,7 @@ u32 ESDevice::GetSharedContentsCount() const
 
 std::vector<std::array<u8, 20>> ESDevice::GetSharedContents() const
 {
-  const ES::SharedContentMap map{m_ios.GetFSDevice()};
-  return map.GetHashes();
+  return GetSharedContentMap().GetHashes();
 }
 
 static bool DeleteDirectoriesIfEmpty(FS::FileSystem* fs, const std::string& path)
@@ -245,6 +272,7 @@ constexpr FS::Modes data_dir_modes{FS::Mode::ReadWrite, FS::Mode::None, FS::Mode
 bool ESDevice::CreateTitleDirectories(u64 title_id, u16 group_id) const
 {
   const auto fs = m_ios.GetFS();
+  InvalidateMetadataCache();
 
   const std::string content_dir = Common::GetTitleContentPath(title_id);
   const auto result1 =
@@ -306,6 +334,7 @@ bool ESDevice::InitImport(const ES::TMDReader& tmd)
     ERROR_LOG_FMT(IOS_ES, "InitImport: Failed to move content dir for {:016x}", tmd.GetTitleId());
     return false;
   }
+  InvalidateMetadataCache();
   DeleteDirectoriesIfEmpty(m_ios.GetFS().get(), import_content_dir);
   return true;
 }
@@ -334,8 +363,9 @@ bool ESDevice::FinishImport(const ES::TMDReader& tmd)
   }
 
   const std::string content_dir = Common::GetTitleContentPath(title_id);
-  if (fs->Rename(PID_KERNEL, PID_KERNEL, import_content_dir, content_dir) !=
-      FS::ResultCode::Success)
+  const auto rename_result = fs->Rename(PID_KERNEL, PID_KERNEL, import_content_dir, content_dir);
+  InvalidateMetadataCache();
+  if (rename_result != FS::ResultCode::Success)
   {
     ERROR_LOG_FMT(IOS_ES, "FinishImport: Failed to rename import directory to {}", content_dir);
     return false;
@@ -367,6 +397,7 @@ void ESDevice::FinishStaleImport(u64 title_id)
     fs->Delete(PID_KERNEL, PID_KERNEL, Common::GetImportTitlePath(title_id) + "/content");
     DeleteDirectoriesIfEmpty(fs.get(), Common::GetImportTitlePath(title_id));
     DeleteDirectoriesIfEmpty(fs.get(), Common::GetTitlePath(title_id));
+    InvalidateMetadataCache();
   }
   else
   {
@@ -385,14 +416,27 @@ std::string ESDevice::GetContentPath(const u64 title_id, const ES::Content& cont
                                      Ticks ticks) const
 {
   if (content.IsShared())
-  {
-    ES::SharedContentMap content_map{m_ios.GetFSDevice()};
-    ticks.Add(content_map.GetTicks());
-    return content_map.GetFilenameFromSHA1(content.sha1).value_or("");
-  }
+    return GetSharedContentMap(ticks).GetFilenameFromSHA1(content.sha1).value_or("");
   return fmt::format("{}/{:08x}.app", Common::GetTitleContentPath(title_id), content.id);
 }
 
+const ES::SharedContentMap& ESDevice::GetSharedContentMap(Ticks ticks) const
+{
+  if (!m_metadata_cache.shared_content_map)
+    m_metadata_cache.shared_content_map.emplace(m_ios.GetFSDevice());
+  ticks.Add(m_metadata_cache.shared_content_map->GetTicks());
+  return *m_metadata_cache.shared_content_map;
+}
+
+void ESDevice::InvalidateMetadataCache() const
+{
+  m_metadata_cache.installed_titles.reset();
+  m_metadata_cache.titles_with_tickets.reset();
+  m_metadata_cache.tmds.clear();
+  m_metadata_cache.tickets.clear();
+  m_metadata_cache.shared_content_map.reset();
+}
+
 s32 ESDevice::WriteSystemFile(const std::string& path, const std::vector<u8>& data, Ticks ticks)
 {
   auto& fs = *m_ios.GetFSDevice();
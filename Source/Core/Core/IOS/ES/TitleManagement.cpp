@@ -84,6 +84,7 @@ ReturnCode ESDevice::ImportTicket(const std::vector<u8>& ticket_bytes,
   }
 
   const ReturnCode write_ret = WriteTicket(m_ios.GetFS().get(), ticket);
+  InvalidateMetadataCache();
   if (write_ret != IPC_SUCCESS)
     return write_ret;
 
@@ -394,6 +395,7 @@ ReturnCode ESDevice::ImportContentEnd(Context& context, u32 content_fd)
   {
     ES::SharedContentMap shared_content{m_ios.GetFSDevice()};
     content_path = shared_content.AddSharedContent(content_info.sha1);
+    InvalidateMetadataCache();
   }
   else
   {
@@ -535,7 +537,9 @@ ReturnCode ESDevice::DeleteTitle(u64 title_id)
     return ES_EINVAL;
 
   const std::string title_dir = Common::GetTitlePath(title_id);
-  return FS::ConvertResult(m_ios.GetFS()->Delete(PID_KERNEL, PID_KERNEL, title_dir));
+  const auto result = m_ios.GetFS()->Delete(PID_KERNEL, PID_KERNEL, title_dir);
+  InvalidateMetadataCache();
+  return FS::ConvertResult(result);
 }
 
 IPCReply ESDevice::DeleteTitle(const IOCtlVRequest& request)
@@ -561,6 +565,7 @@ ReturnCode ESDevice::DeleteTicket(const u8* ticket_view)
 
   const u64 ticket_id = Common::swap64(ticket_view + offsetof(ES::TicketView, ticket_id));
   ticket.DeleteTicket(ticket_id);
+  InvalidateMetadataCache();
 
   const std::vector<u8>& new_ticket = ticket.GetBytes();
   const std::string ticket_path = Common::GetTicketFileName(title_id);
@@ -612,6 +617,7 @@ ReturnCode ESDevice::DeleteTitleContent(u64 title_id) const
     if (file_name.size() == 12 && file_name.compare(8, 4, ".app") == 0)
       m_ios.GetFS()->Delete(PID_KERNEL, PID_KERNEL, content_dir + '/' + file_name);
   }
+  InvalidateMetadataCache();
 
   return IPC_SUCCESS;
 }
@@ -638,7 +644,9 @@ ReturnCode ESDevice::DeleteContent(u64 title_id, u32 content_id) const
 
   const std::string path =
       fmt::format("{}/{:08x}.app", Common::GetTitleContentPath(title_id), content_id);
-  return FS::ConvertResult(m_ios.GetFS()->Delete(PID_KERNEL, PID_KERNEL, path));
+  const auto result = m_ios.GetFS()->Delete(PID_KERNEL, PID_KERNEL, path);
+  InvalidateMetadataCache();
+  return FS::ConvertResult(result);
 }
 
 IPCReply ESDevice::DeleteContent(const IOCtlVRequest& request)
@@ -845,7 +853,9 @@ ReturnCode ESDevice::DeleteSharedContent(const std::array<u8, 20>& sha1) const
   if (delete_result != FS::ResultCode::Success)
     return FS::ConvertResult(delete_result);
 
-  if (!map.DeleteSharedContent(sha1))
+  const bool map_updated = map.DeleteSharedContent(sha1);
+  InvalidateMetadataCache();
+  if (!map_updated)
     return ES_EIO;
 
   return IPC_SUCCESS;
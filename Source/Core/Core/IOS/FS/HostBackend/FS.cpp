@@ -14,6 +14,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
@@ -88,6 +89,38 @@ struct SerializedFstEntry
 static_assert(std::is_standard_layout<SerializedFstEntry>());
 static_assert(sizeof(SerializedFstEntry) == 0x20);
 
+constexpr u32 FST_JOURNAL_MAGIC = 0x4653544A;  // FSTJ
+constexpr u32 FST_JOURNAL_VERSION = 1;
+/// The journal is merged into the FST file once it is larger than both this and the FST file.
+constexpr u64 FST_JOURNAL_COMPACTION_SIZE = 0x40000;
+
+struct SerializedFstJournalHeader
+{
+  Common::BigEndianValue<u32> magic{};
+  Common::BigEndianValue<u32> version{};
+  /// Size of the FST file that the journal applies to
+  Common::BigEndianValue<u32> fst_size{};
+  /// CRC32 of the FST file that the journal applies to
+  Common::BigEndianValue<u32> fst_crc32{};
+};
+static_assert(std::is_standard_layout<SerializedFstJournalHeader>());
+static_assert(sizeof(SerializedFstJournalHeader) == 0x10);
+
+/// A journal record, which is followed by the path and the new path.
+struct SerializedFstJournalRecord
+{
+  u8 op = 0;
+  u8 padding = 0;
+  Common::BigEndianValue<u16> path_length{};
+  /// Only used for renames
+  Common::BigEndianValue<u16> new_path_length{};
+  Common::BigEndianValue<u16> padding2{};
+  /// Entry name and metadata. Only used for creations and metadata changes
+  SerializedFstEntry entry{};
+};
+static_assert(std::is_standard_layout<SerializedFstJournalRecord>());
+static_assert(sizeof(SerializedFstJournalRecord) == 0x28);
+
 template <typename T>
 auto GetMetadataFields(T& obj)
 {
@@ -96,7 +129,7 @@ auto GetMetadataFields(T& obj)
 
 auto GetNamePredicate(const std::string& name)
 {
-  return [&name](const auto& entry) { return entry.name == name; };
+  return [&name](const auto& entry) { return entry->name == name; };
 }
 }  // namespace
 
@@ -124,15 +157,30 @@ HostFileSystem::HostFileSystem(const std::string& root_path,
   LoadFst();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  INFO_LOG_FMT(IOS_FS, "{} reads and {} writes needed {} host reads and {} host writes",
+               m_io_stats.read_requests, m_io_stats.write_requests, m_io_stats.host_reads,
+               m_io_stats.host_writes);
+
+  // Merge the journal so that the FST file is complete on its own.
+  if (m_fst_journal.IsOpen())
+    CompactFst();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
   return fmt::format("{}/fst.bin", m_root_path);
 }
 
+std::string HostFileSystem::GetFstJournalFilePath() const
+{
+  return fmt::format("{}/fst.journal", m_root_path);
+}
+
 void HostFileSystem::ResetFst()
 {
+  m_fst_index.clear();
   m_root_entry = {};
   m_root_entry.name = "/";
   // Mode 0x16 (Directory | Owner_None | Group_Read | Other_Read) in the FS sysmodule
@@ -142,42 +190,184 @@ void HostFileSystem::ResetFst()
 void HostFileSystem::LoadFst()
 {
   File::IOFile file{GetFstFilePath(), "rb"};
+  std::vector<SerializedFstEntry> entries(file.GetSize() / sizeof(SerializedFstEntry));
+  bool loaded = true;
   // Existing filesystems will not have a FST. This is not a problem,
   // as the rest of HostFileSystem will use sane defaults.
-  if (!file)
+  if (file && !entries.empty())
+  {
+    if (!file.ReadArray(entries.data(), entries.size()))
+    {
+      ERROR_LOG_FMT(IOS_FS, "Failed to read FST");
+      loaded = false;
+    }
+    else
+    {
+      size_t next_entry = 0;
+      const auto parse_entry = [&entries, &next_entry](const auto& parse,
+                                                       size_t depth) -> std::unique_ptr<FstEntry> {
+        if (depth > MaxPathDepth || next_entry == entries.size())
+          return nullptr;
+
+        const SerializedFstEntry& entry = entries[next_entry++];
+        auto result = std::make_unique<FstEntry>();
+        result->name = entry.GetName();
+        GetMetadataFields(result->data) = GetMetadataFields(entry);
+        for (size_t i = 0; i < entry.num_children; ++i)
+        {
+          auto child = parse(parse, depth + 1);
+          if (!child)
+            return nullptr;
+          result->children.push_back(std::move(child));
+        }
+        return result;
+      };
+
+      const auto root_entry = parse_entry(parse_entry, 0);
+      if (root_entry)
+      {
+        m_root_entry = std::move(*root_entry);
+      }
+      else
+      {
+        ERROR_LOG_FMT(IOS_FS, "Failed to parse FST: at least one of the entries was invalid");
+        loaded = false;
+      }
+    }
+  }
+
+  m_fst_size = u32(entries.size() * sizeof(SerializedFstEntry));
+  m_fst_crc32 = Common::ComputeCRC32(reinterpret_cast<const u8*>(entries.data()), m_fst_size);
+  // Even if the FST couldn't be loaded, the changes in the journal are applied to the default
+  // FST, and the journal is kept until it has been merged into a new FST file.
+  ReplayFstJournal(!loaded);
+}
+
+void HostFileSystem::ReplayFstJournal(bool fst_is_invalid)
+{
+  const std::string journal_path = GetFstJournalFilePath();
+  File::IOFile file{journal_path, "rb"};
+  SerializedFstJournalHeader header;
+  if (!file.ReadArray(&header, 1))
+    return;
+  if (header.magic != FST_JOURNAL_MAGIC || header.version != FST_JOURNAL_VERSION)
+  {
+    WARN_LOG_FMT(IOS_FS, "Ignoring invalid FST journal");
     return;
+  }
+  if (fst_is_invalid)
+  {
+    // Keep appending to the journal with the header it was created with.
+    m_fst_size = header.fst_size;
+    m_fst_crc32 = header.fst_crc32;
+  }
+  else if (header.fst_size != m_fst_size || header.fst_crc32 != m_fst_crc32)
+  {
+    // This happens if the journal was merged into the FST file but could not be deleted.
+    WARN_LOG_FMT(IOS_FS, "Ignoring FST journal which does not match the FST");
+    return;
+  }
 
-  const auto parse_entry = [&file](const auto& parse, size_t depth) -> std::optional<FstEntry> {
-    if (depth > MaxPathDepth)
-      return std::nullopt;
+  u64 journal_size = sizeof(header);
+  u32 num_records = 0;
+  SerializedFstJournalRecord record;
+  while (file.ReadArray(&record, 1))
+  {
+    std::string path(record.path_length, '\0');
+    std::string new_path(record.new_path_length, '\0');
+    // A record which was only partially written is dropped.
+    if (!file.ReadBytes(path.data(), path.size()) ||
+        !file.ReadBytes(new_path.data(), new_path.size()))
+    {
+      break;
+    }
 
-    SerializedFstEntry entry;
-    if (!file.ReadArray(&entry, 1))
-      return std::nullopt;
+    const auto op = static_cast<FstJournalOp>(record.op);
+    if (!IsValidPath(path) || (op == FstJournalOp::Rename && !IsValidNonRootPath(new_path)))
+    {
+      ERROR_LOG_FMT(IOS_FS, "Invalid path in FST journal: {}", path);
+      break;
+    }
 
-    FstEntry result;
-    result.name = entry.GetName();
-    GetMetadataFields(result.data) = GetMetadataFields(entry);
-    for (size_t i = 0; i < entry.num_children; ++i)
+    const auto split_path = SplitPathAndBasename(path);
+    if (op == FstJournalOp::Create)
     {
-      const auto maybe_child = parse(parse, depth + 1);
-      if (!maybe_child.has_value())
-        return std::nullopt;
-      result.children.push_back(*maybe_child);
+      FstEntry* entry = GetOrCreateFstEntry(&m_root_entry, path, false);
+      *entry = {};
+      entry->name = split_path.file_name;
+      GetMetadataFields(entry->data) = GetMetadataFields(record.entry);
     }
-    return result;
-  };
+    else if (op == FstJournalOp::SetMetadata)
+    {
+      FstEntry* entry = GetOrCreateFstEntry(&m_root_entry, path, false);
+      GetMetadataFields(entry->data) = GetMetadataFields(record.entry);
+      if (entry->data.is_file)
+        entry->children.clear();
+    }
+    else if (op == FstJournalOp::Delete)
+    {
+      FstEntry* parent = GetOrCreateFstEntry(&m_root_entry, split_path.parent, false);
+      const auto it = std::find_if(parent->children.begin(), parent->children.end(),
+                                   GetNamePredicate(split_path.file_name));
+      if (it != parent->children.end())
+        parent->children.erase(it);
+    }
+    else if (op == FstJournalOp::Rename)
+    {
+      FstEntry* new_entry = GetOrCreateFstEntry(&m_root_entry, new_path, false);
+      new_entry->name = SplitPathAndBasename(new_path).file_name;
+      FstEntry* old_parent = GetOrCreateFstEntry(&m_root_entry, split_path.parent, false);
+      const auto it = std::find_if(old_parent->children.begin(), old_parent->children.end(),
+                                   GetNamePredicate(split_path.file_name));
+      if (it != old_parent->children.end() && it->get() != new_entry)
+      {
+        new_entry->data = (*it)->data;
+        new_entry->children = std::move((*it)->children);
+        old_parent->children.erase(it);
+      }
+    }
+    else
+    {
+      ERROR_LOG_FMT(IOS_FS, "Invalid FST journal record type {}", record.op);
+      break;
+    }
+
+    journal_size += sizeof(record) + path.size() + new_path.size();
+    ++num_records;
+  }
+  file.Close();
+  INFO_LOG_FMT(IOS_FS, "Replayed {} FST changes from the journal", num_records);
 
-  const auto root_entry = parse_entry(parse_entry, 0);
-  if (!root_entry.has_value())
+  // Keep appending to the journal, after dropping anything that could not be replayed.
+  if (m_fst_journal.Open(journal_path, "r+b") && m_fst_journal.Resize(journal_size) &&
+      m_fst_journal.Seek(0, File::SeekOrigin::End))
   {
-    ERROR_LOG_FMT(IOS_FS, "Failed to parse FST: at least one of the entries was invalid");
-    return;
+    m_fst_journal_size = journal_size;
+  }
+  else
+  {
+    CompactFst();
   }
-  m_root_entry = *root_entry;
 }
 
 void HostFileSystem::SaveFst()
+{
+  // Nothing was logged.
+  if (!m_fst_journal.IsOpen())
+    return;
+
+  if (!m_fst_journal.Flush())
+  {
+    ERROR_LOG_FMT(IOS_FS, "Failed to write to the FST journal; writing the whole FST instead");
+    CompactFst();
+  }
+  else if (m_fst_journal_size > std::max<u64>(FST_JOURNAL_COMPACTION_SIZE, m_fst_size))
+  {
+    CompactFst();
+  }
+}
+
+void HostFileSystem::CompactFst()
 {
   std::vector<SerializedFstEntry> to_write;
   auto collect_entries = [&to_write](const auto& collect, const FstEntry& entry) -> void {
@@ -185,8 +375,8 @@ void HostFileSystem::SaveFst()
     serialized.SetName(entry.name);
     GetMetadataFields(serialized) = GetMetadataFields(entry.data);
     serialized.num_children = u32(entry.children.size());
-    for (const FstEntry& child : entry.children)
-      collect(collect, child);
+    for (const auto& child : entry.children)
+      collect(collect, *child);
   };
   collect_entries(collect_entries, m_root_entry);
 
@@ -202,7 +392,65 @@ void HostFileSystem::SaveFst()
     }
   }
   if (!File::Rename(temp_path, dest_path))
+  {
     PanicAlertFmt("IOS_FS: Failed to rename temporary FST file");
+    return;
+  }
+
+  m_fst_size = u32(to_write.size() * sizeof(SerializedFstEntry));
+  m_fst_crc32 = Common::ComputeCRC32(reinterpret_cast<const u8*>(to_write.data()), m_fst_size);
+
+  // Everything in the journal is now part of the FST file.
+  m_fst_journal.Close();
+  m_fst_journal_size = 0;
+  File::Delete(GetFstJournalFilePath(), File::IfAbsentBehavior::NoConsoleWarning);
+}
+
+void HostFileSystem::LogFstChange(FstJournalOp op, const std::string& path, const FstEntry* entry,
+                                  const std::string& new_path)
+{
+  // Only the NAND FST is saved.
+  if (BuildFilename(path).is_redirect)
+    return;
+
+  if (!m_fst_journal.IsOpen())
+  {
+    SerializedFstJournalHeader header;
+    header.magic = FST_JOURNAL_MAGIC;
+    header.version = FST_JOURNAL_VERSION;
+    header.fst_size = m_fst_size;
+    header.fst_crc32 = m_fst_crc32;
+    if (!m_fst_journal.Open(GetFstJournalFilePath(), "wb") || !m_fst_journal.WriteArray(&header, 1))
+    {
+      ERROR_LOG_FMT(IOS_FS, "Failed to create the FST journal; writing the whole FST instead");
+      m_fst_journal.Close();
+      CompactFst();
+      return;
+    }
+    m_fst_journal_size = sizeof(header);
+  }
+
+  SerializedFstJournalRecord record;
+  record.op = static_cast<u8>(op);
+  record.path_length = u16(path.size());
+  record.new_path_length = u16(new_path.size());
+  if (entry)
+  {
+    record.entry.SetName(entry->name);
+    GetMetadataFields(record.entry) = GetMetadataFields(entry->data);
+  }
+  // Write errors are handled when the journal is flushed by SaveFst.
+  m_fst_journal.WriteArray(&record, 1);
+  m_fst_journal.WriteString(path);
+  m_fst_journal.WriteString(new_path);
+  m_fst_journal_size += sizeof(record) + path.size() + new_path.size();
+}
+
+void HostFileSystem::LogFstSubtree(const std::string& path, const FstEntry& entry)
+{
+  LogFstChange(FstJournalOp::Create, path, &entry);
+  for (const auto& child : entry.children)
+    LogFstSubtree(path + '/' + child->name, *child);
 }
 
 HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string& path)
@@ -218,7 +466,47 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
   if (!host_file_info.Exists())
     return nullptr;
 
-  FstEntry* entry = host_file.is_redirect ? &m_redirect_fst : &m_root_entry;
+  bool changed = false;
+  FstEntry* entry;
+  if (const auto it = m_fst_index.find(path); it != m_fst_index.end())
+  {
+    entry = it->second;
+  }
+  else
+  {
+    entry = GetOrCreateFstEntry(host_file.is_redirect ? &m_redirect_fst : &m_root_entry, path,
+                                host_file.is_redirect, &changed);
+    m_fst_index.emplace(path, entry);
+  }
+
+  if (entry->data.is_file != host_file_info.IsFile())
+  {
+    entry->data.is_file = host_file_info.IsFile();
+    changed = true;
+  }
+  if (entry->data.is_file && !entry->children.empty())
+  {
+    WARN_LOG_FMT(IOS_FS, "{} is a file but also has children; clearing children", path);
+    RemoveChildrenFromFstIndex(path, *entry);
+    entry->children.clear();
+    changed = true;
+  }
+
+  // Fallback entries and fixed up metadata are saved along with the next change.
+  if (changed)
+    LogFstChange(FstJournalOp::SetMetadata, path, entry);
+
+  return entry;
+}
+
+HostFileSystem::FstEntry* HostFileSystem::GetOrCreateFstEntry(FstEntry* root,
+                                                              std::string_view path,
+                                                              bool is_redirect, bool* created)
+{
+  if (path == "/")
+    return root;
+
+  FstEntry* entry = root;
   std::string complete_path = "";
   for (const std::string& component : SplitString(std::string(path.substr(1)), '/'))
   {
@@ -227,7 +515,7 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
         std::find_if(entry->children.begin(), entry->children.end(), GetNamePredicate(component));
     if (next != entry->children.end())
     {
-      entry = &*next;
+      entry = next->get();
     }
     else
     {
@@ -235,21 +523,27 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
       // This code path is also reached when creating a new file or directory;
       // proper metadata is filled in later.
       INFO_LOG_FMT(IOS_FS, "Creating a default entry for {} ({})", complete_path,
-                   host_file.is_redirect ? "redirect" : "NAND");
-      entry = &entry->children.emplace_back();
+                   is_redirect ? "redirect" : "NAND");
+      entry = entry->children.emplace_back(std::make_unique<FstEntry>()).get();
       entry->name = component;
       entry->data.modes = {Mode::ReadWrite, Mode::ReadWrite, Mode::ReadWrite};
+      if (created)
+        *created = true;
     }
   }
+  return entry;
+}
 
-  entry->data.is_file = host_file_info.IsFile();
-  if (entry->data.is_file && !entry->children.empty())
-  {
-    WARN_LOG_FMT(IOS_FS, "{} is a file but also has children; clearing children", path);
-    entry->children.clear();
-  }
+void HostFileSystem::RemoveFromFstIndex(const std::string& path, const FstEntry& entry)
+{
+  m_fst_index.erase(path);
+  RemoveChildrenFromFstIndex(path, entry);
+}
 
-  return entry;
+void HostFileSystem::RemoveChildrenFromFstIndex(const std::string& path, const FstEntry& entry)
+{
+  for (const auto& child : entry.children)
+    RemoveFromFstIndex(path + '/' + child->name, *child);
 }
 
 void HostFileSystem::DoState(PointerWrap& p)
@@ -368,7 +662,7 @@ ResultCode HostFileSystem::Format(Uid uid)
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   ResetFst();
-  SaveFst();
+  CompactFst();
   // Reset and close all handles.
   m_handles = {};
   return ResultCode::Success;
@@ -404,6 +698,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   }
 
   FstEntry* child = GetFstEntryForPath(path);
+  RemoveChildrenFromFstIndex(path, *child);
   *child = {};
   child->name = split_path.file_name;
   child->data.is_file = is_file;
@@ -411,6 +706,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.uid = uid;
   child->data.gid = gid;
   child->data.attribute = attr;
+  LogFstChange(FstJournalOp::Create, path, child);
   SaveFst();
   return ResultCode::Success;
 }
@@ -469,7 +765,11 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   const auto it = std::find_if(parent->children.begin(), parent->children.end(),
                                GetNamePredicate(split_path.file_name));
   if (it != parent->children.end())
+  {
+    RemoveFromFstIndex(path, **it);
     parent->children.erase(it);
+  }
+  LogFstChange(FstJournalOp::Delete, path);
   SaveFst();
 
   return ResultCode::Success;
@@ -558,14 +858,24 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   // Finally, remove the child from the old parent and move it to the new parent.
   const auto it = std::find_if(old_parent->children.begin(), old_parent->children.end(),
                                GetNamePredicate(split_old_path.file_name));
-  if (it != old_parent->children.end())
+  if (it != old_parent->children.end() && it->get() != new_entry)
   {
-    new_entry->data = it->data;
-    new_entry->children = it->children;
+    RemoveChildrenFromFstIndex(new_path, *new_entry);
+    RemoveFromFstIndex(old_path, **it);
+    new_entry->data = (*it)->data;
+    new_entry->children = std::move((*it)->children);
 
     old_parent->children.erase(it);
   }
 
+  // The redirect FST is not saved, so moves between it and the NAND are
+  // saved as deletions or creations.
+  if (host_old_info.is_redirect == host_new_info.is_redirect)
+    LogFstChange(FstJournalOp::Rename, old_path, nullptr, new_path);
+  else if (host_new_info.is_redirect)
+    LogFstChange(FstJournalOp::Delete, old_path);
+  else
+    LogFstSubtree(new_path, *new_entry);
   SaveFst();
 
   return ResultCode::Success;
@@ -602,7 +912,7 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid uid, Gid gid,
   std::unordered_map<std::string_view, int> sort_keys;
   sort_keys.reserve(entry->children.size());
   for (size_t i = 0; i < entry->children.size(); ++i)
-    sort_keys.emplace(entry->children[i].name, int(i));
+    sort_keys.emplace(entry->children[i]->name, int(i));
 
   const auto get_key = [&sort_keys](std::string_view key) {
     const auto it = sort_keys.find(key);
@@ -655,7 +965,7 @@ Result<Metadata> HostFileSystem::GetMetadata(Uid uid, Gid gid, const std::string
     return ResultCode::NotFound;
 
   Metadata metadata = entry->data;
-  metadata.size = File::GetSize(BuildFilename(path).host_path);
+  metadata.size = GetHostFileSize(BuildFilename(path).host_path);
   return metadata;
 }
 
@@ -674,7 +984,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   if (caller_uid != 0 && uid != entry->data.uid)
     return ResultCode::AccessDenied;
 
-  const bool is_empty = File::GetSize(BuildFilename(path).host_path) == 0;
+  const bool is_empty = GetHostFileSize(BuildFilename(path).host_path) == 0;
   if (entry->data.uid != uid && entry->data.is_file && !is_empty)
     return ResultCode::FileNotEmpty;
 
@@ -682,6 +992,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   entry->data.uid = uid;
   entry->data.attribute = attr;
   entry->data.modes = modes;
+  LogFstChange(FstJournalOp::SetMetadata, path, entry);
   SaveFst();
 
   return ResultCode::Success;
@@ -713,6 +1024,13 @@ Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_
   std::string path(BuildFilename(wii_path).host_path);
   if (File::IsDirectory(path))
   {
+    // The sizes come from the host, so cached data has to be written back first.
+    for (const auto& [host_path, open_file] : m_open_files)
+    {
+      if (const std::shared_ptr<CachedFile> file = open_file.lock())
+        file->Flush();
+    }
+
     File::FSTEntry parent_dir = File::ScanDirectoryTree(path, true);
     // add one for the folder itself
     stats.used_inodes = 1 + (u32)parent_dir.size;
@@ -731,5 +1049,6 @@ Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_
 void HostFileSystem::SetNandRedirects(std::vector<NandRedirect> nand_redirects)
 {
   m_nand_redirects = std::move(nand_redirects);
+  m_fst_index.clear();
 }
 }  // namespace IOS::HLE::FS
@@ -7,6 +7,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -58,6 +60,16 @@ public:
 
   void SetNandRedirects(std::vector<NandRedirect> nand_redirects) override;
 
+  struct IOStats
+  {
+    u64 read_requests = 0;
+    u64 write_requests = 0;
+    /// Reads and writes which had to go to the host file
+    u64 host_reads = 0;
+    u64 host_writes = 0;
+  };
+  const IOStats& GetIOStats() const { return m_io_stats; }
+
 private:
   struct FstEntry
   {
@@ -70,7 +82,31 @@ private:
     /// We use a vector rather than a list here because iterating over children
     /// happens a lot more often than removals.
     /// Newly created entries are added at the end.
-    std::vector<FstEntry> children;
+    /// Entries are heap allocated so that m_fst_index can point to them.
+    std::vector<std::unique_ptr<FstEntry>> children;
+  };
+
+  /// A host file, which is shared by all handles to it so that accesses are strongly ordered.
+  ///
+  /// Games tend to access their files with many small reads and writes, so accesses go through
+  /// a cache of a part of the file, which is filled with read-ahead data and written back when
+  /// another part of the file is accessed or the last handle to the file is closed.
+  struct CachedFile
+  {
+    Result<u32> Read(u32 offset, u8* ptr, u32 count);
+    bool Write(u32 offset, const u8* ptr, u32 count);
+    bool Flush();
+
+    File::IOFile file;
+    /// File size, including data which has not been written back yet
+    u32 size = 0;
+    std::vector<u8> cache;
+    /// Offset of the cached data in the file
+    u32 cache_offset = 0;
+    /// Range of the cache which needs to be written back
+    u32 dirty_begin = 0;
+    u32 dirty_end = 0;
+    IOStats* stats = nullptr;
   };
 
   struct Handle
@@ -78,7 +114,7 @@ private:
     bool opened = false;
     Mode mode = Mode::None;
     std::string wii_path;
-    std::shared_ptr<File::IOFile> host_file;
+    std::shared_ptr<CachedFile> host_file;
     u32 file_offset = 0;
   };
   Handle* AssignFreeHandle();
@@ -91,21 +127,52 @@ private:
     bool is_redirect;
   };
   HostFilename BuildFilename(const std::string& wii_path) const;
-  std::shared_ptr<File::IOFile> OpenHostFile(const std::string& host_path);
+  std::shared_ptr<CachedFile> OpenHostFile(const std::string& host_path);
+  /// Get the size of a host file, taking data which has not been written back into account.
+  u64 GetHostFileSize(const std::string& host_path) const;
 
   ResultCode CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
                                    FileAttribute attribute, Modes modes, bool is_file);
   bool IsFileOpened(const std::string& path) const;
   bool IsDirectoryInUse(const std::string& path) const;
 
+  /// Changes to the FST which are appended to the FST journal.
+  enum class FstJournalOp : u8
+  {
+    /// Replace the entry and drop its children.
+    Create = 1,
+    /// Update the metadata of the entry, and drop its children if it is a file.
+    SetMetadata = 2,
+    Delete = 3,
+    /// Move the entry to a new path, replacing the entry at the new path.
+    Rename = 4,
+  };
+
   std::string GetFstFilePath() const;
+  std::string GetFstJournalFilePath() const;
   void ResetFst();
   void LoadFst();
+  /// Apply the changes in the FST journal to the FST. If the FST file couldn't be loaded,
+  /// the journal is applied even though it doesn't match the (default) FST.
+  void ReplayFstJournal(bool fst_is_invalid);
+  /// Write the changes that were logged since the last call to the FST journal,
+  /// compacting it if it has grown too large.
   void SaveFst();
+  /// Write the whole FST and discard the journal.
+  void CompactFst();
+  void LogFstChange(FstJournalOp op, const std::string& path, const FstEntry* entry = nullptr,
+                    const std::string& new_path = {});
+  void LogFstSubtree(const std::string& path, const FstEntry& entry);
   /// Get the FST entry for a file (or directory).
   /// Automatically creates fallback entries for parents if they do not exist.
   /// Returns nullptr if the path is invalid or the file does not exist.
   FstEntry* GetFstEntryForPath(const std::string& path);
+  /// Walk the FST from <root> without checking the host filesystem,
+  /// creating fallback entries for any missing components.
+  FstEntry* GetOrCreateFstEntry(FstEntry* root, std::string_view path, bool is_redirect,
+                                bool* created = nullptr);
+  void RemoveFromFstIndex(const std::string& path, const FstEntry& entry);
+  void RemoveChildrenFromFstIndex(const std::string& path, const FstEntry& entry);
 
   /// FST entry for the filesystem root.
   ///
@@ -116,8 +183,21 @@ private:
   /// and we do not want FS to break if the user adds or removes files in their
   /// filesystem root manually.
   FstEntry m_root_entry{};
+  /// Entries of both FSTs by Wii path, filled in as paths are looked up.
+  std::unordered_map<std::string, FstEntry*> m_fst_index;
+
+  /// Rather than rewriting the whole FST file for every change, changes are appended to
+  /// a journal, which is merged into the FST file when it becomes too large
+  /// and when the filesystem is destroyed.
+  File::IOFile m_fst_journal;
+  u64 m_fst_journal_size = 0;
+  /// Size and CRC32 of the FST file, which the journal must match to be replayed.
+  u32 m_fst_size = 0;
+  u32 m_fst_crc32 = 0;
+
   std::string m_root_path;
-  std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
+  std::map<std::string, std::weak_ptr<CachedFile>> m_open_files;
+  IOStats m_io_stats;
   std::array<Handle, 16> m_handles{};
 
   FstEntry m_redirect_fst{};
@@ -4,6 +4,7 @@
 #include "Core/IOS/FS/HostBackend/FS.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "Common/FileUtil.h"
@@ -13,8 +14,110 @@
 
 namespace IOS::HLE::FS
 {
+constexpr u32 FILE_CACHE_SIZE = 0x10000;
+
+Result<u32> HostFileSystem::CachedFile::Read(u32 offset, u8* ptr, u32 count)
+{
+  if (offset >= cache_offset && offset + count <= cache_offset + cache.size())
+  {
+    std::memcpy(ptr, cache.data() + (offset - cache_offset), count);
+    return count;
+  }
+
+  if (!Flush() || !file.Seek(offset, File::SeekOrigin::Begin))
+    return ResultCode::AccessDenied;
+
+  ++stats->host_reads;
+  // Large reads go straight to the destination.
+  if (count >= FILE_CACHE_SIZE)
+  {
+    const u32 actually_read = static_cast<u32>(std::fread(ptr, 1, count, file.GetHandle()));
+    if (actually_read != count && std::ferror(file.GetHandle()))
+      return ResultCode::AccessDenied;
+    return actually_read;
+  }
+
+  cache.resize(std::min(FILE_CACHE_SIZE, size - offset));
+  cache_offset = offset;
+  const size_t cached = std::fread(cache.data(), 1, cache.size(), file.GetHandle());
+  cache.resize(cached);
+  if (cached < count && std::ferror(file.GetHandle()))
+    return ResultCode::AccessDenied;
+
+  const u32 actually_read = std::min(count, static_cast<u32>(cached));
+  std::memcpy(ptr, cache.data(), actually_read);
+  return actually_read;
+}
+
+bool HostFileSystem::CachedFile::Write(u32 offset, const u8* ptr, u32 count)
+{
+  if (count == 0)
+    return true;
+
+  // Writes are gathered in the cache, as long as they extend the cached data without a gap.
+  if (offset >= cache_offset && offset <= cache_offset + cache.size() &&
+      offset + count - cache_offset <= FILE_CACHE_SIZE)
+  {
+    const u32 begin = offset - cache_offset;
+    const u32 end = begin + count;
+    if (end > cache.size())
+      cache.resize(end);
+    std::memcpy(cache.data() + begin, ptr, count);
+
+    const bool was_dirty = dirty_begin != dirty_end;
+    dirty_begin = was_dirty ? std::min(dirty_begin, begin) : begin;
+    dirty_end = was_dirty ? std::max(dirty_end, end) : end;
+  }
+  else
+  {
+    if (!Flush())
+      return false;
+
+    if (count >= FILE_CACHE_SIZE)
+    {
+      // Large writes go straight to the file.
+      cache.clear();
+      ++stats->host_writes;
+      if (!file.Seek(offset, File::SeekOrigin::Begin) || !file.WriteBytes(ptr, count) ||
+          !file.Flush())
+      {
+        return false;
+      }
+    }
+    else
+    {
+      cache.assign(ptr, ptr + count);
+      cache_offset = offset;
+      dirty_begin = 0;
+      dirty_end = count;
+    }
+  }
+
+  size = std::max(size, offset + count);
+  return true;
+}
+
+bool HostFileSystem::CachedFile::Flush()
+{
+  if (dirty_begin == dirty_end)
+    return true;
+
+  ++stats->host_writes;
+  const bool success = file.Seek(cache_offset + dirty_begin, File::SeekOrigin::Begin) &&
+                       file.WriteBytes(cache.data() + dirty_begin, dirty_end - dirty_begin) &&
+                       file.Flush();
+  dirty_begin = dirty_end = 0;
+  if (!success)
+  {
+    ERROR_LOG_FMT(IOS_FS, "Failed to write back cached data");
+    cache.clear();
+  }
+  return success;
+}
+
 // This isn't theadsafe, but it's only called from the CPU thread.
-std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
+std::shared_ptr<HostFileSystem::CachedFile>
+HostFileSystem::OpenHostFile(const std::string& host_path)
 {
   // On the wii, all file operations are strongly ordered.
   // If a game opens the same file twice (or 8 times, looking at you PokePark Wii)
@@ -60,20 +163,37 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   }
 
   // This code will be called when all references to the shared pointer below have been removed.
-  auto deleter = [this, host_path](File::IOFile* ptr) {
+  auto deleter = [this, host_path](CachedFile* ptr) {
+    ptr->Flush();
     delete ptr;                     // IOFile's deconstructor closes the file.
     m_open_files.erase(host_path);  // erase the weak pointer from the list of open files.
   };
 
+  auto* cached_file = new CachedFile;
+  cached_file->size = static_cast<u32>(file.GetSize());
+  cached_file->file = std::move(file);
+  cached_file->stats = &m_io_stats;
+
   // Use the custom deleter from above.
-  std::shared_ptr<File::IOFile> file_ptr(new File::IOFile(std::move(file)), deleter);
+  std::shared_ptr<CachedFile> file_ptr(cached_file, deleter);
 
   // Store a weak pointer to our newly opened file in the cache.
-  m_open_files[host_path] = std::weak_ptr<File::IOFile>(file_ptr);
+  m_open_files[host_path] = std::weak_ptr<CachedFile>(file_ptr);
 
   return file_ptr;
 }
 
+u64 HostFileSystem::GetHostFileSize(const std::string& host_path) const
+{
+  const auto it = m_open_files.find(host_path);
+  if (it != m_open_files.end())
+  {
+    if (const std::shared_ptr<CachedFile> file = it->second.lock())
+      return file->size;
+  }
+  return File::GetSize(host_path);
+}
+
 Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
 {
   Handle* handle = AssignFreeHandle();
@@ -115,42 +235,41 @@ ResultCode HostFileSystem::Close(Fd fd)
 Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Read)) == 0)
     return ResultCode::AccessDenied;
 
-  const u32 file_size = static_cast<u32>(handle->host_file->GetSize());
+  ++m_io_stats.read_requests;
+  const u32 file_size = handle->host_file->size;
   // IOS has this check in the read request handler.
   if (count + handle->file_offset > file_size)
     count = file_size - handle->file_offset;
 
-  // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, handle->host_file->GetHandle()));
-
-  if (actually_read != count && ferror(handle->host_file->GetHandle()))
-    return ResultCode::AccessDenied;
+  // The file might be opened twice, so the offset is stored in the handle.
+  const Result<u32> actually_read = handle->host_file->Read(handle->file_offset, ptr, count);
+  if (!actually_read)
+    return actually_read;
 
   // IOS returns the number of bytes read and adds that value to the seek position,
   // instead of adding the *requested* read length.
-  handle->file_offset += actually_read;
+  handle->file_offset += *actually_read;
   return actually_read;
 }
 
 Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
-  // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  if (!handle->host_file->WriteBytes(ptr, count))
+  ++m_io_stats.write_requests;
+  // The file might be opened twice, so the offset is stored in the handle.
+  if (!handle->host_file->Write(handle->file_offset, ptr, count))
     return ResultCode::AccessDenied;
 
   handle->file_offset += count;
@@ -160,7 +279,7 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   u32 new_position = 0;
@@ -173,14 +292,14 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
     new_position = handle->file_offset + offset;
     break;
   case SeekMode::End:
-    new_position = handle->host_file->GetSize() + offset;
+    new_position = handle->host_file->size + offset;
     break;
   default:
     return ResultCode::Invalid;
   }
 
   // This differs from POSIX behaviour which allows seeking past the end of the file.
-  if (handle->host_file->GetSize() < new_position)
+  if (handle->host_file->size < new_position)
     return ResultCode::Invalid;
 
   handle->file_offset = new_position;
@@ -190,11 +309,11 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 Result<FileStatus> HostFileSystem::GetFileStatus(Fd fd)
 {
   const Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   FileStatus status;
-  status.size = handle->host_file->GetSize();
+  status.size = handle->host_file->size;
   status.offset = handle->file_offset;
   return status;
 }
@@ -61,8 +61,10 @@
 
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
+#include "Core/MovieInputLog.h"
 #include "Core/NetPlayProto.h"
 #include "Core/State.h"
+#include "Core/StateHash.h"
 #include "Core/WiiUtils.h"
 
 #include "DiscIO/Enums.h"
@@ -72,14 +74,17 @@
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
-// The chunk to allocate movie data in multiples of.
-#define DTM_BASE_LENGTH (1024)
-
 namespace Movie
 {
 using namespace WiimoteCommon;
 using namespace WiimoteEmu;
 
+// How often a savestate is made while recording, so that playback can be started from close to
+// any frame of the recording.
+constexpr u64 CHECKPOINT_INTERVAL_FRAMES = 60 * 60 * 5;
+// How often the header of the file a recording is streamed to is brought up to date.
+constexpr u64 STREAM_HEADER_INTERVAL_FRAMES = 60;
+
 enum class PlayMode
 {
   None = 0,
@@ -95,7 +100,9 @@ static std::array<ControllerType, 4> s_controllers{};
 static std::array<bool, 4> s_wiimotes{};
 static ControllerState s_padState;
 static DTMHeader tmpHeader;
-static std::vector<u8> s_temp_input;
+static InputLog s_input_log;
+// The movie that the checkpoint savestates of s_input_log are stored next to.
+static std::string s_checkpoint_base_path;
 static u64 s_currentByte = 0;
 static u64 s_currentFrame = 0, s_totalFrames = 0;  // VI
 static u64 s_currentLagCount = 0;
@@ -128,9 +135,12 @@ static WiiManipFunction s_wii_manip_func;
 static std::string s_current_file_name;
 
 static void GetSettings();
-static bool IsMovieHeader(const std::array<u8, 4>& magic)
+static DTMHeader CreateHeader();
+static void StartStreaming();
+static void StopStreaming();
+static bool IsMovieHeader(const DTMHeader& header)
 {
-  return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
+  return InputLog::IsDTMHeader(header) || InputLog::IsDTIHeader(header);
 }
 
 static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
@@ -220,6 +230,19 @@ std::string GetRerecords()
   return "Rerecords: N/A";
 }
 
+// NOTE: Host Thread
+static void SaveCheckpoint()
+{
+  Core::RunAsCPUThread([] {
+    if (!IsRecordingInput() || !s_input_log.IsStreaming())
+      return;
+
+    const InputLog::Checkpoint checkpoint{s_currentFrame, s_currentByte};
+    State::SaveAs(InputLog::GetCheckpointPath(s_checkpoint_base_path, checkpoint.frame));
+    s_input_log.AddCheckpoint(checkpoint);
+  });
+}
+
 void FrameUpdate()
 {
   s_currentFrame++;
@@ -232,6 +255,20 @@ void FrameUpdate()
     s_totalLagCount = s_currentLagCount;
   }
 
+  // Playing back a movie that has no index yet builds one as a side effect.
+  if (IsMovieActive())
+    s_input_log.MarkFrame(s_currentFrame, {s_currentByte, s_currentInputCount, s_currentLagCount});
+
+  if (IsRecordingInput() && s_input_log.IsStreaming())
+  {
+    if (s_currentFrame % STREAM_HEADER_INTERVAL_FRAMES == 0)
+      s_input_log.UpdateStreamHeader(CreateHeader());
+    if (s_currentFrame % CHECKPOINT_INTERVAL_FRAMES == 0)
+      Core::QueueHostJob([] { SaveCheckpoint(); });
+  }
+
+  StateHash::FrameUpdate(s_currentFrame);
+
   s_bPolled = false;
 }
 
@@ -250,6 +287,7 @@ void Init(const BootParameters& boot)
 
   s_bPolled = false;
   s_bSaveConfig = false;
+  StateHash::Init();
   if (IsPlayingInput())
   {
     ReadHeader();
@@ -596,7 +634,8 @@ bool BeginRecordingInput(const ControllerTypeArray& controllers,
 
     s_playMode = PlayMode::Recording;
     s_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
-    s_temp_input.clear();
+    s_input_log.Clear();
+    StartStreaming();
 
     s_currentByte = 0;
 
@@ -869,6 +908,15 @@ void CheckPadStatus(const GCPadStatus* PadStatus, int controllerID)
   SetInputDisplayString(s_padState, controllerID);
 }
 
+// NOTE: CPU Thread
+static void AppendInput(const u8* data, size_t size)
+{
+  // Recording from the middle of the movie discards everything after the current position.
+  s_input_log.Truncate(s_currentByte, s_currentFrame);
+  s_input_log.Append(data, size);
+  s_currentByte = s_input_log.GetSize();
+}
+
 // NOTE: CPU Thread
 void RecordInput(const GCPadStatus* PadStatus, int controllerID)
 {
@@ -877,9 +925,7 @@ void RecordInput(const GCPadStatus* PadStatus, int controllerID)
 
   CheckPadStatus(PadStatus, controllerID);
 
-  s_temp_input.resize(s_currentByte + sizeof(ControllerState));
-  memcpy(&s_temp_input[s_currentByte], &s_padState, sizeof(ControllerState));
-  s_currentByte += sizeof(ControllerState);
+  AppendInput(reinterpret_cast<const u8*>(&s_padState), sizeof(ControllerState));
 }
 
 // NOTE: CPU Thread
@@ -898,10 +944,8 @@ void RecordWiimote(int wiimote, const u8* data, u8 size)
     return;
 
   InputUpdate();
-  s_temp_input.resize(s_currentByte + size + 1);
-  s_temp_input[s_currentByte++] = size;
-  memcpy(&s_temp_input[s_currentByte], data, size);
-  s_currentByte += size;
+  AppendInput(&size, 1);
+  AppendInput(data, size);
 }
 
 // NOTE: EmuThread / Host Thread
@@ -944,7 +988,8 @@ void ReadHeader()
 }
 
 // NOTE: Host Thread
-bool PlayInput(const std::string& movie_path, std::optional<std::string>* savestate_path)
+bool PlayInput(const std::string& movie_path, std::optional<std::string>* savestate_path,
+               u64 start_frame)
 {
   if (s_playMode != PlayMode::None)
     return false;
@@ -952,12 +997,14 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
   File::IOFile recording_file(movie_path, "rb");
   if (!recording_file.ReadArray(&tmpHeader, 1))
     return false;
+  recording_file.Close();
 
-  if (!IsMovieHeader(tmpHeader.filetype))
+  if (!IsMovieHeader(tmpHeader) || !s_input_log.Load(movie_path, &tmpHeader))
   {
     PanicAlertFmtT("Invalid recording file");
     return false;
   }
+  s_checkpoint_base_path = movie_path;
 
   ReadHeader();
   s_totalFrames = tmpHeader.frameCount;
@@ -975,10 +1022,7 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
 
   Core::UpdateWantDeterminism();
 
-  s_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(s_temp_input.data(), s_temp_input.size());
   s_currentByte = 0;
-  recording_file.Close();
 
   // Load savestate (and skip to frame data)
   if (tmpHeader.bFromSaveState && savestate_path)
@@ -999,6 +1043,25 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
     Movie::LoadInput(movie_path);
   }
 
+  // Start from the last checkpoint at or before the requested frame. The checkpoint savestate
+  // restores the movie position along with everything else.
+  if (start_frame != 0 && savestate_path)
+  {
+    const std::optional<InputLog::Checkpoint> checkpoint = s_input_log.FindCheckpoint(start_frame);
+    const std::string checkpoint_path =
+        checkpoint ? InputLog::GetCheckpointPath(movie_path, checkpoint->frame) : std::string();
+    if (checkpoint && File::Exists(checkpoint_path))
+    {
+      *savestate_path = checkpoint_path;
+    }
+    else
+    {
+      PanicAlertFmtT("Movie {0} has no checkpoint at or before frame {1}. Playback will start "
+                     "from the beginning of the movie.",
+                     movie_path, start_frame);
+    }
+  }
+
   return true;
 }
 
@@ -1018,17 +1081,15 @@ void DoState(PointerWrap& p)
 // NOTE: Host Thread
 void LoadInput(const std::string& movie_path)
 {
-  File::IOFile t_record;
-  if (!t_record.Open(movie_path, "r+b"))
+  if (!File::Exists(movie_path))
   {
     PanicAlertFmtT("Failed to read {0}", movie_path);
     EndPlayInput(false);
     return;
   }
 
-  t_record.ReadArray(&tmpHeader, 1);
-
-  if (!IsMovieHeader(tmpHeader.filetype))
+  InputLog saved_input;
+  if (!saved_input.Load(movie_path, &tmpHeader))
   {
     PanicAlertFmtT("Savestate movie {0} is corrupted, movie recording stopping...", movie_path);
     EndPlayInput(false);
@@ -1039,7 +1100,7 @@ void LoadInput(const std::string& movie_path)
   {
     s_rerecords++;
     tmpHeader.numRerecords = s_rerecords;
-    t_record.Seek(0, File::SeekOrigin::Begin);
+    File::IOFile t_record(movie_path, "r+b");
     t_record.WriteArray(&tmpHeader, 1);
   }
 
@@ -1047,7 +1108,7 @@ void LoadInput(const std::string& movie_path)
   if (SConfig::GetInstance().bWii)
     ChangeWiiPads(true);
 
-  u64 totalSavedBytes = t_record.GetSize() - 256;
+  const u64 totalSavedBytes = saved_input.GetSize();
 
   bool afterEnd = false;
   // This can only happen if the user manually deletes data from the dtm.
@@ -1060,41 +1121,43 @@ void LoadInput(const std::string& movie_path)
     afterEnd = true;
   }
 
-  if (!s_bReadOnly || s_temp_input.empty())
+  if (!s_bReadOnly || s_input_log.IsEmpty())
   {
     s_totalFrames = tmpHeader.frameCount;
     s_totalLagCount = tmpHeader.lagCount;
     s_totalInputCount = tmpHeader.inputCount;
     s_totalTickCount = s_tickCountAtLastInput = tmpHeader.tickCount;
 
-    s_temp_input.resize(static_cast<size_t>(totalSavedBytes));
-    t_record.ReadBytes(s_temp_input.data(), s_temp_input.size());
+    // When rerecording, the savestate's movie is usually the current movie cut off at an earlier
+    // point, so this only has to discard the end of the current movie.
+    s_input_log.Assign(saved_input.GetData(), saved_input.GetSize());
   }
   else if (s_currentByte > 0)
   {
     if (s_currentByte > totalSavedBytes)
     {
     }
-    else if (s_currentByte > s_temp_input.size())
+    else if (s_currentByte > s_input_log.GetSize())
     {
       afterEnd = true;
       PanicAlertFmtT(
           "Warning: You loaded a save that's after the end of the current movie. (byte {0} "
           "> {1}) (input {2} > {3}). You should load another save before continuing, or load "
           "this state with read-only mode off.",
-          s_currentByte + 256, s_temp_input.size() + 256, s_currentInputCount, s_totalInputCount);
+          s_currentByte + 256, s_input_log.GetSize() + 256, s_currentInputCount,
+          s_totalInputCount);
     }
-    else if (s_currentByte > 0 && !s_temp_input.empty())
+    else if (s_currentByte > 0 && !s_input_log.IsEmpty())
     {
       // verify identical from movie start to the save's current frame
-      std::vector<u8> movInput(s_currentByte);
-      t_record.ReadArray(movInput.data(), movInput.size());
+      const u8* const movInput = saved_input.GetData();
 
-      const auto result = std::mismatch(movInput.begin(), movInput.end(), s_temp_input.begin());
+      const u8* const result =
+          std::mismatch(movInput, movInput + s_currentByte, s_input_log.GetData()).first;
 
-      if (result.first != movInput.end())
+      if (result != movInput + s_currentByte)
       {
-        const ptrdiff_t mismatch_index = std::distance(movInput.begin(), result.first);
+        const ptrdiff_t mismatch_index = result - movInput;
 
         // this is a "you did something wrong" alert for the user's benefit.
         // we'll try to say what's going on in excruciating detail, otherwise the user might not
@@ -1109,13 +1172,16 @@ void LoadInput(const std::string& movie_path)
                          "read-only mode off. Otherwise you'll probably get a desync.",
                          byte_offset, byte_offset);
 
-          std::copy(movInput.begin(), movInput.end(), s_temp_input.begin());
+          std::vector<u8> input(s_input_log.GetData(),
+                                s_input_log.GetData() + s_input_log.GetSize());
+          std::copy_n(movInput, s_currentByte, input.begin());
+          s_input_log.Assign(input.data(), input.size());
         }
         else
         {
           const ptrdiff_t frame = mismatch_index / sizeof(ControllerState);
           ControllerState curPadState;
-          memcpy(&curPadState, &s_temp_input[frame * sizeof(ControllerState)],
+          memcpy(&curPadState, s_input_log.GetData() + frame * sizeof(ControllerState),
                  sizeof(ControllerState));
           ControllerState movPadState;
           memcpy(&movPadState, &movInput[frame * sizeof(ControllerState)], sizeof(ControllerState));
@@ -1149,8 +1215,6 @@ void LoadInput(const std::string& movie_path)
       }
     }
   }
-  t_record.Close();
-
   s_bSaveConfig = tmpHeader.bSaveConfig;
 
   if (!afterEnd)
@@ -1172,6 +1236,7 @@ void LoadInput(const std::string& movie_path)
         Core::UpdateWantDeterminism();
         Core::DisplayMessage("Switched to recording", 2000);
       }
+      StartStreaming();
     }
   }
   else
@@ -1183,7 +1248,7 @@ void LoadInput(const std::string& movie_path)
 // NOTE: CPU Thread
 static void CheckInputEnd()
 {
-  if (s_currentByte >= s_temp_input.size() ||
+  if (s_currentByte >= s_input_log.GetSize() ||
       (CoreTiming::GetTicks() > s_totalTickCount && !IsRecordingInputFromSaveState()))
   {
     EndPlayInput(!s_bReadOnly);
@@ -1195,18 +1260,18 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 {
   // Correct playback is entirely dependent on the emulator polling the controllers
   // in the same order done during recording
-  if (!IsPlayingInput() || !IsUsingPad(controllerID) || s_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingPad(controllerID) || s_input_log.IsEmpty())
     return;
 
-  if (s_currentByte + sizeof(ControllerState) > s_temp_input.size())
+  if (s_currentByte + sizeof(ControllerState) > s_input_log.GetSize())
   {
     PanicAlertFmtT("Premature movie end in PlayController. {0} + {1} > {2}", s_currentByte,
-                   sizeof(ControllerState), s_temp_input.size());
+                   sizeof(ControllerState), s_input_log.GetSize());
     EndPlayInput(!s_bReadOnly);
     return;
   }
 
-  memcpy(&s_padState, &s_temp_input[s_currentByte], sizeof(ControllerState));
+  memcpy(&s_padState, s_input_log.GetData() + s_currentByte, sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
 
   PadStatus->isConnected = s_padState.is_connected;
@@ -1281,19 +1346,19 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
                  const EncryptionKey& key)
 {
-  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || s_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || s_input_log.IsEmpty())
     return false;
 
-  if (s_currentByte > s_temp_input.size())
+  if (s_currentByte > s_input_log.GetSize())
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} > {1}", s_currentByte,
-                   s_temp_input.size());
+                   s_input_log.GetSize());
     EndPlayInput(!s_bReadOnly);
     return false;
   }
 
   const u8 size = rpt.GetDataSize();
-  const u8 sizeInMovie = s_temp_input[s_currentByte];
+  const u8 sizeInMovie = s_input_log.GetData()[s_currentByte];
 
   if (size != sizeInMovie)
   {
@@ -1310,15 +1375,15 @@ bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
 
   s_currentByte++;
 
-  if (s_currentByte + size > s_temp_input.size())
+  if (s_currentByte + size > s_input_log.GetSize())
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} + {1} > {2}", s_currentByte, size,
-                   s_temp_input.size());
+                   s_input_log.GetSize());
     EndPlayInput(!s_bReadOnly);
     return false;
   }
 
-  memcpy(rpt.GetDataPtr(), &s_temp_input[s_currentByte], size);
+  memcpy(rpt.GetDataPtr(), s_input_log.GetData() + s_currentByte, size);
   s_currentByte += size;
 
   s_currentInputCount++;
@@ -1336,6 +1401,7 @@ void EndPlayInput(bool cont)
     ASSERT(IsMovieActive());
 
     s_playMode = PlayMode::Recording;
+    StartStreaming();
     Core::DisplayMessage("Reached movie end. Resuming recording.", 2000);
   }
   else if (s_playMode != PlayMode::None)
@@ -1346,6 +1412,7 @@ void EndPlayInput(bool cont)
       CPU::Break();
     s_rerecords = 0;
     s_currentByte = 0;
+    StopStreaming();
     s_playMode = PlayMode::None;
     Core::DisplayMessage("Movie End.", 2000);
     s_bRecordingFromSaveState = false;
@@ -1359,11 +1426,8 @@ void EndPlayInput(bool cont)
   }
 }
 
-// NOTE: Save State + Host Thread
-void SaveRecording(const std::string& filename)
+static DTMHeader CreateHeader()
 {
-  File::IOFile save_record(filename, "wb");
-  // Create the real header now and write it
   DTMHeader header;
   memset(&header, 0, sizeof(DTMHeader));
 
@@ -1410,9 +1474,94 @@ void SaveRecording(const std::string& filename)
   header.uniqueID = 0;
   // header.audioEmulator;
 
-  save_record.WriteArray(&header, 1);
+  return header;
+}
+
+// Recordings are streamed to this file while they are being made. If the emulator crashes, it can
+// still be played back, just without its frame index.
+constexpr char STREAMING_FILE_NAME[] = "dtm.dti";
+
+static std::string GetStreamingPath()
+{
+  return File::GetUserPath(D_STATESAVES_IDX) + STREAMING_FILE_NAME;
+}
+
+static void CopyCheckpoints(const std::string& from_movie_path, const std::string& to_movie_path)
+{
+  if (from_movie_path.empty() || from_movie_path == to_movie_path)
+    return;
+
+  for (const InputLog::Checkpoint& checkpoint : s_input_log.GetCheckpoints())
+  {
+    const std::string from = InputLog::GetCheckpointPath(from_movie_path, checkpoint.frame);
+    const std::string to = InputLog::GetCheckpointPath(to_movie_path, checkpoint.frame);
+    File::Copy(from, to);
+    File::Copy(from + ".dtm", to + ".dtm");
+  }
+}
+
+// Removes the checkpoint savestates of earlier recordings that were left next to the streaming
+// file, keeping only the ones that belong to the current input.
+static void DeleteStaleCheckpoints()
+{
+  const std::string directory = File::GetUserPath(D_STATESAVES_IDX);
+  const std::string prefix = std::string(STREAMING_FILE_NAME) + '.';
+
+  std::vector<std::string> current;
+  for (const InputLog::Checkpoint& checkpoint : s_input_log.GetCheckpoints())
+    current.push_back(InputLog::GetCheckpointPath(STREAMING_FILE_NAME, checkpoint.frame));
+
+  for (const File::FSTEntry& entry : File::ScanDirectoryTree(directory, false).children)
+  {
+    const std::string& name = entry.virtualName;
+    if (entry.isDirectory || !StringBeginsWith(name, prefix))
+      continue;
+
+    const std::string state_name =
+        StringEndsWith(name, ".sav.dtm") ? name.substr(0, name.size() - 4) : name;
+    if (!StringEndsWith(state_name, ".sav") ||
+        std::find(current.begin(), current.end(), state_name) != current.end())
+    {
+      continue;
+    }
+
+    File::Delete(entry.physicalName);
+  }
+}
+
+// NOTE: Host / EmuThread / CPU Thread
+static void StartStreaming()
+{
+  if (s_input_log.IsStreaming())
+    return;
+
+  const std::string path = GetStreamingPath();
+  CopyCheckpoints(s_checkpoint_base_path, path);
+  DeleteStaleCheckpoints();
+  s_checkpoint_base_path = path;
+  s_input_log.StartStreaming(path, CreateHeader());
+}
+
+// NOTE: Host / EmuThread / CPU Thread
+static void StopStreaming()
+{
+  if (s_input_log.IsStreaming())
+    s_input_log.StopStreaming(CreateHeader());
+}
+
+// NOTE: Save State + Host Thread
+void SaveRecording(const std::string& filename)
+{
+  const DTMHeader header = CreateHeader();
+
+  // Only files with the .dti extension get the frame index and checkpoints. Savestates and
+  // everything else keep using DTM files, which other programs know how to read.
+  const bool indexed = StringEndsWith(filename, ".dti");
+  bool success =
+      indexed ? s_input_log.SaveDTI(filename, header) : s_input_log.SaveDTM(filename, header);
 
-  bool success = save_record.WriteBytes(s_temp_input.data(), s_temp_input.size());
+  if (success && indexed)
+    CopyCheckpoints(s_checkpoint_base_path, filename);
 
   if (success && s_bRecordingFromSaveState)
   {
@@ -1576,7 +1725,9 @@ static void GetMD5()
 // NOTE: EmuThread
 void Shutdown()
 {
+  StateHash::Shutdown();
+  StopStreaming();
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
-  s_temp_input.clear();
+  s_input_log.Clear();
 }
 }  // namespace Movie
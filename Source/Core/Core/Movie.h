@@ -182,7 +182,10 @@ bool BeginRecordingInput(const ControllerTypeArray& controllers,
 void RecordInput(const GCPadStatus* PadStatus, int controllerID);
 void RecordWiimote(int wiimote, const u8* data, u8 size);
 
-bool PlayInput(const std::string& movie_path, std::optional<std::string>* savestate_path);
+// If start_frame is set, playback starts from the closest checkpoint before it, if the movie
+// has one.
+bool PlayInput(const std::string& movie_path, std::optional<std::string>* savestate_path,
+               u64 start_frame = 0);
 void LoadInput(const std::string& movie_path);
 void ReadHeader();
 void PlayController(GCPadStatus* PadStatus, int controllerID);
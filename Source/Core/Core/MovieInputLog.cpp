@@ -0,0 +1,336 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieInputLog.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/Logging/Log.h"
+
+namespace Movie
+{
+namespace
+{
+constexpr std::array<u8, 4> DTM_MAGIC = {'D', 'T', 'M', 0x1A};
+constexpr std::array<u8, 4> DTI_MAGIC = {'D', 'T', 'I', 0x1A};
+constexpr std::array<u8, 4> DTI_FOOTER_MAGIC = {'D', 'T', 'I', 'F'};
+constexpr u32 DTI_VERSION = 1;
+
+#pragma pack(push, 1)
+struct DTIFrameMarker
+{
+  u64 input_offset;
+  u64 input_count;
+  u64 lag_count;
+};
+static_assert(sizeof(DTIFrameMarker) == 24);
+
+struct DTICheckpoint
+{
+  u64 frame;
+  u64 input_offset;
+};
+static_assert(sizeof(DTICheckpoint) == 16);
+
+// Stored at the very end of a DTI file, after the frame index and the checkpoint list.
+struct DTIFooter
+{
+  u64 input_size;
+  u64 frame_count;
+  u64 checkpoint_count;
+  u32 version;
+  std::array<u8, 4> magic;
+};
+static_assert(sizeof(DTIFooter) == 32);
+#pragma pack(pop)
+
+bool ReadFooter(File::IOFile& file, std::vector<u8>* data,
+                std::vector<InputLog::FrameMarker>* frames,
+                std::vector<InputLog::Checkpoint>* checkpoints)
+{
+  const u64 file_size = file.GetSize();
+  if (file_size < sizeof(DTMHeader) + sizeof(DTIFooter))
+    return false;
+
+  DTIFooter footer;
+  if (!file.Seek(-static_cast<s64>(sizeof(DTIFooter)), File::SeekOrigin::End) ||
+      !file.ReadArray(&footer, 1))
+  {
+    file.ClearError();
+    return false;
+  }
+
+  if (footer.magic != DTI_FOOTER_MAGIC || footer.version != DTI_VERSION)
+    return false;
+
+  if (footer.input_size > file_size || footer.frame_count > file_size ||
+      footer.checkpoint_count > file_size)
+  {
+    return false;
+  }
+
+  const u64 index_size =
+      footer.frame_count * sizeof(DTIFrameMarker) + footer.checkpoint_count * sizeof(DTICheckpoint);
+  if (sizeof(DTMHeader) + footer.input_size + index_size + sizeof(DTIFooter) != file_size)
+    return false;
+
+  data->resize(footer.input_size);
+  std::vector<DTIFrameMarker> dti_frames(footer.frame_count);
+  std::vector<DTICheckpoint> dti_checkpoints(footer.checkpoint_count);
+  if (!file.Seek(sizeof(DTMHeader), File::SeekOrigin::Begin) ||
+      !file.ReadBytes(data->data(), data->size()) ||
+      !file.ReadArray(dti_frames.data(), dti_frames.size()) ||
+      !file.ReadArray(dti_checkpoints.data(), dti_checkpoints.size()))
+  {
+    file.ClearError();
+    return false;
+  }
+
+  frames->reserve(dti_frames.size());
+  for (const DTIFrameMarker& frame : dti_frames)
+    frames->push_back({frame.input_offset, frame.input_count, frame.lag_count});
+  checkpoints->reserve(dti_checkpoints.size());
+  for (const DTICheckpoint& checkpoint : dti_checkpoints)
+    checkpoints->push_back({checkpoint.frame, checkpoint.input_offset});
+  return true;
+}
+
+DTMHeader WithMagic(const DTMHeader& header, const std::array<u8, 4>& magic)
+{
+  DTMHeader result = header;
+  result.filetype = magic;
+  return result;
+}
+}  // namespace
+
+InputLog::InputLog()
+{
+  Clear();
+}
+
+InputLog::~InputLog() = default;
+
+bool InputLog::IsDTMHeader(const DTMHeader& header)
+{
+  return header.filetype == DTM_MAGIC;
+}
+
+bool InputLog::IsDTIHeader(const DTMHeader& header)
+{
+  return header.filetype == DTI_MAGIC;
+}
+
+std::string InputLog::GetCheckpointPath(const std::string& movie_path, u64 frame)
+{
+  return fmt::format("{}.{}.sav", movie_path, frame);
+}
+
+void InputLog::Clear()
+{
+  Truncate(0, 0);
+}
+
+void InputLog::Append(const u8* data, size_t size)
+{
+  m_data.insert(m_data.end(), data, data + size);
+  if (m_stream.IsOpen())
+    m_stream.WriteBytes(data, size);
+}
+
+void InputLog::Truncate(u64 size, u64 frame)
+{
+  if (size < m_data.size())
+  {
+    m_data.resize(size);
+    if (m_stream.IsOpen())
+    {
+      m_stream.Flush();
+      m_stream.Resize(sizeof(DTMHeader) + size);
+      m_stream.Seek(0, File::SeekOrigin::End);
+    }
+  }
+
+  while (!m_frames.empty() &&
+         (m_frames.back().input_offset > size || m_frames.size() - 1 > frame))
+  {
+    m_frames.pop_back();
+  }
+  if (m_frames.empty())
+    m_frames.emplace_back();
+
+  while (!m_checkpoints.empty() &&
+         (m_checkpoints.back().input_offset > size || m_checkpoints.back().frame > frame))
+  {
+    m_checkpoints.pop_back();
+  }
+}
+
+void InputLog::Assign(const u8* data, u64 size)
+{
+  const u64 common_size = std::min<u64>(size, m_data.size());
+  const u64 prefix_size = std::mismatch(data, data + common_size, m_data.begin()).first - data;
+
+  Truncate(prefix_size);
+  Append(data + prefix_size, size - prefix_size);
+}
+
+void InputLog::MarkFrame(u64 frame, const FrameMarker& marker)
+{
+  if (frame < m_frames.size())
+  {
+    if (m_frames[frame] == marker)
+      return;
+
+    // The recording has diverged from what was indexed before.
+    m_frames.resize(frame);
+    m_checkpoints.erase(std::remove_if(m_checkpoints.begin(), m_checkpoints.end(),
+                                       [frame](const Checkpoint& c) { return c.frame >= frame; }),
+                        m_checkpoints.end());
+  }
+
+  if (frame == m_frames.size())
+    m_frames.push_back(marker);
+}
+
+std::optional<InputLog::FrameMarker> InputLog::GetFrame(u64 frame) const
+{
+  if (frame >= m_frames.size())
+    return std::nullopt;
+  return m_frames[frame];
+}
+
+void InputLog::AddCheckpoint(const Checkpoint& checkpoint)
+{
+  if (!m_checkpoints.empty() && m_checkpoints.back().frame >= checkpoint.frame)
+    return;
+  m_checkpoints.push_back(checkpoint);
+}
+
+std::optional<InputLog::Checkpoint> InputLog::FindCheckpoint(u64 frame) const
+{
+  const auto it = std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), frame,
+                                   [](u64 f, const Checkpoint& c) { return f < c.frame; });
+  if (it == m_checkpoints.begin())
+    return std::nullopt;
+  return *std::prev(it);
+}
+
+bool InputLog::Load(const std::string& path, DTMHeader* header)
+{
+  File::IOFile file(path, "rb");
+  if (!file.ReadArray(header, 1))
+    return false;
+
+  const bool is_dti = IsDTIHeader(*header);
+  if (!is_dti && !IsDTMHeader(*header))
+    return false;
+
+  std::vector<u8> data;
+  std::vector<FrameMarker> frames;
+  std::vector<Checkpoint> checkpoints;
+  if (!is_dti || !ReadFooter(file, &data, &frames, &checkpoints))
+  {
+    // A DTM file, or a DTI file which was never finished. Everything after the header is input.
+    frames.clear();
+    checkpoints.clear();
+    data.resize(file.GetSize() - sizeof(DTMHeader));
+    if (!file.Seek(sizeof(DTMHeader), File::SeekOrigin::Begin) ||
+        !file.ReadBytes(data.data(), data.size()))
+    {
+      return false;
+    }
+  }
+
+  Assign(data.data(), data.size());
+  m_frames = std::move(frames);
+  m_checkpoints = std::move(checkpoints);
+  // Drops anything in the index that doesn't fit the input, and adds the start of frame 0.
+  Truncate(m_data.size());
+  return true;
+}
+
+bool InputLog::WriteFooter(File::IOFile& file) const
+{
+  std::vector<DTIFrameMarker> frames;
+  frames.reserve(m_frames.size());
+  for (const FrameMarker& frame : m_frames)
+    frames.push_back({frame.input_offset, frame.input_count, frame.lag_count});
+
+  std::vector<DTICheckpoint> checkpoints;
+  checkpoints.reserve(m_checkpoints.size());
+  for (const Checkpoint& checkpoint : m_checkpoints)
+    checkpoints.push_back({checkpoint.frame, checkpoint.input_offset});
+
+  DTIFooter footer;
+  footer.input_size = m_data.size();
+  footer.frame_count = frames.size();
+  footer.checkpoint_count = checkpoints.size();
+  footer.version = DTI_VERSION;
+  footer.magic = DTI_FOOTER_MAGIC;
+
+  return file.WriteArray(frames.data(), frames.size()) &&
+         file.WriteArray(checkpoints.data(), checkpoints.size()) && file.WriteArray(&footer, 1);
+}
+
+bool InputLog::SaveDTM(const std::string& path, const DTMHeader& header) const
+{
+  File::IOFile file(path, "wb");
+  const DTMHeader dtm_header = WithMagic(header, DTM_MAGIC);
+  return file.WriteArray(&dtm_header, 1) && file.WriteBytes(m_data.data(), m_data.size());
+}
+
+bool InputLog::SaveDTI(const std::string& path, const DTMHeader& header) const
+{
+  File::IOFile file(path, "wb");
+  const DTMHeader dti_header = WithMagic(header, DTI_MAGIC);
+  return file.WriteArray(&dti_header, 1) && file.WriteBytes(m_data.data(), m_data.size()) &&
+         WriteFooter(file);
+}
+
+bool InputLog::StartStreaming(const std::string& path, const DTMHeader& header)
+{
+  if (m_stream.IsOpen())
+    return true;
+
+  const DTMHeader dti_header = WithMagic(header, DTI_MAGIC);
+  if (!m_stream.Open(path, "wb") || !m_stream.WriteArray(&dti_header, 1) ||
+      !m_stream.WriteBytes(m_data.data(), m_data.size()))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to start streaming the recording to {}", path);
+    m_stream.Close();
+    return false;
+  }
+
+  return true;
+}
+
+bool InputLog::UpdateStreamHeader(const DTMHeader& header)
+{
+  if (!m_stream.IsOpen())
+    return false;
+
+  const DTMHeader dti_header = WithMagic(header, DTI_MAGIC);
+  return m_stream.Seek(0, File::SeekOrigin::Begin) && m_stream.WriteArray(&dti_header, 1) &&
+         m_stream.Seek(0, File::SeekOrigin::End) && m_stream.Flush();
+}
+
+bool InputLog::StopStreaming(const DTMHeader& header)
+{
+  if (!m_stream.IsOpen())
+    return false;
+
+  const DTMHeader dti_header = WithMagic(header, DTI_MAGIC);
+  const bool success = m_stream.Seek(0, File::SeekOrigin::End) && WriteFooter(m_stream) &&
+                       m_stream.Seek(0, File::SeekOrigin::Begin) &&
+                       m_stream.WriteArray(&dti_header, 1);
+  if (!success)
+    ERROR_LOG_FMT(CORE, "Failed to finish streaming the recording");
+
+  m_stream.Close();
+  return success;
+}
+}  // namespace Movie
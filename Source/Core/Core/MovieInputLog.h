@@ -0,0 +1,117 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Core/Movie.h"
+
+namespace Movie
+{
+// The input stream of a movie, along with an index of where each frame starts in it and a list
+// of frames which have a savestate (a "checkpoint") that playback can be started from.
+//
+// Input is stored using the same variable-size records as in DTM files. The indexed file format
+// (DTI) is a DTMHeader with the "DTI"0x1A magic, followed by the input stream and a footer which
+// holds the frame index and the checkpoint list. A DTI file without a valid footer, such as one
+// that was still being streamed to when the emulator exited, is loaded without an index.
+class InputLog
+{
+public:
+  // The movie position at the start of a frame.
+  struct FrameMarker
+  {
+    u64 input_offset = 0;
+    u64 input_count = 0;
+    u64 lag_count = 0;
+
+    bool operator==(const FrameMarker& other) const
+    {
+      return input_offset == other.input_offset && input_count == other.input_count &&
+             lag_count == other.lag_count;
+    }
+    bool operator!=(const FrameMarker& other) const { return !(*this == other); }
+  };
+
+  struct Checkpoint
+  {
+    u64 frame = 0;
+    // Input position that the savestate was made at.
+    u64 input_offset = 0;
+
+    bool operator==(const Checkpoint& other) const
+    {
+      return frame == other.frame && input_offset == other.input_offset;
+    }
+    bool operator!=(const Checkpoint& other) const { return !(*this == other); }
+  };
+
+  InputLog();
+  ~InputLog();
+
+  InputLog(const InputLog&) = delete;
+  InputLog& operator=(const InputLog&) = delete;
+
+  static bool IsDTMHeader(const DTMHeader& header);
+  static bool IsDTIHeader(const DTMHeader& header);
+  // Checkpoint savestates are stored next to the movie they belong to.
+  static std::string GetCheckpointPath(const std::string& movie_path, u64 frame);
+
+  void Clear();
+
+  const u8* GetData() const { return m_data.data(); }
+  u64 GetSize() const { return m_data.size(); }
+  bool IsEmpty() const { return m_data.empty(); }
+
+  void Append(const u8* data, size_t size);
+  // Discards all input from the given offset onwards, along with the frames and checkpoints that
+  // start after it or after the given frame. Shrinking the log doesn't move any data, so this is
+  // cheap on rerecords.
+  void Truncate(u64 size, u64 frame = std::numeric_limits<u64>::max());
+  // Replaces the input with the given data. Only the part that differs from the current input
+  // is rewritten, and index entries for frames within the common prefix are kept.
+  void Assign(const u8* data, u64 size);
+
+  // Frames have to be marked in order. Marking a frame that is already known does nothing unless
+  // the marker differs, in which case everything indexed from that frame onwards is replaced.
+  void MarkFrame(u64 frame, const FrameMarker& marker);
+  std::optional<FrameMarker> GetFrame(u64 frame) const;
+  u64 GetIndexedFrameCount() const { return m_frames.size(); }
+
+  // Checkpoints have to be added in order.
+  void AddCheckpoint(const Checkpoint& checkpoint);
+  const std::vector<Checkpoint>& GetCheckpoints() const { return m_checkpoints; }
+  // Returns the last checkpoint at or before the given frame.
+  std::optional<Checkpoint> FindCheckpoint(u64 frame) const;
+
+  // Loads a DTM or DTI file. Returns false if the file couldn't be read.
+  bool Load(const std::string& path, DTMHeader* header);
+  bool SaveDTM(const std::string& path, const DTMHeader& header) const;
+  bool SaveDTI(const std::string& path, const DTMHeader& header) const;
+
+  // While streaming, all changes to the input are written to the given DTI file as they are
+  // made. The footer and final header are only written when streaming is stopped.
+  bool StartStreaming(const std::string& path, const DTMHeader& header);
+  // Rewrites the header of the file being streamed to and flushes it, so that the frame and tick
+  // counts of a file that is never finished are not too far behind its input.
+  bool UpdateStreamHeader(const DTMHeader& header);
+  bool StopStreaming(const DTMHeader& header);
+  bool IsStreaming() const { return m_stream.IsOpen(); }
+
+private:
+  bool WriteFooter(File::IOFile& file) const;
+
+  std::vector<u8> m_data;
+  // m_frames[n] is the position at the start of frame n.
+  std::vector<FrameMarker> m_frames;
+  std::vector<Checkpoint> m_checkpoints;
+
+  File::IOFile m_stream;
+};
+}  // namespace Movie
@@ -570,12 +570,13 @@ void NetPlayClient::OnChunkedDataPayload(sf::Packet& packet)
   if (data_packet_iter == m_chunked_data_receive_queue.end())
     return;
 
+  // Everything after the message ID and the chunked data ID is payload.
+  constexpr size_t header_size = sizeof(MessageID) + sizeof(cid);
   auto& data_packet = data_packet_iter->second;
-  while (!packet.endOfPacket())
+  if (packet.getDataSize() > header_size)
   {
-    u8 byte;
-    packet >> byte;
-    data_packet << byte;
+    data_packet.append(static_cast<const u8*>(packet.getData()) + header_size,
+                       packet.getDataSize() - header_size);
   }
 
   m_dialog->SetChunkedProgress(m_local_player->pid, data_packet.getDataSize());
@@ -784,6 +785,8 @@ void NetPlayClient::OnChangeGame(sf::Packet& packet)
   client_capabilities_packet << ExpansionInterface::CEXIIPL::HasIPLDump();
   client_capabilities_packet << Config::Get(Config::SESSION_USE_FMA);
   Send(client_capabilities_packet);
+
+  SendContentCache();
 }
 
 void NetPlayClient::OnGameStatus(sf::Packet& packet)
@@ -1739,6 +1742,9 @@ void NetPlayClient::SyncSaveDataResponse(const bool success)
   {
     if (++m_sync_save_data_success_count >= m_sync_save_data_count)
     {
+      // Let the host know about the data that was just received, so that it isn't sent again.
+      SendContentCache();
+
       sf::Packet response_packet;
       response_packet << MessageID::SyncSaveData;
       response_packet << SyncSaveDataID::Success;
@@ -1748,6 +1754,9 @@ void NetPlayClient::SyncSaveDataResponse(const bool success)
   }
   else
   {
+    // The host might have expected some data to be cached which isn't.
+    SendContentCache();
+
     sf::Packet response_packet;
     response_packet << MessageID::SyncSaveData;
     response_packet << SyncSaveDataID::Failure;
@@ -1756,6 +1765,14 @@ void NetPlayClient::SyncSaveDataResponse(const bool success)
   }
 }
 
+void NetPlayClient::SendContentCache()
+{
+  sf::Packet packet;
+  packet << MessageID::ContentCache;
+  WriteContentHashes(GetCachedContent(), packet);
+  Send(packet);
+}
+
 void NetPlayClient::SyncCodeResponse(const bool success)
 {
   // If something failed, immediately report back that code sync failed
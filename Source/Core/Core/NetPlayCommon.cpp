@@ -4,90 +4,168 @@
 #include "Core/NetPlayCommon.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include <fmt/format.h>
-#include <lzo/lzo1x.h>
+#include <mbedtls/sha1.h>
+#include <zstd.h>
 
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/SFMLHelper.h"
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
 
 namespace NetPlay
 {
-constexpr u32 LZO_IN_LEN = 1024 * 64;
-constexpr u32 LZO_OUT_LEN = LZO_IN_LEN + (LZO_IN_LEN / 16) + 64 + 3;
+// Data is split into chunks which are compressed independently, so that both compressing and
+// decompressing it can be spread across threads.
+constexpr u64 COMPRESSION_CHUNK_SIZE = 256 * 1024;
+constexpr int NETPLAY_ZSTD_LEVEL = 3;
 
-bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
+// When the content cache would grow larger than this, it is emptied.
+constexpr u64 CONTENT_CACHE_MAX_SIZE = 256 * 1024 * 1024;
+
+static ContentHash GetContentHash(const std::vector<u8>& data)
 {
-  File::IOFile file(file_path, "rb");
-  if (!file)
-  {
-    PanicAlertFmtT("Failed to open file \"{0}\".", file_path);
-    return false;
-  }
+  ContentHash hash;
+  mbedtls_sha1_ret(data.data(), data.size(), hash.data());
+  return hash;
+}
 
-  const sf::Uint64 size = file.GetSize();
-  packet << size;
+std::string GetContentCachePath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "NetPlayContent" DIR_SEP;
+}
 
-  if (size == 0)
-    return true;
+static std::string GetContentCacheFileName(const ContentHash& hash)
+{
+  std::string name;
+  for (const u8 byte : hash)
+    name += fmt::format("{:02x}", byte);
+  return name;
+}
 
-  std::vector<u8> in_buffer(LZO_IN_LEN);
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+static std::optional<ContentHash> ParseContentCacheFileName(const std::string& name)
+{
+  ContentHash hash;
+  if (name.size() != hash.size() * 2)
+    return std::nullopt;
 
-  lzo_uint i = 0;
-  while (true)
+  for (size_t i = 0; i < hash.size(); ++i)
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
+    if (!TryParse(name.substr(i * 2, 2), &hash[i], 16))
+      return std::nullopt;
+  }
+  return hash;
+}
 
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
+ContentHashSet GetCachedContent()
+{
+  ContentHashSet hashes;
+  for (const File::FSTEntry& entry : File::ScanDirectoryTree(GetContentCachePath(), false).children)
+  {
+    if (entry.isDirectory || entry.size < CONTENT_CACHE_MIN_SIZE)
+      continue;
+    if (const std::optional<ContentHash> hash = ParseContentCacheFileName(entry.virtualName))
+      hashes.insert(*hash);
+  }
+  return hashes;
+}
 
-    if (cur_len <= 0)
-      break;  // EOF
+void WriteContentHashes(const ContentHashSet& hashes, sf::Packet& packet)
+{
+  packet << static_cast<u32>(hashes.size());
+  for (const ContentHash& hash : hashes)
+    packet.append(hash.data(), hash.size());
+}
 
-    if (!file.ReadBytes(in_buffer.data(), cur_len))
-    {
-      PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
-      return false;
-    }
+ContentHashSet ReadContentHashes(sf::Packet& packet)
+{
+  u32 count = 0;
+  packet >> count;
 
-    if (lzo1x_1_compress(in_buffer.data(), cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
-    }
+  ContentHashSet hashes;
+  for (u32 i = 0; i < count && !packet.endOfPacket(); ++i)
+  {
+    ContentHash hash;
+    for (u8& byte : hash)
+      packet >> byte;
+    hashes.insert(hash);
+  }
+  return hashes;
+}
 
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
+// Empties the content cache if adding new_size more bytes to it would make it too large.
+static void TrimContentCache(u64 new_size)
+{
+  const std::string cache_path = GetContentCachePath();
+  u64 total_size = new_size;
+  for (const File::FSTEntry& entry : File::ScanDirectoryTree(cache_path, false).children)
+    total_size += entry.size;
 
-    if (cur_len != LZO_IN_LEN)
-      break;
+  if (total_size > CONTENT_CACHE_MAX_SIZE)
+  {
+    File::DeleteDirRecursively(cache_path);
+    File::CreateFullPath(cache_path);
+  }
+}
+
+static void StoreCachedContent(const ContentHash& hash, const std::vector<u8>& data)
+{
+  if (data.size() > CONTENT_CACHE_MAX_SIZE || !File::CreateFullPath(GetContentCachePath()))
+    return;
+
+  TrimContentCache(data.size());
+
+  // Written under a temporary name first, so that a partially written file is never mistaken for
+  // cached content.
+  const std::string path = GetContentCachePath() + GetContentCacheFileName(hash);
+  const std::string temp_path = path + ".tmp";
+  File::IOFile file(temp_path, "wb");
+  const bool success = file.WriteBytes(data.data(), data.size());
+  file.Close();
+  if (!success || !File::Rename(temp_path, path))
+    File::Delete(temp_path);
+}
 
-    i += cur_len;
+static std::optional<std::vector<u8>> LoadCachedContent(const ContentHash& hash, u64 size)
+{
+  const std::string path = GetContentCachePath() + GetContentCacheFileName(hash);
+  File::IOFile file(path, "rb");
+  if (!file || file.GetSize() != size)
+    return std::nullopt;
+
+  std::vector<u8> data(size);
+  if (!file.ReadBytes(data.data(), data.size()) || GetContentHash(data) != hash)
+    return std::nullopt;
+  return data;
+}
+
+bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet,
+                            const ContentHashSet& skip_content)
+{
+  File::IOFile file(file_path, "rb");
+  if (!file)
+  {
+    PanicAlertFmtT("Failed to open file \"{0}\".", file_path);
+    return false;
   }
 
-  // Mark end of data
-  packet << static_cast<u32>(0);
+  std::vector<u8> buffer(file.GetSize());
+  if (!file.ReadBytes(buffer.data(), buffer.size()))
+  {
+    PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
+    return false;
+  }
 
-  return true;
+  return CompressBufferIntoPacket(buffer, packet, skip_content);
 }
 
-static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::Packet& packet)
+static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::Packet& packet,
+                                             const ContentHashSet& skip_content)
 {
   const sf::Uint64 size = folder.children.size();
   packet << size;
@@ -96,15 +174,17 @@ static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::P
     const bool is_folder = child.isDirectory;
     packet << child.virtualName;
     packet << is_folder;
-    const bool success = is_folder ? CompressFolderIntoPacketInternal(child, packet) :
-                                     CompressFileIntoPacket(child.physicalName, packet);
+    const bool success =
+        is_folder ? CompressFolderIntoPacketInternal(child, packet, skip_content) :
+                    CompressFileIntoPacket(child.physicalName, packet, skip_content);
     if (!success)
       return false;
   }
   return true;
 }
 
-bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet)
+bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet,
+                              const ContentHashSet& skip_content)
 {
   if (!File::IsDirectory(folder_path))
   {
@@ -113,10 +193,12 @@ bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet
   }
 
   packet << true;
-  return CompressFolderIntoPacketInternal(File::ScanDirectoryTree(folder_path, true), packet);
+  return CompressFolderIntoPacketInternal(File::ScanDirectoryTree(folder_path, true), packet,
+                                          skip_content);
 }
 
-bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet)
+bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet,
+                              const ContentHashSet& skip_content)
 {
   const sf::Uint64 size = in_buffer.size();
   packet << size;
@@ -124,58 +206,53 @@ bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& pack
   if (size == 0)
     return true;
 
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
-
-  lzo_uint i = 0;
-  while (true)
+  if (size >= CONTENT_CACHE_MIN_SIZE)
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
+    const ContentHash hash = GetContentHash(in_buffer);
+    packet.append(hash.data(), hash.size());
 
-    if (cur_len <= 0)
-      break;  // end of buffer
-
-    if (lzo1x_1_compress(&in_buffer[i], cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
+    const bool is_cached = skip_content.count(hash) != 0;
+    packet << is_cached;
+    if (is_cached)
+      return true;
+  }
 
-    if (cur_len != LZO_IN_LEN)
-      break;
+  const size_t chunk_count = (size + COMPRESSION_CHUNK_SIZE - 1) / COMPRESSION_CHUNK_SIZE;
+  std::vector<std::string> chunks(chunk_count);
+  std::atomic_bool failed = false;
+  Common::ParallelFor(chunk_count, [&](size_t i) {
+    const size_t offset = i * COMPRESSION_CHUNK_SIZE;
+    const size_t chunk_size = std::min<size_t>(COMPRESSION_CHUNK_SIZE, size - offset);
+
+    std::string& chunk = chunks[i];
+    chunk.resize(ZSTD_compressBound(chunk_size));
+    const size_t compressed_size = ZSTD_compress(chunk.data(), chunk.size(), &in_buffer[offset],
+                                                 chunk_size, NETPLAY_ZSTD_LEVEL);
+    if (ZSTD_isError(compressed_size))
+      failed = true;
+    else
+      chunk.resize(compressed_size);
+  });
 
-    i += cur_len;
+  if (failed)
+  {
+    PanicAlertFmtT("Internal zstd Error - compression failed");
+    return false;
   }
 
-  // Mark end of data
-  packet << static_cast<u32>(0);
+  for (const std::string& chunk : chunks)
+    packet << chunk;
 
   return true;
 }
 
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
 {
-  u64 file_size = Common::PacketReadU64(packet);
+  const std::optional<std::vector<u8>> buffer = DecompressPacketIntoBuffer(packet);
+  if (!buffer)
+    return false;
 
-  if (file_size == 0)
+  if (buffer->empty())
     return true;
 
   File::IOFile file(file_path, "wb");
@@ -185,35 +262,10 @@ bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
     return false;
   }
 
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
-  std::vector<u8> out_buffer(LZO_IN_LEN);
-
-  while (true)
+  if (!file.WriteBytes(buffer->data(), buffer->size()))
   {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
-    {
-      packet >> in_buffer[j];
-    }
-
-    if (lzo1x_decompress(in_buffer.data(), cur_len, out_buffer.data(), &new_len, nullptr) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
-      return false;
-    }
-
-    if (!file.WriteBytes(out_buffer.data(), new_len))
-    {
-      PanicAlertFmtT("Error writing file: {0}", file_path);
-      return false;
-    }
+    PanicAlertFmtT("Error writing file: {0}", file_path);
+    return false;
   }
 
   return true;
@@ -262,37 +314,65 @@ bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_pa
 
 std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
 {
-  u64 size = Common::PacketReadU64(packet);
-
-  std::vector<u8> out_buffer(size);
+  const u64 size = Common::PacketReadU64(packet);
 
   if (size == 0)
-    return out_buffer;
-
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
+    return std::vector<u8>();
 
-  lzo_uint i = 0;
-  while (true)
+  std::optional<ContentHash> hash;
+  if (size >= CONTENT_CACHE_MIN_SIZE)
   {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
+    hash.emplace();
+    for (u8& byte : *hash)
+      packet >> byte;
 
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
+    bool is_cached = false;
+    packet >> is_cached;
+    if (is_cached)
     {
-      packet >> in_buffer[j];
+      std::optional<std::vector<u8>> cached = LoadCachedContent(*hash, size);
+      if (!cached)
+        PanicAlertFmtT("Data which the host expected to be cached is missing.");
+      return cached;
     }
+  }
+
+  // The chunks are read up front so that they can be decompressed in parallel.
+  const size_t chunk_count = (size + COMPRESSION_CHUNK_SIZE - 1) / COMPRESSION_CHUNK_SIZE;
+  std::vector<std::string> chunks(chunk_count);
+  for (std::string& chunk : chunks)
+    packet >> chunk;
+  if (!packet)
+  {
+    PanicAlertFmtT("Received incomplete data.");
+    return std::nullopt;
+  }
 
-    if (lzo1x_decompress(in_buffer.data(), cur_len, &out_buffer[i], &new_len, nullptr) != LZO_E_OK)
+  std::vector<u8> out_buffer(size);
+  std::atomic_bool failed = false;
+  Common::ParallelFor(chunk_count, [&](size_t i) {
+    const size_t offset = i * COMPRESSION_CHUNK_SIZE;
+    const size_t chunk_size = std::min<size_t>(COMPRESSION_CHUNK_SIZE, size - offset);
+    const size_t decompressed_size =
+        ZSTD_decompress(&out_buffer[offset], chunk_size, chunks[i].data(), chunks[i].size());
+    if (decompressed_size != chunk_size)
+      failed = true;
+  });
+
+  if (failed)
+  {
+    PanicAlertFmtT("Internal zstd Error - decompression failed");
+    return std::nullopt;
+  }
+
+  if (hash)
+  {
+    if (GetContentHash(out_buffer) != *hash)
     {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
-      return {};
+      PanicAlertFmtT("Received data is corrupted.");
+      return std::nullopt;
     }
-
-    i += new_len;
+    StoreCachedContent(*hash, out_buffer);
   }
 
   return out_buffer;
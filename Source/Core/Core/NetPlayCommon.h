@@ -7,6 +7,7 @@
 
 #include <array>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -16,9 +17,26 @@ namespace NetPlay
 {
 constexpr u32 PEER_TIMEOUT = 30000;
 
-bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet);
-bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet);
-bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet);
+// Data of at least this size is sent along with its SHA-1 hash. Clients keep a copy of such data
+// in their content cache, and it's only sent in full to clients that don't already have a copy.
+constexpr u64 CONTENT_CACHE_MIN_SIZE = 64 * 1024;
+
+using ContentHash = std::array<u8, 20>;
+using ContentHashSet = std::set<ContentHash>;
+
+std::string GetContentCachePath();
+// Returns the hashes of everything in the local content cache.
+ContentHashSet GetCachedContent();
+void WriteContentHashes(const ContentHashSet& hashes, sf::Packet& packet);
+ContentHashSet ReadContentHashes(sf::Packet& packet);
+
+// Data whose hash is in skip_content is sent as a reference to the receiver's content cache.
+bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet,
+                            const ContentHashSet& skip_content = {});
+bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet,
+                              const ContentHashSet& skip_content = {});
+bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet,
+                              const ContentHashSet& skip_content = {});
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path);
 bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path);
 std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet);
@@ -184,6 +184,7 @@ enum class MessageID : u8
   SyncGCSRAM = 0xF0,
   SyncSaveData = 0xF1,
   SyncCodes = 0xF2,
+  ContentCache = 0xF3,
 };
 
 enum class ConnectionError : u8
@@ -7,6 +7,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdio>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -160,6 +161,7 @@ NetPlayServer::NetPlayServer(const u16 port, const bool forward_port, NetPlayUI*
     m_thread = std::thread(&NetPlayServer::ThreadFunc, this);
     m_target_buffer_size = 5;
     m_chunked_data_thread = std::thread(&NetPlayServer::ChunkedDataThreadFunc, this);
+    m_packet_build_thread.Reset([](PacketBuildTask task) { (*task)(); });
 
 #ifdef USE_UPNP
     if (forward_port)
@@ -715,7 +717,7 @@ void NetPlayServer::SendChunked(sf::Packet&& packet, const PlayerId pid, const s
   {
     std::lock_guard lkq(m_crit.chunked_data_queue_write);
     m_chunked_data_queue.Push(
-        ChunkedDataQueueEntry{std::move(packet), pid, TargetMode::Only, title});
+        ChunkedDataQueueEntry{std::move(packet), {}, pid, TargetMode::Only, title});
   }
   m_chunked_data_event.Set();
 }
@@ -726,7 +728,24 @@ void NetPlayServer::SendChunkedToClients(sf::Packet&& packet, const PlayerId ski
   {
     std::lock_guard lkq(m_crit.chunked_data_queue_write);
     m_chunked_data_queue.Push(
-        ChunkedDataQueueEntry{std::move(packet), skip_pid, TargetMode::AllExcept, title});
+        ChunkedDataQueueEntry{std::move(packet), {}, skip_pid, TargetMode::AllExcept, title});
+  }
+  m_chunked_data_event.Set();
+}
+
+void NetPlayServer::SendChunkedToClientsWhenReady(
+    std::function<std::optional<sf::Packet>()> build_packet, const PlayerId skip_pid,
+    const std::string& title)
+{
+  auto task =
+      std::make_shared<std::packaged_task<std::optional<sf::Packet>()>>(std::move(build_packet));
+  std::future<std::optional<sf::Packet>> packet = task->get_future();
+  m_packet_build_thread.EmplaceItem(std::move(task));
+
+  {
+    std::lock_guard lkq(m_crit.chunked_data_queue_write);
+    m_chunked_data_queue.Push(ChunkedDataQueueEntry{sf::Packet{}, std::move(packet), skip_pid,
+                                                    TargetMode::AllExcept, title});
   }
   m_chunked_data_event.Set();
 }
@@ -1015,6 +1034,15 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case MessageID::ContentCache:
+  {
+    ContentHashSet cached_content = ReadContentHashes(packet);
+
+    std::lock_guard lkp(m_crit.players);
+    m_players[player.pid].cached_content = std::move(cached_content);
+  }
+  break;
+
   case MessageID::PowerButton:
   {
     sf::Packet spac;
@@ -1599,6 +1627,34 @@ void NetPlayServer::AbortGameStart()
   }
 }
 
+// Returns the content that every client other than the host has in its content cache.
+ContentHashSet NetPlayServer::GetContentCachedByAllClients()
+{
+  std::lock_guard lkp(m_crit.players);
+
+  std::optional<ContentHashSet> result;
+  for (const auto& [pid, client] : m_players)
+  {
+    if (client.IsHost())
+      continue;
+
+    if (!result)
+    {
+      result = client.cached_content;
+      continue;
+    }
+
+    for (auto it = result->begin(); it != result->end();)
+    {
+      if (client.cached_content.count(*it) == 0)
+        it = result->erase(it);
+      else
+        ++it;
+    }
+  }
+  return result.value_or(ContentHashSet{});
+}
+
 // called from ---GUI--- thread
 bool NetPlayServer::SyncSaveData()
 {
@@ -1668,6 +1724,11 @@ bool NetPlayServer::SyncSaveData()
   const auto game_region = game->GetRegion();
   const std::string region = Config::GetDirectoryForRegion(Config::ToGameCubeRegion(game_region));
 
+  // Only data that some client doesn't have yet needs to be sent in full.
+  const ContentHashSet cached_content = GetContentCachedByAllClients();
+
+  // The packets below are built one after another on a separate thread. Reading and compressing
+  // the data for one packet overlaps with sending the ones before it.
   for (ExpansionInterface::Slot slot : ExpansionInterface::MEMCARD_SLOTS)
   {
     const bool is_slot_a = slot == ExpansionInterface::Slot::A;
@@ -1681,209 +1742,223 @@ bool NetPlayServer::SyncSaveData()
               Memcard::MBIT_SIZE_MEMORY_CARD_2043;
       const std::string path = Config::GetMemcardPath(slot, game_region, card_size_mbits);
 
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::RawData;
-      pac << is_slot_a << region << size_override;
+      auto build_packet = [=]() -> std::optional<sf::Packet> {
+        sf::Packet pac;
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::RawData;
+        pac << is_slot_a << region << size_override;
 
-      if (File::Exists(path))
-      {
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
-      }
-      else
-      {
-        // No file, so we'll say the size is 0
-        pac << sf::Uint64{0};
-      }
+        if (File::Exists(path))
+        {
+          if (!CompressFileIntoPacket(path, pac, cached_content))
+            return std::nullopt;
+        }
+        else
+        {
+          // No file, so we'll say the size is 0
+          pac << sf::Uint64{0};
+        }
+
+        return pac;
+      };
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      SendChunkedToClientsWhenReady(
+          std::move(build_packet), 1,
+          fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
     }
     else if (Config::Get(Config::GetInfoForEXIDevice(slot)) ==
              ExpansionInterface::EXIDeviceType::MemoryCardFolder)
     {
       const std::string path = File::GetUserPath(D_GCUSER_IDX) + region + DIR_SEP +
                                fmt::format("Card {}", is_slot_a ? 'A' : 'B');
+      const std::string game_id = game->GetGameID();
 
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::GCIData;
-      pac << is_slot_a;
+      auto build_packet = [=]() -> std::optional<sf::Packet> {
+        sf::Packet pac;
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::GCIData;
+        pac << is_slot_a;
 
-      if (File::IsDirectory(path))
-      {
-        std::vector<std::string> files =
-            GCMemcardDirectory::GetFileNamesForGameID(path + DIR_SEP, game->GetGameID());
+        if (File::IsDirectory(path))
+        {
+          std::vector<std::string> files =
+              GCMemcardDirectory::GetFileNamesForGameID(path + DIR_SEP, game_id);
 
-        pac << static_cast<u8>(files.size());
+          pac << static_cast<u8>(files.size());
 
-        for (const std::string& file : files)
+          for (const std::string& file : files)
+          {
+            pac << file.substr(file.find_last_of('/') + 1);
+            if (!CompressFileIntoPacket(file, pac, cached_content))
+              return std::nullopt;
+          }
+        }
+        else
         {
-          pac << file.substr(file.find_last_of('/') + 1);
-          if (!CompressFileIntoPacket(file, pac))
-            return false;
+          pac << static_cast<u8>(0);
         }
-      }
-      else
-      {
-        pac << static_cast<u8>(0);
-      }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'));
+        return pac;
+      };
+
+      SendChunkedToClientsWhenReady(
+          std::move(build_packet), 1,
+          fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'));
     }
   }
 
   if (wii_save)
   {
-    const auto configured_fs = IOS::HLE::FS::MakeFileSystem(IOS::HLE::FS::Location::Configured);
-
-    std::vector<std::pair<u64, WiiSave::StoragePointer>> saves;
+    std::vector<u64> titles;
     if (m_settings.m_SyncAllWiiSaves)
     {
       IOS::HLE::Kernel ios;
-      for (const u64 title : ios.GetES()->GetInstalledTitles())
-      {
-        auto save = WiiSave::MakeNandStorage(configured_fs.get(), title);
-        saves.push_back(std::make_pair(title, std::move(save)));
-      }
+      titles = ios.GetES()->GetInstalledTitles();
     }
     else if (game->GetPlatform() == DiscIO::Platform::WiiDisc ||
              game->GetPlatform() == DiscIO::Platform::WiiWAD)
     {
-      auto save = WiiSave::MakeNandStorage(configured_fs.get(), game->GetTitleID());
-      saves.push_back(std::make_pair(game->GetTitleID(), std::move(save)));
+      titles.push_back(game->GetTitleID());
     }
 
-    std::vector<u64> titles;
+    const std::string redirect_path = redirected_save ? redirected_save->m_target_path : "";
 
-    sf::Packet pac;
-    pac << MessageID::SyncSaveData;
-    pac << SyncSaveDataID::WiiData;
+    // Set titles for host-side loading in WiiRoot
+    m_dialog->SetHostWiiSyncData(titles, redirect_path);
 
-    // Shove the Mii data into the start the packet
-    {
-      auto file = configured_fs->OpenFile(IOS::PID_KERNEL, IOS::PID_KERNEL,
-                                          Common::GetMiiDatabasePath(), IOS::HLE::FS::Mode::Read);
-      if (file)
-      {
-        pac << true;
+    auto build_packet = [=]() -> std::optional<sf::Packet> {
+      const auto configured_fs =
+          IOS::HLE::FS::MakeFileSystem(IOS::HLE::FS::Location::Configured);
 
-        std::vector<u8> file_data(file->GetStatus()->size);
-        if (!file->Read(file_data.data(), file_data.size()))
-          return false;
-        if (!CompressBufferIntoPacket(file_data, pac))
-          return false;
-      }
-      else
+      sf::Packet pac;
+      pac << MessageID::SyncSaveData;
+      pac << SyncSaveDataID::WiiData;
+
+      // Shove the Mii data into the start the packet
       {
-        pac << false;  // no mii data
-      }
-    }
+        auto file = configured_fs->OpenFile(IOS::PID_KERNEL, IOS::PID_KERNEL,
+                                            Common::GetMiiDatabasePath(), IOS::HLE::FS::Mode::Read);
+        if (file)
+        {
+          pac << true;
 
-    // Carry on with the save files
-    pac << static_cast<u32>(saves.size());
+          std::vector<u8> file_data(file->GetStatus()->size);
+          if (!file->Read(file_data.data(), file_data.size()))
+            return std::nullopt;
+          if (!CompressBufferIntoPacket(file_data, pac, cached_content))
+            return std::nullopt;
+        }
+        else
+        {
+          pac << false;  // no mii data
+        }
+      }
 
-    for (const auto& pair : saves)
-    {
-      pac << sf::Uint64{pair.first};
-      titles.push_back(pair.first);
-      const auto& save = pair.second;
+      // Carry on with the save files
+      pac << static_cast<u32>(titles.size());
 
-      if (save->SaveExists())
+      for (const u64 title : titles)
       {
-        const std::optional<WiiSave::Header> header = save->ReadHeader();
-        const std::optional<WiiSave::BkHeader> bk_header = save->ReadBkHeader();
-        const std::optional<std::vector<WiiSave::Storage::SaveFile>> files = save->ReadFiles();
-        if (!header || !bk_header || !files)
-          return false;
-
-        pac << true;  // save exists
-
-        // Header
-        pac << sf::Uint64{header->tid};
-        pac << header->banner_size << header->permissions << header->unk1;
-        for (u8 byte : header->md5)
-          pac << byte;
-        pac << header->unk2;
-        for (size_t i = 0; i < header->banner_size; i++)
-          pac << header->banner[i];
-
-        // BkHeader
-        pac << bk_header->size << bk_header->magic << bk_header->ngid << bk_header->number_of_files
-            << bk_header->size_of_files << bk_header->unk1 << bk_header->unk2
-            << bk_header->total_size;
-        for (u8 byte : bk_header->unk3)
-          pac << byte;
-        pac << sf::Uint64{bk_header->tid};
-        for (u8 byte : bk_header->mac_address)
-          pac << byte;
-
-        // Files
-        for (const WiiSave::Storage::SaveFile& file : *files)
-        {
-          pac << file.mode << file.attributes << file.type << file.path;
+        pac << sf::Uint64{title};
+        const auto save = WiiSave::MakeNandStorage(configured_fs.get(), title);
 
-          if (file.type == WiiSave::Storage::SaveFile::Type::File)
+        if (save->SaveExists())
+        {
+          const std::optional<WiiSave::Header> header = save->ReadHeader();
+          const std::optional<WiiSave::BkHeader> bk_header = save->ReadBkHeader();
+          const std::optional<std::vector<WiiSave::Storage::SaveFile>> files = save->ReadFiles();
+          if (!header || !bk_header || !files)
+            return std::nullopt;
+
+          pac << true;  // save exists
+
+          // Header
+          pac << sf::Uint64{header->tid};
+          pac << header->banner_size << header->permissions << header->unk1;
+          for (u8 byte : header->md5)
+            pac << byte;
+          pac << header->unk2;
+          for (size_t i = 0; i < header->banner_size; i++)
+            pac << header->banner[i];
+
+          // BkHeader
+          pac << bk_header->size << bk_header->magic << bk_header->ngid
+              << bk_header->number_of_files << bk_header->size_of_files << bk_header->unk1
+              << bk_header->unk2 << bk_header->total_size;
+          for (u8 byte : bk_header->unk3)
+            pac << byte;
+          pac << sf::Uint64{bk_header->tid};
+          for (u8 byte : bk_header->mac_address)
+            pac << byte;
+
+          // Files
+          for (const WiiSave::Storage::SaveFile& file : *files)
           {
-            const std::optional<std::vector<u8>>& data = *file.data;
-            if (!data || !CompressBufferIntoPacket(*data, pac))
-              return false;
+            pac << file.mode << file.attributes << file.type << file.path;
+
+            if (file.type == WiiSave::Storage::SaveFile::Type::File)
+            {
+              const std::optional<std::vector<u8>>& data = *file.data;
+              if (!data || !CompressBufferIntoPacket(*data, pac, cached_content))
+                return std::nullopt;
+            }
           }
         }
+        else
+        {
+          pac << false;  // save does not exist
+        }
+      }
+
+      if (!redirect_path.empty())
+      {
+        pac << true;
+        if (!CompressFolderIntoPacket(redirect_path, pac, cached_content))
+          return std::nullopt;
       }
       else
       {
-        pac << false;  // save does not exist
+        pac << false;  // no redirected save
       }
-    }
 
-    if (redirected_save)
-    {
-      pac << true;
-      if (!CompressFolderIntoPacket(redirected_save->m_target_path, pac))
-        return false;
-    }
-    else
-    {
-      pac << false;  // no redirected save
-    }
-
-    // Set titles for host-side loading in WiiRoot
-    m_dialog->SetHostWiiSyncData(std::move(titles),
-                                 redirected_save ? redirected_save->m_target_path : "");
+      return pac;
+    };
 
-    SendChunkedToClients(std::move(pac), 1, "Wii Save Synchronization");
+    SendChunkedToClientsWhenReady(std::move(build_packet), 1, "Wii Save Synchronization");
   }
 
   for (size_t i = 0; i < m_gba_config.size(); ++i)
   {
     if (m_gba_config[i].enabled && m_gba_config[i].has_rom)
     {
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::GBAData;
-      pac << static_cast<u8>(i);
-
       std::string path;
 #ifdef HAS_LIBMGBA
       path = HW::GBA::Core::GetSavePath(Config::Get(Config::MAIN_GBA_ROM_PATHS[i]),
                                         static_cast<int>(i));
 #endif
-      if (File::Exists(path))
-      {
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
-      }
-      else
-      {
-        // No file, so we'll say the size is 0
-        pac << sf::Uint64{0};
-      }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GBA{} Save File Synchronization", i + 1));
+      auto build_packet = [=]() -> std::optional<sf::Packet> {
+        sf::Packet pac;
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::GBAData;
+        pac << static_cast<u8>(i);
+
+        if (File::Exists(path))
+        {
+          if (!CompressFileIntoPacket(path, pac, cached_content))
+            return std::nullopt;
+        }
+        else
+        {
+          // No file, so we'll say the size is 0
+          pac << sf::Uint64{0};
+        }
+
+        return pac;
+      };
+
+      SendChunkedToClientsWhenReady(std::move(build_packet), 1,
+                                    fmt::format("GBA{} Save File Synchronization", i + 1));
     }
   }
 
@@ -2174,6 +2249,20 @@ void NetPlayServer::ChunkedDataThreadFunc()
       if (m_abort_chunked_data)
         break;
       auto& e = m_chunked_data_queue.Front();
+      if (e.pending_packet.valid())
+      {
+        std::optional<sf::Packet> packet = e.pending_packet.get();
+        if (!packet)
+        {
+          PanicAlertFmtT("Error synchronizing save data!");
+          m_dialog->OnGameStartAborted();
+          m_start_pending = false;
+          ChunkedDataAbort();
+          break;
+        }
+        e.packet = std::move(*packet);
+      }
+
       const u32 id = m_next_chunked_data_id++;
 
       m_chunked_data_complete_count[id] = 0;
@@ -5,9 +5,12 @@
 
 #include <SFML/Network/Packet.hpp>
 
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <sstream>
 #include <thread>
@@ -19,7 +22,9 @@
 #include "Common/QoSSession.h"
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
+#include "Common/WorkQueueThread.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayCommon.h"
 #include "Core/NetPlayProto.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
@@ -86,6 +91,7 @@ private:
     SyncIdentifierComparison game_status = SyncIdentifierComparison::Unknown;
     bool has_ipl_dump = false;
     bool has_hardware_fma = false;
+    ContentHashSet cached_content;
 
     ENetPeer* socket = nullptr;
     u32 ping = 0;
@@ -114,11 +120,20 @@ private:
   struct ChunkedDataQueueEntry
   {
     sf::Packet packet;
+    // If valid, the packet is still being built, and is sent once it's done. No packet means that
+    // building it failed, which aborts the game start.
+    std::future<std::optional<sf::Packet>> pending_packet;
     PlayerId target_pid{};
     TargetMode target_mode{};
     std::string title;
   };
 
+  using PacketBuildTask = std::shared_ptr<std::packaged_task<std::optional<sf::Packet>()>>;
+
+  // Builds the packet on m_packet_build_thread and sends it once it's done, in queue order.
+  void SendChunkedToClientsWhenReady(std::function<std::optional<sf::Packet>()> build_packet,
+                                     PlayerId skip_pid, const std::string& title);
+
   bool SetupNetSettings();
   bool SyncSaveData();
   bool SyncCodes();
@@ -144,6 +159,8 @@ private:
   void ChunkedDataSend(sf::Packet&& packet, PlayerId pid, const TargetMode target_mode);
   void ChunkedDataAbort();
 
+  ContentHashSet GetContentCachedByAllClients();
+
   void SetupIndex();
   bool PlayerHasControllerMapped(PlayerId pid) const;
 
@@ -191,6 +208,8 @@ private:
   Common::Event m_chunked_data_event;
   Common::Event m_chunked_data_complete_event;
   std::thread m_chunked_data_thread;
+  // Packets are built one at a time, as building one already compresses its chunks in parallel.
+  Common::WorkQueueThread<PacketBuildTask> m_packet_build_thread;
   u32 m_next_chunked_data_id = 0;
   std::unordered_map<u32, unsigned int> m_chunked_data_complete_count;
   bool m_abort_chunked_data = false;
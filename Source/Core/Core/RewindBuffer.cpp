@@ -0,0 +1,178 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/RewindBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <zstd.h>
+
+#include "Common/Assert.h"
+
+namespace State
+{
+constexpr int REWIND_ZSTD_LEVEL = 1;
+
+RewindBuffer::RewindBuffer(size_t memory_budget) : m_memory_budget(memory_budget)
+{
+  m_compression_thread.Reset([this](DeltaPtr delta) { CompressDelta(std::move(delta)); });
+}
+
+RewindBuffer::~RewindBuffer()
+{
+  m_compression_thread.Cancel();
+}
+
+std::vector<u8> RewindBuffer::Push(std::vector<u8> state)
+{
+  std::lock_guard lk(m_lock);
+
+  if (m_has_newest)
+  {
+    DeltaPtr delta = CreateDelta(m_newest, state);
+    m_delta_memory_usage += delta->data.size();
+    m_deltas.push_back(delta);
+    m_compression_thread.EmplaceItem(std::move(delta));
+  }
+
+  std::swap(m_newest, state);
+  m_has_newest = true;
+  DropOldStates();
+  return state;
+}
+
+bool RewindBuffer::Pop(std::vector<u8>* state)
+{
+  std::lock_guard lk(m_lock);
+  if (!m_has_newest)
+    return false;
+
+  if (m_deltas.empty())
+  {
+    *state = std::move(m_newest);
+    m_newest.clear();
+    m_has_newest = false;
+    return true;
+  }
+
+  *state = m_newest;
+  const DeltaPtr delta = std::move(m_deltas.back());
+  m_deltas.pop_back();
+  m_delta_memory_usage -= delta->data.size();
+  ApplyDelta(*delta, &m_newest);
+  return true;
+}
+
+void RewindBuffer::Clear()
+{
+  std::lock_guard lk(m_lock);
+  m_newest.clear();
+  m_has_newest = false;
+  m_deltas.clear();
+  m_delta_memory_usage = 0;
+}
+
+size_t RewindBuffer::GetStateCount() const
+{
+  std::lock_guard lk(m_lock);
+  return m_has_newest ? m_deltas.size() + 1 : 0;
+}
+
+size_t RewindBuffer::GetMemoryUsage() const
+{
+  std::lock_guard lk(m_lock);
+  return m_newest.size() + m_delta_memory_usage;
+}
+
+RewindBuffer::DeltaPtr RewindBuffer::CreateDelta(const std::vector<u8>& older,
+                                                 const std::vector<u8>& newer)
+{
+  auto delta = std::make_shared<Delta>();
+  delta->state_size = older.size();
+
+  if (older.size() != newer.size())
+  {
+    delta->full = true;
+    delta->data = older;
+  }
+  else
+  {
+    for (size_t offset = 0; offset < older.size(); offset += BLOCK_SIZE)
+    {
+      const size_t size = std::min(BLOCK_SIZE, older.size() - offset);
+      if (std::memcmp(older.data() + offset, newer.data() + offset, size) != 0)
+      {
+        delta->blocks.push_back(static_cast<u32>(offset / BLOCK_SIZE));
+        delta->data.insert(delta->data.end(), older.begin() + offset,
+                           older.begin() + offset + size);
+      }
+    }
+  }
+
+  delta->uncompressed_size = delta->data.size();
+  return delta;
+}
+
+void RewindBuffer::ApplyDelta(const Delta& delta, std::vector<u8>* state) const
+{
+  std::vector<u8> decompressed;
+  const std::vector<u8>* data = &delta.data;
+  if (delta.compressed)
+  {
+    decompressed.resize(delta.uncompressed_size);
+    const size_t result = ZSTD_decompress(decompressed.data(), decompressed.size(),
+                                          delta.data.data(), delta.data.size());
+    ASSERT(result == delta.uncompressed_size);
+    data = &decompressed;
+  }
+
+  if (delta.full)
+  {
+    state->assign(data->begin(), data->end());
+    return;
+  }
+
+  ASSERT(state->size() == delta.state_size);
+  size_t data_offset = 0;
+  for (const u32 block : delta.blocks)
+  {
+    const size_t offset = size_t{block} * BLOCK_SIZE;
+    const size_t size = std::min(BLOCK_SIZE, state->size() - offset);
+    std::memcpy(state->data() + offset, data->data() + data_offset, size);
+    data_offset += size;
+  }
+}
+
+void RewindBuffer::CompressDelta(DeltaPtr delta)
+{
+  // Nothing but this thread modifies the data of a delta, so it can be read without the lock.
+  std::vector<u8> compressed(ZSTD_compressBound(delta->data.size()));
+  const size_t compressed_size =
+      ZSTD_compress(compressed.data(), compressed.size(), delta->data.data(), delta->data.size(),
+                    REWIND_ZSTD_LEVEL);
+  if (ZSTD_isError(compressed_size) || compressed_size >= delta->data.size())
+    return;
+  compressed.resize(compressed_size);
+
+  std::lock_guard lk(m_lock);
+
+  // The delta may have been popped or dropped in the meantime.
+  const bool is_stored = std::find(m_deltas.begin(), m_deltas.end(), delta) != m_deltas.end();
+  if (is_stored)
+    m_delta_memory_usage -= delta->data.size() - compressed.size();
+
+  delta->data = std::move(compressed);
+  delta->compressed = true;
+}
+
+void RewindBuffer::DropOldStates()
+{
+  while (!m_deltas.empty() && m_newest.size() + m_delta_memory_usage > m_memory_budget)
+  {
+    m_delta_memory_usage -= m_deltas.front()->data.size();
+    m_deltas.pop_front();
+  }
+}
+}  // namespace State
@@ -0,0 +1,80 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+namespace State
+{
+// A bounded in-memory history of savestates, used for rewinding.
+//
+// Only the newest state is kept as is. Every older state is stored as the blocks in which it
+// differs from the state after it (a reverse delta), so each state only costs as much memory as
+// what changed in between, which is mostly the parts of MEM1/MEM2 the game wrote to plus the
+// device state. Deltas are compressed on a background thread. When the memory budget is exceeded,
+// the oldest states are dropped; no other state depends on them.
+class RewindBuffer
+{
+public:
+  static constexpr size_t BLOCK_SIZE = 4096;
+
+  explicit RewindBuffer(size_t memory_budget);
+  ~RewindBuffer();
+
+  RewindBuffer(const RewindBuffer&) = delete;
+  RewindBuffer& operator=(const RewindBuffer&) = delete;
+
+  // Adds a state, which becomes the newest one. Returns the storage of the previous newest state,
+  // which can be reused for the next state to avoid allocating a new one each time.
+  std::vector<u8> Push(std::vector<u8> state);
+
+  // Removes the newest state and returns it. Returns false if there are no states.
+  bool Pop(std::vector<u8>* state);
+
+  void Clear();
+
+  size_t GetStateCount() const;
+  size_t GetMemoryUsage() const;
+  size_t GetMemoryBudget() const { return m_memory_budget; }
+
+private:
+  struct Delta
+  {
+    // The blocks of the older state that differ from the newer one. If the states have different
+    // sizes, the whole older state is stored instead, and blocks is empty.
+    std::vector<u32> blocks;
+    size_t state_size = 0;
+    bool full = false;
+
+    // The contents of those blocks, concatenated.
+    std::vector<u8> data;
+    size_t uncompressed_size = 0;
+    bool compressed = false;
+  };
+  using DeltaPtr = std::shared_ptr<Delta>;
+
+  static DeltaPtr CreateDelta(const std::vector<u8>& older, const std::vector<u8>& newer);
+  void ApplyDelta(const Delta& delta, std::vector<u8>* state) const;
+  void CompressDelta(DeltaPtr delta);
+  void DropOldStates();
+
+  const size_t m_memory_budget;
+
+  mutable std::mutex m_lock;
+  std::vector<u8> m_newest;
+  bool m_has_newest = false;
+  std::deque<DeltaPtr> m_deltas;
+  size_t m_delta_memory_usage = 0;
+
+  // Declared last, so that the thread is stopped before the other members are destroyed.
+  Common::WorkQueueThread<DeltaPtr> m_compression_thread;
+};
+}  // namespace State
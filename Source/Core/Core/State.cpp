@@ -3,6 +3,9 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <lzo/lzo1x.h>
 #include <map>
 #include <mutex>
@@ -12,18 +15,22 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 #include "Common/Version.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -35,6 +42,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/RewindBuffer.h"
 
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/OnScreenDisplay.h"
@@ -52,12 +60,34 @@ static const u32 IN_LEN = 128 * 1024u;
 
 static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
+// Only used for loading states written by older versions, which were compressed with LZO.
 static unsigned char __LZO_MMODEL out[OUT_LEN];
 
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
+// States are compressed with zstd in independent chunks, so that both compression and
+// decompression can be spread across threads. The layout after the StateHeader is:
+//   CompressedStateHeader
+//   u32 compressed size of each chunk
+//   chunk data
+// StateHeader::size is set to 0 for these states. Older versions treat such states as
+// uncompressed, and reject them with a version mismatch as COMPRESSED_STATE_MAGIC isn't a valid
+// state version cookie.
+struct CompressedStateHeader
+{
+  u32 magic;
+  u32 chunk_size;
+  u32 chunk_count;
+  u32 reserved;
+  u64 uncompressed_size;
+};
+static_assert(sizeof(CompressedStateHeader) == 24);
 
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+constexpr u32 COMPRESSED_STATE_MAGIC = 0x31435344;  // "DSC1"
+constexpr u32 COMPRESSED_STATE_CHUNK_SIZE = 1024 * 1024;
+constexpr u32 COMPRESSED_STATE_MAX_CHUNK_SIZE = 64 * 1024 * 1024;
+// Far more than any state needs, even with the RAM sizes overridden. Only used to reject corrupted
+// headers before anything is allocated.
+constexpr u64 COMPRESSED_STATE_MAX_UNCOMPRESSED_SIZE = u64{1} << 30;
+constexpr int COMPRESSED_STATE_ZSTD_LEVEL = 1;
 
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
@@ -73,6 +103,22 @@ static Common::Event g_compressAndDumpStateSyncEvent;
 static std::recursive_mutex g_save_thread_mutex;
 static std::thread g_save_thread;
 
+static std::mutex s_rewind_mutex;
+// Shared, so that states can be pushed and popped without holding s_rewind_mutex, which
+// UpdateRewind takes every field.
+static std::shared_ptr<RewindBuffer> s_rewind_buffer;
+static std::vector<u8> s_rewind_state_buffer;
+static u32 s_fields_since_rewind_checkpoint = 0;
+static std::atomic<bool> s_rewind_checkpoint_pending = false;
+
+static size_t s_registered_config_callback_id;
+static bool s_config_rewind_enable;
+static u32 s_config_rewind_interval;
+static size_t s_config_rewind_memory_budget;
+
+// Size of the last state that was saved. Only accessed from the CPU thread while running.
+static size_t s_last_state_size = 0;
+
 // Don't forget to increase this after doing changes on the savestate system
 constexpr u32 STATE_VERSION = 144;  // Last changed in PR 10762
 
@@ -232,22 +278,32 @@ void LoadFromBuffer(std::vector<u8>& buffer)
       true);
 }
 
-void SaveToBuffer(std::vector<u8>& buffer)
+// Serializes the state into buffer in a single pass, growing it as needed.
+// Returns false (and leaves buffer empty) if some DoState aborted the save.
+static bool WriteStateToBuffer(std::vector<u8>& buffer)
 {
-  Core::RunOnCPUThread(
-      [&] {
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  // The state is almost always the same size as the last one, so start with that much space to
+  // avoid growing (and copying) the buffer while writing.
+  if (buffer.size() < s_last_state_size)
+    buffer.resize(s_last_state_size);
+
+  u8* ptr = nullptr;
+  PointerWrap p(&ptr, &buffer);
+  DoState(p);
+  if (!p.IsWriteMode())
+  {
+    buffer.clear();
+    return false;
+  }
 
-        DoState(p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-        buffer.resize(buffer_size);
+  buffer.resize(ptr - buffer.data());
+  s_last_state_size = buffer.size();
+  return true;
+}
 
-        ptr = buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(p);
-      },
-      true);
+void SaveToBuffer(std::vector<u8>& buffer)
+{
+  Core::RunOnCPUThread([&] { WriteStateToBuffer(buffer); }, true);
 }
 
 // return state number not in map
@@ -297,6 +353,92 @@ static std::map<double, int> GetSavedStates()
   return m;
 }
 
+static bool WriteCompressedState(File::IOFile& f, const u8* buffer_data, size_t buffer_size)
+{
+  CompressedStateHeader header{};
+  header.magic = COMPRESSED_STATE_MAGIC;
+  header.chunk_size = COMPRESSED_STATE_CHUNK_SIZE;
+  header.chunk_count = static_cast<u32>((buffer_size + header.chunk_size - 1) / header.chunk_size);
+  header.uncompressed_size = buffer_size;
+
+  std::vector<std::vector<u8>> chunks(header.chunk_count);
+  std::atomic_bool failed = false;
+  Common::ParallelFor(chunks.size(), [&](size_t i) {
+    const size_t offset = i * header.chunk_size;
+    const size_t size = std::min<size_t>(header.chunk_size, buffer_size - offset);
+
+    std::vector<u8>& chunk = chunks[i];
+    chunk.resize(ZSTD_compressBound(size));
+    const size_t compressed_size = ZSTD_compress(chunk.data(), chunk.size(), buffer_data + offset,
+                                                 size, COMPRESSED_STATE_ZSTD_LEVEL);
+    if (ZSTD_isError(compressed_size))
+      failed = true;
+    else
+      chunk.resize(compressed_size);
+  });
+
+  if (failed)
+  {
+    PanicAlertFmtT("Internal zstd error - compression failed");
+    return false;
+  }
+
+  std::vector<u32> chunk_sizes(chunks.size());
+  std::transform(chunks.begin(), chunks.end(), chunk_sizes.begin(),
+                 [](const std::vector<u8>& chunk) { return static_cast<u32>(chunk.size()); });
+
+  bool success = f.WriteArray(&header, 1) && f.WriteArray(chunk_sizes.data(), chunk_sizes.size());
+  for (const std::vector<u8>& chunk : chunks)
+    success = success && f.WriteBytes(chunk.data(), chunk.size());
+  return success;
+}
+
+// Reads a state written by WriteCompressedState, starting after the StateHeader.
+static bool ReadCompressedState(File::IOFile& f, std::vector<u8>& buffer)
+{
+  CompressedStateHeader header;
+  if (!f.ReadArray(&header, 1) || header.magic != COMPRESSED_STATE_MAGIC ||
+      header.chunk_size == 0 || header.chunk_size > COMPRESSED_STATE_MAX_CHUNK_SIZE ||
+      header.uncompressed_size > COMPRESSED_STATE_MAX_UNCOMPRESSED_SIZE ||
+      header.chunk_count !=
+          (header.uncompressed_size + header.chunk_size - 1) / header.chunk_size ||
+      u64{header.chunk_count} * sizeof(u32) > f.GetSize() - f.Tell())
+  {
+    return false;
+  }
+
+  std::vector<u32> chunk_sizes(header.chunk_count);
+  if (!f.ReadArray(chunk_sizes.data(), chunk_sizes.size()))
+    return false;
+
+  std::vector<u64> chunk_offsets(header.chunk_count);
+  u64 compressed_size = 0;
+  for (size_t i = 0; i < chunk_sizes.size(); ++i)
+  {
+    chunk_offsets[i] = compressed_size;
+    compressed_size += chunk_sizes[i];
+  }
+  if (compressed_size != f.GetSize() - f.Tell())
+    return false;
+
+  std::vector<u8> compressed(compressed_size);
+  if (!f.ReadBytes(compressed.data(), compressed.size()))
+    return false;
+
+  buffer.resize(header.uncompressed_size);
+  std::atomic_bool failed = false;
+  Common::ParallelFor(chunk_sizes.size(), [&](size_t i) {
+    const size_t offset = i * header.chunk_size;
+    const size_t size = std::min<size_t>(header.chunk_size, buffer.size() - offset);
+    const size_t result = ZSTD_decompress(buffer.data() + offset, size,
+                                          compressed.data() + chunk_offsets[i], chunk_sizes[i]);
+    if (result != size)
+      failed = true;
+  });
+
+  return !failed;
+}
+
 struct CompressAndDumpState_args
 {
   std::vector<u8>* buffer_vector = nullptr;
@@ -358,42 +500,21 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
   // Setting up the header
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.gameID, std::size(header.gameID));
-  header.size = s_use_compression ? (u32)buffer_size : 0;
+  header.size = 0;
   header.time = Common::Timer::GetDoubleTime();
 
   f.WriteArray(&header, 1);
 
-  if (header.size != 0)  // non-zero header size means the state is compressed
+  if (s_use_compression)
   {
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertFmtT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
-    }
+    const auto start_time = std::chrono::steady_clock::now();
+    WriteCompressedState(f, buffer_data, buffer_size);
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    INFO_LOG_FMT(CORE, "Compressed state from {} to {} bytes in {} ms", buffer_size, f.Tell(),
+                 duration.count());
   }
-  else  // uncompressed
+  else
   {
     f.WriteBytes(buffer_data, buffer_size);
   }
@@ -410,21 +531,10 @@ void SaveAs(const std::string& filename, bool wait)
 
   Core::RunOnCPUThread(
       [&] {
-        // Measure the size of the buffer.
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-        DoState(p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-        // Then actually do the write.
         bool is_write_mode;
         {
           std::lock_guard lk2(g_cs_current_buffer);
-          g_current_buffer.resize(buffer_size);
-          ptr = g_current_buffer.data();
-          PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-          DoState(p);
-          is_write_mode = p.IsWriteMode();
+          is_write_mode = WriteStateToBuffer(g_current_buffer);
         }
 
         if (is_write_mode)
@@ -507,7 +617,22 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
   std::vector<u8> buffer;
 
-  if (header.size != 0)  // non-zero size means the state is compressed
+  u32 magic = 0;
+  if (header.size == 0 && f.ReadArray(&magic, 1) && magic == COMPRESSED_STATE_MAGIC)
+  {
+    const auto start_time = std::chrono::steady_clock::now();
+    f.Seek(sizeof(StateHeader), File::SeekOrigin::Begin);
+    if (!ReadCompressedState(f, buffer))
+    {
+      Core::DisplayMessage("The savestate is corrupted", 2000);
+      return;
+    }
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    INFO_LOG_FMT(CORE, "Decompressed state from {} to {} bytes in {} ms", f.GetSize(),
+                 buffer.size(), duration.count());
+  }
+  else if (header.size != 0)  // LZO-compressed, from an older version
   {
     Core::DisplayMessage("Decompressing State...", 500);
 
@@ -538,6 +663,7 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
   }
   else  // uncompressed
   {
+    f.Seek(sizeof(StateHeader), File::SeekOrigin::Begin);
     const auto size = static_cast<size_t>(f.GetSize() - sizeof(StateHeader));
     buffer.resize(size);
 
@@ -629,14 +755,27 @@ void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback)
   s_on_after_load_callback = std::move(callback);
 }
 
+static void RefreshConfig()
+{
+  s_config_rewind_enable = Config::Get(Config::MAIN_REWIND_ENABLE);
+  s_config_rewind_interval = Config::Get(Config::MAIN_REWIND_INTERVAL);
+  s_config_rewind_memory_budget = size_t{Config::Get(Config::MAIN_REWIND_MEMORY_MB)} * 1024 * 1024;
+}
+
 void Init()
 {
   if (lzo_init() != LZO_E_OK)
     PanicAlertFmtT("Internal LZO Error - lzo_init() failed");
+
+  s_registered_config_callback_id =
+      Config::AddConfigChangedCallback([]() { Core::RunAsCPUThread([]() { RefreshConfig(); }); });
+  RefreshConfig();
 }
 
 void Shutdown()
 {
+  Config::RemoveConfigChangedCallback(s_registered_config_callback_id);
+
   Flush();
 
   // swapping with an empty vector, rather than clear()ing
@@ -647,10 +786,21 @@ void Shutdown()
     std::vector<u8>().swap(g_current_buffer);
   }
 
+  s_last_state_size = 0;
+
   {
     std::lock_guard lk(g_cs_undo_load_buffer);
     std::vector<u8>().swap(g_undo_load_buffer);
   }
+
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    s_rewind_buffer.reset();
+    std::vector<u8>().swap(s_rewind_state_buffer);
+    s_fields_since_rewind_checkpoint = 0;
+  }
+  // A pending checkpoint job is dropped when emulation stops.
+  s_rewind_checkpoint_pending = false;
 }
 
 static std::string MakeStateFilename(int number)
@@ -738,4 +888,81 @@ void UndoSaveState()
   LoadAs(File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav");
 }
 
+// Runs as a host job, so that the CPU thread is paused outside of event dispatch while the state
+// is saved. Saving from within the VI event would leave the VI event unscheduled in the state.
+static void SaveRewindCheckpoint()
+{
+  std::vector<u8> buffer;
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    buffer = std::move(s_rewind_state_buffer);
+  }
+
+  SaveToBuffer(buffer);
+
+  std::shared_ptr<RewindBuffer> rewind_buffer;
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    rewind_buffer = s_rewind_buffer;
+  }
+
+  // Computing the delta against the previous state compares the whole state, so don't block the
+  // CPU thread in UpdateRewind while doing so.
+  if (rewind_buffer && !buffer.empty())
+  {
+    buffer = rewind_buffer->Push(std::move(buffer));
+
+    std::lock_guard lk(s_rewind_mutex);
+    s_rewind_state_buffer = std::move(buffer);
+  }
+  s_rewind_checkpoint_pending = false;
+}
+
+void UpdateRewind()
+{
+  std::lock_guard lk(s_rewind_mutex);
+
+  if (!s_config_rewind_enable || NetPlay::IsNetPlayRunning() || Movie::IsMovieActive())
+  {
+    s_rewind_buffer.reset();
+    return;
+  }
+
+  if (!s_rewind_buffer || s_rewind_buffer->GetMemoryBudget() != s_config_rewind_memory_budget)
+    s_rewind_buffer = std::make_shared<RewindBuffer>(s_config_rewind_memory_budget);
+
+  if (++s_fields_since_rewind_checkpoint < s_config_rewind_interval)
+    return;
+  s_fields_since_rewind_checkpoint = 0;
+
+  // Don't queue up checkpoints if the host hasn't got around to the previous one yet.
+  if (!s_rewind_checkpoint_pending.exchange(true))
+    Core::QueueHostJob([] { SaveRewindCheckpoint(); });
+}
+
+void Rewind()
+{
+  if (NetPlay::IsNetPlayRunning())
+  {
+    OSD::AddMessage("Rewinding is disabled in Netplay to prevent desyncs");
+    return;
+  }
+
+  std::shared_ptr<RewindBuffer> rewind_buffer;
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    rewind_buffer = s_rewind_buffer;
+    s_fields_since_rewind_checkpoint = 0;
+  }
+
+  std::vector<u8> buffer;
+  if (!rewind_buffer || !rewind_buffer->Pop(&buffer))
+  {
+    Core::DisplayMessage("Nothing to rewind", 2000);
+    return;
+  }
+
+  LoadFromBuffer(buffer);
+}
+
 }  // namespace State
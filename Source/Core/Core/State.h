@@ -67,6 +67,12 @@ void UndoLoadState();
 // wait until previously scheduled savestate event (if any) is done
 void Flush();
 
+// Queues a host job which takes a rewind checkpoint every MAIN_REWIND_INTERVAL fields, if
+// rewinding is enabled. Must be called on the CPU thread once per video field.
+void UpdateRewind();
+// Loads the newest rewind checkpoint and discards it, so that repeated calls go further back.
+void Rewind();
+
 // for calling back into UI code without introducing a dependency on it in core
 using AfterLoadCallbackFunc = std::function<void()>;
 void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback);
@@ -0,0 +1,317 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateHash.h"
+
+#include <ctime>
+#include <memory>
+#include <type_traits>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/DSPEmulator.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/XFMemory.h"
+
+namespace StateHash
+{
+namespace
+{
+constexpr std::array<u8, 4> LOG_MAGIC = {'D', 'S', 'H', 0x1A};
+constexpr u32 LOG_VERSION = 1;
+
+#pragma pack(push, 1)
+struct LogHeader
+{
+  std::array<u8, 4> magic;
+  u32 version;
+  u32 num_subsystems;
+  u32 pad;
+};
+static_assert(sizeof(LogHeader) == 16);
+#pragma pack(pop)
+
+// Memory is too large to hash in full every frame. Instead, one stripe of it is rehashed per
+// frame, and the hash of a memory region is the hash of its stripe hashes. Changes to memory are
+// thus reflected in the hash within MEMORY_STRIPES frames. Which stripe is rehashed only depends
+// on the frame number, so two runs that log the same frames produce the same hashes.
+constexpr u32 MEMORY_STRIPES = 32;
+
+class StripedHash
+{
+public:
+  void Reset() { m_valid = false; }
+
+  u64 Update(const u8* data, u32 size, u64 frame)
+  {
+    const u32 stripe_size = size / MEMORY_STRIPES;
+    if (!m_valid || m_size != size)
+    {
+      for (u32 i = 0; i < MEMORY_STRIPES; ++i)
+        m_stripe_hashes[i] = Common::GetHash64(data + i * stripe_size, stripe_size, 0);
+      m_size = size;
+      m_valid = true;
+    }
+    else
+    {
+      const u32 i = static_cast<u32>(frame % MEMORY_STRIPES);
+      m_stripe_hashes[i] = Common::GetHash64(data + i * stripe_size, stripe_size, 0);
+    }
+
+    return Common::GetHash64(reinterpret_cast<const u8*>(m_stripe_hashes.data()),
+                             sizeof(m_stripe_hashes), 0);
+  }
+
+private:
+  std::array<u64, MEMORY_STRIPES> m_stripe_hashes{};
+  u32 m_size = 0;
+  bool m_valid = false;
+};
+
+// Mixes the hash of the given data into seed.
+u64 Combine(u64 seed, const void* data, size_t size)
+{
+  const u64 hash = Common::GetHash64(static_cast<const u8*>(data), static_cast<u32>(size), 0);
+  return (seed ^ hash) * 0x9E3779B97F4A7C15ULL;
+}
+
+template <typename T>
+u64 Combine(u64 seed, const T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  return Combine(seed, &value, sizeof(value));
+}
+
+u64 HashPowerPC()
+{
+  const PowerPC::PowerPCState& state = PowerPC::ppcState;
+  u64 hash = 0;
+  hash = Combine(hash, state.pc);
+  hash = Combine(hash, state.npc);
+  hash = Combine(hash, state.gpr);
+  hash = Combine(hash, state.ps);
+  hash = Combine(hash, state.cr.Get());
+  hash = Combine(hash, state.msr.Hex);
+  hash = Combine(hash, state.fpscr.Hex);
+  hash = Combine(hash, state.Exceptions);
+  hash = Combine(hash, state.xer_ca);
+  hash = Combine(hash, state.xer_so_ov);
+  hash = Combine(hash, state.xer_stringctrl);
+  hash = Combine(hash, state.sr);
+  hash = Combine(hash, state.spr);
+  return hash;
+}
+
+u64 HashVideo()
+{
+  // The video state belongs to the GPU thread, which is only in sync with the CPU thread at frame
+  // boundaries in single core mode.
+  if (Config::Get(Config::MAIN_CPU_THREAD))
+    return 0;
+
+  u64 hash = 0;
+  hash = Combine(hash, bpmem);
+  hash = Combine(hash, xfmem);
+  hash = Combine(hash, g_main_cp_state);
+  return hash;
+}
+
+struct Hasher
+{
+  StripedHash mem1;
+  StripedHash mem2;
+  StripedHash aram;
+  std::vector<u8> dsp_state;
+  std::optional<u64> last_frame;
+
+  u64 HashDSP(u64 frame)
+  {
+    DSPEmulator* const dsp = DSP::GetDSPEmulator();
+    // With LLE on a separate thread, the DSP doesn't run in lockstep with the frames.
+    if (!dsp || (dsp->IsLLE() && Config::Get(Config::MAIN_DSP_THREAD)))
+      return 0;
+
+    u8* ptr = nullptr;
+    PointerWrap p(&ptr, &dsp_state);
+    dsp->DoState(p);
+    u64 hash = Combine(0, dsp_state.data(), ptr - dsp_state.data());
+
+    // On the Wii, ARAM is part of MEM2.
+    if (!SConfig::GetInstance().bWii)
+      hash = Combine(hash, aram.Update(DSP::GetARAMPtr(), DSP::ARAM_SIZE, frame));
+
+    return hash;
+  }
+
+  FrameHashes Hash(u64 frame)
+  {
+    // Loading a savestate makes the stripe hashes stale.
+    if (last_frame && frame != *last_frame + 1)
+    {
+      mem1.Reset();
+      mem2.Reset();
+      aram.Reset();
+    }
+    last_frame = frame;
+
+    FrameHashes result;
+    result.frame = frame;
+    result.hashes[static_cast<size_t>(Subsystem::PowerPC)] = HashPowerPC();
+    result.hashes[static_cast<size_t>(Subsystem::MEM1)] =
+        mem1.Update(Memory::m_pRAM, Memory::GetRamSizeReal(), frame);
+    if (Memory::m_pEXRAM)
+    {
+      result.hashes[static_cast<size_t>(Subsystem::MEM2)] =
+          mem2.Update(Memory::m_pEXRAM, Memory::GetExRamSizeReal(), frame);
+    }
+    result.hashes[static_cast<size_t>(Subsystem::Video)] = HashVideo();
+    result.hashes[static_cast<size_t>(Subsystem::DSP)] = HashDSP(frame);
+    return result;
+  }
+};
+
+std::unique_ptr<LogWriter> s_log;
+std::unique_ptr<Hasher> s_hasher;
+}  // namespace
+
+std::string_view GetSubsystemName(Subsystem subsystem)
+{
+  switch (subsystem)
+  {
+  case Subsystem::PowerPC:
+    return "PowerPC";
+  case Subsystem::MEM1:
+    return "MEM1";
+  case Subsystem::MEM2:
+    return "MEM2";
+  case Subsystem::Video:
+    return "Video";
+  case Subsystem::DSP:
+    return "DSP";
+  }
+  return "Unknown";
+}
+
+LogWriter::LogWriter(const std::string& path) : m_file(path, "wb")
+{
+  const LogHeader header{LOG_MAGIC, LOG_VERSION, static_cast<u32>(NUM_SUBSYSTEMS), 0};
+  if (!m_file.WriteArray(&header, 1))
+    m_file.Close();
+}
+
+void LogWriter::Write(const FrameHashes& hashes)
+{
+  m_file.WriteArray(&hashes.frame, 1);
+  m_file.WriteArray(hashes.hashes.data(), hashes.hashes.size());
+}
+
+std::optional<std::vector<FrameHashes>> ReadLog(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  LogHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != LOG_MAGIC || header.version != LOG_VERSION ||
+      header.num_subsystems != NUM_SUBSYSTEMS)
+  {
+    return std::nullopt;
+  }
+
+  constexpr u64 record_size = sizeof(u64) * (1 + NUM_SUBSYSTEMS);
+  std::vector<FrameHashes> frames((file.GetSize() - sizeof(LogHeader)) / record_size);
+  for (FrameHashes& frame : frames)
+  {
+    if (!file.ReadArray(&frame.frame, 1) ||
+        !file.ReadArray(frame.hashes.data(), frame.hashes.size()))
+    {
+      return std::nullopt;
+    }
+  }
+
+  return frames;
+}
+
+std::optional<Divergence> FindFirstDivergence(const std::vector<FrameHashes>& a,
+                                              const std::vector<FrameHashes>& b)
+{
+  auto it_a = a.begin();
+  auto it_b = b.begin();
+  while (it_a != a.end() && it_b != b.end())
+  {
+    if (it_a->frame < it_b->frame)
+    {
+      ++it_a;
+    }
+    else if (it_b->frame < it_a->frame)
+    {
+      ++it_b;
+    }
+    else
+    {
+      if (it_a->hashes != it_b->hashes)
+      {
+        Divergence divergence;
+        divergence.frame = it_a->frame;
+        for (size_t i = 0; i < NUM_SUBSYSTEMS; ++i)
+        {
+          if (it_a->hashes[i] != it_b->hashes[i])
+            divergence.subsystems.push_back(static_cast<Subsystem>(i));
+        }
+        return divergence;
+      }
+      ++it_a;
+      ++it_b;
+    }
+  }
+
+  return std::nullopt;
+}
+
+void Init()
+{
+  if (!Config::Get(Config::MAIN_MOVIE_LOG_STATE_HASHES))
+    return;
+
+  Common::SetHash64Function();
+
+  const std::string directory = File::GetUserPath(D_DUMP_IDX) + "StateHashes/";
+  File::CreateFullPath(directory);
+  const std::string path =
+      fmt::format("{}{}_{:%Y-%m-%d_%H-%M-%S}.dsh", directory, SConfig::GetInstance().GetGameID(),
+                  fmt::localtime(std::time(nullptr)));
+
+  auto log = std::make_unique<LogWriter>(path);
+  if (!log->IsOpen())
+  {
+    ERROR_LOG_FMT(CORE, "Failed to open state hash log {}", path);
+    return;
+  }
+
+  NOTICE_LOG_FMT(CORE, "Logging state hashes to {}", path);
+  s_log = std::move(log);
+  s_hasher = std::make_unique<Hasher>();
+}
+
+void Shutdown()
+{
+  s_log.reset();
+  s_hasher.reset();
+}
+
+void FrameUpdate(u64 frame)
+{
+  if (!s_log)
+    return;
+
+  s_log->Write(s_hasher->Hash(frame));
+}
+}  // namespace StateHash
@@ -0,0 +1,70 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+// Per-frame hashes of the emulated machine state, for verifying that two runs of the same movie
+// or replay stay in sync without having to compare full savestates.
+namespace StateHash
+{
+enum class Subsystem
+{
+  PowerPC,
+  MEM1,
+  MEM2,
+  Video,
+  DSP,
+};
+constexpr size_t NUM_SUBSYSTEMS = 5;
+
+std::string_view GetSubsystemName(Subsystem subsystem);
+
+struct FrameHashes
+{
+  u64 frame = 0;
+  std::array<u64, NUM_SUBSYSTEMS> hashes{};
+
+  u64 Get(Subsystem subsystem) const { return hashes[static_cast<size_t>(subsystem)]; }
+};
+
+struct Divergence
+{
+  u64 frame = 0;
+  std::vector<Subsystem> subsystems;
+};
+
+class LogWriter
+{
+public:
+  explicit LogWriter(const std::string& path);
+
+  bool IsOpen() const { return m_file.IsOpen(); }
+  void Write(const FrameHashes& hashes);
+
+private:
+  File::IOFile m_file;
+};
+
+std::optional<std::vector<FrameHashes>> ReadLog(const std::string& path);
+// Compares the hashes of frames that are present in both logs. The logs have to be sorted by
+// frame, which they are unless a savestate was loaded while logging.
+std::optional<Divergence> FindFirstDivergence(const std::vector<FrameHashes>& a,
+                                              const std::vector<FrameHashes>& b);
+
+// Starts logging the state hashes of each frame, if enabled in the config.
+// NOTE: EmuThread
+void Init();
+void Shutdown();
+
+// NOTE: CPU Thread
+void FrameUpdate(u64 frame);
+}  // namespace StateHash
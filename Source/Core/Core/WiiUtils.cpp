@@ -30,6 +30,7 @@
 #include "Common/Swap.h"
 #include "Core/CommonTitles.h"
 #include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/ES/ES.h"
 #include "Core/IOS/ES/Formats.h"
@@ -194,6 +195,16 @@ bool InstallWAD(IOS::HLE::Kernel& ios, const DiscIO::VolumeWAD& wad, InstallType
   return true;
 }
 
+// Titles which are changed through a separate kernel are not seen by the ES of the emulated IOS
+// until its cached metadata is dropped.
+static void InvalidateEmulatedMetadataCache()
+{
+  Core::RunAsCPUThread([] {
+    if (IOS::HLE::EmulationKernel* ios = IOS::HLE::GetIOS())
+      ios->GetES()->InvalidateMetadataCache();
+  });
+}
+
 bool InstallWAD(const std::string& wad_path)
 {
   std::unique_ptr<DiscIO::VolumeWAD> wad = DiscIO::CreateWAD(wad_path);
@@ -201,13 +212,17 @@ bool InstallWAD(const std::string& wad_path)
     return false;
 
   IOS::HLE::Kernel ios;
-  return InstallWAD(ios, *wad, InstallType::Permanent);
+  const bool success = InstallWAD(ios, *wad, InstallType::Permanent);
+  InvalidateEmulatedMetadataCache();
+  return success;
 }
 
 bool UninstallTitle(u64 title_id)
 {
   IOS::HLE::Kernel ios;
-  return ios.GetES()->DeleteTitleContent(title_id) == IOS::HLE::IPC_SUCCESS;
+  const bool success = ios.GetES()->DeleteTitleContent(title_id) == IOS::HLE::IPC_SUCCESS;
+  InvalidateEmulatedMetadataCache();
+  return success;
 }
 
 bool IsTitleInstalled(u64 title_id)
@@ -959,6 +974,14 @@ static NANDCheckResult CheckNAND(IOS::HLE::Kernel& ios, bool repair)
     }
   }
 
+  // Titles were deleted behind the back of ES.
+  if (repair && !result.titles_to_remove.empty())
+  {
+    es->InvalidateMetadataCache();
+    if (&ios != IOS::HLE::GetIOS())
+      InvalidateEmulatedMetadataCache();
+  }
+
   return result;
 }
 
@@ -0,0 +1,424 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/BatchRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+
+namespace BatchRunner
+{
+namespace
+{
+// How long a stopped instance gets to shut down before it is killed.
+constexpr std::chrono::seconds STOP_GRACE_PERIOD{10};
+
+#ifdef _WIN32
+using ProcessHandle = HANDLE;
+#else
+using ProcessHandle = pid_t;
+#endif
+
+struct Job
+{
+  size_t index;
+  std::vector<std::string> args;
+};
+
+struct Instance
+{
+  const Job* job;
+  ProcessHandle process;
+  std::chrono::steady_clock::time_point start_time;
+  std::optional<std::chrono::steady_clock::time_point> stop_time;
+};
+
+std::vector<std::string> SplitArguments(std::string_view line)
+{
+  std::vector<std::string> args;
+  std::string current;
+  bool in_argument = false;
+  bool in_quotes = false;
+  for (const char c : line)
+  {
+    if (c == '"')
+    {
+      in_quotes = !in_quotes;
+      in_argument = true;
+    }
+    else if (!in_quotes && (c == ' ' || c == '\t'))
+    {
+      if (in_argument)
+        args.push_back(std::move(current));
+      current.clear();
+      in_argument = false;
+    }
+    else
+    {
+      current += c;
+      in_argument = true;
+    }
+  }
+
+  if (in_argument)
+    args.push_back(std::move(current));
+  return args;
+}
+
+std::optional<std::vector<Job>> ReadJobList(const std::string& path)
+{
+  std::ifstream file;
+  File::OpenFStream(file, path, std::ios_base::in);
+  if (!file.is_open())
+    return std::nullopt;
+
+  std::vector<Job> jobs;
+  std::string line;
+  while (std::getline(file, line))
+  {
+    const std::string_view stripped = StripSpaces(line);
+    if (stripped.empty() || stripped.front() == '#')
+      continue;
+
+    jobs.push_back({jobs.size(), SplitArguments(stripped)});
+  }
+  return jobs;
+}
+
+// Each of the instances that run at the same time gets its own set of host cores, so that the
+// instances don't compete for cores or keep migrating between them.
+std::vector<u32> GetSlotCores(size_t slot, size_t num_slots)
+{
+  const u32 num_cores = std::max(1u, std::thread::hardware_concurrency());
+  const u32 cores_per_slot = std::max<u32>(1, num_cores / static_cast<u32>(num_slots));
+
+  std::vector<u32> cores;
+  for (u32 i = 0; i < cores_per_slot; ++i)
+    cores.push_back((static_cast<u32>(slot) * cores_per_slot + i) % num_cores);
+  return cores;
+}
+
+// Instances start from a fresh user folder, so that saves made by an earlier run can't affect the
+// result. Only the configuration is copied over.
+bool PrepareUserFolder(const std::string& path)
+{
+  if (File::IsDirectory(path) && !File::DeleteDirRecursively(path))
+    return false;
+
+  if (!File::CreateFullPath(path))
+    return false;
+
+  File::CopyDir(File::GetUserPath(D_CONFIG_IDX), path + CONFIG_DIR DIR_SEP);
+  File::CopyDir(File::GetUserPath(D_GAMESETTINGS_IDX), path + GAMESETTINGS_DIR DIR_SEP);
+  return true;
+}
+
+#ifdef _WIN32
+std::wstring QuoteArgument(const std::string& arg)
+{
+  const std::wstring warg = UTF8ToWString(arg);
+  if (!warg.empty() && warg.find_first_of(L" \t\"") == std::wstring::npos)
+    return warg;
+
+  // Backslashes are only special when they precede a double quote.
+  std::wstring result = L"\"";
+  size_t backslashes = 0;
+  for (const wchar_t c : warg)
+  {
+    if (c == L'\\')
+    {
+      ++backslashes;
+      continue;
+    }
+
+    result.append(c == L'"' ? backslashes * 2 + 1 : backslashes, L'\\');
+    result += c;
+    backslashes = 0;
+  }
+  result.append(backslashes * 2, L'\\');
+  result += L'"';
+  return result;
+}
+
+std::optional<ProcessHandle> StartProcess(const std::vector<std::string>& args,
+                                          const std::string& log_path,
+                                          const std::vector<u32>& cores)
+{
+  std::wstring command_line;
+  for (const std::string& arg : args)
+  {
+    if (!command_line.empty())
+      command_line += L' ';
+    command_line += QuoteArgument(arg);
+  }
+
+  SECURITY_ATTRIBUTES security_attributes{sizeof(security_attributes), nullptr, TRUE};
+  const HANDLE log =
+      CreateFileW(UTF8ToWString(log_path).c_str(), GENERIC_WRITE, FILE_SHARE_READ,
+                  &security_attributes, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  STARTUPINFOW startup_info{};
+  startup_info.cb = sizeof(startup_info);
+  if (log != INVALID_HANDLE_VALUE)
+  {
+    startup_info.dwFlags = STARTF_USESTDHANDLES;
+    startup_info.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    startup_info.hStdOutput = log;
+    startup_info.hStdError = log;
+  }
+
+  // The process is started suspended so that its affinity is set before any threads exist.
+  PROCESS_INFORMATION process_info{};
+  const BOOL success = CreateProcessW(nullptr, command_line.data(), nullptr, nullptr, TRUE,
+                                      CREATE_SUSPENDED, nullptr, nullptr, &startup_info,
+                                      &process_info);
+  if (log != INVALID_HANDLE_VALUE)
+    CloseHandle(log);
+  if (!success)
+    return std::nullopt;
+
+  DWORD_PTR mask = 0;
+  for (const u32 core : cores)
+  {
+    if (core < sizeof(mask) * 8)
+      mask |= DWORD_PTR(1) << core;
+  }
+  if (mask != 0)
+    SetProcessAffinityMask(process_info.hProcess, mask);
+
+  ResumeThread(process_info.hThread);
+  CloseHandle(process_info.hThread);
+  return process_info.hProcess;
+}
+
+std::optional<int> PollProcess(ProcessHandle process)
+{
+  DWORD exit_code;
+  if (WaitForSingleObject(process, 0) != WAIT_OBJECT_0 || !GetExitCodeProcess(process, &exit_code))
+    return std::nullopt;
+
+  CloseHandle(process);
+  return static_cast<int>(exit_code);
+}
+
+void StopProcess(ProcessHandle process, bool force)
+{
+  // A console process without a window can't be asked to exit.
+  TerminateProcess(process, 1);
+}
+#else
+std::optional<ProcessHandle> StartProcess(const std::vector<std::string>& args,
+                                          const std::string& log_path,
+                                          const std::vector<u32>& cores)
+{
+  std::vector<char*> argv;
+  for (const std::string& arg : args)
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  argv.push_back(nullptr);
+
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const u32 core : cores)
+    CPU_SET(core, &cpu_set);
+#endif
+
+  const pid_t pid = fork();
+  if (pid < 0)
+    return std::nullopt;
+
+  if (pid == 0)
+  {
+    // Only async-signal-safe functions may be used between fork and exec. The affinity is
+    // inherited by every thread that the instance creates.
+    const int fd = open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0)
+    {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+      close(fd);
+    }
+#ifdef __linux__
+    sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
+#endif
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+
+  return pid;
+}
+
+std::optional<int> PollProcess(ProcessHandle process)
+{
+  int status;
+  if (waitpid(process, &status, WNOHANG) != process)
+    return std::nullopt;
+
+  return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+void StopProcess(ProcessHandle process, bool force)
+{
+  // Instances shut down cleanly on SIGTERM, just like when they're run from a terminal.
+  kill(process, force ? SIGKILL : SIGTERM);
+}
+#endif
+
+std::string JoinArguments(const std::vector<std::string>& args)
+{
+  std::string result;
+  for (const std::string& arg : args)
+  {
+    if (!result.empty())
+      result += ' ';
+    result += arg;
+  }
+  return result;
+}
+}  // namespace
+
+int Run(const Options& options)
+{
+  const std::optional<std::vector<Job>> jobs = ReadJobList(options.job_list_path);
+  if (!jobs)
+  {
+    fmt::print(stderr, "Could not read the job list {}\n", options.job_list_path);
+    return 1;
+  }
+  if (jobs->empty())
+    return 0;
+
+  const u32 num_cores = std::max(1u, std::thread::hardware_concurrency());
+  const u32 max_instances =
+      options.max_instances != 0 ? options.max_instances : std::max(1u, num_cores / 2);
+  const size_t num_slots = std::min<size_t>(jobs->size(), max_instances);
+
+  // Instances read from our caches and the Load folder, but write to their own user folders.
+  // Emulation speed is unlimited, as the point of a batch is to get through it quickly.
+  std::vector<std::string> base_args = {
+      options.executable_path,
+      "--platform",
+      "headless",
+      "-C",
+      "Dolphin.Core.EmulationSpeed=0",
+      "-C",
+      "Dolphin.General.LoadPath=" + File::GetUserPath(D_LOAD_IDX),
+      "-C",
+      "Dolphin.General.ResourcePackPath=" + File::GetUserPath(D_RESOURCEPACK_IDX),
+      "-C",
+      "Dolphin.General.SharedCachePath=" + File::GetUserPath(D_CACHE_IDX),
+  };
+  base_args.insert(base_args.end(), options.instance_args.begin(), options.instance_args.end());
+
+  std::string instance_path = options.instance_path;
+  if (!instance_path.empty() && instance_path.back() != '/')
+    instance_path += '/';
+
+  fmt::print("Running {} jobs in {} instances\n", jobs->size(), num_slots);
+
+  std::vector<std::optional<Instance>> slots(num_slots);
+  size_t next_job = 0;
+  size_t num_failed = 0;
+  while (true)
+  {
+    bool any_running = false;
+    for (size_t slot = 0; slot < num_slots; ++slot)
+    {
+      std::optional<Instance>& instance = slots[slot];
+      const auto now = std::chrono::steady_clock::now();
+
+      if (instance)
+      {
+        const std::optional<int> exit_code = PollProcess(instance->process);
+        if (!exit_code)
+        {
+          any_running = true;
+
+          const bool timed_out = options.timeout_seconds != 0 &&
+                                 now - instance->start_time >=
+                                     std::chrono::seconds(options.timeout_seconds);
+          if (timed_out && !instance->stop_time)
+          {
+            StopProcess(instance->process, false);
+            instance->stop_time = now;
+          }
+          else if (instance->stop_time && now - *instance->stop_time >= STOP_GRACE_PERIOD)
+          {
+            StopProcess(instance->process, true);
+          }
+          continue;
+        }
+
+        const auto seconds =
+            std::chrono::duration_cast<std::chrono::seconds>(now - instance->start_time).count();
+        fmt::print("Job {} {} with exit code {} after {} s\n", instance->job->index,
+                   instance->stop_time ? "was stopped" : "exited", *exit_code, seconds);
+        if (*exit_code != 0)
+          ++num_failed;
+        instance.reset();
+      }
+
+      if (next_job == jobs->size())
+        continue;
+
+      const Job& job = (*jobs)[next_job++];
+      const std::string user_path = fmt::format("{}{}/", instance_path, job.index);
+      if (!PrepareUserFolder(user_path))
+      {
+        fmt::print(stderr, "Job {}: could not create the user folder {}\n", job.index, user_path);
+        ++num_failed;
+        continue;
+      }
+
+      std::vector<std::string> args = base_args;
+      args.push_back("--user");
+      args.push_back(user_path);
+      args.insert(args.end(), job.args.begin(), job.args.end());
+
+      const std::optional<ProcessHandle> process =
+          StartProcess(args, user_path + "output.log", GetSlotCores(slot, num_slots));
+      if (!process)
+      {
+        fmt::print(stderr, "Job {}: could not start {}\n", job.index, options.executable_path);
+        ++num_failed;
+        continue;
+      }
+
+      fmt::print("Job {} started: {}\n", job.index, JoinArguments(job.args));
+      instance = Instance{&job, *process, now, std::nullopt};
+      any_running = true;
+    }
+
+    if (!any_running && next_job == jobs->size())
+      break;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  fmt::print("{} of {} jobs succeeded\n", jobs->size() - num_failed, jobs->size());
+  return num_failed == 0 ? 0 : 1;
+}
+}  // namespace BatchRunner
@@ -0,0 +1,35 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Runs a list of jobs in parallel, each in a separate headless instance of dolphin-emu-nogui with
+// its own user folder. The instances use the configuration and the Load folder of the user folder
+// that the batch was started with, and read its caches without writing to them.
+namespace BatchRunner
+{
+struct Options
+{
+  std::string executable_path;
+  // Each line is one job, and holds the command-line arguments of its instance, for example
+  // "-m movie.dtm game.rvz". Arguments with spaces can be put in double quotes. Empty lines and
+  // lines starting with # are ignored.
+  std::string job_list_path;
+  // Each job runs in a numbered subfolder of this folder, which is cleared before it starts.
+  std::string instance_path;
+  // Arguments which are passed to every instance, before the arguments of the job.
+  std::vector<std::string> instance_args;
+  // Number of instances that run at the same time. 0 runs one instance per two host cores.
+  u32 max_instances = 0;
+  // Instances which are still running after this many seconds are stopped. 0 means no limit.
+  u32 timeout_seconds = 0;
+};
+
+// Returns 0 if every job ran and exited successfully.
+int Run(const Options& options);
+}  // namespace BatchRunner
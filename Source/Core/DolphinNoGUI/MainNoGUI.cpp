@@ -1,9 +1,11 @@
 // Copyright 2008 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "DolphinNoGUI/BatchRunner.h"
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
@@ -11,12 +13,15 @@
 #include <string>
 #include <vector>
 
+#include <fmt/format.h>
+
 #ifndef _WIN32
 #include <unistd.h>
 #else
 #include <Windows.h>
 #endif
 
+#include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
@@ -126,6 +131,39 @@ std::unique_ptr<GBAHostInterface> Host_CreateGBAHost(std::weak_ptr<HW::GBA::Core
   return nullptr;
 }
 
+static int RunBatch(const optparse::Values& options, const char* executable_path)
+{
+  BatchRunner::Options batch_options;
+  batch_options.executable_path = executable_path;
+  batch_options.job_list_path = static_cast<const char*>(options.get("batch_list"));
+  if (options.is_set("batch_dir"))
+    batch_options.instance_path = static_cast<const char*>(options.get("batch_dir"));
+  else
+    batch_options.instance_path = File::GetUserPath(D_USER_IDX) + "Batch/";
+  if (options.is_set("batch_instances"))
+    batch_options.max_instances = std::max(0, static_cast<int>(options.get("batch_instances")));
+  if (options.is_set("batch_timeout"))
+    batch_options.timeout_seconds = std::max(0, static_cast<int>(options.get("batch_timeout")));
+
+  // Settings from the command line aren't saved, so they have to be passed on.
+  if (options.is_set_by_user("config"))
+  {
+    for (const std::string& config : options.all("config"))
+    {
+      batch_options.instance_args.push_back("-C");
+      batch_options.instance_args.push_back(config);
+    }
+  }
+  for (const char* option : {"video_backend", "audio_emulation"})
+  {
+    const std::string value = static_cast<const char*>(options.get(option));
+    if (!value.empty())
+      batch_options.instance_args.push_back(fmt::format("--{}={}", option, value));
+  }
+
+  return BatchRunner::Run(batch_options);
+}
+
 static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
 {
   std::string platform_name = static_cast<const char*>(options.get("platform"));
@@ -176,10 +214,44 @@ int main(int argc, char* argv[])
             "win32"
 #endif
       });
+  parser->add_option("--batch_list")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Run the jobs in the given file in parallel headless instances. Each line holds the "
+            "arguments of one instance, e.g. a movie and a game");
+  parser->add_option("--batch_dir")
+      .action("store")
+      .metavar("<dir>")
+      .type("string")
+      .help("Folder for the user folders of the batch instances (default: Batch in the user "
+            "folder)");
+  parser->add_option("--batch_instances")
+      .action("store")
+      .type("int")
+      .help("Number of batch instances to run at the same time (default: one per two cores)");
+  parser->add_option("--batch_timeout")
+      .action("store")
+      .metavar("<seconds>")
+      .type("int")
+      .help("Stop batch instances which are still running after the given time");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
 
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+
+  if (options.is_set("batch_list"))
+  {
+    UICommon::SetUserDirectory(user_directory);
+    UICommon::Init();
+    const int result = RunBatch(options, argv[0]);
+    UICommon::Shutdown();
+    return result;
+  }
+
   std::optional<std::string> save_state_path;
   if (options.is_set("save_state"))
   {
@@ -222,10 +294,6 @@ int main(int argc, char* argv[])
     return 0;
   }
 
-  std::string user_directory;
-  if (options.is_set("user"))
-    user_directory = static_cast<const char*>(options.get("user"));
-
   UICommon::SetUserDirectory(user_directory);
   UICommon::Init();
   GCAdapter::Init();
@@ -106,11 +106,17 @@ void HacksWidget::CreateWidgets()
   m_vertex_rounding = new GraphicsBool(tr("Vertex Rounding"), Config::GFX_HACK_VERTEX_ROUNDING);
   m_save_texture_cache_state =
       new GraphicsBool(tr("Save Texture Cache to State"), Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE);
+  m_async_vertex_loading =
+      new GraphicsBool(tr("Threaded Vertex Loading"), Config::GFX_ASYNC_VERTEX_LOADING);
+  m_vertex_loader_cache =
+      new GraphicsBool(tr("Cache Display List Vertices"), Config::GFX_VERTEX_LOADER_CACHE);
 
   other_layout->addWidget(m_fast_depth_calculation, 0, 0);
   other_layout->addWidget(m_disable_bounding_box, 0, 1);
   other_layout->addWidget(m_vertex_rounding, 1, 0);
   other_layout->addWidget(m_save_texture_cache_state, 1, 1);
+  other_layout->addWidget(m_async_vertex_loading, 2, 0);
+  other_layout->addWidget(m_vertex_loader_cache, 2, 1);
 
   main_layout->addWidget(efb_box);
   main_layout->addWidget(texture_cache_box);
@@ -279,6 +285,16 @@ void HacksWidget::AddDescriptions()
       "Fixes graphical problems in some games at higher internal resolutions. This setting has no "
       "effect when native internal resolution is used.<br><br>"
       "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
+  static const char TR_ASYNC_VERTEX_LOADING_DESCRIPTION[] = QT_TR_NOOP(
+      "Converts vertices to the host format on a separate thread, while the GPU thread continues "
+      "processing commands and loading textures.<br><br>This may improve performance on systems "
+      "with more than two CPU cores in games that draw a lot of geometry.<br><br>"
+      "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
+  static const char TR_VERTEX_LOADER_CACHE_DESCRIPTION[] = QT_TR_NOOP(
+      "Keeps the converted vertices of display lists, so that they can be reused when a game "
+      "draws the same display list again.<br><br>Vertex data is hashed to detect changes, which "
+      "costs some performance in games that rarely redraw the same geometry.<br><br>"
+      "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
 
   m_skip_efb_cpu->SetDescription(tr(TR_SKIP_EFB_CPU_ACCESS_DESCRIPTION));
   m_ignore_format_changes->SetDescription(tr(TR_IGNORE_FORMAT_CHANGE_DESCRIPTION));
@@ -294,6 +310,8 @@ void HacksWidget::AddDescriptions()
   m_disable_bounding_box->SetDescription(tr(TR_DISABLE_BOUNDINGBOX_DESCRIPTION));
   m_save_texture_cache_state->SetDescription(tr(TR_SAVE_TEXTURE_CACHE_TO_STATE_DESCRIPTION));
   m_vertex_rounding->SetDescription(tr(TR_VERTEX_ROUNDING_DESCRIPTION));
+  m_async_vertex_loading->SetDescription(tr(TR_ASYNC_VERTEX_LOADING_DESCRIPTION));
+  m_vertex_loader_cache->SetDescription(tr(TR_VERTEX_LOADER_CACHE_DESCRIPTION));
 }
 
 void HacksWidget::UpdateDeferEFBCopiesEnabled()
@@ -43,6 +43,8 @@ private:
   GraphicsBool* m_disable_bounding_box;
   GraphicsBool* m_vertex_rounding;
   GraphicsBool* m_save_texture_cache_state;
+  GraphicsBool* m_async_vertex_loading;
+  GraphicsBool* m_vertex_loader_cache;
 
   void CreateWidgets();
   void ConnectWidgets();
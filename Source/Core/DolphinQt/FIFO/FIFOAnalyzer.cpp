@@ -118,6 +118,7 @@ void FIFOAnalyzer::CreateWidgets()
 void FIFOAnalyzer::ConnectWidgets()
 {
   connect(m_tree_widget, &QTreeWidget::itemSelectionChanged, this, &FIFOAnalyzer::UpdateDetails);
+  connect(m_tree_widget, &QTreeWidget::itemExpanded, this, &FIFOAnalyzer::PopulateFrame);
   connect(m_detail_list, &QListWidget::itemSelectionChanged, this,
           &FIFOAnalyzer::UpdateDescription);
 
@@ -155,48 +156,64 @@ void FIFOAnalyzer::UpdateTree()
   for (u32 frame = 0; frame < frame_count; frame++)
   {
     auto* frame_item = new QTreeWidgetItem({tr("Frame %1").arg(frame)});
+    frame_item->setData(0, FRAME_ROLE, frame);
+
+    // The objects are only added once the frame is expanded, as that requires analyzing the frame.
+    frame_item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
 
     recording_item->addChild(frame_item);
+  }
+}
 
-    const AnalyzedFrameInfo& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame);
-    ASSERT(frame_info.parts.size() != 0);
+void FIFOAnalyzer::PopulateFrame(QTreeWidgetItem* frame_item)
+{
+  // Only frame items are populated, and only once.
+  if (frame_item->childCount() != 0 || frame_item->data(0, FRAME_ROLE).isNull())
+    return;
 
-    Common::EnumMap<u32, FramePartType::EFBCopy> part_counts;
-    u32 part_start = 0;
+  const u32 frame = frame_item->data(0, FRAME_ROLE).toUInt();
+  const auto frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame);
+  if (!frame_info)
+    return;
+  ASSERT(frame_info->parts.size() != 0);
 
-    for (u32 part_nr = 0; part_nr < frame_info.parts.size(); part_nr++)
-    {
-      const auto& part = frame_info.parts[part_nr];
+  Common::EnumMap<u32, FramePartType::EFBCopy> part_counts;
+  u32 part_start = 0;
 
-      const u32 part_type_nr = part_counts[part.m_type];
-      part_counts[part.m_type]++;
+  for (u32 part_nr = 0; part_nr < frame_info->parts.size(); part_nr++)
+  {
+    const auto& part = frame_info->parts[part_nr];
 
-      QTreeWidgetItem* object_item = nullptr;
-      if (part.m_type == FramePartType::PrimitiveData)
-        object_item = new QTreeWidgetItem({tr("Object %1").arg(part_type_nr)});
-      else if (part.m_type == FramePartType::EFBCopy)
-        object_item = new QTreeWidgetItem({tr("EFB copy %1").arg(part_type_nr)});
-      // We don't create dedicated labels for FramePartType::Command;
-      // those are grouped with the primitive
+    const u32 part_type_nr = part_counts[part.m_type];
+    part_counts[part.m_type]++;
 
-      if (object_item != nullptr)
-      {
-        frame_item->addChild(object_item);
+    QTreeWidgetItem* object_item = nullptr;
+    if (part.m_type == FramePartType::PrimitiveData)
+      object_item = new QTreeWidgetItem({tr("Object %1").arg(part_type_nr)});
+    else if (part.m_type == FramePartType::EFBCopy)
+      object_item = new QTreeWidgetItem({tr("EFB copy %1").arg(part_type_nr)});
+    // We don't create dedicated labels for FramePartType::Command;
+    // those are grouped with the primitive
 
-        object_item->setData(0, FRAME_ROLE, frame);
-        object_item->setData(0, PART_START_ROLE, part_start);
-        object_item->setData(0, PART_END_ROLE, part_nr);
+    if (object_item != nullptr)
+    {
+      frame_item->addChild(object_item);
 
-        part_start = part_nr + 1;
-      }
-    }
+      object_item->setData(0, FRAME_ROLE, frame);
+      object_item->setData(0, PART_START_ROLE, part_start);
+      object_item->setData(0, PART_END_ROLE, part_nr);
 
-    // We shouldn't end on a Command (it should end with an EFB copy)
-    ASSERT(part_start == frame_info.parts.size());
-    // The counts we computed should match the frame's counts
-    ASSERT(std::equal(frame_info.part_type_counts.begin(), frame_info.part_type_counts.end(),
-                      part_counts.begin()));
+      part_start = part_nr + 1;
+    }
   }
+
+  // We shouldn't end on a Command (it should end with an EFB copy)
+  ASSERT(part_start == frame_info->parts.size());
+  // The counts we computed should match the frame's counts
+  ASSERT(std::equal(frame_info->part_type_counts.begin(), frame_info->part_type_counts.end(),
+                    part_counts.begin()));
+
+  frame_item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
 }
 
 namespace
@@ -346,25 +363,27 @@ void FIFOAnalyzer::UpdateDetails()
   const u32 start_part_nr = items[0]->data(0, PART_START_ROLE).toUInt();
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
 
-  const AnalyzedFrameInfo& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
-  const auto& fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
+  const auto frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
+  const auto fifo_frame = FifoPlayer::GetInstance().GetFrame(frame_nr);
+  if (!frame_info || !fifo_frame)
+    return;
 
-  const u32 object_start = frame_info.parts[start_part_nr].m_start;
-  const u32 object_end = frame_info.parts[end_part_nr].m_end;
+  const u32 object_start = frame_info->parts[start_part_nr].m_start;
+  const u32 object_end = frame_info->parts[end_part_nr].m_end;
   const u32 object_size = object_end - object_start;
 
   u32 object_offset = 0;
   // NOTE: object_info.m_cpmem is the state of cpmem _after_ all of the commands in this object.
   // However, it doesn't matter that it doesn't match the start, since it will match by the time
   // primitives are reached.
-  auto callback = DetailCallback(frame_info.parts[end_part_nr].m_cpmem);
+  auto callback = DetailCallback(frame_info->parts[end_part_nr].m_cpmem);
 
   while (object_offset < object_size)
   {
     const u32 start_offset = object_offset;
     m_object_data_offsets.push_back(start_offset);
 
-    object_offset += OpcodeDecoder::RunCommand(&fifo_frame.fifoData[object_start + start_offset],
+    object_offset += OpcodeDecoder::RunCommand(&fifo_frame->fifoData[object_start + start_offset],
                                                object_size - start_offset, callback);
 
     QString new_label =
@@ -429,14 +448,16 @@ void FIFOAnalyzer::BeginSearch()
   const u32 start_part_nr = items[0]->data(0, PART_START_ROLE).toUInt();
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
 
-  const AnalyzedFrameInfo& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
+  const auto frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
+  const auto fifo_frame = FifoPlayer::GetInstance().GetFrame(frame_nr);
+  if (!frame_info || !fifo_frame)
+    return;
 
-  const u32 object_start = frame_info.parts[start_part_nr].m_start;
-  const u32 object_end = frame_info.parts[end_part_nr].m_end;
+  const u32 object_start = frame_info->parts[start_part_nr].m_start;
+  const u32 object_end = frame_info->parts[end_part_nr].m_end;
   const u32 object_size = object_end - object_start;
 
-  const u8* const object = &fifo_frame.fifoData[object_start];
+  const u8* const object = &fifo_frame->fifoData[object_start];
 
   // TODO: Support searching for bit patterns
   for (u32 cmd_nr = 0; cmd_nr < m_object_data_offsets.size(); cmd_nr++)
@@ -756,16 +777,18 @@ void FIFOAnalyzer::UpdateDescription()
   const u32 end_part_nr = items[0]->data(0, PART_END_ROLE).toUInt();
   const u32 entry_nr = m_detail_list->currentRow();
 
-  const AnalyzedFrameInfo& frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
-  const FifoFrameInfo& fifo_frame = FifoPlayer::GetInstance().GetFile()->GetFrame(frame_nr);
+  const auto frame_info = FifoPlayer::GetInstance().GetAnalyzedFrameInfo(frame_nr);
+  const auto fifo_frame = FifoPlayer::GetInstance().GetFrame(frame_nr);
+  if (!frame_info || !fifo_frame)
+    return;
 
-  const u32 object_start = frame_info.parts[start_part_nr].m_start;
-  const u32 object_end = frame_info.parts[end_part_nr].m_end;
+  const u32 object_start = frame_info->parts[start_part_nr].m_start;
+  const u32 object_end = frame_info->parts[end_part_nr].m_end;
   const u32 object_size = object_end - object_start;
   const u32 entry_start = m_object_data_offsets[entry_nr];
 
-  auto callback = DescriptionCallback(frame_info.parts[end_part_nr].m_cpmem);
-  OpcodeDecoder::RunCommand(&fifo_frame.fifoData[object_start + entry_start],
+  auto callback = DescriptionCallback(frame_info->parts[end_part_nr].m_cpmem);
+  OpcodeDecoder::RunCommand(&fifo_frame->fifoData[object_start + entry_start],
                             object_size - entry_start, callback);
   m_entry_detail_browser->setText(callback.text);
 }
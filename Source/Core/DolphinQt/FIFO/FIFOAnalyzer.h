@@ -17,6 +17,7 @@ class QPushButton;
 class QSplitter;
 class QTextBrowser;
 class QTreeWidget;
+class QTreeWidgetItem;
 
 class FIFOAnalyzer final : public QWidget
 {
@@ -39,6 +40,7 @@ private:
   void ShowSearchResult(size_t index);
 
   void UpdateTree();
+  void PopulateFrame(QTreeWidgetItem* frame_item);
   void UpdateDetails();
   void UpdateDescription();
 
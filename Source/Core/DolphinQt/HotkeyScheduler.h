@@ -45,6 +45,7 @@ signals:
   void StateLoadFile();
   void StateSaveFile();
   void StateLoadUndo();
+  void StateRewind();
   void StateSaveUndo();
   void StartRecording();
   void PlayRecording();
@@ -205,7 +205,7 @@ static std::vector<std::string> StringListToStdVector(QStringList list)
 }
 
 MainWindow::MainWindow(std::unique_ptr<BootParameters> boot_parameters,
-                       const std::string& movie_path)
+                       const std::string& movie_path, u64 movie_start_frame)
     : QMainWindow(nullptr)
 {
   setWindowTitle(QString::fromStdString(Common::GetScmRevStr()));
@@ -248,7 +248,7 @@ MainWindow::MainWindow(std::unique_ptr<BootParameters> boot_parameters,
     if (!movie_path.empty())
     {
       std::optional<std::string> savestate_path;
-      if (Movie::PlayInput(movie_path, &savestate_path))
+      if (Movie::PlayInput(movie_path, &savestate_path, movie_start_frame))
       {
         m_pending_boot->boot_session_data.SetSavestateData(std::move(savestate_path),
                                                            DeleteSavestateAfterBoot::No);
@@ -601,6 +601,7 @@ void MainWindow::ConnectHotkeys()
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadLastSaved, this,
           &MainWindow::StateLoadLastSavedAt);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadUndo, this, &MainWindow::StateLoadUndo);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::StateRewind, this, &MainWindow::StateRewind);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveUndo, this, &MainWindow::StateSaveUndo);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveOldest, this,
           &MainWindow::StateSaveOldest);
@@ -1356,6 +1357,11 @@ void MainWindow::StateLoadUndo()
   State::UndoLoadState();
 }
 
+void MainWindow::StateRewind()
+{
+  State::Rewind();
+}
+
 void MainWindow::StateSaveUndo()
 {
   State::UndoSaveState();
@@ -1699,7 +1705,8 @@ void MainWindow::OnImportNANDBackup()
 void MainWindow::OnPlayRecording()
 {
   QString dtm_file = DolphinFileDialog::getOpenFileName(
-      this, tr("Select the Recording File to Play"), QString(), tr("Dolphin TAS Movies (*.dtm)"));
+      this, tr("Select the Recording File to Play"), QString(),
+      tr("Dolphin TAS Movies (*.dtm *.dti)"));
 
   if (dtm_file.isEmpty())
     return;
@@ -1770,7 +1777,8 @@ void MainWindow::OnExportRecording()
 {
   Core::RunAsCPUThread([this] {
     QString dtm_file = DolphinFileDialog::getSaveFileName(
-        this, tr("Save Recording File As"), QString(), tr("Dolphin TAS Movies (*.dtm)"));
+        this, tr("Save Recording File As"), QString(),
+        tr("Dolphin TAS Movies (*.dtm);;Indexed Dolphin TAS Movies (*.dti)"));
     if (!dtm_file.isEmpty())
       Movie::SaveRecording(dtm_file.toStdString());
   });
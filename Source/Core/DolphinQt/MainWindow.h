@@ -11,6 +11,8 @@
 #include <optional>
 #include <string>
 
+#include "Common/CommonTypes.h"
+
 class QStackedWidget;
 class QString;
 
@@ -67,7 +69,7 @@ class MainWindow final : public QMainWindow
 
 public:
   explicit MainWindow(std::unique_ptr<BootParameters> boot_parameters,
-                      const std::string& movie_path);
+                      const std::string& movie_path, u64 movie_start_frame);
   ~MainWindow();
 
   void Show();
@@ -98,6 +100,7 @@ private:
   void StateSaveSlotAt(int slot);
   void StateLoadLastSavedAt(int slot);
   void StateLoadUndo();
+  void StateRewind();
   void StateSaveUndo();
   void StateSaveOldest();
   void SetStateSlot(int slot);
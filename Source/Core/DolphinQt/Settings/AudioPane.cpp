@@ -91,6 +91,20 @@ void AudioPane::CreateWidgets()
            "crackling. Certain backends only."));
   }
 
+  m_resampling_label = new QLabel(tr("Resampling:"));
+  m_resampling_combo = new QComboBox();
+  m_resampling_combo->addItem(tr("Linear"));
+  m_resampling_combo->addItem(tr("Windowed Sinc"));
+  m_resampling_combo->setToolTip(
+      tr("Algorithm used to convert the audio of the emulated console to the output sample "
+         "rate. Windowed Sinc sounds clearer but uses slightly more CPU time."));
+
+  m_mixer_thread = new QCheckBox(tr("Mix Audio on a Separate Thread"));
+  m_mixer_thread->setToolTip(
+      tr("Mixes audio ahead of time on a dedicated thread, so that the audio backend only has to "
+         "copy it. May reduce crackling on busy systems, at the cost of slightly higher audio "
+         "latency."));
+
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
@@ -111,7 +125,12 @@ void AudioPane::CreateWidgets()
   m_dolby_quality_highest_label =
       new QLabel(GetDPL2QualityLabel(AudioCommon::DPL2Quality::Highest));
   m_dolby_quality_latency_label =
-      new QLabel(GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality::Highest));
+      new QLabel(GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality::Highest, false));
+
+  m_dolby_low_latency = new QCheckBox(tr("Low Latency Decoding"));
+  m_dolby_low_latency->setToolTip(
+      tr("Decodes surround audio in small steps, so that it is only delayed by a few milliseconds "
+         "at any quality. Uses more CPU time, especially at higher qualities."));
 
   dolby_quality_layout->addWidget(m_dolby_quality_low_label);
   dolby_quality_layout->addWidget(m_dolby_quality_slider);
@@ -130,10 +149,13 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_wasapi_device_label, m_wasapi_device_combo);
 #endif
 
+  backend_layout->addRow(m_resampling_label, m_resampling_combo);
+  backend_layout->addRow(m_mixer_thread);
   backend_layout->addRow(m_dolby_pro_logic);
   backend_layout->addRow(m_dolby_quality_label);
   backend_layout->addRow(dolby_quality_layout);
   backend_layout->addRow(m_dolby_quality_latency_label);
+  backend_layout->addRow(m_dolby_low_latency);
 
   auto* stretching_box = new QGroupBox(tr("Audio Stretching Settings"));
   auto* stretching_layout = new QGridLayout;
@@ -181,8 +203,12 @@ void AudioPane::ConnectWidgets()
             &AudioPane::SaveSettings);
   }
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
+  connect(m_resampling_combo, qOverload<int>(&QComboBox::currentIndexChanged), this,
+          &AudioPane::SaveSettings);
+  connect(m_mixer_thread, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
+  connect(m_dolby_low_latency, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_stretching_enable, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_hle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_lle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
@@ -232,8 +258,9 @@ void AudioPane::LoadSettings()
   // DPL2
   m_dolby_pro_logic->setChecked(Config::Get(Config::MAIN_DPL2_DECODER));
   m_dolby_quality_slider->setValue(int(Config::Get(Config::MAIN_DPL2_QUALITY)));
-  m_dolby_quality_latency_label->setText(
-      GetDPL2ApproximateLatencyLabel(Config::Get(Config::MAIN_DPL2_QUALITY)));
+  m_dolby_low_latency->setChecked(Config::Get(Config::MAIN_DPL2_LOW_LATENCY));
+  m_dolby_quality_latency_label->setText(GetDPL2ApproximateLatencyLabel(
+      Config::Get(Config::MAIN_DPL2_QUALITY), Config::Get(Config::MAIN_DPL2_LOW_LATENCY)));
   if (AudioCommon::SupportsDPL2Decoder(current) && !m_dsp_hle->isChecked())
   {
     EnableDolbyQualityWidgets(m_dolby_pro_logic->isChecked());
@@ -243,6 +270,11 @@ void AudioPane::LoadSettings()
   if (m_latency_control_supported)
     m_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_LATENCY));
 
+  // Mixer
+  m_resampling_combo->setCurrentIndex(
+      static_cast<int>(Config::Get(Config::MAIN_AUDIO_RESAMPLING_QUALITY)));
+  m_mixer_thread->setChecked(Config::Get(Config::MAIN_AUDIO_MIXER_THREAD));
+
   // Stretch
   m_stretching_enable->setChecked(Config::Get(Config::MAIN_AUDIO_STRETCH));
   m_stretching_buffer_slider->setValue(Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY));
@@ -298,8 +330,9 @@ void AudioPane::SaveSettings()
   Config::SetBaseOrCurrent(Config::MAIN_DPL2_DECODER, m_dolby_pro_logic->isChecked());
   Config::SetBase(Config::MAIN_DPL2_QUALITY,
                   static_cast<AudioCommon::DPL2Quality>(m_dolby_quality_slider->value()));
-  m_dolby_quality_latency_label->setText(
-      GetDPL2ApproximateLatencyLabel(Config::Get(Config::MAIN_DPL2_QUALITY)));
+  Config::SetBase(Config::MAIN_DPL2_LOW_LATENCY, m_dolby_low_latency->isChecked());
+  m_dolby_quality_latency_label->setText(GetDPL2ApproximateLatencyLabel(
+      Config::Get(Config::MAIN_DPL2_QUALITY), Config::Get(Config::MAIN_DPL2_LOW_LATENCY)));
   if (AudioCommon::SupportsDPL2Decoder(backend) && !m_dsp_hle->isChecked())
   {
     EnableDolbyQualityWidgets(m_dolby_pro_logic->isChecked());
@@ -309,6 +342,12 @@ void AudioPane::SaveSettings()
   if (m_latency_control_supported)
     Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LATENCY, m_latency_spin->value());
 
+  // Mixer
+  Config::SetBaseOrCurrent(
+      Config::MAIN_AUDIO_RESAMPLING_QUALITY,
+      static_cast<AudioCommon::ResamplingQuality>(m_resampling_combo->currentIndex()));
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_MIXER_THREAD, m_mixer_thread->isChecked());
+
   // Stretch
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH, m_stretching_enable->isChecked());
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH_LATENCY, m_stretching_buffer_slider->value());
@@ -380,6 +419,7 @@ void AudioPane::OnEmulationStateChanged(bool running)
   m_dsp_interpreter->setEnabled(!running);
   m_backend_label->setEnabled(!running);
   m_backend_combo->setEnabled(!running);
+  m_mixer_thread->setEnabled(!running);
   if (AudioCommon::SupportsDPL2Decoder(Config::Get(Config::MAIN_AUDIO_BACKEND)) &&
       !m_dsp_hle->isChecked())
   {
@@ -426,8 +466,12 @@ QString AudioPane::GetDPL2QualityLabel(AudioCommon::DPL2Quality value) const
   }
 }
 
-QString AudioPane::GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality value) const
+QString AudioPane::GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality value,
+                                                  bool low_latency) const
 {
+  if (low_latency)
+    return tr("Latency: ~5 ms");
+
   switch (value)
   {
   case AudioCommon::DPL2Quality::Lowest:
@@ -448,4 +492,5 @@ void AudioPane::EnableDolbyQualityWidgets(bool enabled) const
   m_dolby_quality_low_label->setEnabled(enabled);
   m_dolby_quality_highest_label->setEnabled(enabled);
   m_dolby_quality_latency_label->setEnabled(enabled);
+  m_dolby_low_latency->setEnabled(enabled);
 }
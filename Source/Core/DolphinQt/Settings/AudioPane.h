@@ -41,7 +41,7 @@ private:
   bool m_latency_control_supported;
 
   QString GetDPL2QualityLabel(AudioCommon::DPL2Quality value) const;
-  QString GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality value) const;
+  QString GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality value, bool low_latency) const;
   void EnableDolbyQualityWidgets(bool enabled) const;
 
   QHBoxLayout* m_main_layout;
@@ -64,8 +64,12 @@ private:
   QLabel* m_dolby_quality_low_label;
   QLabel* m_dolby_quality_highest_label;
   QLabel* m_dolby_quality_latency_label;
+  QCheckBox* m_dolby_low_latency;
   QLabel* m_latency_label;
   QSpinBox* m_latency_spin;
+  QLabel* m_resampling_label;
+  QComboBox* m_resampling_combo;
+  QCheckBox* m_mixer_thread;
 #ifdef _WIN32
   QLabel* m_wasapi_device_label;
   QComboBox* m_wasapi_device_combo;
@@ -0,0 +1,395 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/FifoBenchCommand.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#include <OptionParser.h>
+#include <picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/Statistics.h"
+
+namespace DolphinTool
+{
+namespace
+{
+// The counters reported for each frame. They are read from the running totals in g_stats, which
+// wrap around on overflow, so they are kept unsigned and only ever subtracted from each other.
+struct FrameCounters
+{
+  u32 opcodes = 0;
+  u32 primitives = 0;
+  u32 draw_calls = 0;
+  u32 vertices = 0;
+  u32 texture_uploads = 0;
+};
+
+struct FrameSample
+{
+  u32 frame = 0;
+  double time_us = 0;
+  FrameCounters counters;
+};
+
+class Benchmark
+{
+public:
+  Benchmark(int warmup_loops, int loops) : m_warmup_loops(warmup_loops), m_loops(loops) {}
+
+  // Called by the FIFO player before it writes each frame. With the CPU thread disabled, the GPU
+  // has finished the previous frame by then, and g_stats can be read on this thread.
+  void OnFrameWritten()
+  {
+    const auto now = std::chrono::steady_clock::now();
+    const FrameCounters counters = ReadCounters();
+    const FifoPlayer& player = FifoPlayer::GetInstance();
+
+    if (m_frames_per_loop == 0)
+    {
+      m_frames_per_loop = player.GetFrameRangeEnd() - player.GetFrameRangeStart() + 1;
+      m_samples.reserve(GetWarmupFrames() + size_t(m_loops) * m_frames_per_loop);
+    }
+
+    if (m_has_previous && !m_done.load(std::memory_order_relaxed))
+    {
+      FrameSample sample;
+      sample.frame = m_previous_frame;
+      sample.time_us = std::chrono::duration<double, std::micro>(now - m_previous_time).count();
+      sample.counters.opcodes = counters.opcodes - m_previous_counters.opcodes;
+      sample.counters.primitives = counters.primitives - m_previous_counters.primitives;
+      sample.counters.draw_calls = counters.draw_calls - m_previous_counters.draw_calls;
+      sample.counters.vertices = counters.vertices - m_previous_counters.vertices;
+      sample.counters.texture_uploads =
+          counters.texture_uploads - m_previous_counters.texture_uploads;
+      m_samples.push_back(sample);
+
+      if (m_samples.size() >= GetWarmupFrames() + size_t(m_loops) * m_frames_per_loop)
+        m_done.store(true, std::memory_order_release);
+    }
+
+    m_has_previous = true;
+    m_previous_frame = player.GetCurrentFrameNum();
+    m_previous_time = now;
+    m_previous_counters = counters;
+  }
+
+  bool IsDone() const { return m_done.load(std::memory_order_acquire); }
+
+  // Only valid once IsDone() returns true, or the emulation has stopped.
+  u32 GetFramesPerLoop() const { return m_frames_per_loop; }
+  size_t GetWarmupFrames() const { return size_t(m_warmup_loops) * m_frames_per_loop; }
+
+  // Returns the samples after the warmup loops.
+  std::vector<FrameSample> GetMeasuredSamples() const
+  {
+    if (m_samples.size() <= GetWarmupFrames())
+      return {};
+    return std::vector<FrameSample>(m_samples.begin() + GetWarmupFrames(), m_samples.end());
+  }
+
+private:
+  static FrameCounters ReadCounters()
+  {
+    const Statistics::ThisFrame totals = g_stats.GetTotals();
+
+    FrameCounters counters;
+    counters.opcodes = u32(totals.num_bp_loads) + u32(totals.num_cp_loads) +
+                       u32(totals.num_xf_loads) + u32(totals.num_bp_loads_in_dl) +
+                       u32(totals.num_cp_loads_in_dl) + u32(totals.num_xf_loads_in_dl) +
+                       u32(totals.num_prims) + u32(totals.num_dl_prims) +
+                       u32(totals.num_dlists_called);
+    counters.primitives = u32(totals.num_prims) + u32(totals.num_dl_prims);
+    counters.draw_calls = u32(totals.num_draw_calls);
+    counters.vertices = u32(totals.num_vertices_loaded);
+    counters.texture_uploads = u32(g_stats.num_textures_uploaded);
+    return counters;
+  }
+
+  const int m_warmup_loops;
+  const int m_loops;
+  u32 m_frames_per_loop = 0;
+  std::vector<FrameSample> m_samples;
+  std::atomic<bool> m_done = false;
+
+  bool m_has_previous = false;
+  u32 m_previous_frame = 0;
+  std::chrono::steady_clock::time_point m_previous_time;
+  FrameCounters m_previous_counters;
+};
+
+// Summarizes the values with their mean and nearest-rank percentiles.
+picojson::object Summarize(std::vector<double> values)
+{
+  picojson::object summary;
+  if (values.empty())
+    return summary;
+
+  std::sort(values.begin(), values.end());
+  const auto percentile = [&values](double p) {
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100 * values.size()));
+    return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+  };
+
+  double sum = 0;
+  for (const double value : values)
+    sum += value;
+
+  summary.emplace("mean", picojson::value(sum / values.size()));
+  summary.emplace("min", picojson::value(values.front()));
+  summary.emplace("p50", picojson::value(percentile(50)));
+  summary.emplace("p90", picojson::value(percentile(90)));
+  summary.emplace("p99", picojson::value(percentile(99)));
+  summary.emplace("max", picojson::value(values.back()));
+  return summary;
+}
+
+template <typename Getter>
+picojson::object SummarizeSamples(const std::vector<FrameSample>& samples, Getter getter)
+{
+  std::vector<double> values;
+  values.reserve(samples.size());
+  for (const FrameSample& sample : samples)
+    values.push_back(static_cast<double>(getter(sample)));
+  return Summarize(std::move(values));
+}
+
+picojson::value GenerateReport(const std::string& path, const std::string& backend,
+                               u32 frames_per_loop, const std::vector<FrameSample>& samples,
+                               bool per_frame)
+{
+  double total_time_us = 0;
+  for (const FrameSample& sample : samples)
+    total_time_us += sample.time_us;
+
+  picojson::object report;
+  report.emplace("file", picojson::value(path));
+  report.emplace("backend", picojson::value(backend));
+  report.emplace("frames_per_loop", picojson::value(static_cast<double>(frames_per_loop)));
+  report.emplace("frames", picojson::value(static_cast<double>(samples.size())));
+  report.emplace("total_time_ms", picojson::value(total_time_us / 1000));
+  if (total_time_us > 0)
+    report.emplace("fps", picojson::value(samples.size() * 1000000.0 / total_time_us));
+
+  const auto add_summary = [&](const char* name, auto getter) {
+    report.emplace(name, picojson::value(SummarizeSamples(samples, getter)));
+  };
+  add_summary("frame_time_us", [](const FrameSample& s) { return s.time_us; });
+  add_summary("opcodes", [](const FrameSample& s) { return s.counters.opcodes; });
+  add_summary("primitives", [](const FrameSample& s) { return s.counters.primitives; });
+  add_summary("draw_calls", [](const FrameSample& s) { return s.counters.draw_calls; });
+  add_summary("vertices", [](const FrameSample& s) { return s.counters.vertices; });
+  add_summary("texture_uploads", [](const FrameSample& s) { return s.counters.texture_uploads; });
+
+  if (per_frame)
+  {
+    picojson::array frames;
+    for (const FrameSample& sample : samples)
+    {
+      picojson::object frame;
+      frame.emplace("frame", picojson::value(static_cast<double>(sample.frame)));
+      frame.emplace("time_us", picojson::value(sample.time_us));
+      frame.emplace("opcodes", picojson::value(static_cast<double>(sample.counters.opcodes)));
+      frame.emplace("primitives",
+                    picojson::value(static_cast<double>(sample.counters.primitives)));
+      frame.emplace("draw_calls",
+                    picojson::value(static_cast<double>(sample.counters.draw_calls)));
+      frame.emplace("vertices", picojson::value(static_cast<double>(sample.counters.vertices)));
+      frame.emplace("texture_uploads",
+                    picojson::value(static_cast<double>(sample.counters.texture_uploads)));
+      frames.emplace_back(std::move(frame));
+    }
+    report.emplace("per_frame", picojson::value(std::move(frames)));
+  }
+
+  return picojson::value(std::move(report));
+}
+}  // namespace
+
+int FifoBenchCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: fifobench [options]... FILE");
+
+  parser->description("Plays back a FIFO log (.dff) without a window and reports how long each "
+                      "frame took, along with the per-frame opcode, vertex and texture upload "
+                      "counts, as JSON. The CPU thread is disabled, so frame times include both "
+                      "the FIFO player and the GPU emulation.");
+
+  parser->add_option("-b", "--backend")
+      .type("string")
+      .action("store")
+      .set_default("null")
+      .help("Video BACKEND to play the log with, either null or software. [default: %default]")
+      .metavar("BACKEND");
+
+  parser->add_option("-n", "--loops")
+      .type("int")
+      .action("store")
+      .set_default(10)
+      .help("Number of times to play back the whole log. [default: %default]")
+      .metavar("COUNT");
+
+  parser->add_option("-w", "--warmup")
+      .type("int")
+      .action("store")
+      .set_default(1)
+      .help("Number of loops to play back before measuring. [default: %default]")
+      .metavar("COUNT");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the FILE to write the JSON report to, instead of standard output.")
+      .metavar("FILE");
+
+  parser->add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User DIRECTORY to run with. By default, an empty temporary directory is used so "
+            "that results don't depend on the local configuration.")
+      .metavar("DIRECTORY");
+
+  parser->add_option("--per-frame")
+      .action("store_true")
+      .help("Include every measured frame in the report, not just the summary.");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  // The first positional argument is the name of this command.
+  const std::vector<std::string> positional = parser->args();
+  if (positional.size() != 2)
+  {
+    parser->print_usage(std::cerr);
+    return 1;
+  }
+  const std::string& input_file_path = positional[1];
+
+  std::string backend = static_cast<const char*>(options.get("backend"));
+  std::transform(backend.begin(), backend.end(), backend.begin(),
+                 [](char c) { return static_cast<char>(std::tolower(c)); });
+  std::string backend_name;
+  if (backend == "null")
+    backend_name = "Null";
+  else if (backend == "software")
+    backend_name = "Software Renderer";
+  else
+  {
+    std::cerr << "Error: Unknown backend " << backend << std::endl;
+    return 1;
+  }
+
+  const int loops = static_cast<int>(options.get("loops"));
+  const int warmup_loops = static_cast<int>(options.get("warmup"));
+  if (loops < 1 || warmup_loops < 0)
+  {
+    std::cerr << "Error: Invalid number of loops" << std::endl;
+    return 1;
+  }
+
+  std::string user_directory = static_cast<const char*>(options.get("user"));
+  std::string temp_user_directory;
+  if (user_directory.empty())
+  {
+    temp_user_directory = File::CreateTempDir();
+    if (temp_user_directory.empty())
+    {
+      std::cerr << "Error: Failed to create a temporary user directory" << std::endl;
+      return 1;
+    }
+    user_directory = temp_user_directory;
+  }
+
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, backend_name);
+  Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+
+  int result = 0;
+  std::vector<FrameSample> samples;
+  u32 frames_per_loop = 0;
+  {
+    Benchmark benchmark(warmup_loops, loops);
+    FifoPlayer::GetInstance().SetFrameWrittenCallback([&benchmark] { benchmark.OnFrameWritten(); });
+
+    WindowSystemInfo wsi;
+    wsi.type = WindowSystemType::Headless;
+
+    if (BootManager::BootCore(BootParameters::GenerateFromFile(input_file_path), wsi))
+    {
+      while (!benchmark.IsDone() && Core::GetState() != Core::State::Uninitialized)
+      {
+        Core::HostDispatchJobs();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      Core::Stop();
+      Core::Shutdown();
+
+      if (benchmark.IsDone())
+      {
+        frames_per_loop = benchmark.GetFramesPerLoop();
+        samples = benchmark.GetMeasuredSamples();
+      }
+      else
+      {
+        std::cerr << "Error: Playback of " << input_file_path << " stopped early" << std::endl;
+        result = 1;
+      }
+    }
+    else
+    {
+      std::cerr << "Error: Could not boot " << input_file_path << std::endl;
+      result = 1;
+    }
+
+    FifoPlayer::GetInstance().SetFrameWrittenCallback({});
+  }
+
+  UICommon::Shutdown();
+  if (!temp_user_directory.empty())
+    File::DeleteDirRecursively(temp_user_directory);
+
+  if (result != 0)
+    return result;
+
+  const std::string report = GenerateReport(input_file_path, backend_name, frames_per_loop,
+                                            samples, options.is_set("per_frame"))
+                                 .serialize(true);
+
+  const std::string output_file_path = static_cast<const char*>(options.get("output"));
+  if (output_file_path.empty())
+  {
+    std::cout << report;
+    return 0;
+  }
+
+  if (!File::WriteStringToFile(output_file_path, report))
+  {
+    std::cerr << "Error: Failed to write " << output_file_path << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,416 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/NetPlayBenchCommand.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <thread>
+#include <utility>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Config/NetplaySettings.h"
+#include "Core/HW/EXI/EXI.h"
+#include "Core/HW/EXI/EXI_Device.h"
+#include "Core/HW/GCMemcard/GCMemcard.h"
+#include "Core/NetPlayClient.h"
+#include "Core/NetPlayCommon.h"
+#include "Core/NetPlayServer.h"
+#include "UICommon/GameFile.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+namespace
+{
+constexpr std::chrono::seconds SESSION_TIMEOUT{120};
+
+// A NetPlay UI that doesn't show anything, and only keeps track of how far the session got.
+class BenchmarkUI final : public NetPlay::NetPlayUI
+{
+public:
+  BenchmarkUI(std::shared_ptr<const UICommon::GameFile> game, bool is_hosting)
+      : m_game(std::move(game)), m_is_hosting(is_hosting)
+  {
+  }
+
+  bool HasGameChanged() const { return m_game_changed; }
+  bool HasGameStarted() const { return m_game_started; }
+  bool HasFailed() const { return m_failed; }
+  u64 GetChunkedDataSize() const { return m_chunked_data_size; }
+
+  void BootGame(const std::string&, std::unique_ptr<BootSessionData>) override {}
+  void StopGame() override {}
+  bool IsHosting() const override { return m_is_hosting; }
+
+  void Update() override {}
+  void AppendChat(const std::string&) override {}
+
+  void OnMsgChangeGame(const NetPlay::SyncIdentifier&, const std::string&) override
+  {
+    m_game_changed = true;
+  }
+  void OnMsgChangeGBARom(int, const NetPlay::GBAConfig&) override {}
+  void OnMsgStartGame() override { m_game_started = true; }
+  void OnMsgStopGame() override {}
+  void OnMsgPowerButton() override {}
+  void OnPlayerConnect(const std::string&) override {}
+  void OnPlayerDisconnect(const std::string&) override {}
+  void OnPadBufferChanged(u32) override {}
+  void OnHostInputAuthorityChanged(bool) override {}
+  void OnDesync(u32, const std::string&) override {}
+  void OnConnectionLost() override { m_failed = true; }
+  void OnConnectionError(const std::string& message) override
+  {
+    std::cerr << "Error: " << message << std::endl;
+    m_failed = true;
+  }
+  void OnTraversalError(TraversalClient::FailureReason) override {}
+  void OnTraversalStateChanged(TraversalClient::State) override {}
+  void OnGameStartAborted() override { m_failed = true; }
+  void OnGolferChanged(bool, const std::string&) override {}
+
+  bool IsRecording() override { return false; }
+  std::shared_ptr<const UICommon::GameFile>
+  FindGameFile(const NetPlay::SyncIdentifier& sync_identifier,
+               NetPlay::SyncIdentifierComparison* found = nullptr) override
+  {
+    const NetPlay::SyncIdentifierComparison comparison =
+        m_game->CompareSyncIdentifier(sync_identifier);
+    if (found)
+      *found = comparison;
+    return comparison == NetPlay::SyncIdentifierComparison::SameGame ? m_game : nullptr;
+  }
+  std::string FindGBARomPath(const std::array<u8, 20>&, std::string_view, int) override
+  {
+    return {};
+  }
+  void ShowMD5Dialog(const std::string&) override {}
+  void SetMD5Progress(int, int) override {}
+  void SetMD5Result(int, const std::string&) override {}
+  void AbortMD5() override {}
+
+  void OnIndexAdded(bool, std::string) override {}
+  void OnIndexRefreshFailed(std::string) override {}
+
+  // Only called on the host, once for every piece of chunked data that is sent.
+  void ShowChunkedProgressDialog(const std::string&, u64 data_size,
+                                 const std::vector<int>&) override
+  {
+    m_chunked_data_size += data_size;
+  }
+  void HideChunkedProgressDialog() override {}
+  void SetChunkedProgress(int, u64) override {}
+
+  void SetHostWiiSyncData(std::vector<u64>, std::string) override {}
+
+private:
+  const std::shared_ptr<const UICommon::GameFile> m_game;
+  const bool m_is_hosting;
+
+  std::atomic<bool> m_game_changed = false;
+  std::atomic<bool> m_game_started = false;
+  std::atomic<bool> m_failed = false;
+  std::atomic<u64> m_chunked_data_size = 0;
+};
+
+struct SessionResult
+{
+  double start_time_ms = 0;
+  u64 chunked_data_size = 0;
+};
+
+// Waits until condition returns true, or until the session fails or times out.
+template <typename Condition>
+bool WaitFor(const std::vector<std::unique_ptr<BenchmarkUI>>& uis, Condition condition)
+{
+  const auto deadline = std::chrono::steady_clock::now() + SESSION_TIMEOUT;
+  while (!condition())
+  {
+    const bool failed = std::any_of(uis.begin(), uis.end(),
+                                    [](const auto& ui) { return ui->HasFailed(); });
+    if (failed || std::chrono::steady_clock::now() > deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+std::optional<SessionResult> RunSession(const std::shared_ptr<const UICommon::GameFile>& game,
+                                        u16 port, int client_count)
+{
+  const NetPlay::NetTraversalConfig traversal_config;
+
+  // uis[0] belongs to the host, which is both the server and the first client.
+  std::vector<std::unique_ptr<BenchmarkUI>> uis;
+  uis.push_back(std::make_unique<BenchmarkUI>(game, true));
+  for (int i = 0; i < client_count; ++i)
+    uis.push_back(std::make_unique<BenchmarkUI>(game, false));
+
+  NetPlay::NetPlayServer server(port, false, uis[0].get(), traversal_config);
+  if (!server.is_connected)
+  {
+    std::cerr << "Error: Failed to host on port " << port << std::endl;
+    return std::nullopt;
+  }
+
+  std::vector<std::unique_ptr<NetPlay::NetPlayClient>> clients;
+  for (size_t i = 0; i < uis.size(); ++i)
+  {
+    const std::string name = i == 0 ? "Host" : fmt::format("Client {}", i);
+    clients.push_back(std::make_unique<NetPlay::NetPlayClient>("127.0.0.1", port, uis[i].get(),
+                                                               name, traversal_config));
+    if (!clients.back()->IsConnected())
+    {
+      std::cerr << "Error: " << name << " failed to connect" << std::endl;
+      return std::nullopt;
+    }
+  }
+
+  server.ChangeGame(game->GetSyncIdentifier(), game->GetFileName());
+  const bool changed = WaitFor(uis, [&uis] {
+    return std::all_of(uis.begin(), uis.end(), [](const auto& ui) { return ui->HasGameChanged(); });
+  });
+  if (!changed)
+  {
+    std::cerr << "Error: Not every client received the game" << std::endl;
+    return std::nullopt;
+  }
+
+  // Clients tell the server what they have cached right after they receive the game. There's no
+  // way to observe the server handling that, but on the loopback interface, this is plenty.
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  const auto start_time = std::chrono::steady_clock::now();
+  if (!server.RequestStartGame())
+  {
+    std::cerr << "Error: Failed to start the game" << std::endl;
+    return std::nullopt;
+  }
+
+  const bool started = WaitFor(uis, [&uis] {
+    return std::all_of(uis.begin(), uis.end(), [](const auto& ui) { return ui->HasGameStarted(); });
+  });
+  if (!started)
+  {
+    std::cerr << "Error: The session failed to start" << std::endl;
+    return std::nullopt;
+  }
+
+  SessionResult result;
+  result.start_time_ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time)
+          .count();
+  result.chunked_data_size = uis[0]->GetChunkedDataSize();
+
+  // Clients disconnect before the server shuts down.
+  clients.clear();
+  return result;
+}
+
+// Writes a full-size memory card whose first quarter is incompressible, like save data tends to
+// be, and whose remainder is unused.
+bool GenerateMemoryCard(const std::string& path)
+{
+  std::vector<u8> data(Memcard::MBIT_SIZE_MEMORY_CARD_2043 * Memcard::MBIT_TO_BLOCKS *
+                           Memcard::BLOCK_SIZE,
+                       0xFF);
+  std::mt19937 rng(0);
+  std::generate(data.begin(), data.begin() + data.size() / 4,
+                [&rng] { return static_cast<u8>(rng()); });
+
+  File::CreateFullPath(path);
+  File::IOFile file(path, "wb");
+  return file.WriteBytes(data.data(), data.size());
+}
+
+picojson::value GenerateReport(const std::string& path, int client_count,
+                               const std::vector<SessionResult>& sessions)
+{
+  picojson::object report;
+  report.emplace("file", picojson::value(path));
+  report.emplace("clients", picojson::value(static_cast<double>(client_count)));
+
+  picojson::array session_reports;
+  for (const SessionResult& session : sessions)
+  {
+    picojson::object session_report;
+    session_report.emplace("start_time_ms", picojson::value(session.start_time_ms));
+    session_report.emplace("chunked_data_bytes",
+                           picojson::value(static_cast<double>(session.chunked_data_size)));
+    session_reports.emplace_back(std::move(session_report));
+  }
+  report.emplace("sessions", picojson::value(std::move(session_reports)));
+
+  return picojson::value(std::move(report));
+}
+}  // namespace
+
+int NetPlayBenchCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: netplaybench [options]... GAME");
+
+  parser->description(
+      "Hosts NetPlay sessions for GAME on the loopback interface, connects clients to them, and "
+      "reports as JSON how long it takes from requesting the game start until every client has "
+      "received the save data and is told to start. The game itself isn't booted. The clients "
+      "share a content cache, so sessions after the first one only send data that changed.");
+
+  parser->add_option("-c", "--clients")
+      .type("int")
+      .action("store")
+      .set_default(1)
+      .help("Number of clients to connect in addition to the host. [default: %default]")
+      .metavar("COUNT");
+
+  parser->add_option("-n", "--sessions")
+      .type("int")
+      .action("store")
+      .set_default(3)
+      .help("Number of sessions to start one after the other. [default: %default]")
+      .metavar("COUNT");
+
+  parser->add_option("-p", "--port")
+      .type("int")
+      .action("store")
+      .set_default(Config::NETPLAY_HOST_PORT.GetDefaultValue())
+      .help("PORT to host the sessions on. [default: %default]")
+      .metavar("PORT");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the FILE to write the JSON report to, instead of standard output.")
+      .metavar("FILE");
+
+  parser->add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User DIRECTORY whose saves are synchronized. By default, an empty temporary "
+            "directory is used.")
+      .metavar("DIRECTORY");
+
+  parser->add_option("--generate-memcard")
+      .action("store_true")
+      .help("Put a generated memory card in slot A, which replaces the one in the user directory.");
+
+  parser->add_option("--no-cache")
+      .action("store_true")
+      .help("Empty the content cache before every session.");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  // The first positional argument is the name of this command.
+  const std::vector<std::string> positional = parser->args();
+  if (positional.size() != 2)
+  {
+    parser->print_usage(std::cerr);
+    return 1;
+  }
+  const std::string& input_file_path = positional[1];
+
+  const int client_count = static_cast<int>(options.get("clients"));
+  const int session_count = static_cast<int>(options.get("sessions"));
+  const int port = static_cast<int>(options.get("port"));
+  if (client_count < 1 || session_count < 1 || port < 1 || port > 0xFFFF)
+  {
+    std::cerr << "Error: Invalid number of clients or sessions, or invalid port" << std::endl;
+    return 1;
+  }
+
+  std::string user_directory = static_cast<const char*>(options.get("user"));
+  std::string temp_user_directory;
+  if (user_directory.empty())
+  {
+    temp_user_directory = File::CreateTempDir();
+    if (temp_user_directory.empty())
+    {
+      std::cerr << "Error: Failed to create a temporary user directory" << std::endl;
+      return 1;
+    }
+    user_directory = temp_user_directory;
+  }
+
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+
+  Config::SetCurrent(Config::NETPLAY_SYNC_SAVES, true);
+  Config::SetCurrent(Config::NETPLAY_SYNC_CODES, false);
+
+  int result = 0;
+  std::vector<SessionResult> sessions;
+
+  const auto game = std::make_shared<const UICommon::GameFile>(input_file_path);
+  if (!game->IsValid())
+  {
+    std::cerr << "Error: Could not open " << input_file_path << std::endl;
+    result = 1;
+  }
+  else if (options.is_set("generate_memcard"))
+  {
+    constexpr auto slot = ExpansionInterface::Slot::A;
+    Config::SetCurrent(Config::GetInfoForEXIDevice(slot),
+                       ExpansionInterface::EXIDeviceType::MemoryCard);
+    Config::SetCurrent(Config::MAIN_MEMORY_CARD_SIZE, -1);
+    const std::string path = Config::GetMemcardPath(slot, game->GetRegion(),
+                                                    Memcard::MBIT_SIZE_MEMORY_CARD_2043);
+    if (!GenerateMemoryCard(path))
+    {
+      std::cerr << "Error: Failed to write " << path << std::endl;
+      result = 1;
+    }
+  }
+
+  for (int i = 0; result == 0 && i < session_count; ++i)
+  {
+    if (options.is_set("no_cache"))
+      File::DeleteDirRecursively(NetPlay::GetContentCachePath());
+
+    const std::optional<SessionResult> session =
+        RunSession(game, static_cast<u16>(port), client_count);
+    if (session)
+      sessions.push_back(*session);
+    else
+      result = 1;
+  }
+
+  UICommon::Shutdown();
+  if (!temp_user_directory.empty())
+    File::DeleteDirRecursively(temp_user_directory);
+
+  if (result != 0)
+    return result;
+
+  const std::string report =
+      GenerateReport(input_file_path, client_count, sessions).serialize(true);
+
+  const std::string output_file_path = static_cast<const char*>(options.get("output"));
+  if (output_file_path.empty())
+  {
+    std::cout << report;
+    return 0;
+  }
+
+  if (!File::WriteStringToFile(output_file_path, report))
+  {
+    std::cerr << "Error: Failed to write " << output_file_path << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace DolphinTool
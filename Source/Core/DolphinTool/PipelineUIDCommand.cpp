@@ -0,0 +1,161 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/PipelineUIDCommand.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+
+#include "Common/Hash.h"
+#include "VideoCommon/PipelineUIDDatabase.h"
+
+namespace DolphinTool
+{
+template <typename T>
+static u32 HashUid(const T& uid)
+{
+  return Common::ComputeCRC32(reinterpret_cast<const u8*>(&uid), sizeof(uid));
+}
+
+static int Merge(const std::string& output_file_path, const std::vector<std::string>& input_paths)
+{
+  VideoCommon::PipelineUIDDatabase database;
+  for (const std::string& path : input_paths)
+  {
+    VideoCommon::PipelineUIDDatabase input;
+    if (!input.Load(path))
+    {
+      std::cerr << "Error: " << path << " is not a pipeline UID database for this version"
+                << std::endl;
+      return 1;
+    }
+
+    std::cout << "Read " << input.GetSize() << " pipeline UIDs from " << path << std::endl;
+    database.Merge(input);
+  }
+
+  if (!database.Save(output_file_path))
+  {
+    std::cerr << "Error: Failed to write " << output_file_path << std::endl;
+    return 1;
+  }
+
+  std::cout << "Wrote " << database.GetSize() << " unique pipeline UIDs to " << output_file_path
+            << std::endl;
+  return 0;
+}
+
+static int Inspect(const std::string& path, size_t max_entries)
+{
+  VideoCommon::PipelineUIDDatabase database;
+  if (!database.Load(path))
+  {
+    std::cerr << "Error: " << path << " is not a pipeline UID database for this version"
+              << std::endl;
+    return 1;
+  }
+
+  const std::vector<VideoCommon::PipelineUIDDatabase::Entry> entries =
+      database.GetEntriesByUseCount();
+  u64 total_uses = 0;
+  for (const auto& entry : entries)
+    total_uses += entry.use_count;
+
+  std::cout << fmt::format("{} pipeline UIDs, bound {} times in total", entries.size(), total_uses)
+            << std::endl;
+  if (entries.empty())
+    return 0;
+
+  std::cout << std::endl
+            << "   rank       uses  stride  vertex    geometry  pixel     raster    depth     blend"
+            << std::endl;
+  for (size_t i = 0; i < std::min(entries.size(), max_entries); i++)
+  {
+    const VideoCommon::SerializedGXPipelineUid& uid = entries[i].uid;
+    std::cout << fmt::format("{:7} {:10} {:7}  {:08x}  {:08x}  {:08x}  {:08x}  {:08x}  {:08x}",
+                             i + 1, entries[i].use_count, uid.vertex_decl.stride,
+                             HashUid(uid.vs_uid), HashUid(uid.gs_uid), HashUid(uid.ps_uid),
+                             uid.rasterization_state_bits, uid.depth_state_bits,
+                             uid.blending_state_bits)
+              << std::endl;
+  }
+  if (entries.size() > max_entries)
+    std::cout << "(" << entries.size() - max_entries << " more)" << std::endl;
+
+  return 0;
+}
+
+int PipelineUIDCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: pipelines merge -o FILE INPUT...\n"
+                "       pipelines inspect [-n COUNT] FILE");
+
+  parser->description("Merges or inspects the pipeline UID databases (.uiddb) that Dolphin "
+                      "records in the Cache folder. When the shader cache is enabled, pipelines "
+                      "in a game's database are compiled at boot, most frequently used first.");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the database FILE to write when merging.")
+      .metavar("FILE");
+
+  parser->add_option("-n", "--count")
+      .type("int")
+      .action("store")
+      .set_default(50)
+      .help("Number of pipelines to list when inspecting. [default: %default]")
+      .metavar("COUNT");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  // The first positional argument is the name of this command.
+  const std::vector<std::string> positional = parser->args();
+  if (positional.size() < 2)
+  {
+    parser->print_usage(std::cerr);
+    return 1;
+  }
+
+  const std::string& action = positional[1];
+  const std::vector<std::string> paths(positional.begin() + 2, positional.end());
+
+  if (action == "merge")
+  {
+    const std::string output_file_path = static_cast<const char*>(options.get("output"));
+    if (output_file_path.empty())
+    {
+      std::cerr << "Error: No output set" << std::endl;
+      return 1;
+    }
+    if (paths.empty())
+    {
+      std::cerr << "Error: No input set" << std::endl;
+      return 1;
+    }
+
+    return Merge(output_file_path, paths);
+  }
+
+  if (action == "inspect")
+  {
+    if (paths.size() != 1)
+    {
+      std::cerr << "Error: Exactly one input must be set" << std::endl;
+      return 1;
+    }
+
+    const int count = static_cast<int>(options.get("count"));
+    return Inspect(paths[0], static_cast<size_t>(std::max(count, 0)));
+  }
+
+  parser->print_usage(std::cerr);
+  return 1;
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,68 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/StateHashDiffCommand.h"
+
+#include <iostream>
+#include <memory>
+#include <optional>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+
+#include "Core/StateHash.h"
+
+namespace DolphinTool
+{
+int StateHashDiffCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: statehashdiff [options]... LOG_A LOG_B");
+  parser->description("Compares two state hash logs written with Movie/LogStateHashes enabled, "
+                      "and prints the first frame at which the emulated state differs.");
+
+  // The first argument is the command name.
+  parser->parse_args(args.begin() + 1, args.end());
+
+  const std::vector<std::string> positional = parser->args();
+  if (positional.size() != 2)
+  {
+    std::cerr << "Error: Expected exactly two state hash logs" << std::endl;
+    return 1;
+  }
+
+  std::optional<std::vector<StateHash::FrameHashes>> logs[2];
+  for (size_t i = 0; i < 2; ++i)
+  {
+    logs[i] = StateHash::ReadLog(positional[i]);
+    if (!logs[i])
+    {
+      std::cerr << "Error: Unable to read state hash log " << positional[i] << std::endl;
+      return 1;
+    }
+  }
+
+  const std::optional<StateHash::Divergence> divergence =
+      StateHash::FindFirstDivergence(*logs[0], *logs[1]);
+  if (!divergence)
+  {
+    std::cout << fmt::format("No divergence in the frames common to both logs ({} and {} frames)",
+                             logs[0]->size(), logs[1]->size())
+              << std::endl;
+    return 0;
+  }
+
+  std::string subsystems;
+  for (StateHash::Subsystem subsystem : divergence->subsystems)
+  {
+    if (!subsystems.empty())
+      subsystems += ", ";
+    subsystems += StateHash::GetSubsystemName(subsystem);
+  }
+
+  std::cout << fmt::format("First divergence at frame {}: {}", divergence->frame, subsystems)
+            << std::endl;
+  return 2;
+}
+}  // namespace DolphinTool
@@ -0,0 +1,71 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TexturePackCommand.h"
+
+#include <iostream>
+
+#include <OptionParser.h>
+
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTexturePack.h"
+#include "VideoCommon/HiresTextures.h"
+
+namespace DolphinTool
+{
+int TexturePackCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: texpack [options]...");
+
+  parser->add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a custom texture DIRECTORY.")
+      .metavar("DIRECTORY");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the texture pack FILE to write. To be picked up automatically, the file "
+            "must be placed in the Load/Textures folder and be named after the game ID, "
+            "e.g. GALE01.dtp.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  // Validate options
+  const std::string input_directory = static_cast<const char*>(options.get("input"));
+  if (input_directory.empty() || !File::IsDirectory(input_directory))
+  {
+    std::cerr << "Error: No valid input directory set" << std::endl;
+    return 1;
+  }
+
+  const std::string output_file_path = static_cast<const char*>(options.get("output"));
+  if (output_file_path.empty())
+  {
+    std::cerr << "Error: No output set" << std::endl;
+    return 1;
+  }
+
+  if (!HiresTexture::BuildPack(input_directory, output_file_path))
+  {
+    std::cerr << "Error: Failed to build the texture pack" << std::endl;
+    return 1;
+  }
+
+  const std::unique_ptr<HiresTexturePack> pack = HiresTexturePack::Open(output_file_path);
+  if (!pack)
+  {
+    std::cerr << "Error: The written texture pack could not be read back" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Packed " << pack->GetTextureCount() << " textures into " << output_file_path
+            << " (" << File::GetSize(output_file_path) << " bytes)" << std::endl;
+  return 0;
+}
+
+}  // namespace DolphinTool
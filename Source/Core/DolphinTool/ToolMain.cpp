@@ -10,13 +10,20 @@
 #include "Common/Version.h"
 #include "DolphinTool/Command.h"
 #include "DolphinTool/ConvertCommand.h"
+#include "DolphinTool/FifoBenchCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/NetPlayBenchCommand.h"
+#include "DolphinTool/PipelineUIDCommand.h"
+#include "DolphinTool/StateHashDiffCommand.h"
+#include "DolphinTool/TexturePackCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static int PrintUsage(int code)
 {
   std::cerr << "usage: dolphin-tool COMMAND -h" << std::endl << std::endl;
-  std::cerr << "commands supported: [convert, verify, header]" << std::endl;
+  std::cerr << "commands supported: [convert, verify, header, texpack, pipelines, fifobench, "
+               "netplaybench, statehashdiff]"
+            << std::endl;
 
   return code;
 }
@@ -45,6 +52,16 @@ int main(int argc, char* argv[])
     command = std::make_unique<DolphinTool::VerifyCommand>();
   else if (command_str == "header")
     command = std::make_unique<DolphinTool::HeaderCommand>();
+  else if (command_str == "texpack")
+    command = std::make_unique<DolphinTool::TexturePackCommand>();
+  else if (command_str == "pipelines")
+    command = std::make_unique<DolphinTool::PipelineUIDCommand>();
+  else if (command_str == "fifobench")
+    command = std::make_unique<DolphinTool::FifoBenchCommand>();
+  else if (command_str == "netplaybench")
+    command = std::make_unique<DolphinTool::NetPlayBenchCommand>();
+  else if (command_str == "statehashdiff")
+    command = std::make_unique<DolphinTool::StateHashDiffCommand>();
   else
     return PrintUsage(1);
 
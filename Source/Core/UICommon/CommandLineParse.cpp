@@ -82,6 +82,11 @@ std::unique_ptr<optparse::OptionParser> CreateParser(ParserOptions options)
 
   parser->add_option("-u", "--user").action("store").help("User folder path");
   parser->add_option("-m", "--movie").action("store").help("Play a movie file");
+  parser->add_option("--movie_start_frame")
+      .action("store")
+      .type("int")
+      .metavar("<frame>")
+      .help("Start the movie from its last checkpoint at or before the given frame");
   parser->add_option("-e", "--exec")
       .action("append")
       .metavar("<file>")
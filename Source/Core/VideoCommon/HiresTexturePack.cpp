@@ -0,0 +1,285 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/HiresTexturePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <xxhash.h>
+
+#include "Common/Align.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace
+{
+#pragma pack(push, 1)
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 entry_count;
+  u32 reserved;
+  u64 index_offset;
+  u64 names_offset;
+};
+static_assert(sizeof(Header) == 32);
+
+struct LevelHeader
+{
+  u32 width;
+  u32 height;
+  u32 row_length;
+  u32 format;
+  u64 data_size;
+};
+static_assert(sizeof(LevelHeader) == 24);
+#pragma pack(pop)
+
+constexpr u64 PAYLOAD_ALIGNMENT = 64;
+constexpr u8 ENTRY_FLAG_ARBITRARY_MIPMAPS = 1;
+
+u64 HashName(std::string_view name)
+{
+  return XXH64(name.data(), name.size(), 0);
+}
+}  // namespace
+
+std::unique_ptr<HiresTexturePack> HiresTexturePack::Open(const std::string& path)
+{
+  // Can't use make_unique due to private constructor.
+  std::unique_ptr<HiresTexturePack> pack(new HiresTexturePack());
+  pack->m_path = path;
+  if (!pack->m_file.Open(path))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open custom texture pack {}", path);
+    return nullptr;
+  }
+
+  Header header;
+  const u8* header_ptr = pack->m_file.GetPointer(0, sizeof(header));
+  if (!header_ptr)
+  {
+    ERROR_LOG_FMT(VIDEO, "Custom texture pack {} is too small", path);
+    return nullptr;
+  }
+  std::memcpy(&header, header_ptr, sizeof(header));
+
+  if (header.magic != MAGIC || header.version != VERSION)
+  {
+    ERROR_LOG_FMT(VIDEO,
+                  "Custom texture pack {} has an unsupported format (magic {:08x}, version {})",
+                  path, header.magic, header.version);
+    return nullptr;
+  }
+
+  const u64 index_size = u64{header.entry_count} * sizeof(IndexEntry);
+  if (!pack->m_file.GetPointer(header.index_offset, index_size) ||
+      header.names_offset > header.index_offset)
+  {
+    ERROR_LOG_FMT(VIDEO, "Custom texture pack {} has a corrupted index", path);
+    return nullptr;
+  }
+
+  pack->m_entry_count = header.entry_count;
+  pack->m_index_offset = header.index_offset;
+  pack->m_names_offset = header.names_offset;
+  pack->m_names_size = header.index_offset - header.names_offset;
+  return pack;
+}
+
+HiresTexturePack::IndexEntry HiresTexturePack::GetIndexEntry(u32 index) const
+{
+  IndexEntry entry;
+  std::memcpy(&entry, m_file.GetData() + m_index_offset + u64{index} * sizeof(IndexEntry),
+              sizeof(entry));
+  return entry;
+}
+
+std::optional<u32> HiresTexturePack::Find(std::string_view name) const
+{
+  const u64 hash = HashName(name);
+
+  // Binary search for the first entry with a matching hash.
+  u32 first = 0;
+  u32 count = m_entry_count;
+  while (count > 0)
+  {
+    const u32 step = count / 2;
+    if (GetIndexEntry(first + step).name_hash < hash)
+    {
+      first += step + 1;
+      count -= step + 1;
+    }
+    else
+    {
+      count = step;
+    }
+  }
+
+  for (u32 i = first; i < m_entry_count && GetIndexEntry(i).name_hash == hash; ++i)
+  {
+    if (GetName(i) == name)
+      return i;
+  }
+
+  return std::nullopt;
+}
+
+std::string_view HiresTexturePack::GetName(u32 index) const
+{
+  const IndexEntry entry = GetIndexEntry(index);
+  if (u64{entry.name_offset} + entry.name_length > m_names_size)
+    return {};
+
+  return std::string_view(
+      reinterpret_cast<const char*>(m_file.GetData() + m_names_offset + entry.name_offset),
+      entry.name_length);
+}
+
+bool HiresTexturePack::HasArbitraryMipmaps(u32 index) const
+{
+  return (GetIndexEntry(index).flags & ENTRY_FLAG_ARBITRARY_MIPMAPS) != 0;
+}
+
+bool HiresTexturePack::ReadLevels(u32 index, std::vector<HiresTexture::Level>* levels) const
+{
+  const IndexEntry entry = GetIndexEntry(index);
+  const u8* payload = m_file.GetPointer(entry.payload_offset, entry.payload_size);
+  if (!payload)
+    return false;
+
+  levels->clear();
+  levels->reserve(entry.level_count);
+
+  u64 offset = 0;
+  for (u32 i = 0; i < entry.level_count; ++i)
+  {
+    LevelHeader level_header;
+    if (entry.payload_size - offset < sizeof(level_header))
+      return false;
+    std::memcpy(&level_header, payload + offset, sizeof(level_header));
+    offset += sizeof(level_header);
+
+    if (entry.payload_size - offset < level_header.data_size ||
+        level_header.format >= static_cast<u32>(AbstractTextureFormat::Undefined))
+    {
+      return false;
+    }
+
+    HiresTexture::Level& level = levels->emplace_back();
+    level.format = static_cast<AbstractTextureFormat>(level_header.format);
+    level.width = level_header.width;
+    level.height = level_header.height;
+    level.row_length = level_header.row_length;
+    level.data.assign(payload + offset, payload + offset + level_header.data_size);
+    offset += level_header.data_size;
+  }
+
+  return true;
+}
+
+void HiresTexturePack::Prefetch(u32 index) const
+{
+  const IndexEntry entry = GetIndexEntry(index);
+  m_file.PrefetchRange(entry.payload_offset, entry.payload_size);
+}
+
+HiresTexturePack::Writer::~Writer()
+{
+  if (m_file.IsOpen())
+  {
+    m_file.Close();
+    File::Delete(m_path + ".tmp");
+  }
+}
+
+bool HiresTexturePack::Writer::Open(const std::string& path)
+{
+  m_path = path;
+  m_index.clear();
+  m_names.clear();
+  if (!m_file.Open(path + ".tmp", "wb"))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to create custom texture pack {}", path);
+    return false;
+  }
+
+  // The header is rewritten once the index location is known.
+  const Header header{};
+  return m_file.WriteBytes(&header, sizeof(header));
+}
+
+bool HiresTexturePack::Writer::AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                                          const std::vector<HiresTexture::Level>& levels)
+{
+  static constexpr u8 padding[PAYLOAD_ALIGNMENT] = {};
+  const u64 position = m_file.Tell();
+  const u64 aligned_position = Common::AlignUp(position, PAYLOAD_ALIGNMENT);
+  m_file.WriteBytes(padding, aligned_position - position);
+
+  IndexEntry entry;
+  entry.name_hash = HashName(name);
+  entry.payload_offset = aligned_position;
+  entry.name_offset = static_cast<u32>(m_names.size());
+  entry.name_length = static_cast<u16>(name.size());
+  entry.level_count = static_cast<u8>(levels.size());
+  entry.flags = has_arbitrary_mipmaps ? ENTRY_FLAG_ARBITRARY_MIPMAPS : 0;
+
+  for (const HiresTexture::Level& level : levels)
+  {
+    const LevelHeader level_header{level.width, level.height, level.row_length,
+                                   static_cast<u32>(level.format), level.data.size()};
+    m_file.WriteBytes(&level_header, sizeof(level_header));
+    m_file.WriteBytes(level.data.data(), level.data.size());
+  }
+
+  entry.payload_size = m_file.Tell() - entry.payload_offset;
+  m_index.push_back(entry);
+  m_names += name;
+  return m_file.IsGood();
+}
+
+bool HiresTexturePack::Writer::Finish()
+{
+  const std::string temp_path = m_path + ".tmp";
+
+  Header header{};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.entry_count = static_cast<u32>(m_index.size());
+
+  header.names_offset = m_file.Tell();
+  m_file.WriteBytes(m_names.data(), m_names.size());
+
+  const std::string_view names = m_names;
+  std::sort(m_index.begin(), m_index.end(), [names](const IndexEntry& a, const IndexEntry& b) {
+    if (a.name_hash != b.name_hash)
+      return a.name_hash < b.name_hash;
+    return names.substr(a.name_offset, a.name_length) < names.substr(b.name_offset, b.name_length);
+  });
+
+  header.index_offset = m_file.Tell();
+  m_file.WriteBytes(m_index.data(), m_index.size() * sizeof(IndexEntry));
+
+  m_file.Seek(0, File::SeekOrigin::Begin);
+  m_file.WriteBytes(&header, sizeof(header));
+
+  if (!m_file.IsGood() || !m_file.Close())
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write custom texture pack {}", temp_path);
+    m_file.Close();
+    File::Delete(temp_path);
+    return false;
+  }
+
+  if (!File::Rename(temp_path, m_path))
+  {
+    File::Delete(temp_path);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,101 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/HiresTextures.h"
+
+// A single-file container for a custom texture pack.
+//
+// Loose texture packs consist of thousands of PNG/DDS files, which all have to be enumerated at
+// startup and decoded before use. A packed texture pack stores every texture (including all of its
+// mip levels) already decoded into the format that is uploaded to the GPU, alongside a table that
+// is sorted by the hash of the texture name. The file is memory-mapped, so opening it only touches
+// the header and the table, and loading a texture is a copy rather than a decode.
+//
+// Layout (all values little-endian):
+//   Header
+//   Payloads, each aligned to PAYLOAD_ALIGNMENT:
+//     LevelHeader, level data, LevelHeader, level data, ...
+//   Name table (names are not null-terminated)
+//   Index, sorted by name hash
+class HiresTexturePack
+{
+#pragma pack(push, 1)
+  struct IndexEntry
+  {
+    u64 name_hash;
+    u64 payload_offset;
+    u64 payload_size;
+    u32 name_offset;
+    u16 name_length;
+    u8 level_count;
+    u8 flags;
+  };
+#pragma pack(pop)
+  static_assert(sizeof(IndexEntry) == 32);
+
+public:
+  static constexpr u32 MAGIC = 0x4B505444;  // "DTPK"
+  static constexpr u32 VERSION = 1;
+  static constexpr std::string_view EXTENSION = ".dtp";
+
+  // Writes textures one at a time, so that a pack can be built without keeping every decoded
+  // texture in memory. The pack is written to a temporary file, which is renamed by Finish and
+  // deleted if the writer is destroyed before that.
+  class Writer
+  {
+  public:
+    Writer() = default;
+    ~Writer();
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    bool Open(const std::string& path);
+    bool AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                    const std::vector<HiresTexture::Level>& levels);
+    bool Finish();
+
+  private:
+    std::string m_path;
+    File::IOFile m_file;
+    std::vector<IndexEntry> m_index;
+    std::string m_names;
+  };
+
+  static std::unique_ptr<HiresTexturePack> Open(const std::string& path);
+
+  const std::string& GetPath() const { return m_path; }
+  u32 GetTextureCount() const { return m_entry_count; }
+
+  std::optional<u32> Find(std::string_view name) const;
+  std::string_view GetName(u32 index) const;
+  bool HasArbitraryMipmaps(u32 index) const;
+
+  // Copies all levels of the given texture out of the pack.
+  bool ReadLevels(u32 index, std::vector<HiresTexture::Level>* levels) const;
+
+  // Asks the OS to start reading the given texture from disk.
+  void Prefetch(u32 index) const;
+
+private:
+  HiresTexturePack() = default;
+  IndexEntry GetIndexEntry(u32 index) const;
+
+  std::string m_path;
+  File::MappedFile m_file;
+  u32 m_entry_count = 0;
+  u64 m_index_offset = 0;
+  u64 m_names_offset = 0;
+  u64 m_names_size = 0;
+};
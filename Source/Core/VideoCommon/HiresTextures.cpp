@@ -4,12 +4,17 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
@@ -24,12 +29,13 @@
 #include "Common/Image.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
+#include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
-#include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/HiresTexturePack.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -39,47 +45,70 @@ struct DiskTexture
   bool has_arbitrary_mipmaps;
 };
 
+namespace
+{
+struct LoadRequest
+{
+  std::string base_filename;
+  u32 width = 0;
+  u32 height = 0;
+
+  // Whether the request was queued when prefetching started, and so counts towards its progress.
+  bool prefetch = false;
+
+  // Requests made by Search jump the queue, and their latency is tracked.
+  bool on_demand = false;
+  u64 request_time_us = 0;
+};
+
+struct CachedTexture
+{
+  std::shared_ptr<HiresTexture> texture;
+  size_t size = 0;
+  u64 last_used = 0;
+};
+}  // namespace
+
 constexpr std::string_view s_format_prefix{"tex1_"};
 
 static std::unordered_map<std::string, DiskTexture> s_textureMap;
-static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_textureCache;
+static std::unique_ptr<HiresTexturePack> s_texturePack;
+
+// Everything below is guarded by s_textureCacheMutex.
+static std::unordered_map<std::string, CachedTexture> s_textureCache;
+static size_t s_textureCacheSize = 0;
+static size_t s_textureCacheBudget = 0;
+static u64 s_textureUseCounter = 0;
+static std::deque<LoadRequest> s_loadQueue;
+static std::unordered_set<std::string> s_pendingLoads;
+static std::unordered_set<std::string> s_failedLoads;
+static size_t s_prefetchRemaining = 0;
+static u64 s_prefetchStartTime = 0;
+static HiresTexture::LoadStats s_loadStats;
 static std::mutex s_textureCacheMutex;
-static Common::Flag s_textureCacheAbortLoading;
+static std::condition_variable s_loadQueueCondition;
 
-static std::thread s_prefetcher;
+static Common::Flag s_textureCacheAbortLoading;
+static std::atomic<u32> s_loadGeneration{0};
+static std::vector<std::thread> s_loaderThreads;
 
-void HiresTexture::Init()
+static size_t GetTextureCacheBudget()
 {
-  // Note: Update is not called here so that we handle dynamic textures on startup more gracefully
+  const size_t sys_mem = Common::MemPhysical();
+  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
+  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
+  return (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
 }
 
-void HiresTexture::Shutdown()
+static bool HasTexture(const std::string& name)
 {
-  Clear();
+  return s_textureMap.find(name) != s_textureMap.end() ||
+         (s_texturePack && s_texturePack->Find(name));
 }
 
-void HiresTexture::Update()
+static void CollectTextures(const std::set<std::string>& texture_directories,
+                            std::unordered_map<std::string, DiskTexture>* texture_map)
 {
-  if (s_prefetcher.joinable())
-  {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
-  }
-
-  if (!g_ActiveConfig.bHiresTextures)
-  {
-    Clear();
-    return;
-  }
-
-  if (!g_ActiveConfig.bCacheHiresTextures)
-  {
-    s_textureCache.clear();
-  }
-
-  const std::string& game_id = SConfig::GetInstance().GetGameID();
-  const std::set<std::string> texture_directories =
-      GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
   const std::vector<std::string> extensions{".png", ".dds"};
 
   for (const auto& texture_directory : texture_directories)
@@ -101,7 +130,7 @@ void HiresTexture::Update()
           filename.erase(arb_index, 4);
 
         const auto [it, inserted] =
-            s_textureMap.try_emplace(filename, DiskTexture{path, has_arbitrary_mipmaps});
+            texture_map->try_emplace(filename, DiskTexture{path, has_arbitrary_mipmaps});
         if (!inserted)
         {
           failed_insert = true;
@@ -115,6 +144,193 @@ void HiresTexture::Update()
                     texture_directory);
     }
   }
+}
+
+// A packed texture pack named after the game ID takes the place of the texture directories.
+static std::unique_ptr<HiresTexturePack> OpenTexturePack(const std::string& root_directory,
+                                                         const std::string& game_id)
+{
+  for (const std::string& name : {game_id, game_id.substr(0, 3)})
+  {
+    const std::string path = root_directory + name + std::string(HiresTexturePack::EXTENSION);
+    if (!File::Exists(path))
+      continue;
+
+    std::unique_ptr<HiresTexturePack> pack = HiresTexturePack::Open(path);
+    if (pack)
+    {
+      INFO_LOG_FMT(VIDEO, "Using custom texture pack {} with {} textures", path,
+                   pack->GetTextureCount());
+    }
+    return pack;
+  }
+
+  return nullptr;
+}
+
+static void ClearTextureCache()
+{
+  s_textureCache.clear();
+  s_textureCacheSize = 0;
+}
+
+static void StopLoaderThreads()
+{
+  if (s_loaderThreads.empty())
+    return;
+
+  {
+    std::lock_guard lk(s_textureCacheMutex);
+    s_textureCacheAbortLoading.Set();
+  }
+  s_loadQueueCondition.notify_all();
+
+  for (std::thread& thread : s_loaderThreads)
+    thread.join();
+  s_loaderThreads.clear();
+
+  s_loadQueue.clear();
+  s_pendingLoads.clear();
+  s_prefetchRemaining = 0;
+  s_textureCacheAbortLoading.Clear();
+}
+
+// Drops the queued prefetch requests, but keeps the requests made by Search.
+static void StopPrefetching()
+{
+  for (auto iter = s_loadQueue.begin(); iter != s_loadQueue.end();)
+  {
+    if (!iter->on_demand)
+    {
+      s_pendingLoads.erase(iter->base_filename);
+      iter = s_loadQueue.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+  s_prefetchRemaining = 0;
+}
+
+static void EvictTextures()
+{
+  // Leave some headroom so that we don't have to evict again on the very next load.
+  const size_t target_size = s_textureCacheBudget / 10 * 9;
+
+  std::vector<decltype(s_textureCache)::iterator> candidates;
+  candidates.reserve(s_textureCache.size());
+  for (auto iter = s_textureCache.begin(); iter != s_textureCache.end(); ++iter)
+    candidates.push_back(iter);
+  std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+    return a->second.last_used < b->second.last_used;
+  });
+
+  for (const auto& iter : candidates)
+  {
+    if (s_textureCacheSize <= target_size)
+      break;
+
+    s_textureCacheSize -= iter->second.size;
+    s_loadStats.evictions++;
+    s_loadStats.bytes_evicted += iter->second.size;
+    s_textureCache.erase(iter);
+  }
+}
+
+static void InsertIntoTextureCache(const std::string& base_filename,
+                                   std::shared_ptr<HiresTexture> texture, size_t size)
+{
+  auto [iter, inserted] = s_textureCache.try_emplace(base_filename);
+  if (!inserted)
+    s_textureCacheSize -= iter->second.size;
+
+  iter->second.texture = std::move(texture);
+  iter->second.size = size;
+  iter->second.last_used = ++s_textureUseCounter;
+  s_textureCacheSize += size;
+
+  if (s_textureCacheBudget == 0 || s_textureCacheSize <= s_textureCacheBudget)
+    return;
+
+  if (s_prefetchRemaining != 0)
+  {
+    StopPrefetching();
+    OSD::AddMessage(
+        fmt::format("Custom Textures prefetching stopped after {:.1f} MB, memory budget reached",
+                    s_textureCacheSize / (1024.0 * 1024.0)),
+        10000);
+  }
+
+  EvictTextures();
+}
+
+static void RecordLoad(const HiresTexture* texture, size_t size, u64 load_time_us)
+{
+  if (!texture)
+  {
+    s_loadStats.load_failures++;
+    return;
+  }
+
+  s_loadStats.textures_loaded++;
+  s_loadStats.bytes_loaded += size;
+  s_loadStats.total_load_time_us += load_time_us;
+  s_loadStats.max_load_time_us = std::max(s_loadStats.max_load_time_us, load_time_us);
+}
+
+void HiresTexture::Init()
+{
+  // Note: Update is not called here so that we handle dynamic textures on startup more gracefully
+}
+
+void HiresTexture::Shutdown()
+{
+  Clear();
+
+  const LoadStats& stats = s_loadStats;
+  if (stats.textures_loaded != 0)
+  {
+    INFO_LOG_FMT(VIDEO,
+                 "Custom textures: {} loaded ({:.1f} MB, {} failed), average load {:.2f} ms, "
+                 "max {:.2f} ms; {} on-demand, average latency {:.2f} ms, max {:.2f} ms; "
+                 "{} evicted ({:.1f} MB)",
+                 stats.textures_loaded, stats.bytes_loaded / (1024.0 * 1024.0),
+                 stats.load_failures, stats.total_load_time_us / 1000.0 / stats.textures_loaded,
+                 stats.max_load_time_us / 1000.0, stats.on_demand_loads,
+                 stats.on_demand_loads ?
+                     stats.total_on_demand_latency_us / 1000.0 / stats.on_demand_loads :
+                     0.0,
+                 stats.max_on_demand_latency_us / 1000.0, stats.evictions,
+                 stats.bytes_evicted / (1024.0 * 1024.0));
+  }
+  s_loadStats = {};
+}
+
+void HiresTexture::Update()
+{
+  StopLoaderThreads();
+
+  if (!g_ActiveConfig.bHiresTextures)
+  {
+    Clear();
+    return;
+  }
+
+  if (!g_ActiveConfig.bCacheHiresTextures)
+  {
+    ClearTextureCache();
+  }
+
+  s_textureMap.clear();
+  s_texturePack.reset();
+  s_failedLoads.clear();
+
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  const std::string& root_directory = File::GetUserPath(D_HIRESTEXTURES_IDX);
+  s_texturePack = OpenTexturePack(root_directory, game_id);
+  if (!s_texturePack)
+    CollectTextures(GetTextureDirectoriesWithGameId(root_directory, game_id), &s_textureMap);
 
   if (g_ActiveConfig.bCacheHiresTextures)
   {
@@ -122,8 +338,9 @@ void HiresTexture::Update()
     auto iter = s_textureCache.begin();
     while (iter != s_textureCache.end())
     {
-      if (s_textureMap.find(iter->first) == s_textureMap.end())
+      if (!HasTexture(iter->first))
       {
+        s_textureCacheSize -= iter->second.size;
         iter = s_textureCache.erase(iter);
       }
       else
@@ -132,97 +349,116 @@ void HiresTexture::Update()
       }
     }
 
-    s_textureCacheAbortLoading.Clear();
-    s_prefetcher = std::thread(Prefetch);
+    s_textureCacheBudget = GetTextureCacheBudget();
+
+    const auto queue_prefetch = [](std::string base_filename) {
+      if (base_filename.find("_mip") != std::string::npos ||
+          s_textureCache.find(base_filename) != s_textureCache.end())
+      {
+        return;
+      }
+      if (s_pendingLoads.insert(base_filename).second)
+      {
+        LoadRequest& request = s_loadQueue.emplace_back();
+        request.base_filename = std::move(base_filename);
+        request.prefetch = true;
+      }
+    };
+
+    for (const auto& entry : s_textureMap)
+      queue_prefetch(entry.first);
+    if (s_texturePack)
+    {
+      for (u32 i = 0; i < s_texturePack->GetTextureCount(); ++i)
+        queue_prefetch(std::string(s_texturePack->GetName(i)));
+    }
+
+    s_prefetchRemaining = s_loadQueue.size();
+    s_prefetchStartTime = Common::Timer::GetTimeUs();
+
+    const u32 thread_count = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+    for (u32 i = 0; i < thread_count; ++i)
+      s_loaderThreads.emplace_back(&HiresTexture::LoaderThread);
   }
 }
 
 void HiresTexture::Clear()
 {
-  if (s_prefetcher.joinable())
-  {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
-  }
+  StopLoaderThreads();
   s_textureMap.clear();
-  s_textureCache.clear();
+  s_texturePack.reset();
+  s_failedLoads.clear();
+  ClearTextureCache();
 }
 
-void HiresTexture::Prefetch()
+void HiresTexture::LoaderThread()
 {
-  Common::SetCurrentThreadName("Prefetcher");
-
-  size_t size_sum = 0;
-  const size_t sys_mem = Common::MemPhysical();
-  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
-  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
-  const size_t max_mem =
-      (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+  Common::SetCurrentThreadName("Custom Texture Loader");
 
-  const u32 start_time = Common::Timer::GetTimeMs();
-  for (const auto& entry : s_textureMap)
+  std::unique_lock lk(s_textureCacheMutex);
+  while (true)
   {
-    const std::string& base_filename = entry.first;
+    s_loadQueueCondition.wait(
+        lk, [] { return s_textureCacheAbortLoading.IsSet() || !s_loadQueue.empty(); });
+    if (s_textureCacheAbortLoading.IsSet())
+      return;
 
-    if (base_filename.find("_mip") == std::string::npos)
-    {
-      std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+    const LoadRequest request = std::move(s_loadQueue.front());
+    s_loadQueue.pop_front();
 
-      auto iter = s_textureCache.find(base_filename);
-      if (iter == s_textureCache.end())
-      {
-        // unlock while loading a texture. This may result in a race condition where
-        // we'll load a texture twice, but it reduces the stuttering a lot.
-        lk.unlock();
-        std::unique_ptr<HiresTexture> texture = Load(base_filename, 0, 0);
-        lk.lock();
-        if (texture)
-        {
-          std::shared_ptr<HiresTexture> ptr(std::move(texture));
-          iter = s_textureCache.insert(iter, std::make_pair(base_filename, ptr));
-        }
-      }
-      if (iter != s_textureCache.end())
-      {
-        for (const Level& l : iter->second->m_levels)
-          size_sum += l.data.size();
-      }
+    // Start reading the next texture from the pack while this one is being copied.
+    if (s_texturePack && !s_loadQueue.empty())
+    {
+      if (const auto index = s_texturePack->Find(s_loadQueue.front().base_filename))
+        s_texturePack->Prefetch(*index);
     }
 
-    if (s_textureCacheAbortLoading.IsSet())
+    lk.unlock();
+    const u64 start_time = Common::Timer::GetTimeUs();
+    std::shared_ptr<HiresTexture> texture = Load(request.base_filename, request.width,
+                                                 request.height);
+    const size_t size = texture ? texture->GetSizeInBytes() : 0;
+    const u64 end_time = Common::Timer::GetTimeUs();
+    lk.lock();
+
+    RecordLoad(texture.get(), size, end_time - start_time);
+    if (request.on_demand)
     {
-      return;
+      const u64 latency = end_time - request.request_time_us;
+      s_loadStats.on_demand_loads++;
+      s_loadStats.total_on_demand_latency_us += latency;
+      s_loadStats.max_on_demand_latency_us =
+          std::max(s_loadStats.max_on_demand_latency_us, latency);
     }
 
-    if (size_sum > max_mem)
-    {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
+    s_pendingLoads.erase(request.base_filename);
+    if (texture)
+      InsertIntoTextureCache(request.base_filename, std::move(texture), size);
+    else
+      s_failedLoads.insert(request.base_filename);
 
-      OSD::AddMessage(
-          fmt::format(
-              "Custom Textures prefetching after {:.1f} MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
-          10000);
-      return;
+    s_loadGeneration.fetch_add(1, std::memory_order_release);
+
+    if (request.prefetch && s_prefetchRemaining != 0 && --s_prefetchRemaining == 0)
+    {
+      OSD::AddMessage(fmt::format("Custom Textures loaded, {:.1f} MB in {:.1f}s",
+                                  s_textureCacheSize / (1024.0 * 1024.0),
+                                  (end_time - s_prefetchStartTime) / 1000000.0),
+                      10000);
     }
   }
-
-  const u32 stop_time = Common::Timer::GetTimeMs();
-  OSD::AddMessage(fmt::format("Custom Textures loaded, {:.1f} MB in {:.1f}s",
-                              size_sum / (1024.0 * 1024.0), (stop_time - start_time) / 1000.0),
-                  10000);
 }
 
 std::string HiresTexture::GenBaseName(const TextureInfo& texture_info, bool dump)
 {
-  if (!dump && s_textureMap.empty())
+  if (!dump && s_textureMap.empty() && !s_texturePack)
     return "";
 
   const auto texture_name_details = texture_info.CalculateTextureName();
 
   // look for an exact match first
   const std::string full_name = texture_name_details.GetFullName();
-  if (dump || s_textureMap.find(full_name) != s_textureMap.end())
+  if (dump || HasTexture(full_name))
     return full_name;
 
   // else try and find a wildcard
@@ -232,14 +468,14 @@ std::string HiresTexture::GenBaseName(const TextureInfo& texture_info, bool dump
     const std::string texture_name_single_wildcard_tlut =
         fmt::format("{}_{}_$_{}", texture_name_details.base_name, texture_name_details.texture_name,
                     texture_name_details.format_name);
-    if (s_textureMap.find(texture_name_single_wildcard_tlut) != s_textureMap.end())
+    if (HasTexture(texture_name_single_wildcard_tlut))
       return texture_name_single_wildcard_tlut;
 
     // Single wildcard ignoring the texture hash
     const std::string texture_name_single_wildcard_tex =
         fmt::format("{}_${}_{}", texture_name_details.base_name, texture_name_details.tlut_name,
                     texture_name_details.format_name);
-    if (s_textureMap.find(texture_name_single_wildcard_tex) != s_textureMap.end())
+    if (HasTexture(texture_name_single_wildcard_tex))
       return texture_name_single_wildcard_tex;
   }
 
@@ -261,35 +497,203 @@ u32 HiresTexture::CalculateMipCount(u32 width, u32 height)
   return mip_count;
 }
 
-std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
+std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info,
+                                                   std::string* pending_base_filename)
 {
   const std::string base_filename = GenBaseName(texture_info);
+  if (base_filename.empty())
+    return nullptr;
 
-  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  std::unique_lock<std::mutex> lk(s_textureCacheMutex);
 
   auto iter = s_textureCache.find(base_filename);
   if (iter != s_textureCache.end())
   {
-    return iter->second;
+    iter->second.last_used = ++s_textureUseCounter;
+    return iter->second.texture;
+  }
+
+  if (!s_loaderThreads.empty())
+  {
+    // Don't stall the GPU thread, let the loader threads pick it up instead.
+    if (s_failedLoads.find(base_filename) != s_failedLoads.end())
+      return nullptr;
+
+    LoadRequest request;
+    if (s_pendingLoads.insert(base_filename).second)
+    {
+      request.base_filename = base_filename;
+    }
+    else
+    {
+      // Already queued by the prefetcher, so move it to the front of the queue.
+      auto queued = std::find_if(s_loadQueue.begin(), s_loadQueue.end(), [&](const auto& r) {
+        return !r.on_demand && r.base_filename == base_filename;
+      });
+      if (queued != s_loadQueue.end())
+      {
+        request = std::move(*queued);
+        s_loadQueue.erase(queued);
+      }
+    }
+
+    if (!request.base_filename.empty())
+    {
+      request.width = texture_info.GetRawWidth();
+      request.height = texture_info.GetRawHeight();
+      request.on_demand = true;
+      request.request_time_us = Common::Timer::GetTimeUs();
+      s_loadQueue.push_front(std::move(request));
+      s_loadQueueCondition.notify_one();
+    }
+
+    if (pending_base_filename)
+      *pending_base_filename = base_filename;
+    return nullptr;
   }
 
+  const u64 start_time = Common::Timer::GetTimeUs();
   std::shared_ptr<HiresTexture> ptr(
       Load(base_filename, texture_info.GetRawWidth(), texture_info.GetRawHeight()));
+  const size_t size = ptr ? ptr->GetSizeInBytes() : 0;
+  RecordLoad(ptr.get(), size, Common::Timer::GetTimeUs() - start_time);
 
   if (ptr && g_ActiveConfig.bCacheHiresTextures)
   {
-    s_textureCache[base_filename] = ptr;
+    InsertIntoTextureCache(base_filename, ptr, size);
   }
 
   return ptr;
 }
 
+bool HiresTexture::IsLoadPending(const std::string& base_filename)
+{
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  return s_pendingLoads.find(base_filename) != s_pendingLoads.end();
+}
+
+u32 HiresTexture::GetLoadGeneration()
+{
+  return s_loadGeneration.load(std::memory_order_acquire);
+}
+
+HiresTexture::LoadStats HiresTexture::GetLoadStats()
+{
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  return s_loadStats;
+}
+
+// Returns false if the texture has a block-compressed format which the backend can't sample.
+static bool IsFormatSupported(AbstractTextureFormat format)
+{
+  switch (format)
+  {
+  case AbstractTextureFormat::DXT1:
+  case AbstractTextureFormat::DXT3:
+  case AbstractTextureFormat::DXT5:
+    return g_ActiveConfig.backend_info.bSupportsST3CTextures;
+  case AbstractTextureFormat::BPTC:
+    return g_ActiveConfig.backend_info.bSupportsBPTCTextures;
+  default:
+    return true;
+  }
+}
+
+bool HiresTexture::BuildPack(const std::string& texture_directory, const std::string& pack_path)
+{
+  // Keep block-compressed DDS textures as they are, rather than letting the loader fall back to
+  // decoding them to RGBA when the current backend can't use them. Whether they can be used is
+  // checked when the pack is loaded.
+  const bool supports_s3tc = g_ActiveConfig.backend_info.bSupportsST3CTextures;
+  const bool supports_bptc = g_ActiveConfig.backend_info.bSupportsBPTCTextures;
+  g_ActiveConfig.backend_info.bSupportsST3CTextures = true;
+  g_ActiveConfig.backend_info.bSupportsBPTCTextures = true;
+  Common::ScopeGuard restore_backend_info([&] {
+    g_ActiveConfig.backend_info.bSupportsST3CTextures = supports_s3tc;
+    g_ActiveConfig.backend_info.bSupportsBPTCTextures = supports_bptc;
+  });
+
+  DiskTextureMap texture_map;
+  CollectTextures({texture_directory}, &texture_map);
+
+  HiresTexturePack::Writer writer;
+  if (!writer.Open(pack_path))
+    return false;
+
+  size_t texture_count = 0;
+  for (const auto& entry : texture_map)
+  {
+    const std::string& base_filename = entry.first;
+    if (base_filename.find("_mip") != std::string::npos)
+      continue;
+
+    std::string source_path;
+    std::unique_ptr<HiresTexture> texture = LoadFromFiles(texture_map, base_filename, &source_path);
+    if (!texture || !ValidateLevels(texture.get(), source_path, 0, 0))
+    {
+      WARN_LOG_FMT(VIDEO, "Skipping custom texture {} which failed to load", base_filename);
+      continue;
+    }
+
+    if (!writer.AddTexture(base_filename, texture->m_has_arbitrary_mipmaps, texture->m_levels))
+      return false;
+    texture_count++;
+  }
+
+  if (!writer.Finish())
+    return false;
+
+  INFO_LOG_FMT(VIDEO, "Wrote {} custom textures from {} to {}", texture_count, texture_directory,
+               pack_path);
+  return true;
+}
+
 std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filename, u32 width,
                                                  u32 height)
+{
+  std::unique_ptr<HiresTexture> ret;
+  std::string source_path;
+
+  if (s_texturePack)
+  {
+    const std::optional<u32> index = s_texturePack->Find(base_filename);
+    if (!index)
+      return nullptr;
+
+    // Can't use make_unique due to private constructor.
+    ret = std::unique_ptr<HiresTexture>(new HiresTexture());
+    ret->m_has_arbitrary_mipmaps = s_texturePack->HasArbitraryMipmaps(*index);
+    source_path = fmt::format("{}:{}", s_texturePack->GetPath(), base_filename);
+    if (!s_texturePack->ReadLevels(*index, &ret->m_levels))
+    {
+      ERROR_LOG_FMT(VIDEO, "Custom texture {} failed to load", source_path);
+      return nullptr;
+    }
+    if (!ret->m_levels.empty() && !IsFormatSupported(ret->m_levels[0].format))
+    {
+      ERROR_LOG_FMT(VIDEO, "Custom texture {} has a compressed format the backend doesn't support",
+                    source_path);
+      return nullptr;
+    }
+  }
+  else
+  {
+    ret = LoadFromFiles(s_textureMap, base_filename, &source_path);
+  }
+
+  if (!ret || !ValidateLevels(ret.get(), source_path, width, height))
+    return nullptr;
+
+  return ret;
+}
+
+std::unique_ptr<HiresTexture> HiresTexture::LoadFromFiles(const DiskTextureMap& texture_map,
+                                                          const std::string& base_filename,
+                                                          std::string* source_path)
 {
   // We need to have a level 0 custom texture to even consider loading.
-  auto filename_iter = s_textureMap.find(base_filename);
-  if (filename_iter == s_textureMap.end())
+  auto filename_iter = texture_map.find(base_filename);
+  if (filename_iter == texture_map.end())
     return nullptr;
 
   // Try to load level 0 (and any mipmaps) from a DDS file.
@@ -298,6 +702,7 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
   const DiskTexture& first_mip_file = filename_iter->second;
   ret->m_has_arbitrary_mipmaps = first_mip_file.has_arbitrary_mipmaps;
+  *source_path = first_mip_file.path;
   LoadDDSTexture(ret.get(), first_mip_file.path);
 
   // Load remaining mip levels, or from the start if it's not a DDS texture.
@@ -307,8 +712,8 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     if (mip_level != 0)
       filename += fmt::format("_mip{}", mip_level);
 
-    filename_iter = s_textureMap.find(filename);
-    if (filename_iter == s_textureMap.end())
+    filename_iter = texture_map.find(filename);
+    if (filename_iter == texture_map.end())
       break;
 
     // Try loading DDS textures first, that way we maintain compression of DXT formats.
@@ -331,18 +736,24 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     ret->m_levels.push_back(std::move(level));
   }
 
+  return ret;
+}
+
+bool HiresTexture::ValidateLevels(HiresTexture* texture, const std::string& source_path,
+                                  u32 width, u32 height)
+{
   // If we failed to load any mip levels, we can't use this texture at all.
-  if (ret->m_levels.empty())
-    return nullptr;
+  if (texture->m_levels.empty())
+    return false;
 
   // Verify that the aspect ratio of the texture hasn't changed, as this could have side-effects.
-  const Level& first_mip = ret->m_levels[0];
+  const Level& first_mip = texture->m_levels[0];
   if (first_mip.width * height != first_mip.height * width)
   {
     ERROR_LOG_FMT(VIDEO,
                   "Invalid custom texture size {}x{} for texture {}. The aspect differs "
                   "from the native size {}x{}.",
-                  first_mip.width, first_mip.height, first_mip_file.path, width, height);
+                  first_mip.width, first_mip.height, source_path, width, height);
   }
 
   // Same deal if the custom texture isn't a multiple of the native size.
@@ -351,51 +762,51 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     ERROR_LOG_FMT(VIDEO,
                   "Invalid custom texture size {}x{} for texture {}. Please use an integer "
                   "upscaling factor based on the native size {}x{}.",
-                  first_mip.width, first_mip.height, first_mip_file.path, width, height);
+                  first_mip.width, first_mip.height, source_path, width, height);
   }
 
   // Verify that each mip level is the correct size (divide by 2 each time).
   u32 current_mip_width = first_mip.width;
   u32 current_mip_height = first_mip.height;
-  for (u32 mip_level = 1; mip_level < static_cast<u32>(ret->m_levels.size()); mip_level++)
+  for (u32 mip_level = 1; mip_level < static_cast<u32>(texture->m_levels.size()); mip_level++)
   {
     if (current_mip_width != 1 || current_mip_height != 1)
     {
       current_mip_width = std::max(current_mip_width / 2, 1u);
       current_mip_height = std::max(current_mip_height / 2, 1u);
 
-      const Level& level = ret->m_levels[mip_level];
+      const Level& level = texture->m_levels[mip_level];
       if (current_mip_width == level.width && current_mip_height == level.height)
         continue;
 
       ERROR_LOG_FMT(
           VIDEO, "Invalid custom texture size {}x{} for texture {}. Mipmap level {} must be {}x{}.",
-          level.width, level.height, first_mip_file.path, mip_level, current_mip_width,
+          level.width, level.height, source_path, mip_level, current_mip_width,
           current_mip_height);
     }
     else
     {
       // It is invalid to have more than a single 1x1 mipmap.
       ERROR_LOG_FMT(VIDEO, "Custom texture {} has too many 1x1 mipmaps. Skipping extra levels.",
-                    first_mip_file.path);
+                    source_path);
     }
 
     // Drop this mip level and any others after it.
-    while (ret->m_levels.size() > mip_level)
-      ret->m_levels.pop_back();
+    while (texture->m_levels.size() > mip_level)
+      texture->m_levels.pop_back();
   }
 
   // All levels have to have the same format.
-  if (std::any_of(ret->m_levels.begin(), ret->m_levels.end(),
-                  [&ret](const Level& l) { return l.format != ret->m_levels[0].format; }))
+  if (std::any_of(texture->m_levels.begin(), texture->m_levels.end(),
+                  [texture](const Level& l) { return l.format != texture->m_levels[0].format; }))
   {
     ERROR_LOG_FMT(VIDEO, "Custom texture {} has inconsistent formats across mip levels.",
-                  first_mip_file.path);
+                  source_path);
 
-    return nullptr;
+    return false;
   }
 
-  return ret;
+  return true;
 }
 
 bool HiresTexture::LoadTexture(Level& level, const std::vector<u8>& buffer)
@@ -462,6 +873,14 @@ HiresTexture::~HiresTexture()
 {
 }
 
+size_t HiresTexture::GetSizeInBytes() const
+{
+  size_t size = 0;
+  for (const Level& level : m_levels)
+    size += level.data.size();
+  return size;
+}
+
 AbstractTextureFormat HiresTexture::GetFormat() const
 {
   return m_levels.at(0).format;
@@ -6,6 +6,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -13,6 +14,7 @@
 #include "VideoCommon/TextureInfo.h"
 
 enum class TextureFormat;
+struct DiskTexture;
 
 std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_directory,
                                                       const std::string& game_id);
@@ -25,12 +27,43 @@ public:
   static void Clear();
   static void Shutdown();
 
-  static std::shared_ptr<HiresTexture> Search(const TextureInfo& texture_info);
+  // When custom textures are cached, textures which are not loaded yet are queued for loading on
+  // a worker thread instead. In that case nullptr is returned and the name of the texture is
+  // stored in pending_base_filename, so that the caller can use the native texture as a
+  // placeholder until IsLoadPending returns false.
+  static std::shared_ptr<HiresTexture> Search(const TextureInfo& texture_info,
+                                              std::string* pending_base_filename = nullptr);
+  static bool IsLoadPending(const std::string& base_filename);
+
+  // Incremented every time a queued load finishes, so that callers can cheaply skip polling
+  // IsLoadPending when nothing has changed.
+  static u32 GetLoadGeneration();
 
   static std::string GenBaseName(const TextureInfo& texture_info, bool dump = false);
 
   static u32 CalculateMipCount(u32 width, u32 height);
 
+  // Decodes every texture in the given directory and writes them to a single texture pack file.
+  static bool BuildPack(const std::string& texture_directory, const std::string& pack_path);
+
+  struct LoadStats
+  {
+    u64 textures_loaded = 0;
+    u64 load_failures = 0;
+    u64 bytes_loaded = 0;
+    u64 total_load_time_us = 0;
+    u64 max_load_time_us = 0;
+
+    // Loads requested by Search, measured from the request until the texture is ready.
+    u64 on_demand_loads = 0;
+    u64 total_on_demand_latency_us = 0;
+    u64 max_on_demand_latency_us = 0;
+
+    u64 evictions = 0;
+    u64 bytes_evicted = 0;
+  };
+  static LoadStats GetLoadStats();
+
   ~HiresTexture();
 
   AbstractTextureFormat GetFormat() const;
@@ -47,12 +80,21 @@ public:
   std::vector<Level> m_levels;
 
 private:
+  using DiskTextureMap = std::unordered_map<std::string, DiskTexture>;
+
   static std::unique_ptr<HiresTexture> Load(const std::string& base_filename, u32 width,
                                             u32 height);
+  static std::unique_ptr<HiresTexture> LoadFromFiles(const DiskTextureMap& texture_map,
+                                                     const std::string& base_filename,
+                                                     std::string* source_path);
+  static bool ValidateLevels(HiresTexture* texture, const std::string& source_path, u32 width,
+                             u32 height);
   static bool LoadDDSTexture(HiresTexture* tex, const std::string& filename);
   static bool LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level);
   static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
-  static void Prefetch();
+  static void LoaderThread();
+
+  size_t GetSizeInBytes() const;
 
   HiresTexture() = default;
   bool m_has_arbitrary_mipmaps = false;
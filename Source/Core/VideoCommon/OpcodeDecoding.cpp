@@ -74,6 +74,10 @@ public:
         VertexLoaderManager::g_bases_dirty = true;
       }
 
+      // Deferred vertex conversion reads the array strides directly from the CP state.
+      if (sub_command == ARRAY_STRIDE)
+        VertexLoaderManager::WaitForVertexDecoding();
+
       INCSTAT(g_stats.this_frame.num_cp_loads);
     }
     else if constexpr (is_preprocess)
@@ -121,8 +125,8 @@ public:
 
     // HACK
     DataReader src{const_cast<u8*>(vertex_data), const_cast<u8*>(vertex_data) + size};
-    const u32 bytes =
-        VertexLoaderManager::RunVertices(vat, primitive, num_vertices, src, is_preprocess);
+    const u32 bytes = VertexLoaderManager::RunVertices(vat, primitive, num_vertices, src,
+                                                       is_preprocess, m_in_display_list);
 
     ASSERT(bytes == size);
 
@@ -239,6 +243,11 @@ u8* RunFifo(DataReader src, u32* cycles)
   auto callback = CallbackT{};
   u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
 
+  // The vertex data that was queued for conversion lives in the FIFO, which may be overwritten once
+  // this returns.
+  if constexpr (!is_preprocess)
+    VertexLoaderManager::FinishVertexDecoding();
+
   if (cycles != nullptr)
     *cycles = callback.m_cycles;
 
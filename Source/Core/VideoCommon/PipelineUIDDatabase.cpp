@@ -0,0 +1,118 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/PipelineUIDDatabase.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+namespace VideoCommon
+{
+namespace
+{
+#pragma pack(push, 1)
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 uid_version;
+  u32 uid_size;
+};
+static_assert(sizeof(Header) == 16);
+
+struct Record
+{
+  SerializedGXPipelineUid uid;
+  u32 use_count;
+};
+#pragma pack(pop)
+}  // namespace
+
+bool PipelineUIDDatabase::Load(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  Header header;
+  if (!file.ReadBytes(&header, sizeof(header)))
+    return false;
+
+  if (header.magic != MAGIC || header.version != VERSION ||
+      header.uid_version != GX_PIPELINE_UID_VERSION || header.uid_size != sizeof(Record::uid))
+  {
+    WARN_LOG_FMT(VIDEO, "Ignoring pipeline UID database {} from a different version", path);
+    return false;
+  }
+
+  const u64 record_count = (file.GetSize() - sizeof(Header)) / sizeof(Record);
+  std::vector<Record> records(record_count);
+  if (!file.ReadArray(records.data(), records.size()))
+    return false;
+
+  for (const Record& record : records)
+    Add(record.uid, record.use_count);
+
+  return true;
+}
+
+bool PipelineUIDDatabase::Save(const std::string& path) const
+{
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(path);
+  File::IOFile file(temp_path, "wb");
+  if (!WriteHeader(file))
+    return false;
+
+  for (const auto& [uid, use_count] : m_entries)
+    WriteRecord(file, uid, use_count);
+
+  if (!file.IsGood() || !file.Close())
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write pipeline UID database {}", temp_path);
+    file.Close();
+    File::Delete(temp_path);
+    return false;
+  }
+
+  return File::Rename(temp_path, path);
+}
+
+void PipelineUIDDatabase::Add(const SerializedGXPipelineUid& uid, u32 use_count)
+{
+  u32& entry = m_entries[uid];
+  entry += std::min(use_count, std::numeric_limits<u32>::max() - entry);
+}
+
+void PipelineUIDDatabase::Merge(const PipelineUIDDatabase& other)
+{
+  for (const auto& [uid, use_count] : other.m_entries)
+    Add(uid, use_count);
+}
+
+std::vector<PipelineUIDDatabase::Entry> PipelineUIDDatabase::GetEntriesByUseCount() const
+{
+  std::vector<Entry> entries;
+  entries.reserve(m_entries.size());
+  for (const auto& [uid, use_count] : m_entries)
+    entries.push_back({uid, use_count});
+
+  // m_entries is already sorted by UID, so a stable sort keeps ties in UID order.
+  std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    return a.use_count > b.use_count;
+  });
+  return entries;
+}
+
+bool PipelineUIDDatabase::WriteHeader(File::IOFile& file)
+{
+  const Header header{MAGIC, VERSION, GX_PIPELINE_UID_VERSION, sizeof(Record::uid)};
+  return file.WriteBytes(&header, sizeof(header));
+}
+
+bool PipelineUIDDatabase::WriteRecord(File::IOFile& file, const SerializedGXPipelineUid& uid,
+                                      u32 use_count)
+{
+  const Record record{uid, use_count};
+  return file.WriteBytes(&record, sizeof(record));
+}
+}  // namespace VideoCommon
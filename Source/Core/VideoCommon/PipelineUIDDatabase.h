@@ -0,0 +1,80 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/GXPipelineTypes.h"
+
+namespace VideoCommon
+{
+// A database of the GX pipelines a game has been seen to use, along with how many times each one
+// was bound. This is used to compile pipelines ahead of time, most frequently used first.
+//
+// Unlike the pipeline binary caches, the database doesn't depend on the video backend or on the
+// Dolphin revision, only on GX_PIPELINE_UID_VERSION. Databases recorded on different machines or
+// in different sessions can be merged by summing the use counts of identical UIDs.
+//
+// Layout (all values little-endian):
+//   Header
+//   Record, Record, ...
+//
+// A UID can appear in several records, in which case its use counts are summed. This allows
+// newly-seen UIDs to be appended to an existing file while the game is running, so that they
+// survive a crash. Save() writes every UID exactly once, sorted by UID.
+class PipelineUIDDatabase
+{
+public:
+  static constexpr u32 MAGIC = 0x42445550;  // "PUDB"
+  static constexpr u32 VERSION = 1;
+  static constexpr std::string_view EXTENSION = ".uiddb";
+
+  struct Entry
+  {
+    SerializedGXPipelineUid uid;
+    u32 use_count;
+  };
+
+  // Reads the given file and merges its entries into this database. Returns false if the file
+  // couldn't be read or was written for a different UID version, in which case nothing is merged.
+  // A partial record at the end of the file, left behind by a crash while appending, is ignored.
+  bool Load(const std::string& path);
+
+  // Writes the whole database to the given file, replacing it.
+  bool Save(const std::string& path) const;
+
+  void Add(const SerializedGXPipelineUid& uid, u32 use_count);
+  void Merge(const PipelineUIDDatabase& other);
+  void Clear() { m_entries.clear(); }
+
+  size_t GetSize() const { return m_entries.size(); }
+  bool IsEmpty() const { return m_entries.empty(); }
+
+  // Returns every entry, most frequently used first. Ties are broken by UID so that the order
+  // doesn't depend on the order the databases were merged in.
+  std::vector<Entry> GetEntriesByUseCount() const;
+
+  // Appends a single record to a database file which is open for writing.
+  static bool WriteRecord(File::IOFile& file, const SerializedGXPipelineUid& uid, u32 use_count);
+
+private:
+  static bool WriteHeader(File::IOFile& file);
+
+  struct UidLess
+  {
+    bool operator()(const SerializedGXPipelineUid& a, const SerializedGXPipelineUid& b) const
+    {
+      return std::memcmp(&a, &b, sizeof(a)) < 0;
+    }
+  };
+
+  std::map<SerializedGXPipelineUid, u32, UidLess> m_entries;
+};
+}  // namespace VideoCommon
@@ -3,11 +3,16 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <algorithm>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/FramebufferManager.h"
@@ -113,7 +118,7 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 {
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
-    return it->second.first.get();
+    return CountGXPipelineUse(it->second.first.get());
 
   const bool exists_in_cache = it != m_gx_pipeline_cache.end();
   std::unique_ptr<AbstractPipeline> pipeline;
@@ -122,7 +127,7 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
     pipeline = g_renderer->CreatePipeline(*pipeline_config);
   if (g_ActiveConfig.bShaderCache && !exists_in_cache)
     AppendGXPipelineUID(uid);
-  return InsertGXPipeline(uid, std::move(pipeline));
+  return CountGXPipelineUse(InsertGXPipeline(uid, std::move(pipeline)));
 }
 
 std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& uid)
@@ -132,7 +137,7 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
   {
     // .second is the pending flag, i.e. compiling in the background.
     if (!it->second.second)
-      return it->second.first.get();
+      return CountGXPipelineUse(it->second.first.get());
     else
       return {};
   }
@@ -197,6 +202,26 @@ void ShaderCache::WaitForAsyncCompiler()
   g_renderer->EndUIFrame();
 }
 
+// Returns the path of the given cache file within the shared cache folder, or an empty string if
+// there is no shared cache. Shared caches are only read, as other instances may be using them.
+static std::string GetSharedCacheFileName(const std::string& filename)
+{
+  std::string shared_path = Config::Get(Config::MAIN_SHARED_CACHE_PATH);
+  const std::string& cache_path = File::GetUserPath(D_CACHE_IDX);
+  if (shared_path.empty() || !StringBeginsWith(filename, cache_path))
+    return {};
+
+#ifdef _WIN32
+  std::replace(shared_path.begin(), shared_path.end(), '\\', DIR_SEP_CHR);
+#endif
+  if (shared_path.back() != DIR_SEP_CHR)
+    shared_path += DIR_SEP_CHR;
+  if (shared_path == cache_path)
+    return {};
+
+  return shared_path + filename.substr(cache_path.size());
+}
+
 template <typename SerializedUidType, typename UidType>
 static void SerializePipelineUid(const UidType& uid, SerializedUidType& serialized_uid)
 {
@@ -261,6 +286,16 @@ void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type,
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
   CacheReader reader(cache);
+
+  // Shaders from our own cache replace those from the shared one, and new shaders are only
+  // written to our own cache.
+  const std::string shared_filename = GetSharedCacheFileName(filename);
+  if (!shared_filename.empty())
+  {
+    const u32 shared_count = LinearDiskCache<K, u8>::Read(shared_filename, reader);
+    INFO_LOG_FMT(VIDEO, "Loaded {} shared cached shaders from {}", shared_count, shared_filename);
+  }
+
   u32 count = cache.disk_cache.OpenAndRead(filename, reader);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached shaders from {}", count, filename);
 }
@@ -315,6 +350,18 @@ void ShaderCache::LoadPipelineCache(T& cache, LinearDiskCache<DiskKeyType, u8>&
   };
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
+
+  // Pipelines which fail to create from the shared cache are simply skipped. It's up to whoever
+  // owns the shared cache to discard it.
+  const std::string shared_filename = GetSharedCacheFileName(filename);
+  if (!shared_filename.empty())
+  {
+    CacheReader shared_reader(this, cache);
+    const u32 shared_count = LinearDiskCache<DiskKeyType, u8>::Read(shared_filename, shared_reader);
+    INFO_LOG_FMT(VIDEO, "Loaded {} shared cached pipelines from {}", shared_count,
+                 shared_filename);
+  }
+
   CacheReader reader(this, cache);
   const u32 count = disk_cache.OpenAndRead(filename, reader);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached pipelines from {}", count, filename);
@@ -415,11 +462,20 @@ void ShaderCache::ClearCaches()
 
 void ShaderCache::CompileMissingPipelines()
 {
-  // Queue all uids with a null pipeline for compilation.
+  // Queue all uids with a null pipeline for compilation, starting with the ones that were used the
+  // most in previous sessions. The rank is part of the priority rather than relying on the queue
+  // order, as pipelines whose shaders aren't ready yet are re-queued.
+  u32 rank = 0;
+  for (const GXPipelineUid& uid : m_gx_pipeline_warmup_order)
+  {
+    auto it = m_gx_pipeline_cache.find(uid);
+    if (it != m_gx_pipeline_cache.end() && !it->second.first && !it->second.second)
+      QueuePipelineCompile(uid, COMPILE_PRIORITY_SHADERCACHE_PIPELINE + rank++);
+  }
   for (auto& it : m_gx_pipeline_cache)
   {
-    if (!it.second.first)
-      QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+    if (!it.second.first && !it.second.second)
+      QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE + rank);
   }
   for (auto& it : m_gx_uber_pipeline_cache)
   {
@@ -740,74 +796,82 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
   return entry.first.get();
 }
 
-void ShaderCache::LoadPipelineUIDCache()
+// Reads the pipeline UID cache used before the UID database, so that its UIDs aren't lost.
+static bool ImportLegacyPipelineUIDCache(const std::string& filename,
+                                         PipelineUIDDatabase* database)
 {
   constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
-  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
-      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
-  if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
+  File::IOFile file(filename, "rb");
+  u32 existing_magic;
+  u32 existing_version;
+  if (!file.ReadBytes(&existing_magic, sizeof(existing_magic)) ||
+      !file.ReadBytes(&existing_version, sizeof(existing_version)) ||
+      existing_magic != CACHE_FILE_MAGIC || existing_version != GX_PIPELINE_UID_VERSION)
   {
-    // If an existing case exists, validate the version before reading entries.
-    u32 existing_magic;
-    u32 existing_version;
-    bool uid_file_valid = false;
-    if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
-        m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
-    {
-      // Ensure the expected size matches the actual size of the file. If it doesn't, it means
-      // the cache file may be corrupted, and we should not proceed with loading potentially
-      // garbage or invalid UIDs.
-      const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
-      const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
-      uid_file_valid = file_size == expected_size;
-      if (uid_file_valid)
-      {
-        for (size_t i = 0; i < uid_count; i++)
-        {
-          SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
-          {
-            // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
-          }
-          else
-          {
-            uid_file_valid = false;
-            break;
-          }
-        }
-      }
+    return false;
+  }
 
-      // We open the file for reading and writing, so we must seek to the end before writing.
-      if (uid_file_valid)
-        uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, File::SeekOrigin::Begin);
-    }
+  SerializedGXPipelineUid serialized_uid;
+  while (file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
+    database->Add(serialized_uid, 1);
+  return true;
+}
 
-    // If the file is invalid, close it. We re-open and truncate it below.
-    if (!uid_file_valid)
-      m_gx_pipeline_uid_cache_file.Close();
+void ShaderCache::LoadPipelineUIDCache()
+{
+  const std::string cache_prefix =
+      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID();
+  const std::string filename = cache_prefix + std::string(PipelineUIDDatabase::EXTENSION);
+  const std::string legacy_filename = cache_prefix + ".uidcache";
+
+  m_gx_pipeline_uid_database.Clear();
+  if (!m_gx_pipeline_uid_database.Load(filename) &&
+      ImportLegacyPipelineUIDCache(legacy_filename, &m_gx_pipeline_uid_database))
+  {
+    File::Delete(legacy_filename);
   }
 
-  // If the file is not open, it means it was either corrupted or didn't exist.
-  if (!m_gx_pipeline_uid_cache_file.IsOpen())
+  // UIDs from the shared cache are only used for warming up. They aren't added to our own
+  // database, so that merging it back into the shared one doesn't count them twice.
+  PipelineUIDDatabase warmup_database;
+  const std::string shared_filename = GetSharedCacheFileName(filename);
+  if (!shared_filename.empty() && warmup_database.Load(shared_filename))
   {
-    if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
-    {
-      // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
-      m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
-                                              sizeof(GX_PIPELINE_UID_VERSION));
-
-      // Write any current UIDs out to the file.
-      // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
-      // we don't lose the existing UIDs which were previously at the beginning.
-      for (const auto& it : m_gx_pipeline_cache)
-        AppendGXPipelineUID(it.first);
-    }
+    INFO_LOG_FMT(VIDEO, "Read {} shared pipeline UIDs from {}", warmup_database.GetSize(),
+                 shared_filename);
+  }
+  warmup_database.Merge(m_gx_pipeline_uid_database);
+
+  // This just adds the pipelines to the map, they are compiled later.
+  m_gx_pipeline_warmup_order.clear();
+  for (const PipelineUIDDatabase::Entry& entry : warmup_database.GetEntriesByUseCount())
+  {
+    AddSerializedGXPipelineUID(entry.uid);
+
+    GXPipelineUid real_uid;
+    UnserializePipelineUid(entry.uid, real_uid);
+    m_gx_pipeline_warmup_order.push_back(real_uid);
+  }
+
+  // Keep any pipelines which were only found in the pipeline binary cache.
+  for (const auto& it : m_gx_pipeline_cache)
+  {
+    SerializedGXPipelineUid disk_uid;
+    SerializePipelineUid(it.first, disk_uid);
+    m_gx_pipeline_uid_database.Add(disk_uid, 0);
+  }
+
+  // Rewrite the file without duplicates or partially-written records, then append UIDs which are
+  // seen for the first time as they come in. This way, they aren't lost if Dolphin crashes. The
+  // use counts are only written out when the cache is closed.
+  if (m_gx_pipeline_uid_database.Save(filename) &&
+      m_gx_pipeline_uid_cache_file.Open(filename, "ab"))
+  {
+    m_gx_pipeline_uid_database_path = filename;
+  }
+  else
+  {
+    WARN_LOG_FMT(VIDEO, "Failed to open pipeline UID database {}", filename);
   }
 
   INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs from {}", m_gx_pipeline_cache.size(), filename);
@@ -815,8 +879,25 @@ void ShaderCache::LoadPipelineUIDCache()
 
 void ShaderCache::ClosePipelineUIDCache()
 {
-  // This is left as a method in case we need to append extra data to the file in the future.
   m_gx_pipeline_uid_cache_file.Close();
+  if (m_gx_pipeline_uid_database_path.empty())
+    return;
+
+  // Pipelines which were first seen this session are added even if they were never bound, e.g.
+  // because they were still compiling in the background.
+  for (const auto& [uid, entry] : m_gx_pipeline_cache)
+  {
+    const auto count_iter = m_gx_pipeline_use_counts.find(entry.first.get());
+    const u32 use_count = count_iter != m_gx_pipeline_use_counts.end() ? count_iter->second : 0;
+
+    SerializedGXPipelineUid disk_uid;
+    SerializePipelineUid(uid, disk_uid);
+    m_gx_pipeline_uid_database.Add(disk_uid, use_count);
+  }
+  m_gx_pipeline_use_counts.clear();
+
+  m_gx_pipeline_uid_database.Save(m_gx_pipeline_uid_database_path);
+  m_gx_pipeline_uid_database_path.clear();
 }
 
 void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
@@ -840,13 +921,23 @@ void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
 
   SerializedGXPipelineUid disk_uid;
   SerializePipelineUid(config, disk_uid);
-  if (!m_gx_pipeline_uid_cache_file.WriteBytes(&disk_uid, sizeof(disk_uid)))
+  if (!PipelineUIDDatabase::WriteRecord(m_gx_pipeline_uid_cache_file, disk_uid, 1))
   {
     WARN_LOG_FMT(VIDEO, "Writing pipeline UID to cache failed, closing file.");
     m_gx_pipeline_uid_cache_file.Close();
   }
 }
 
+// Counts are keyed by the pipeline object rather than the UID, as hashing a pointer is much cheaper
+// than comparing UIDs. They are matched up with the UIDs when the database is written.
+const AbstractPipeline* ShaderCache::CountGXPipelineUse(const AbstractPipeline* pipeline)
+{
+  if (pipeline && !m_gx_pipeline_uid_database_path.empty())
+    m_gx_pipeline_use_counts[pipeline]++;
+
+  return pipeline;
+}
+
 void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority)
 {
   class VertexShaderWorkItem final : public AsyncShaderCompiler::WorkItem
@@ -3,11 +3,15 @@
 
 #include "VideoCommon/Statistics.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <utility>
 
 #include <imgui.h>
 
+#include "Common/CommonTypes.h"
+
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -15,8 +19,32 @@
 Statistics g_stats;
 static bool clear_scissors;
 
+// ThisFrame consists of nothing but int counters, so it can be summed as an array.
+constexpr size_t NUM_FRAME_COUNTERS = sizeof(Statistics::ThisFrame) / sizeof(int);
+static_assert(sizeof(Statistics::ThisFrame) == NUM_FRAME_COUNTERS * sizeof(int));
+
+static Statistics::ThisFrame AddFrameCounters(const Statistics::ThisFrame& a,
+                                              const Statistics::ThisFrame& b)
+{
+  std::array<u32, NUM_FRAME_COUNTERS> counters_a, counters_b;
+  std::memcpy(counters_a.data(), &a, sizeof(a));
+  std::memcpy(counters_b.data(), &b, sizeof(b));
+  for (size_t i = 0; i < NUM_FRAME_COUNTERS; i++)
+    counters_a[i] += counters_b[i];
+
+  Statistics::ThisFrame result;
+  std::memcpy(&result, counters_a.data(), sizeof(result));
+  return result;
+}
+
+Statistics::ThisFrame Statistics::GetTotals() const
+{
+  return AddFrameCounters(previous_frames_total, this_frame);
+}
+
 void Statistics::ResetFrame()
 {
+  previous_frames_total = GetTotals();
   this_frame = {};
   clear_scissors = true;
   if (scissors.size() > 1)
@@ -91,6 +119,13 @@ void Statistics::Display() const
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
+  draw_statistic("Vertex cache hits", "%d", this_frame.num_vertex_cache_hits);
+  draw_statistic("Vertex cache misses", "%d", this_frame.num_vertex_cache_misses);
+  const int vertex_cache_lookups =
+      this_frame.num_vertex_cache_hits + this_frame.num_vertex_cache_misses;
+  draw_statistic("Vertex cache hit rate", "%.1f%%",
+                 100.0 * this_frame.num_vertex_cache_hits / std::max(vertex_cache_lookups, 1));
+  draw_statistic("Vertex cache skipped", "%i kB", this_frame.bytes_vertex_cache_skipped / 1024);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
 
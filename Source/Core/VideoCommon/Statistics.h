@@ -71,8 +71,20 @@ struct Statistics
 
     int num_efb_peeks;
     int num_efb_pokes;
+
+    int num_vertex_cache_hits;
+    int num_vertex_cache_misses;
+    int bytes_vertex_cache_skipped;
   };
   ThisFrame this_frame;
+
+  // this_frame summed over all previous frames. Counters wrap around on overflow, so only the
+  // difference between two totals is meaningful.
+  ThisFrame previous_frames_total;
+
+  // Returns the counters summed over all frames so far, including the current one.
+  ThisFrame GetTotals() const;
+
   void ResetFrame();
   void SwapDL();
   void AddScissorRect();
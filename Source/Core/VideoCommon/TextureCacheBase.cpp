@@ -60,6 +60,29 @@ static int xfb_count = 0;
 
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
+// Returns true if the entry was created with a placeholder while its custom texture was being
+// loaded in the background, and that load has finished since.
+static bool HasCustomTextureLoaded(TextureCacheBase::TCacheEntry* entry)
+{
+  if (entry->pending_custom_tex.empty())
+    return false;
+
+  // Only look up the texture when some load has finished since the last check.
+  const u32 generation = HiresTexture::GetLoadGeneration();
+  if (entry->pending_custom_tex_generation == generation)
+    return false;
+
+  if (HiresTexture::IsLoadPending(entry->pending_custom_tex))
+  {
+    entry->pending_custom_tex_generation = generation;
+    return false;
+  }
+
+  // The generation is left as it is, so that every lookup keeps skipping the placeholder until the
+  // entry has been replaced, not just the first one after the load finished.
+  return true;
+}
+
 TextureCacheBase::TCacheEntry::TCacheEntry(std::unique_ptr<AbstractTexture> tex,
                                            std::unique_ptr<AbstractFramebuffer> fb)
     : texture(std::move(tex)), framebuffer(std::move(fb))
@@ -1438,6 +1461,13 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
+        // Replace the placeholder once the custom texture is ready.
+        if (HasCustomTextureLoaded(entry))
+        {
+          iter = InvalidateTexture(iter);
+          continue;
+        }
+
         entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
         entry->texture->FinishedRendering();
@@ -1504,7 +1534,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
       // All parameters, except the address, need to match here
       if (entry->format == full_format && entry->native_levels >= texture_info.GetLevelCount() &&
           entry->native_width == texture_info.GetRawWidth() &&
-          entry->native_height == texture_info.GetRawHeight())
+          entry->native_height == texture_info.GetRawHeight() && !HasCustomTextureLoaded(entry))
       {
         entry = DoPartialTextureUpdates(hash_iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
@@ -1523,9 +1553,10 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
+  std::string pending_custom_tex;
   if (g_ActiveConfig.bHiresTextures)
   {
-    hires_tex = HiresTexture::Search(texture_info);
+    hires_tex = HiresTexture::Search(texture_info, &pending_custom_tex);
 
     if (hires_tex)
     {
@@ -1634,6 +1665,11 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
                        texture_info.GetLevelCount());
   entry->SetHashes(base_hash, full_hash);
   entry->is_custom_tex = hires_tex != nullptr;
+  if (!pending_custom_tex.empty())
+  {
+    entry->pending_custom_tex = std::move(pending_custom_tex);
+    entry->pending_custom_tex_generation = HiresTexture::GetLoadGeneration();
+  }
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
@@ -157,6 +157,11 @@ public:
 
     std::string texture_info_name = "";
 
+    // Name of the custom texture which was still being loaded when this entry was created, and the
+    // load generation it was last checked against.
+    std::string pending_custom_tex;
+    u32 pending_custom_tex_generation = 0;
+
     explicit TCacheEntry(std::unique_ptr<AbstractTexture> tex,
                          std::unique_ptr<AbstractFramebuffer> fb);
 
@@ -0,0 +1,113 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/VertexDecodeQueue.h"
+
+#include "Common/Thread.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/VertexLoaderBase.h"
+
+VertexDecodeQueue::~VertexDecodeQueue()
+{
+  Stop();
+}
+
+bool VertexDecodeQueue::MaySkipVertices(const TVtxDesc& vtx_desc, const u8* src, u32 vertex_size,
+                                        int count)
+{
+  if (!IsIndexed(vtx_desc.low.Position))
+    return false;
+
+  u32 offset = vtx_desc.low.PosMatIdx ? 1 : 0;
+  for (u32 i = 0; i < vtx_desc.low.TexMatIdx.Size(); i++)
+  {
+    if (vtx_desc.low.TexMatIdx[i])
+      offset++;
+  }
+
+  const u8* data = src + offset;
+  if (vtx_desc.low.Position == VertexComponentFormat::Index8)
+  {
+    for (int i = 0; i < count; i++, data += vertex_size)
+    {
+      if (*data == 0xFF)
+        return true;
+    }
+  }
+  else
+  {
+    for (int i = 0; i < count; i++, data += vertex_size)
+    {
+      if (data[0] == 0xFF && data[1] == 0xFF)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+void VertexDecodeQueue::Push(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+{
+  if (!IsRunning())
+    Start();
+
+  u32 write_index = m_write_index.load(std::memory_order_relaxed);
+  if (write_index - m_read_index.load(std::memory_order_acquire) == QUEUE_SIZE)
+    Wait();
+
+  m_jobs[write_index % QUEUE_SIZE] = {loader, src, dst, count};
+  m_write_index.store(++write_index, std::memory_order_release);
+  m_loop.Wakeup();
+}
+
+void VertexDecodeQueue::Wait()
+{
+  if (IsEmpty())
+    return;
+
+  m_loop.Wait();
+}
+
+void VertexDecodeQueue::Finish()
+{
+  Wait();
+  m_loop.AllowSleep();
+}
+
+void VertexDecodeQueue::Stop()
+{
+  if (!IsRunning())
+    return;
+
+  Finish();
+  m_loop.Stop();
+  m_thread.join();
+}
+
+void VertexDecodeQueue::Start()
+{
+  m_read_index.store(0);
+  m_write_index.store(0);
+  m_loop.Prepare();
+  m_thread = std::thread([this] {
+    Common::SetCurrentThreadName("Vertex decoder");
+    m_loop.Run([this] { RunJobs(); });
+  });
+}
+
+void VertexDecodeQueue::RunJobs()
+{
+  u32 read_index = m_read_index.load(std::memory_order_relaxed);
+  while (read_index != m_write_index.load(std::memory_order_acquire))
+  {
+    Job& job = m_jobs[read_index % QUEUE_SIZE];
+    job.loader->RunVertices(job.src, job.dst, job.count);
+    m_read_index.store(++read_index, std::memory_order_release);
+  }
+}
+
+bool VertexDecodeQueue::IsEmpty() const
+{
+  return m_read_index.load(std::memory_order_acquire) ==
+         m_write_index.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,71 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+#include "Common/BlockingLoop.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/DataReader.h"
+
+class VertexLoaderBase;
+struct TVtxDesc;
+
+// Runs vertex loaders on a separate thread, in the order they were queued.
+//
+// This lets vertex conversion overlap with the rest of the command processing on the GPU thread
+// (index generation, register loads and texture loading in VertexManagerBase::Flush). The vertex
+// loaders write to the vertex buffer and the zfreeze and binormal caches, and read the array bases
+// and strides while running, so all of these are only safe to touch after Wait().
+class VertexDecodeQueue
+{
+public:
+  static constexpr u32 QUEUE_SIZE = 256;
+
+  VertexDecodeQueue() = default;
+  ~VertexDecodeQueue();
+
+  VertexDecodeQueue(const VertexDecodeQueue&) = delete;
+  VertexDecodeQueue& operator=(const VertexDecodeQueue&) = delete;
+
+  // The vertex loaders skip vertices with a position index of 0xFF or 0xFFFF, in which case fewer
+  // vertices are written than were requested. Those draws can't be queued, as the number of
+  // vertices has to be known when the indices are generated.
+  static bool MaySkipVertices(const TVtxDesc& vtx_desc, const u8* src, u32 vertex_size,
+                              int count);
+
+  // Queues loader->RunVertices(src, dst, count). The thread is started on first use. Blocks if the
+  // queue is full.
+  void Push(VertexLoaderBase* loader, DataReader src, DataReader dst, int count);
+
+  // Blocks until all queued conversions have finished.
+  void Wait();
+  // Same as Wait(), but also lets the thread go to sleep.
+  void Finish();
+  // Finishes all queued conversions and stops the thread.
+  void Stop();
+
+  bool IsRunning() const { return m_thread.joinable(); }
+
+private:
+  struct Job
+  {
+    VertexLoaderBase* loader;
+    DataReader src;
+    DataReader dst;
+    int count;
+  };
+
+  void Start();
+  void RunJobs();
+  bool IsEmpty() const;
+
+  std::array<Job, QUEUE_SIZE> m_jobs{};
+  std::atomic<u32> m_read_index{0};
+  std::atomic<u32> m_write_index{0};
+  Common::BlockingLoop m_loop;
+  std::thread m_thread;
+};
@@ -0,0 +1,249 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/VertexLoaderCache.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <xxhash.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexLoader_Color.h"
+#include "VideoCommon/VertexLoader_Normal.h"
+#include "VideoCommon/VertexLoader_Position.h"
+#include "VideoCommon/VertexLoader_TextCoord.h"
+
+namespace VertexLoaderCache
+{
+namespace
+{
+struct CacheEntry
+{
+  const VertexLoaderBase* loader;
+  u32 src_size;
+  int count;
+  std::vector<u8> vertices;
+
+  // Values the vertex loader left in the caches used by zfreeze and emboss texgens.
+  std::array<std::array<float, 4>, 3> position_cache;
+  std::array<u32, 3> position_matrix_index_cache;
+  std::array<float, 4> tangent_cache;
+  std::array<float, 4> binormal_cache;
+
+  u64 last_used;
+};
+
+// Upper bound on how far past (index * stride) a vertex loader reads for a single index. The
+// largest case is the binormal of an NTB normal with three indices, which is read from 24 bytes
+// past the start of the element.
+constexpr u32 MAX_ELEMENT_READ_SIZE = 36;
+
+// Hashing the referenced part of an array is only cheaper than converting the vertices if the
+// indices are reasonably close together. Draws that reference a much larger part of an array than
+// they read (e.g. a few vertices from either end of a large model) aren't cached.
+constexpr u32 MAX_HASHED_BYTES_PER_INDEX = 64;
+
+constexpr size_t MAX_CACHE_SIZE = 64 * 1024 * 1024;
+
+std::unordered_map<u64, CacheEntry> s_cache;
+size_t s_cache_size = 0;
+u64 s_use_counter = 0;
+u64 s_last_trim = 0;
+
+// Hashes the part of an array that is referenced by the indices stored at the given offset of
+// each vertex. Returns nullopt if the referenced range isn't in RAM or is too large to be worth
+// hashing.
+std::optional<u64> HashArrayData(CPArray array, const u8* src, u32 vertex_size, int count,
+                                 u32 offset, u32 index_size, u32 index_count, u64 seed)
+{
+  u32 min_index = UINT32_MAX;
+  u32 max_index = 0;
+  for (int i = 0; i < count; i++)
+  {
+    const u8* data = src + i * vertex_size + offset;
+    for (u32 j = 0; j < index_count; j++, data += index_size)
+    {
+      const u32 index = index_size == 1 ? *data : Common::swap16(data);
+      min_index = std::min(min_index, index);
+      max_index = std::max(max_index, index);
+    }
+  }
+
+  const u32 base = g_main_cp_state.array_bases[array];
+  const u32 stride = g_main_cp_state.array_strides[array];
+  const u64 start = u64{min_index} * stride;
+  const u64 size = u64{max_index - min_index} * stride + MAX_ELEMENT_READ_SIZE;
+  if (size > u64{MAX_HASHED_BYTES_PER_INDEX} * count * index_count)
+    return std::nullopt;
+  if (start + size > VertexLoaderManager::cached_arraysizes[array])
+    return std::nullopt;
+
+  seed ^= (u64{base} << 32) | stride;
+  return XXH64(VertexLoaderManager::cached_arraybases[array] + start, size, seed);
+}
+
+std::optional<u64> ComputeKey(const VertexLoaderBase* loader, const u8* src, int count)
+{
+  const u32 vertex_size = loader->m_vertex_size;
+  u64 hash = XXH64(src, count * vertex_size, reinterpret_cast<uintptr_t>(loader));
+
+  const TVtxDesc& vtx_desc = g_main_cp_state.vtx_desc;
+  const VAT& vtx_attr = g_main_cp_state.vtx_attr[VertexLoaderManager::g_current_vat];
+
+  u32 offset = vtx_desc.low.PosMatIdx ? 1 : 0;
+  for (auto texmtxidx : vtx_desc.low.TexMatIdx)
+  {
+    if (texmtxidx)
+      offset++;
+  }
+
+  const auto add_component = [&](VertexComponentFormat format, CPArray array, u32 size) {
+    if (IsIndexed(format) && hash != 0)
+    {
+      const u32 index_size = format == VertexComponentFormat::Index8 ? 1 : 2;
+      const auto array_hash = HashArrayData(array, src, vertex_size, count, offset, index_size,
+                                            size / index_size, hash);
+      // A hash of 0 marks the draw as uncacheable.
+      hash = array_hash.value_or(0);
+    }
+    offset += size;
+  };
+
+  add_component(vtx_desc.low.Position, CPArray::Position,
+                VertexLoader_Position::GetSize(vtx_desc.low.Position, vtx_attr.g0.PosFormat,
+                                               vtx_attr.g0.PosElements));
+  add_component(vtx_desc.low.Normal, CPArray::Normal,
+                VertexLoader_Normal::GetSize(vtx_desc.low.Normal, vtx_attr.g0.NormalFormat,
+                                             vtx_attr.g0.NormalElements,
+                                             vtx_attr.g0.NormalIndex3));
+  for (u32 i = 0; i < vtx_desc.low.Color.Size(); i++)
+  {
+    add_component(vtx_desc.low.Color[i], CPArray::Color0 + i,
+                  VertexLoader_Color::GetSize(vtx_desc.low.Color[i], vtx_attr.GetColorFormat(i)));
+  }
+  for (u32 i = 0; i < vtx_desc.high.TexCoord.Size(); i++)
+  {
+    add_component(vtx_desc.high.TexCoord[i], CPArray::TexCoord0 + i,
+                  VertexLoader_TextCoord::GetSize(vtx_desc.high.TexCoord[i],
+                                                  vtx_attr.GetTexFormat(i),
+                                                  vtx_attr.GetTexElements(i)));
+  }
+
+  if (hash == 0)
+    return std::nullopt;
+  return hash;
+}
+
+void Trim()
+{
+  // Drop everything that hasn't been used since the last trim. If that doesn't free up enough
+  // space, the working set is too large for the cache to be useful, so start over.
+  for (auto iter = s_cache.begin(); iter != s_cache.end();)
+  {
+    if (iter->second.last_used <= s_last_trim)
+    {
+      s_cache_size -= iter->second.vertices.size();
+      iter = s_cache.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+  s_last_trim = s_use_counter;
+
+  if (s_cache_size > MAX_CACHE_SIZE / 2)
+    Clear();
+}
+
+void RestoreLoaderCaches(const VertexLoaderBase* loader, const CacheEntry& entry)
+{
+  // The vertex loaders only store the last three vertices in the zfreeze caches.
+  const size_t rows = std::min<size_t>(entry.count, 3);
+  if (loader->m_native_vtx_decl.position.enable)
+  {
+    std::copy_n(entry.position_cache.begin(), rows,
+                VertexLoaderManager::position_cache.begin());
+  }
+  if (loader->m_native_vtx_decl.posmtx.enable)
+  {
+    std::copy_n(entry.position_matrix_index_cache.begin(), rows,
+                VertexLoaderManager::position_matrix_index_cache.begin());
+  }
+  if (loader->m_native_vtx_decl.normals[1].enable)
+    VertexLoaderManager::tangent_cache = entry.tangent_cache;
+  if (loader->m_native_vtx_decl.normals[2].enable)
+    VertexLoaderManager::binormal_cache = entry.binormal_cache;
+}
+}  // namespace
+
+int RunVertices(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+{
+  const u32 src_size = count * loader->m_vertex_size;
+  const std::optional<u64> key = ComputeKey(loader, src.GetPointer(), count);
+  if (!key)
+    return loader->RunVertices(src, dst, count);
+
+  auto iter = s_cache.find(*key);
+  if (iter != s_cache.end() && iter->second.loader == loader && iter->second.src_size == src_size)
+  {
+    CacheEntry& entry = iter->second;
+    entry.last_used = ++s_use_counter;
+    std::memcpy(dst.GetPointer(), entry.vertices.data(), entry.vertices.size());
+    RestoreLoaderCaches(loader, entry);
+
+    INCSTAT(g_stats.this_frame.num_vertex_cache_hits);
+    ADDSTAT(g_stats.this_frame.bytes_vertex_cache_skipped, src_size);
+    return entry.count;
+  }
+
+  INCSTAT(g_stats.this_frame.num_vertex_cache_misses);
+  const int loaded = loader->RunVertices(src, dst, count);
+
+  // Draws with skipped vertices are rare, and the loader caches don't line up with the vertex
+  // count for them, so don't bother.
+  if (loaded != count)
+    return loaded;
+
+  if (iter != s_cache.end())
+  {
+    s_cache_size -= iter->second.vertices.size();
+    s_cache.erase(iter);
+  }
+
+  const u32 output_size = loaded * loader->m_native_vtx_decl.stride;
+  CacheEntry entry{loader,
+                   src_size,
+                   loaded,
+                   std::vector<u8>(dst.GetPointer(), dst.GetPointer() + output_size),
+                   VertexLoaderManager::position_cache,
+                   VertexLoaderManager::position_matrix_index_cache,
+                   VertexLoaderManager::tangent_cache,
+                   VertexLoaderManager::binormal_cache,
+                   ++s_use_counter};
+  s_cache.emplace(*key, std::move(entry));
+  s_cache_size += output_size;
+
+  if (s_cache_size > MAX_CACHE_SIZE)
+    Trim();
+
+  return loaded;
+}
+
+void Clear()
+{
+  s_cache.clear();
+  s_cache_size = 0;
+}
+}  // namespace VertexLoaderCache
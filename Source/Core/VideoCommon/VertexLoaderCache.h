@@ -0,0 +1,23 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+class DataReader;
+class VertexLoaderBase;
+
+// Caches the converted vertices of draws from display lists.
+//
+// Games tend to call the same display lists every frame, which means the same vertex data is
+// converted by the vertex loaders over and over again. Entries are keyed by a hash of the source
+// vertex data, the vertex loader (and thus the VCD/VAT state), and the array data that is
+// referenced through indexed attributes, so changes to guest memory are picked up without any
+// write tracking, the same way the texture cache detects modified textures.
+namespace VertexLoaderCache
+{
+// Same as loader->RunVertices(), but replays the output of a previous identical call if there is
+// one. The caller must have flushed any deferred vertex conversion beforehand.
+int RunVertices(VertexLoaderBase* loader, DataReader src, DataReader dst, int count);
+
+void Clear();
+}  // namespace VertexLoaderCache
@@ -26,9 +26,12 @@
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/Statistics.h"
+#include "VideoCommon/VertexDecodeQueue.h"
 #include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderCache.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace VertexLoaderManager
@@ -50,6 +53,7 @@ static VertexLoaderMap s_vertex_loader_map;
 // TODO - change into array of pointers. Keep a map of all seen so far.
 
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
+Common::EnumMap<u32, CPArray::TexCoord7> cached_arraysizes;
 
 BitSet8 g_main_vat_dirty;
 BitSet8 g_preprocess_vat_dirty;
@@ -58,6 +62,31 @@ u8 g_current_vat;    // Main only
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_main_vertex_loaders;
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_preprocess_vertex_loaders;
 
+static VertexDecodeQueue s_decode_queue;
+
+void WaitForVertexDecoding()
+{
+  s_decode_queue.Wait();
+}
+
+void FinishVertexDecoding()
+{
+  s_decode_queue.Finish();
+}
+
+static bool QueueDecodeJob(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+{
+  if (!g_ActiveConfig.bAsyncVertexLoading ||
+      VertexDecodeQueue::MaySkipVertices(g_main_cp_state.vtx_desc, src.GetPointer(),
+                                         loader->m_vertex_size, count))
+  {
+    return false;
+  }
+
+  s_decode_queue.Push(loader, src, dst, count);
+  return true;
+}
+
 void Init()
 {
   MarkAllDirty();
@@ -70,17 +99,43 @@ void Init()
 
 void Clear()
 {
+  s_decode_queue.Stop();
+  VertexLoaderCache::Clear();
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
 }
 
+static void UpdateArrayPointer(CPArray array)
+{
+  const u32 address = g_main_cp_state.array_bases[array] & 0x3FFFFFFF;
+  cached_arraybases[array] = Memory::GetPointer(address);
+
+  if (address < Memory::GetRamSizeReal())
+  {
+    cached_arraysizes[array] = Memory::GetRamSizeReal() - address;
+  }
+  else if (Memory::m_pEXRAM && (address >> 28) == 0x1 &&
+           (address & 0x0FFFFFFF) < Memory::GetExRamSizeReal())
+  {
+    cached_arraysizes[array] = Memory::GetExRamSizeReal() - (address & 0x0FFFFFFF);
+  }
+  else
+  {
+    cached_arraysizes[array] = 0;
+  }
+}
+
 void UpdateVertexArrayPointers()
 {
   // Anything to update?
   if (!g_bases_dirty)
     return;
 
+  // Deferred vertex conversion may still be reading from the old arrays.
+  WaitForVertexDecoding();
+
   // Some games such as Burnout 2 can put invalid addresses into
   // the array base registers. (see issue 8591)
   // But the vertex arrays with invalid addresses aren't actually enabled.
@@ -88,25 +143,21 @@ void UpdateVertexArrayPointers()
   //       12 through 15 are used for loading data into xfmem.
   // We also only update the array base if the vertex description states we are going to use it.
   if (IsIndexed(g_main_cp_state.vtx_desc.low.Position))
-    cached_arraybases[CPArray::Position] =
-        Memory::GetPointer(g_main_cp_state.array_bases[CPArray::Position]);
+    UpdateArrayPointer(CPArray::Position);
 
   if (IsIndexed(g_main_cp_state.vtx_desc.low.Normal))
-    cached_arraybases[CPArray::Normal] =
-        Memory::GetPointer(g_main_cp_state.array_bases[CPArray::Normal]);
+    UpdateArrayPointer(CPArray::Normal);
 
   for (u8 i = 0; i < g_main_cp_state.vtx_desc.low.Color.Size(); i++)
   {
     if (IsIndexed(g_main_cp_state.vtx_desc.low.Color[i]))
-      cached_arraybases[CPArray::Color0 + i] =
-          Memory::GetPointer(g_main_cp_state.array_bases[CPArray::Color0 + i]);
+      UpdateArrayPointer(CPArray::Color0 + i);
   }
 
   for (u8 i = 0; i < g_main_cp_state.vtx_desc.high.TexCoord.Size(); i++)
   {
     if (IsIndexed(g_main_cp_state.vtx_desc.high.TexCoord[i]))
-      cached_arraybases[CPArray::TexCoord0 + i] =
-          Memory::GetPointer(g_main_cp_state.array_bases[CPArray::TexCoord0 + i]);
+      UpdateArrayPointer(CPArray::TexCoord0 + i);
   }
 
   g_bases_dirty = false;
@@ -336,7 +387,7 @@ static void CheckCPConfiguration(int vtx_attr_group)
 }
 
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, DataReader src,
-                bool is_preprocess)
+                bool is_preprocess, bool is_display_list)
 {
   if (count == 0)
     return 0;
@@ -372,7 +423,17 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  if (is_display_list && g_ActiveConfig.bVertexLoaderCache)
+  {
+    WaitForVertexDecoding();
+    count = VertexLoaderCache::RunVertices(loader, src, dst, count);
+  }
+  else if (!QueueDecodeJob(loader, src, dst, count))
+  {
+    // Vertex loaders share the zfreeze and binormal caches, so keep the conversions in order.
+    WaitForVertexDecoding();
+    count = loader->RunVertices(src, dst, count);
+  }
 
   g_vertex_manager->AddIndices(primitive, count);
   g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
@@ -43,12 +43,22 @@ NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl);
 
 // Returns -1 if buf_size is insufficient, else the amount of bytes consumed
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, DataReader src,
-                bool is_preprocess);
+                bool is_preprocess, bool is_display_list = false);
 
 NativeVertexFormat* GetCurrentVertexFormat();
 
+// Blocks until all vertices passed to RunVertices() have been converted. Must be called before the
+// vertex buffer, position_cache, tangent_cache or binormal_cache are used, and before the array
+// bases or strides change.
+void WaitForVertexDecoding();
+// Same as WaitForVertexDecoding(), but also lets the decode thread go to sleep. Called once the
+// source data of the queued vertices is about to go away (end of a FIFO run).
+void FinishVertexDecoding();
+
 // Resolved pointers to array bases. Used by vertex loaders.
 extern Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
+// Number of bytes that can be read from each of cached_arraybases. 0 if the base is invalid.
+extern Common::EnumMap<u32, CPArray::TexCoord7> cached_arraysizes;
 void UpdateVertexArrayPointers();
 
 // Position cache for zfreeze (3 vertices, 4 floats each to allow SIMD overwrite).
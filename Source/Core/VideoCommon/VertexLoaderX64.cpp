@@ -31,6 +31,10 @@ static const X64Reg scratch3 = ABI_PARAM4;
 static const X64Reg remaining_reg = R10;
 static const X64Reg skipped_reg = R11;
 static const X64Reg base_reg = RBX;
+// Hold the address of the second vertex's indexed attribute in the loop that converts two vertices
+// at once.
+static const X64Reg pair_index_reg = R12;
+static const X64Reg pair_base_reg = R13;
 
 static const u8* memory_base_ptr = (u8*)&g_main_cp_state.array_strides;
 
@@ -44,6 +48,60 @@ static OpArg MPIC(const void* ptr)
   return MDisp(base_reg, PtrOffset(ptr, memory_base_ptr));
 }
 
+static const __m128i shuffle_lut[5][3] = {
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
+     _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
+     _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
+     _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
+};
+static const __m128 scale_factors[32] = {
+    _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
+    _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
+    _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
+    _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
+    _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
+    _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
+    _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
+    _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
+    _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
+    _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
+    _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
+};
+
+// The same tables with each value repeated for both 128-bit lanes of a YMM register.
+static const auto shuffle_lut_pair = [] {
+  struct
+  {
+    __m128i values[5][3][2];
+  } lut;
+  for (size_t i = 0; i < 5; i++)
+  {
+    for (size_t j = 0; j < 3; j++)
+      lut.values[i][j][0] = lut.values[i][j][1] = shuffle_lut[i][j];
+  }
+  return lut;
+}();
+static const auto scale_factors_pair = [] {
+  struct
+  {
+    __m128 values[32][2];
+  } factors;
+  for (size_t i = 0; i < 32; i++)
+    factors.values[i][0] = factors.values[i][1] = scale_factors[i];
+  return factors;
+}();
+
 VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
     : VertexLoaderBase(vtx_desc, vtx_att)
 {
@@ -56,22 +114,28 @@ VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
                         vtx_att);
 }
 
-OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attribute)
+OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attribute, int vertex)
 {
-  OpArg data = MDisp(src_reg, m_src_ofs);
+  OpArg data = MDisp(src_reg, m_src_ofs + vertex * m_vertex_size);
   if (IsIndexed(attribute))
   {
+    // The second vertex of a pair is addressed first, so it doesn't advance m_src_ofs, and it uses
+    // its own registers so that the address survives addressing the first vertex.
+    const X64Reg index_reg = vertex ? pair_index_reg : scratch1;
+    const X64Reg array_reg = vertex ? pair_base_reg : scratch2;
     int bits = attribute == VertexComponentFormat::Index8 ? 8 : 16;
-    LoadAndSwap(bits, scratch1, data);
-    m_src_ofs += bits / 8;
-    if (array == CPArray::Position)
+    LoadAndSwap(bits, index_reg, data);
+    if (vertex == 0)
+      m_src_ofs += bits / 8;
+    // Pairs with a skipped vertex are handled by the single vertex loop.
+    if (array == CPArray::Position && !m_paired)
     {
-      CMP(bits, R(scratch1), Imm8(-1));
+      CMP(bits, R(index_reg), Imm8(-1));
       m_skip_vertex = J_CC(CC_E, true);
     }
-    IMUL(32, scratch1, MPIC(&g_main_cp_state.array_strides[array]));
-    MOV(64, R(scratch2), MPIC(&VertexLoaderManager::cached_arraybases[array]));
-    return MRegSum(scratch1, scratch2);
+    IMUL(32, index_reg, MPIC(&g_main_cp_state.array_strides[array]));
+    MOV(64, R(array_reg), MPIC(&VertexLoaderManager::cached_arraybases[array]));
+    return MRegSum(index_reg, array_reg);
   }
   else
   {
@@ -83,37 +147,6 @@ int VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute, Com
                                 int count_in, int count_out, bool dequantize, u8 scaling_exponent,
                                 AttributeFormat* native_format)
 {
-  static const __m128i shuffle_lut[5][3] = {
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
-       _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
-       _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
-       _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
-  };
-  static const __m128 scale_factors[32] = {
-      _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
-      _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
-      _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
-      _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
-      _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
-      _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
-      _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
-      _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
-      _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
-      _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
-      _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
-  };
-
   X64Reg coords = XMM0;
 
   const auto write_zfreeze = [&]() {  // zfreeze
@@ -280,8 +313,115 @@ int VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute, Com
   return load_bytes;
 }
 
-void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, ColorFormat format)
+int VertexLoaderX64::ReadVertexPair(OpArg data0, OpArg data1, VertexComponentFormat attribute,
+                                    ComponentFormat format, int count_in, int count_out,
+                                    bool dequantize, u8 scaling_exponent,
+                                    AttributeFormat* native_format)
+{
+  const u32 stride = m_native_vtx_decl.stride;
+  int elem_size = GetElementSize(format);
+  int load_bytes = elem_size * count_in;
+  OpArg dest0 = MDisp(dst_reg, m_dst_ofs);
+  OpArg dest1 = MDisp(dst_reg, m_dst_ofs + stride);
+
+  // native_format was already filled in by the single vertex loop.
+  m_dst_ofs += sizeof(float) * count_out;
+
+  if (attribute == VertexComponentFormat::Direct)
+    m_src_ofs += load_bytes;
+
+  for (const auto& [reg, data] : {std::pair(XMM0, data0), std::pair(XMM1, data1)})
+  {
+    if (load_bytes > 8)
+      MOVDQU(reg, data);
+    else if (load_bytes > 4)
+      MOVQ_xmm(reg, data);
+    else
+      MOVD_xmm(reg, data);
+
+    // Floats only need their bytes swapped, which is cheaper than moving them between lanes.
+    if (format == ComponentFormat::Float)
+      PSHUFB(reg, MPIC(&shuffle_lut[u32(format)][count_in - 1]));
+  }
+
+  if (format != ComponentFormat::Float)
+  {
+    // Convert both vertices at once, with one in each 128-bit lane.
+    VINSERTI128(YMM0, YMM0, R(XMM1), 1);
+
+    VPSHUFB(256, YMM0, YMM0, MPIC(&shuffle_lut_pair.values[u32(format)][count_in - 1]));
+
+    // Sign-extend.
+    if (format == ComponentFormat::Byte)
+      VPSRAD(256, YMM0, YMM0, 24);
+    if (format == ComponentFormat::Short)
+      VPSRAD(256, YMM0, YMM0, 16);
+
+    VCVTDQ2PS(256, YMM0, R(YMM0));
+
+    if (dequantize && scaling_exponent)
+      VMULPS(256, YMM0, YMM0, MPIC(&scale_factors_pair.values[scaling_exponent]));
+
+    VEXTRACTI128(R(XMM1), YMM0, 1);
+    // Avoid the penalty for mixing SSE and AVX code in everything that follows.
+    VZEROUPPER();
+  }
+
+  switch (count_out)
+  {
+  case 1:
+    MOVSS(dest0, XMM0);
+    MOVSS(dest1, XMM1);
+    break;
+  case 2:
+    MOVLPS(dest0, XMM0);
+    MOVLPS(dest1, XMM1);
+    break;
+  case 3:
+    // Unlike the single vertex loop, a 16-byte store for the first vertex could overwrite the
+    // start of the second vertex, which has already been written.
+    MOVLPS(dest0, XMM0);
+    dest0.AddMemOffset(2 * sizeof(float));
+    VEXTRACTPS(dest0, XMM0, 2);
+    MOVUPS(dest1, XMM1);
+    break;
+  }
+
+  // zfreeze. The first vertex of the pair is at index remaining_reg and the second one is at
+  // index remaining_reg - 1, which is never negative as there are at least two vertices left.
+  if (native_format == &m_native_vtx_decl.position)
+  {
+    CMP(32, R(remaining_reg), Imm8(4));
+    FixupBranch dont_store = J_CC(CC_AE);
+    LEA(32, scratch3, MScaled(remaining_reg, SCALE_4, 0));
+    OpArg row = MPIC(VertexLoaderManager::position_cache.data(), scratch3, SCALE_4);
+    row.AddMemOffset(-4 * static_cast<int>(sizeof(float)));
+    MOVUPS(row, XMM1);
+    CMP(32, R(remaining_reg), Imm8(3));
+    FixupBranch dont_store_first = J_CC(CC_AE);
+    MOVUPS(MPIC(VertexLoaderManager::position_cache.data(), scratch3, SCALE_4), XMM0);
+    SetJumpTarget(dont_store);
+    SetJumpTarget(dont_store_first);
+  }
+  else if (native_format == &m_native_vtx_decl.normals[1])
+  {
+    CMP(32, R(remaining_reg), Imm8(1));
+    FixupBranch dont_store = J_CC(CC_NE);
+    MOVUPS(MPIC(VertexLoaderManager::tangent_cache.data()), XMM1);
+    SetJumpTarget(dont_store);
+  }
+  else if (native_format == &m_native_vtx_decl.normals[2])
+  {
+    MOVUPS(MPIC(VertexLoaderManager::binormal_cache.data()), XMM1);
+  }
+
+  return load_bytes;
+}
+
+void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, ColorFormat format,
+                                int vertex)
 {
+  const OpArg dest = MDisp(dst_reg, m_dst_ofs + vertex * m_native_vtx_decl.stride);
   int load_bytes = 0;
   switch (format)
   {
@@ -291,7 +431,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     MOV(32, R(scratch1), data);
     if (format != ColorFormat::RGBA8888)
       OR(32, R(scratch1), Imm32(0xFF000000));
-    MOV(32, MDisp(dst_reg, m_dst_ofs), R(scratch1));
+    MOV(32, dest, R(scratch1));
     load_bytes = format == ColorFormat::RGB888 ? 3 : 4;
     break;
 
@@ -331,7 +471,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
       OR(32, R(scratch1), R(scratch2));
     }
     OR(32, R(scratch1), Imm32(0x000000FF));
-    SwapAndStore(32, MDisp(dst_reg, m_dst_ofs), scratch1);
+    SwapAndStore(32, dest, scratch1);
     load_bytes = 2;
     break;
 
@@ -359,7 +499,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     MOV(32, R(scratch2), R(scratch1));
     SHL(32, R(scratch1), Imm8(4));
     OR(32, R(scratch1), R(scratch2));
-    SwapAndStore(32, MDisp(dst_reg, m_dst_ofs), scratch1);
+    SwapAndStore(32, dest, scratch1);
     load_bytes = 2;
     break;
 
@@ -391,50 +531,37 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     SHR(32, R(scratch1), Imm8(6));
     AND(32, R(scratch1), Imm32(0x03030303));
     OR(32, R(scratch1), R(scratch2));
-    SwapAndStore(32, MDisp(dst_reg, m_dst_ofs), scratch1);
+    SwapAndStore(32, dest, scratch1);
     load_bytes = 3;
     break;
   }
-  if (attribute == VertexComponentFormat::Direct)
+  if (attribute == VertexComponentFormat::Direct && vertex == 0)
     m_src_ofs += load_bytes;
 }
 
-void VertexLoaderX64::GenerateVertexLoader()
+void VertexLoaderX64::GenerateVertexConversion()
 {
-  BitSet32 regs = {src_reg,  dst_reg,       scratch1,    scratch2,
-                   scratch3, remaining_reg, skipped_reg, base_reg};
-  regs &= ABI_ALL_CALLEE_SAVED;
-  ABI_PushRegistersAndAdjustStack(regs, 0);
-
-  // Backup count since we're going to count it down.
-  PUSH(32, R(ABI_PARAM3));
-
-  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
-  // We also have it end at a value of 0, to simplify indexing for zfreeze;
-  // this requires subtracting 1 at the start.
-  LEA(32, remaining_reg, MDisp(ABI_PARAM3, -1));
-
-  MOV(64, R(base_reg), R(ABI_PARAM4));
-
-  if (IsIndexed(m_VtxDesc.low.Position))
-    XOR(32, R(skipped_reg), R(skipped_reg));
-
-  // TODO: load constants into registers outside the main loop
-
-  const u8* loop_start = GetCodePtr();
+  // When m_paired is set, this converts the vertex at src_reg and the one after it, with the
+  // non-trivial conversions done for both vertices at once.
+  const int vertex_count = m_paired ? 2 : 1;
 
   if (m_VtxDesc.low.PosMatIdx)
   {
-    MOVZX(32, 8, scratch1, MDisp(src_reg, m_src_ofs));
-    AND(32, R(scratch1), Imm8(0x3F));
-    MOV(32, MDisp(dst_reg, m_dst_ofs), R(scratch1));
+    for (int vertex = 0; vertex < vertex_count; vertex++)
+    {
+      MOVZX(32, 8, scratch1, MDisp(src_reg, m_src_ofs + vertex * m_vertex_size));
+      AND(32, R(scratch1), Imm8(0x3F));
+      MOV(32, MDisp(dst_reg, m_dst_ofs + vertex * m_native_vtx_decl.stride), R(scratch1));
 
-    // zfreeze
-    CMP(32, R(remaining_reg), Imm8(3));
-    FixupBranch dont_store = J_CC(CC_AE);
-    MOV(32, MPIC(VertexLoaderManager::position_matrix_index_cache.data(), remaining_reg, SCALE_4),
-        R(scratch1));
-    SetJumpTarget(dont_store);
+      // zfreeze
+      CMP(32, R(remaining_reg), Imm8(3 + vertex));
+      FixupBranch dont_store = J_CC(CC_AE);
+      OpArg row =
+          MPIC(VertexLoaderManager::position_matrix_index_cache.data(), remaining_reg, SCALE_4);
+      row.AddMemOffset(-vertex * static_cast<int>(sizeof(u32)));
+      MOV(32, row, R(scratch1));
+      SetJumpTarget(dont_store);
+    }
 
     m_native_vtx_decl.posmtx.components = 4;
     m_native_vtx_decl.posmtx.enable = true;
@@ -452,10 +579,24 @@ void VertexLoaderX64::GenerateVertexLoader()
       texmatidx_ofs[i] = m_src_ofs++;
   }
 
+  // The address of the second vertex's attribute, when converting a pair.
+  OpArg data1;
+
+  if (m_paired)
+    data1 = GetVertexAddr(CPArray::Position, m_VtxDesc.low.Position, 1);
   OpArg data = GetVertexAddr(CPArray::Position, m_VtxDesc.low.Position);
   int pos_elements = m_VtxAttr.g0.PosElements == CoordComponentCount::XY ? 2 : 3;
-  ReadVertex(data, m_VtxDesc.low.Position, m_VtxAttr.g0.PosFormat, pos_elements, pos_elements,
-             m_VtxAttr.g0.ByteDequant, m_VtxAttr.g0.PosFrac, &m_native_vtx_decl.position);
+  if (m_paired)
+  {
+    ReadVertexPair(data, data1, m_VtxDesc.low.Position, m_VtxAttr.g0.PosFormat, pos_elements,
+                   pos_elements, m_VtxAttr.g0.ByteDequant, m_VtxAttr.g0.PosFrac,
+                   &m_native_vtx_decl.position);
+  }
+  else
+  {
+    ReadVertex(data, m_VtxDesc.low.Position, m_VtxAttr.g0.PosFormat, pos_elements, pos_elements,
+               m_VtxAttr.g0.ByteDequant, m_VtxAttr.g0.PosFrac, &m_native_vtx_decl.position);
+  }
 
   if (m_VtxDesc.low.Normal != VertexComponentFormat::NotPresent)
   {
@@ -467,12 +608,28 @@ void VertexLoaderX64::GenerateVertexLoader()
     {
       if (!i || m_VtxAttr.g0.NormalIndex3)
       {
-        data = GetVertexAddr(CPArray::Normal, m_VtxDesc.low.Normal);
         int elem_size = GetElementSize(m_VtxAttr.g0.NormalFormat);
+        if (m_paired)
+        {
+          data1 = GetVertexAddr(CPArray::Normal, m_VtxDesc.low.Normal, 1);
+          data1.AddMemOffset(i * elem_size * 3);
+        }
+        data = GetVertexAddr(CPArray::Normal, m_VtxDesc.low.Normal);
         data.AddMemOffset(i * elem_size * 3);
       }
-      data.AddMemOffset(ReadVertex(data, m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat, 3, 3,
-                                   true, scaling_exponent, &m_native_vtx_decl.normals[i]));
+      if (m_paired)
+      {
+        const int load_bytes =
+            ReadVertexPair(data, data1, m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat, 3, 3,
+                           true, scaling_exponent, &m_native_vtx_decl.normals[i]);
+        data.AddMemOffset(load_bytes);
+        data1.AddMemOffset(load_bytes);
+      }
+      else
+      {
+        data.AddMemOffset(ReadVertex(data, m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat, 3, 3,
+                                     true, scaling_exponent, &m_native_vtx_decl.normals[i]));
+      }
     }
   }
 
@@ -480,8 +637,12 @@ void VertexLoaderX64::GenerateVertexLoader()
   {
     if (m_VtxDesc.low.Color[i] != VertexComponentFormat::NotPresent)
     {
-      data = GetVertexAddr(CPArray::Color0 + i, m_VtxDesc.low.Color[i]);
-      ReadColor(data, m_VtxDesc.low.Color[i], m_VtxAttr.GetColorFormat(i));
+      // Colors are converted with integer instructions, one vertex at a time.
+      for (int vertex = vertex_count - 1; vertex >= 0; vertex--)
+      {
+        data = GetVertexAddr(CPArray::Color0 + i, m_VtxDesc.low.Color[i], vertex);
+        ReadColor(data, m_VtxDesc.low.Color[i], m_VtxAttr.GetColorFormat(i), vertex);
+      }
       m_native_vtx_decl.colors[i].components = 4;
       m_native_vtx_decl.colors[i].enable = true;
       m_native_vtx_decl.colors[i].offset = m_dst_ofs;
@@ -496,11 +657,23 @@ void VertexLoaderX64::GenerateVertexLoader()
     int elements = m_VtxAttr.GetTexElements(i) == TexComponentCount::ST ? 2 : 1;
     if (m_VtxDesc.high.TexCoord[i] != VertexComponentFormat::NotPresent)
     {
+      if (m_paired)
+        data1 = GetVertexAddr(CPArray::TexCoord0 + i, m_VtxDesc.high.TexCoord[i], 1);
       data = GetVertexAddr(CPArray::TexCoord0 + i, m_VtxDesc.high.TexCoord[i]);
       u8 scaling_exponent = m_VtxAttr.GetTexFrac(i);
-      ReadVertex(data, m_VtxDesc.high.TexCoord[i], m_VtxAttr.GetTexFormat(i), elements,
-                 m_VtxDesc.low.TexMatIdx[i] ? 2 : elements, m_VtxAttr.g0.ByteDequant,
-                 scaling_exponent, &m_native_vtx_decl.texcoords[i]);
+      if (m_paired)
+      {
+        ReadVertexPair(data, data1, m_VtxDesc.high.TexCoord[i], m_VtxAttr.GetTexFormat(i),
+                       elements, m_VtxDesc.low.TexMatIdx[i] ? 2 : elements,
+                       m_VtxAttr.g0.ByteDequant, scaling_exponent,
+                       &m_native_vtx_decl.texcoords[i]);
+      }
+      else
+      {
+        ReadVertex(data, m_VtxDesc.high.TexCoord[i], m_VtxAttr.GetTexFormat(i), elements,
+                   m_VtxDesc.low.TexMatIdx[i] ? 2 : elements, m_VtxAttr.g0.ByteDequant,
+                   scaling_exponent, &m_native_vtx_decl.texcoords[i]);
+      }
     }
     if (m_VtxDesc.low.TexMatIdx[i])
     {
@@ -508,24 +681,89 @@ void VertexLoaderX64::GenerateVertexLoader()
       m_native_vtx_decl.texcoords[i].enable = true;
       m_native_vtx_decl.texcoords[i].type = ComponentFormat::Float;
       m_native_vtx_decl.texcoords[i].integer = false;
-      MOVZX(64, 8, scratch1, MDisp(src_reg, texmatidx_ofs[i]));
-      if (m_VtxDesc.high.TexCoord[i] != VertexComponentFormat::NotPresent)
-      {
-        CVTSI2SS(XMM0, R(scratch1));
-        MOVSS(MDisp(dst_reg, m_dst_ofs), XMM0);
-        m_dst_ofs += sizeof(float);
-      }
-      else
-      {
+      const bool has_texcoord = m_VtxDesc.high.TexCoord[i] != VertexComponentFormat::NotPresent;
+      if (!has_texcoord)
         m_native_vtx_decl.texcoords[i].offset = m_dst_ofs;
-        PXOR(XMM0, R(XMM0));
-        CVTSI2SS(XMM0, R(scratch1));
-        SHUFPS(XMM0, R(XMM0), 0x45);  // 000X -> 0X00
-        MOVUPS(MDisp(dst_reg, m_dst_ofs), XMM0);
-        m_dst_ofs += sizeof(float) * 3;
+      for (int vertex = 0; vertex < vertex_count; vertex++)
+      {
+        OpArg dest = MDisp(dst_reg, m_dst_ofs + vertex * m_native_vtx_decl.stride);
+        MOVZX(64, 8, scratch1, MDisp(src_reg, texmatidx_ofs[i] + vertex * m_vertex_size));
+        if (has_texcoord)
+        {
+          CVTSI2SS(XMM0, R(scratch1));
+          MOVSS(dest, XMM0);
+        }
+        else
+        {
+          PXOR(XMM0, R(XMM0));
+          CVTSI2SS(XMM0, R(scratch1));
+          SHUFPS(XMM0, R(XMM0), 0x45);  // 000X -> 0X00
+          if (m_paired)
+          {
+            // Don't overwrite the start of the next vertex, see ReadVertexPair.
+            MOVLPS(dest, XMM0);
+            dest.AddMemOffset(2 * sizeof(float));
+            VEXTRACTPS(dest, XMM0, 2);
+          }
+          else
+          {
+            MOVUPS(dest, XMM0);
+          }
+        }
       }
+      m_dst_ofs += sizeof(float) * (has_texcoord ? 1 : 3);
     }
   }
+}
+
+void VertexLoaderX64::GenerateVertexLoader()
+{
+  // With AVX2, vertices with fixed-point attributes are converted in pairs, with one vertex in each
+  // 128-bit lane of the YMM registers. Indexed attributes are loaded one lane at a time rather than
+  // with VPGATHERDD, as gathering the two to four elements of an attribute is slower than two plain
+  // loads. Float attributes don't need to be converted, so they don't benefit from this.
+  const auto is_fixed_point = [](VertexComponentFormat attribute, ComponentFormat format) {
+    return attribute != VertexComponentFormat::NotPresent && format != ComponentFormat::Float;
+  };
+  bool paired = is_fixed_point(m_VtxDesc.low.Position, m_VtxAttr.g0.PosFormat) ||
+                is_fixed_point(m_VtxDesc.low.Normal, m_VtxAttr.g0.NormalFormat);
+  for (u8 i = 0; i < m_VtxDesc.high.TexCoord.Size(); i++)
+    paired |= is_fixed_point(m_VtxDesc.high.TexCoord[i], m_VtxAttr.GetTexFormat(i));
+  paired &= cpu_info.bAVX2;
+
+  BitSet32 regs = {src_reg,  dst_reg,       scratch1,    scratch2,
+                   scratch3, remaining_reg, skipped_reg, base_reg};
+  if (paired)
+  {
+    regs[pair_index_reg] = true;
+    regs[pair_base_reg] = true;
+  }
+  regs &= ABI_ALL_CALLEE_SAVED;
+  ABI_PushRegistersAndAdjustStack(regs, 0);
+
+  // Backup count since we're going to count it down.
+  PUSH(32, R(ABI_PARAM3));
+
+  // ABI_PARAM3 is one of the lower registers, so free it for scratch2.
+  // We also have it end at a value of 0, to simplify indexing for zfreeze;
+  // this requires subtracting 1 at the start.
+  LEA(32, remaining_reg, MDisp(ABI_PARAM3, -1));
+
+  MOV(64, R(base_reg), R(ABI_PARAM4));
+
+  if (IsIndexed(m_VtxDesc.low.Position))
+    XOR(32, R(skipped_reg), R(skipped_reg));
+
+  // TODO: load constants into registers outside the main loop
+
+  FixupBranch to_pair_loop;
+  if (paired)
+    to_pair_loop = J(true);
+
+  const u8* loop_start = GetCodePtr();
+
+  GenerateVertexConversion();
+  m_native_vtx_decl.stride = m_dst_ofs;
 
   // Prepare for the next vertex.
   ADD(64, R(dst_reg), Imm32(m_dst_ofs));
@@ -533,7 +771,48 @@ void VertexLoaderX64::GenerateVertexLoader()
   ADD(64, R(src_reg), Imm32(m_src_ofs));
 
   SUB(32, R(remaining_reg), Imm8(1));
-  J_CC(CC_AE, loop_start);
+  if (paired)
+  {
+    FixupBranch done = J_CC(CC_B, true);
+
+    SetJumpTarget(to_pair_loop);
+    const u8* pair_loop_start = GetCodePtr();
+
+    // The last vertex, and pairs that contain a skipped vertex, go through the single vertex loop.
+    CMP(32, R(remaining_reg), Imm8(1));
+    J_CC(CC_L, loop_start);
+    if (IsIndexed(m_VtxDesc.low.Position))
+    {
+      u32 position_ofs = m_VtxDesc.low.PosMatIdx ? 1 : 0;
+      for (auto texmatidx : m_VtxDesc.low.TexMatIdx)
+      {
+        if (texmatidx)
+          position_ofs++;
+      }
+      const int bits = m_VtxDesc.low.Position == VertexComponentFormat::Index8 ? 8 : 16;
+      CMP(bits, MDisp(src_reg, position_ofs), Imm8(-1));
+      J_CC(CC_E, loop_start);
+      CMP(bits, MDisp(src_reg, position_ofs + m_vertex_size), Imm8(-1));
+      J_CC(CC_E, loop_start);
+    }
+
+    m_src_ofs = 0;
+    m_dst_ofs = 0;
+    m_paired = true;
+    GenerateVertexConversion();
+    m_paired = false;
+
+    ADD(64, R(dst_reg), Imm32(2 * m_dst_ofs));
+    ADD(64, R(src_reg), Imm32(2 * m_src_ofs));
+    SUB(32, R(remaining_reg), Imm8(2));
+    J_CC(CC_AE, pair_loop_start);
+
+    SetJumpTarget(done);
+  }
+  else
+  {
+    J_CC(CC_AE, loop_start);
+  }
 
   // Get the original count.
   POP(32, R(ABI_RETURN));
@@ -547,7 +826,7 @@ void VertexLoaderX64::GenerateVertexLoader()
 
     SetJumpTarget(m_skip_vertex);
     ADD(32, R(skipped_reg), Imm8(1));
-    JMP(cont);
+    JMP(cont, true);
   }
   else
   {
@@ -555,7 +834,6 @@ void VertexLoaderX64::GenerateVertexLoader()
   }
 
   ASSERT(m_vertex_size == m_src_ofs);
-  m_native_vtx_decl.stride = m_dst_ofs;
 }
 
 int VertexLoaderX64::RunVertices(DataReader src, DataReader dst, int count)
@@ -23,11 +23,18 @@ protected:
 private:
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
+  // Whether the code being generated converts two vertices at once.
+  bool m_paired = false;
   Gen::FixupBranch m_skip_vertex;
-  Gen::OpArg GetVertexAddr(CPArray array, VertexComponentFormat attribute);
+  Gen::OpArg GetVertexAddr(CPArray array, VertexComponentFormat attribute, int vertex = 0);
   int ReadVertex(Gen::OpArg data, VertexComponentFormat attribute, ComponentFormat format,
                  int count_in, int count_out, bool dequantize, u8 scaling_exponent,
                  AttributeFormat* native_format);
-  void ReadColor(Gen::OpArg data, VertexComponentFormat attribute, ColorFormat format);
+  int ReadVertexPair(Gen::OpArg data0, Gen::OpArg data1, VertexComponentFormat attribute,
+                     ComponentFormat format, int count_in, int count_out, bool dequantize,
+                     u8 scaling_exponent, AttributeFormat* native_format);
+  void ReadColor(Gen::OpArg data, VertexComponentFormat attribute, ColorFormat format,
+                 int vertex = 0);
+  void GenerateVertexConversion();
   void GenerateVertexLoader();
 };
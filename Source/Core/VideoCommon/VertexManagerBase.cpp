@@ -301,6 +301,7 @@ void VertexManagerBase::UploadUtilityVertices(const void* vertices, u32 vertex_s
 {
   // The GX vertex list should be flushed before any utility draws occur.
   ASSERT(m_is_flushed);
+  VertexLoaderManager::WaitForVertexDecoding();
 
   // Copy into the buffers usually used for GX drawing.
   ResetBuffer(std::max(vertex_stride, 1u));
@@ -382,6 +383,7 @@ void VertexManagerBase::Flush()
           GameQuirk::MISMATCHED_GPU_COLORS_BETWEEN_XF_AND_BP);
     }
 
+    VertexLoaderManager::WaitForVertexDecoding();
     return;
   }
 
@@ -450,8 +452,8 @@ void VertexManagerBase::Flush()
     }
   }
 
-  CalculateBinormals(VertexLoaderManager::GetCurrentVertexFormat());
-  // Calculate ZSlope for zfreeze
+  // Textures are loaded before anything that touches the vertices, so that texture decoding
+  // overlaps with deferred vertex conversion.
   const auto used_textures = UsedTextures();
   std::vector<std::string> texture_names;
   if (!m_cull_all)
@@ -475,6 +477,10 @@ void VertexManagerBase::Flush()
       }
     }
   }
+  VertexLoaderManager::WaitForVertexDecoding();
+
+  CalculateBinormals(VertexLoaderManager::GetCurrentVertexFormat());
+  // Calculate ZSlope for zfreeze
   VertexShaderManager::SetConstants(texture_names);
   if (!bpmem.genMode.zfreeze)
   {
@@ -0,0 +1,150 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "AudioCommon/Enums.h"
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/NullSoundStream.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Flag.h"
+#include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
+
+namespace
+{
+class ScopedMixerConfig final
+{
+public:
+  ScopedMixerConfig(AudioCommon::ResamplingQuality quality, bool mixer_thread)
+  {
+    Config::Init();
+    Config::SetCurrent(Config::MAIN_AUDIO_RESAMPLING_QUALITY, quality);
+    Config::SetCurrent(Config::MAIN_AUDIO_MIXER_THREAD, mixer_thread);
+  }
+  ~ScopedMixerConfig() { Config::Shutdown(); }
+};
+
+// Stereo frames in the big endian format of DMA audio.
+std::vector<short> CreateDMAFrames(size_t count, short left, short right)
+{
+  std::vector<short> frames(count * 2);
+  for (size_t i = 0; i < count; ++i)
+  {
+    frames[i * 2] = Common::swap16(left);
+    frames[i * 2 + 1] = Common::swap16(right);
+  }
+  return frames;
+}
+
+// Calls Mix() like the callback of a 48 kHz backend using 256 frame buffers would, while another
+// thread pushes 32 kHz DMA audio like the emulator does. Both run 4 times faster than real time.
+// Returns how long every call took, in microseconds.
+std::vector<double> MeasureCallbackDurations(AudioCommon::ResamplingQuality quality,
+                                             bool mixer_thread)
+{
+  constexpr u32 CALLBACK_FRAMES = 256;
+  constexpr u32 CALLBACKS = 300;
+  constexpr u32 PUSHED_FRAMES = 160;
+  constexpr auto CALLBACK_PERIOD = std::chrono::microseconds(1333);
+  constexpr auto PUSH_PERIOD = std::chrono::microseconds(1250);
+
+  ScopedMixerConfig config(quality, mixer_thread);
+  NullSound stream;
+  Mixer* mixer = stream.GetMixer();
+
+  Common::Flag producer_running(true);
+  std::thread producer([&] {
+    std::vector<short> frames(PUSHED_FRAMES * 2);
+    u32 t = 0;
+    auto next = std::chrono::steady_clock::now();
+    while (producer_running.IsSet())
+    {
+      for (u32 i = 0; i < PUSHED_FRAMES; ++i, ++t)
+      {
+        const auto sample = static_cast<short>(std::sin(t * 0.05) * 10000);
+        frames[i * 2] = frames[i * 2 + 1] = Common::swap16(sample);
+      }
+      mixer->PushSamples(frames.data(), PUSHED_FRAMES);
+      next += PUSH_PERIOD;
+      std::this_thread::sleep_until(next);
+    }
+  });
+
+  std::vector<double> durations;
+  std::array<short, CALLBACK_FRAMES * 2> buffer;
+  bool heard_samples = false;
+  auto next = std::chrono::steady_clock::now();
+  for (u32 i = 0; i < CALLBACKS; ++i)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    mixer->Mix(buffer.data(), CALLBACK_FRAMES);
+    const std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    durations.push_back(elapsed.count());
+    heard_samples |= std::any_of(buffer.begin(), buffer.end(), [](short s) { return s != 0; });
+
+    next += CALLBACK_PERIOD;
+    std::this_thread::sleep_until(next);
+  }
+
+  producer_running.Clear();
+  producer.join();
+  EXPECT_TRUE(heard_samples);
+  return durations;
+}
+
+void PrintPercentiles(const char* name, std::vector<double> durations)
+{
+  std::sort(durations.begin(), durations.end());
+  const auto percentile = [&](double p) {
+    return durations[static_cast<size_t>(p * (durations.size() - 1))];
+  };
+  fmt::print("{}: callback duration p50 {:.1f} us, p99 {:.1f} us, max {:.1f} us\n", name,
+             percentile(0.5), percentile(0.99), durations.back());
+}
+}  // namespace
+
+TEST(Mixer, MixesPushedSamples)
+{
+  for (const auto quality : {AudioCommon::ResamplingQuality::Linear,
+                             AudioCommon::ResamplingQuality::Sinc})
+  {
+    ScopedMixerConfig config(quality, false);
+    NullSound stream;
+    Mixer* mixer = stream.GetMixer();
+
+    const std::vector<short> frames = CreateDMAFrames(1000, 1000, -2000);
+    mixer->PushSamples(frames.data(), 1000);
+    std::array<short, 256 * 2> buffer;
+    ASSERT_EQ(256u, mixer->Mix(buffer.data(), 256));
+
+    // Resampling a constant gives the same constant. The output has the right channel first.
+    // The sinc filter needs a few frames to start, as it reads the frames before the first one.
+    for (size_t i = 8; i < 256; ++i)
+    {
+      ASSERT_EQ(-2000, buffer[i * 2]) << "frame " << i;
+      ASSERT_EQ(1000, buffer[i * 2 + 1]) << "frame " << i;
+    }
+  }
+}
+
+TEST(Mixer, CallbackDuration)
+{
+  PrintPercentiles("Linear",
+                   MeasureCallbackDurations(AudioCommon::ResamplingQuality::Linear, false));
+  PrintPercentiles("Sinc", MeasureCallbackDurations(AudioCommon::ResamplingQuality::Sinc, false));
+  PrintPercentiles("Linear, mixer thread",
+                   MeasureCallbackDurations(AudioCommon::ResamplingQuality::Linear, true));
+  PrintPercentiles("Sinc, mixer thread",
+                   MeasureCallbackDurations(AudioCommon::ResamplingQuality::Sinc, true));
+}
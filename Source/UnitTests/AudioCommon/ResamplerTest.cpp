@@ -0,0 +1,133 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/Resampler.h"
+#include "Common/CommonTypes.h"
+
+using namespace AudioCommon;
+
+namespace
+{
+constexpr u32 MAX_COUNT = 67;
+
+s16 RandomSample(std::mt19937& rng)
+{
+  // Favour the extremes, which is where overflows happen.
+  switch (rng() % 4)
+  {
+  case 0:
+    return -32768;
+  case 1:
+    return 32767;
+  default:
+    return static_cast<s16>(rng());
+  }
+}
+
+s16 MixSample(s16 mixed, s32 sample, s32 volume)
+{
+  sample = std::clamp(sample >> 14, -32768, 32767);
+  return static_cast<s16>(std::clamp(mixed + ((sample * volume) >> 8), -32767, 32767));
+}
+
+void TestResampler(bool sinc)
+{
+  std::mt19937 rng(sinc ? 1 : 2);
+  const auto& table = Resampler::GetSincTable();
+
+  for (u32 test = 0; test < 2000; ++test)
+  {
+    const u32 count = rng() % (MAX_COUNT + 1);
+    const s32 lvolume = rng() % 258;
+    const s32 rvolume = rng() % 258;
+
+    // Positions go forwards by up to 3 frames, like when downsampling.
+    std::vector<u32> positions(count);
+    std::vector<u16> fracs(count);
+    u32 position = Resampler::SINC_FRAMES_BEFORE;
+    for (u32 i = 0; i < count; ++i)
+    {
+      positions[i] = position;
+      fracs[i] = static_cast<u16>(rng());
+      position += rng() % 4;
+    }
+    std::vector<s16> input((position + Resampler::SINC_FRAMES_AFTER + 1) * 2);
+    for (s16& sample : input)
+      sample = RandomSample(rng);
+
+    std::array<s16, MAX_COUNT * 2> expected;
+    for (s16& sample : expected)
+      sample = RandomSample(rng);
+    std::array<s16, MAX_COUNT * 2> actual = expected;
+
+    for (u32 i = 0; i < count; ++i)
+    {
+      s32 left = 0, right = 0;
+      if (sinc)
+      {
+        const auto& c = table[fracs[i] >> 10];
+        for (u32 j = 0; j < Resampler::SINC_TAPS; ++j)
+        {
+          const u32 frame = positions[i] + j - Resampler::SINC_FRAMES_BEFORE;
+          left += input[frame * 2] * c[j];
+          right += input[frame * 2 + 1] * c[j];
+        }
+      }
+      else
+      {
+        const s32 w = fracs[i] >> 2;
+        const u32 frame = positions[i];
+        left = input[frame * 2] * (0x4000 - w) + input[frame * 2 + 2] * w;
+        right = input[frame * 2 + 1] * (0x4000 - w) + input[frame * 2 + 3] * w;
+      }
+      expected[i * 2] = MixSample(expected[i * 2], right, rvolume);
+      expected[i * 2 + 1] = MixSample(expected[i * 2 + 1], left, lvolume);
+    }
+
+    if (sinc)
+    {
+      Resampler::MixSinc(input.data(), positions.data(), fracs.data(), count, lvolume, rvolume,
+                         actual.data());
+    }
+    else
+    {
+      Resampler::MixLinear(input.data(), positions.data(), fracs.data(), count, lvolume, rvolume,
+                           actual.data());
+    }
+    ASSERT_EQ(expected, actual) << "test " << test;
+  }
+}
+}  // namespace
+
+TEST(Resampler, MixLinear)
+{
+  TestResampler(false);
+}
+
+TEST(Resampler, MixSinc)
+{
+  TestResampler(true);
+}
+
+TEST(Resampler, SincTableHasUnityGain)
+{
+  for (const auto& phase : Resampler::GetSincTable())
+  {
+    s32 sum = 0;
+    for (const s16 coefficient : phase)
+      sum += coefficient;
+    EXPECT_EQ(1 << 14, sum);
+  }
+
+  // Without a fractional part, the current frame has the highest weight.
+  const auto& first_phase = Resampler::GetSincTable()[0];
+  EXPECT_EQ(first_phase[Resampler::SINC_FRAMES_BEFORE],
+            *std::max_element(first_phase.begin(), first_phase.end()));
+}
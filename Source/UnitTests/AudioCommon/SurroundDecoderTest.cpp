@@ -0,0 +1,145 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "AudioCommon/SurroundDecoder.h"
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+
+using AudioCommon::SurroundDecoder;
+
+namespace
+{
+constexpr u32 SAMPLE_RATE = 48000;
+constexpr size_t SURROUND_CHANNELS = 6;
+constexpr size_t FRONT_CENTER = 2;
+
+// The frame block sizes the mixer uses for each DPL2 quality.
+constexpr std::array<std::pair<const char*, u32>, 4> QUALITIES{{
+    {"Lowest", 512},
+    {"Low", 1024},
+    {"High", 2048},
+    {"Highest", 4096},
+}};
+
+// Interleaved stereo frames of a sine wave starting at <start>, with the right channel scaled by
+// <right_gain>.
+std::vector<short> CreateSine(size_t count, size_t start, double right_gain)
+{
+  std::vector<short> frames(count * 2);
+  for (size_t i = start; i < count; ++i)
+  {
+    const double sample = 16000 * std::sin(2 * MathUtil::PI * 1000 * i / SAMPLE_RATE);
+    frames[i * 2] = static_cast<short>(sample);
+    frames[i * 2 + 1] = static_cast<short>(sample * right_gain);
+  }
+  return frames;
+}
+
+// Decodes <input> the way the mixer does, asking for <output_frames> frames at a time.
+std::vector<float> Decode(SurroundDecoder& decoder, const std::vector<short>& input,
+                          size_t output_frames)
+{
+  std::vector<float> output;
+  std::vector<float> buffer(output_frames * SURROUND_CHANNELS);
+  size_t read = 0;
+  while (true)
+  {
+    const size_t needed = decoder.QueryFramesNeededForSurroundOutput(output_frames);
+    if (read + needed > input.size() / 2)
+      break;
+    decoder.PutFrames(&input[read * 2], needed);
+    read += needed;
+    decoder.ReceiveFrames(buffer.data(), output_frames);
+    output.insert(output.end(), buffer.begin(), buffer.end());
+  }
+  return output;
+}
+
+double ChannelEnergy(const std::vector<float>& output, size_t channel, size_t first_frame)
+{
+  double energy = 0;
+  for (size_t i = first_frame * SURROUND_CHANNELS + channel; i < output.size();
+       i += SURROUND_CHANNELS)
+  {
+    energy += output[i] * output[i];
+  }
+  return energy;
+}
+
+// Returns the first frame which has a sample louder than a quarter of the input level.
+size_t FindOnset(const std::vector<float>& output)
+{
+  for (size_t i = 0; i < output.size(); ++i)
+  {
+    if (std::abs(output[i]) > 0.12f)
+      return i / SURROUND_CHANNELS;
+  }
+  return output.size() / SURROUND_CHANNELS;
+}
+}  // namespace
+
+TEST(SurroundDecoder, CenterSoundIsDecodedToCenterChannel)
+{
+  for (const bool low_latency : {false, true})
+  {
+    SurroundDecoder decoder(SAMPLE_RATE, 2048, low_latency);
+    const std::vector<float> output = Decode(decoder, CreateSine(SAMPLE_RATE, 0, 1.0), 256);
+    ASSERT_FALSE(output.empty());
+
+    const double center = ChannelEnergy(output, FRONT_CENTER, 8192);
+    for (size_t channel = 0; channel < SURROUND_CHANNELS; ++channel)
+    {
+      if (channel != FRONT_CENTER)
+      {
+        EXPECT_LT(ChannelEnergy(output, channel, 8192), center * 0.1) << "channel " << channel;
+      }
+    }
+  }
+}
+
+TEST(SurroundDecoder, LowLatencyDelay)
+{
+  constexpr size_t ONSET = 8192;
+  const std::vector<short> input = CreateSine(ONSET * 2, ONSET, 0.5);
+  for (const auto& [name, block_size] : QUALITIES)
+  {
+    SurroundDecoder classic(SAMPLE_RATE, block_size, false);
+    SurroundDecoder low_latency(SAMPLE_RATE, block_size, true);
+    // Audio backends commonly ask for 256 frames at a time.
+    const size_t classic_delay = FindOnset(Decode(classic, input, 256)) - ONSET;
+    const size_t low_latency_delay = FindOnset(Decode(low_latency, input, 256)) - ONSET;
+    fmt::print("{}: delay {:.1f} ms, {:.1f} ms in low latency mode\n", name,
+               classic_delay * 1000.0 / SAMPLE_RATE, low_latency_delay * 1000.0 / SAMPLE_RATE);
+
+    EXPECT_LE(low_latency_delay, SurroundDecoder::LOW_LATENCY_HOP_SIZE * 2) << name;
+    EXPECT_LT(low_latency_delay, classic_delay) << name;
+  }
+}
+
+TEST(SurroundDecoder, DecodeCost)
+{
+  // Reports how long decoding one second of audio takes at each quality.
+  const std::vector<short> input = CreateSine(SAMPLE_RATE * 4, 0, 0.5);
+  for (const bool low_latency : {false, true})
+  {
+    for (const auto& [name, block_size] : QUALITIES)
+    {
+      SurroundDecoder decoder(SAMPLE_RATE, block_size, low_latency);
+      const auto start = std::chrono::steady_clock::now();
+      const std::vector<float> output = Decode(decoder, input, 256);
+      const std::chrono::duration<double, std::milli> elapsed =
+          std::chrono::steady_clock::now() - start;
+      ASSERT_FALSE(output.empty());
+      fmt::print("{}{}: {:.2f} ms per second of audio\n", name, low_latency ? ", low latency" : "",
+                 elapsed.count() * SAMPLE_RATE * SURROUND_CHANNELS / output.size());
+    }
+  }
+}
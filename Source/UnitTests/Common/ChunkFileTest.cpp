@@ -0,0 +1,156 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+
+namespace
+{
+// Roughly the shape of a Wii savestate: MEM1 and MEM2, plus lots of small device state.
+struct FakeState
+{
+  std::vector<u8> mem1 = std::vector<u8>(24 * 1024 * 1024);
+  std::vector<u8> mem2 = std::vector<u8>(64 * 1024 * 1024);
+  std::vector<u32> registers = std::vector<u32>(100000);
+  std::map<u32, std::string> files;
+  bool flag = false;
+
+  FakeState()
+  {
+    for (size_t i = 0; i < mem1.size(); i += 4096)
+      mem1[i] = static_cast<u8>(i >> 12);
+    for (size_t i = 0; i < registers.size(); i++)
+      registers[i] = static_cast<u32>(i * 0x9E3779B9);
+    for (u32 i = 0; i < 1000; i++)
+      files.emplace(i, fmt::format("/title/00010000/{:08x}/data", i));
+  }
+
+  void DoState(PointerWrap& p)
+  {
+    p.Do(mem1);
+    p.DoMarker("MEM1");
+    p.Do(mem2);
+    p.DoMarker("MEM2");
+    for (u32& reg : registers)
+      p.Do(reg);
+    p.Do(files);
+    p.Do(flag);
+    p.DoMarker("Devices");
+  }
+
+  bool operator==(const FakeState& other) const
+  {
+    return mem1 == other.mem1 && mem2 == other.mem2 && registers == other.registers &&
+           files == other.files && flag == other.flag;
+  }
+};
+
+std::vector<u8> Save(FakeState& state)
+{
+  std::vector<u8> buffer;
+  u8* ptr = nullptr;
+  PointerWrap p(&ptr, &buffer);
+  state.DoState(p);
+  EXPECT_TRUE(p.IsWriteMode());
+  buffer.resize(ptr - buffer.data());
+  return buffer;
+}
+
+bool Load(std::vector<u8>& buffer, FakeState& state)
+{
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  state.DoState(p);
+  return p.IsReadMode();
+}
+}  // namespace
+
+TEST(ChunkFile, GrowableWriteMatchesMeasuredWrite)
+{
+  FakeState state;
+  state.flag = true;
+
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  state.DoState(p_measure);
+  const size_t measured_size = reinterpret_cast<size_t>(ptr);
+
+  std::vector<u8> measured_buffer(measured_size);
+  ptr = measured_buffer.data();
+  PointerWrap p(&ptr, measured_size, PointerWrap::Mode::Write);
+  state.DoState(p);
+  ASSERT_TRUE(p.IsWriteMode());
+
+  EXPECT_EQ(Save(state), measured_buffer);
+}
+
+TEST(ChunkFile, GrowableWriteReusesBuffer)
+{
+  std::vector<u8> buffer(100, 0xFF);
+  const u8* const data = buffer.data();
+
+  u32 value = 0x12345678;
+  u8* ptr = nullptr;
+  PointerWrap p(&ptr, &buffer);
+  p.Do(value);
+  p.Do(value);
+
+  EXPECT_EQ(ptr - buffer.data(), 8);
+  EXPECT_EQ(buffer.data(), data);
+}
+
+TEST(ChunkFile, RoundTrip)
+{
+  FakeState state;
+  state.flag = true;
+  std::vector<u8> buffer = Save(state);
+
+  FakeState loaded;
+  loaded.mem1.assign(loaded.mem1.size(), 0);
+  loaded.files.clear();
+  ASSERT_TRUE(Load(buffer, loaded));
+  EXPECT_TRUE(loaded == state);
+
+  // Loading from a truncated buffer must fail rather than read past the end.
+  buffer.resize(buffer.size() / 2);
+  EXPECT_FALSE(Load(buffer, loaded));
+}
+
+TEST(ChunkFile, Throughput)
+{
+  constexpr int ITERATIONS = 5;
+  FakeState state;
+
+  // Reuse one buffer, the same way State::SaveAs reuses its buffer.
+  std::vector<u8> buffer;
+  const auto save_start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++)
+  {
+    u8* ptr = nullptr;
+    PointerWrap p(&ptr, &buffer);
+    state.DoState(p);
+    buffer.resize(ptr - buffer.data());
+  }
+  const auto save_end = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < ITERATIONS; i++)
+    ASSERT_TRUE(Load(buffer, state));
+  const auto load_end = std::chrono::steady_clock::now();
+
+  const auto bytes_per_second = [&](auto start, auto end) {
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(buffer.size()) * ITERATIONS / seconds;
+  };
+
+  fmt::print("state size: {} bytes\n", buffer.size());
+  fmt::print("save: {:.0f} MB/s\n", bytes_per_second(save_start, save_end) / 1e6);
+  fmt::print("load: {:.0f} MB/s\n", bytes_per_second(save_end, load_end) / 1e6);
+}
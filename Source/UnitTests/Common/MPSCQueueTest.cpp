@@ -0,0 +1,75 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32> q;
+
+  EXPECT_TRUE(q.Empty());
+
+  q.Push(1);
+  EXPECT_FALSE(q.Empty());
+
+  u32 v;
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(1u, v);
+  EXPECT_TRUE(q.Empty());
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order.
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  for (u32 i = 0; i < 1000; ++i)
+  {
+    u32 v2;
+    EXPECT_TRUE(q.Pop(v2));
+    EXPECT_EQ(i, v2);
+  }
+  EXPECT_TRUE(q.Empty());
+
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  EXPECT_FALSE(q.Empty());
+  q.Clear();
+  EXPECT_TRUE(q.Empty());
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 NUM_THREADS = 4;
+  constexpr u32 NUM_ITEMS = 100000;
+  Common::MPSCQueue<u32> q;
+
+  std::vector<std::thread> inserter_threads;
+  for (u32 producer = 0; producer < NUM_THREADS; ++producer)
+  {
+    inserter_threads.emplace_back([&q, producer]() {
+      for (u32 i = 0; i < NUM_ITEMS; ++i)
+        q.Push(producer << 24 | i);
+    });
+  }
+
+  // Items from each producer must come out in the order they were pushed in.
+  std::array<u32, NUM_THREADS> next_item{};
+  for (u32 i = 0; i < NUM_THREADS * NUM_ITEMS; ++i)
+  {
+    u32 v;
+    while (!q.Pop(v))
+      ;
+    const u32 producer = v >> 24;
+    ASSERT_LT(producer, NUM_THREADS);
+    EXPECT_EQ(next_item[producer]++, v & 0xFFFFFF);
+  }
+  EXPECT_TRUE(q.Empty());
+
+  for (std::thread& thread : inserter_threads)
+    thread.join();
+}
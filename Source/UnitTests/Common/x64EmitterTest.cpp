@@ -1205,6 +1205,95 @@ AVX_RRMI_TEST(VSHUFPD, "dqword")
 AVX_RRMI_TEST(VBLENDPS, "dqword")
 AVX_RRMI_TEST(VBLENDPD, "dqword")
 
+// for AVX2 instructions that take the form op reg, reg, r/m and have a 128-bit and a 256-bit form
+#define AVX2_RRM_TEST(Name)                                                                        \
+  TEST_F(x64EmitterTest, Name##_AVX2)                                                              \
+  {                                                                                                \
+    struct                                                                                         \
+    {                                                                                              \
+      int bits;                                                                                    \
+      std::vector<NamedReg> regs;                                                                  \
+      X64Reg out_reg;                                                                              \
+      std::string out_name;                                                                        \
+      std::string size;                                                                            \
+    } regsets[] = {                                                                                \
+        {128, xmmnames, XMM0, "xmm0", "dqword"},                                                   \
+        {256, ymmnames, YMM0, "ymm0", "qqword"},                                                   \
+    };                                                                                             \
+    for (const auto& regset : regsets)                                                             \
+      for (const auto& r : regset.regs)                                                            \
+      {                                                                                            \
+        emitter->Name(regset.bits, r.reg, regset.out_reg, R(regset.out_reg));                      \
+        emitter->Name(regset.bits, regset.out_reg, r.reg, MatR(R12));                              \
+        ExpectDisassembly(#Name " " + r.name + ", " + regset.out_name + ", " + regset.out_name +   \
+                          " " #Name " " + regset.out_name + ", " + r.name + ", " + regset.size +   \
+                          " ptr ds:[r12]");                                                        \
+      }                                                                                            \
+  }
+
+AVX2_RRM_TEST(VPSHUFB)
+AVX2_RRM_TEST(VMULPS)
+
+TEST_F(x64EmitterTest, VCVTDQ2PS_AVX2)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VCVTDQ2PS(256, r.reg, R(YMM0));
+    emitter->VCVTDQ2PS(256, YMM0, R(r.reg));
+    emitter->VCVTDQ2PS(256, r.reg, MatR(R12));
+    ExpectDisassembly("vcvtdq2ps " + r.name + ", ymm0 vcvtdq2ps ymm0, " + r.name + " vcvtdq2ps " +
+                      r.name + ", qqword ptr ds:[r12]");
+  }
+}
+
+TEST_F(x64EmitterTest, VPSRAD_AVX2)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VPSRAD(256, r.reg, YMM0, 16);
+    emitter->VPSRAD(256, YMM0, r.reg, 24);
+    ExpectDisassembly("vpsrad " + r.name + ", ymm0, 0x10 vpsrad ymm0, " + r.name + ", 0x18");
+  }
+}
+
+// Bochs prints the 128-bit operand of VINSERTI128/VEXTRACTI128 with the size of the 256-bit one.
+TEST_F(x64EmitterTest, VINSERTI128)
+{
+  for (size_t i = 0; i < ymmnames.size(); i++)
+  {
+    const auto& r = ymmnames[i];
+    emitter->VINSERTI128(r.reg, YMM0, R(xmmnames[i].reg), 1);
+    emitter->VINSERTI128(YMM0, r.reg, MatR(R12), 0);
+    ExpectDisassembly("vinserti128 " + r.name + ", ymm0, " + r.name + ", 0x01 vinserti128 ymm0, " +
+                      r.name + ", qqword ptr ds:[r12], 0x00");
+  }
+}
+
+TEST_F(x64EmitterTest, VEXTRACTI128)
+{
+  for (size_t i = 0; i < ymmnames.size(); i++)
+  {
+    const auto& r = ymmnames[i];
+    emitter->VEXTRACTI128(R(xmmnames[i].reg), YMM0, 1);
+    emitter->VEXTRACTI128(MatR(R12), r.reg, 0);
+    ExpectDisassembly("vextracti128 " + r.name + ", ymm0, 0x01 vextracti128 qqword ptr ds:[r12], " +
+                      r.name + ", 0x00");
+  }
+}
+
+TEST_F(x64EmitterTest, VEXTRACTPS)
+{
+  for (const auto& r : xmmnames)
+  {
+    emitter->VEXTRACTPS(R(EAX), r.reg, 2);
+    emitter->VEXTRACTPS(MatR(R12), r.reg, 3);
+    ExpectDisassembly("vextractps eax, " + r.name + ", 0x02 vextractps dword ptr ds:[r12], " +
+                      r.name + ", 0x03");
+  }
+}
+
+TEST_INSTR_NO_OPERANDS(VZEROUPPER, "vzeroupper")
+
 // for VEX instructions that take the form op reg, reg, r/m, reg OR reg, reg, reg, r/m
 #define VEX_RRMR_RRRM_TEST(Name, sizename)                                                         \
   TEST_F(x64EmitterTest, Name)                                                                     \
@@ -4,8 +4,14 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <chrono>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -362,3 +368,149 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
+
+namespace EventOrderTest
+{
+static std::vector<u64> s_order;
+
+static void RecordCallback(u64 userdata, s64 lateness)
+{
+  s_order.push_back(userdata);
+}
+}  // namespace EventOrderTest
+
+// Check that events spread far apart run in order, including after removing some.
+TEST(CoreTiming, EventOrder)
+{
+  using namespace EventOrderTest;
+
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  CoreTiming::EventType* cb_a = CoreTiming::RegisterEvent("callbackA", RecordCallback);
+  CoreTiming::EventType* cb_b = CoreTiming::RegisterEvent("callbackB", RecordCallback);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  s_order.clear();
+  CoreTiming::ScheduleEvent(5000000, cb_a, 4);
+  CoreTiming::ScheduleEvent(300000, cb_a, 2);
+  CoreTiming::ScheduleEvent(1000, cb_a, 0);
+  CoreTiming::ScheduleEvent(300000, cb_a, 3);
+  CoreTiming::ScheduleEvent(20000, cb_a, 1);
+  CoreTiming::ScheduleEvent(800000, cb_b, 5);
+  CoreTiming::ScheduleEvent(900, cb_b, 6);
+  CoreTiming::RemoveEvent(cb_b);
+
+  while (s_order.size() < 5)
+  {
+    PowerPC::ppcState.downcount = 0;
+    CoreTiming::Advance();
+  }
+  EXPECT_EQ((std::vector<u64>{0, 1, 2, 3, 4}), s_order);
+  EXPECT_EQ(5000000, static_cast<s64>(CoreTiming::GetTicks()));
+}
+
+namespace ScheduleFromOtherThreadsTest
+{
+static u64 s_callbacks_ran = 0;
+
+static void CountCallback(u64 userdata, s64 lateness)
+{
+  ++s_callbacks_ran;
+}
+}  // namespace ScheduleFromOtherThreadsTest
+
+TEST(CoreTiming, ScheduleFromOtherThreads)
+{
+  using namespace ScheduleFromOtherThreadsTest;
+
+  constexpr u32 NUM_THREADS = 4;
+  constexpr u32 EVENTS_PER_THREAD = 10000;
+
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  CoreTiming::EventType* cb = CoreTiming::RegisterEvent("callbackCount", CountCallback);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  s_callbacks_ran = 0;
+  std::vector<std::thread> threads;
+  for (u32 i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([cb] {
+      for (u32 j = 0; j < EVENTS_PER_THREAD; ++j)
+        CoreTiming::ScheduleEvent(j % 1000, cb, j, CoreTiming::FromThread::NON_CPU);
+    });
+  }
+
+  // Keep running the CPU thread while the other threads are scheduling.
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (s_callbacks_ran < NUM_THREADS * EVENTS_PER_THREAD &&
+         std::chrono::steady_clock::now() < timeout)
+  {
+    PowerPC::ppcState.downcount = 0;
+    CoreTiming::Advance();
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+  EXPECT_EQ(NUM_THREADS * EVENTS_PER_THREAD, s_callbacks_ran);
+}
+
+namespace ThroughputTest
+{
+static constexpr std::array<s64, 16> PERIODS{
+    {400, 1500, 2700, 5000, 8000, 12000, 15000, 20000, 40000, 60000, 120000, 250000, 800000,
+     2000000, 8000000, 16000000}};
+static std::array<CoreTiming::EventType*, PERIODS.size()> s_event_types;
+static u64 s_callbacks_ran = 0;
+
+static void RescheduleCallback(u64 userdata, s64 lateness)
+{
+  ++s_callbacks_ran;
+  CoreTiming::ScheduleEvent(PERIODS[userdata] - lateness, s_event_types[userdata], userdata);
+}
+}  // namespace ThroughputTest
+
+// Not so much a test as a benchmark of scheduling and running events, with a set of recurring
+// events that resembles what the emulated hardware keeps scheduled.
+TEST(CoreTiming, Throughput)
+{
+  using namespace ThroughputTest;
+
+  constexpr int NUM_ADVANCES = 2000000;
+
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  for (u32 i = 0; i < PERIODS.size(); ++i)
+  {
+    s_event_types[i] = CoreTiming::RegisterEvent(fmt::format("callback{}", i), RescheduleCallback);
+  }
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  for (u32 i = 0; i < PERIODS.size(); ++i)
+    CoreTiming::ScheduleEvent(PERIODS[i], s_event_types[i], i);
+
+  s_callbacks_ran = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_ADVANCES; ++i)
+  {
+    PowerPC::ppcState.downcount = 0;
+    CoreTiming::Advance();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  EXPECT_GT(s_callbacks_ran, static_cast<u64>(NUM_ADVANCES));
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  fmt::print("CoreTiming throughput:\n");
+  fmt::print("advances  {:.1f} M/s\n", NUM_ADVANCES / seconds / 1e6);
+  fmt::print("events    {:.1f} M/s\n", s_callbacks_ran / seconds / 1e6);
+}
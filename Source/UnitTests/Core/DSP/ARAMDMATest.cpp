@@ -0,0 +1,143 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/ARAMDMA.h"
+
+using namespace DSP::ARAMDMA;
+
+namespace
+{
+constexpr u32 ARAM_SIZE = 0x1000000;
+constexpr u32 ARAM_MASK = ARAM_SIZE - 1;
+
+std::vector<u8> MakeData(u32 size, u8 seed)
+{
+  std::vector<u8> data(size);
+  for (u32 i = 0; i < size; ++i)
+    data[i] = static_cast<u8>((seed + i) * 2654435761u >> 24);
+  return data;
+}
+
+// The MRAM -> ARAM transfer the way it is done without a bulk copy, 8 bytes at a time.
+void ChunkedCopyToARAM(const ARAMView& aram, u32 address, const u8* mram, u32 count,
+                       bool mirror_low_4mb)
+{
+  for (u32 i = 0; i < count; i += 8)
+  {
+    if (mirror_low_4mb && address + i < 0x400000)
+      std::memcpy(&aram.ptr[(address + i + 0x400000) & aram.mask], &mram[i], 8);
+    std::memcpy(&aram.ptr[(address + i) & aram.mask], &mram[i], 8);
+  }
+}
+}  // namespace
+
+TEST(ARAMDMA, GetPointers)
+{
+  std::vector<u8> ram(0x1000);
+  EXPECT_EQ(GetMRAMPointer(ram.data(), 0x1000, 0x800, 0x800), &ram[0x800]);
+  EXPECT_EQ(GetMRAMPointer(ram.data(), 0x1000, 0x800, 0x808), nullptr);
+  EXPECT_EQ(GetMRAMPointer(ram.data(), 0x1000, 0xfffffff8, 0x10), nullptr);
+
+  const ARAMView aram{ram.data(), 0x1000, 0xfff};
+  EXPECT_EQ(GetARAMPointer(aram, 0x1800, 0x800), &ram[0x800]);
+  EXPECT_EQ(GetARAMPointer(aram, 0xff8, 0x10), nullptr);
+}
+
+TEST(ARAMDMA, CopyFromARAM)
+{
+  std::vector<u8> aram_data = MakeData(ARAM_SIZE, 1);
+  const ARAMView aram{aram_data.data(), ARAM_SIZE, ARAM_MASK};
+  std::vector<u8> mram(0x1000);
+
+  ASSERT_TRUE(CopyFromARAM(aram, 0x123400, mram.data(), 0x1000));
+  EXPECT_EQ(0, std::memcmp(mram.data(), &aram_data[0x123400], 0x1000));
+
+  // A transfer which wraps around isn't done at all.
+  const std::vector<u8> before = mram;
+  EXPECT_FALSE(CopyFromARAM(aram, ARAM_SIZE - 0x800, mram.data(), 0x1000));
+  EXPECT_EQ(mram, before);
+}
+
+TEST(ARAMDMA, MirroredCopyMatchesChunkedCopy)
+{
+  struct Transfer
+  {
+    u32 address;
+    u32 count;
+  };
+  const Transfer transfers[] = {
+      // Entirely below 4MB.
+      {0x100000, 0x10000},
+      // Crossing 4MB, so only the start is mirrored.
+      {0x3ff000, 0x2000},
+      // Overlapping its own mirror, where the later chunks of the transfer have to win.
+      {0x0, 0x500000},
+      {0x3ff000, 0x402000},
+      // Entirely above 4MB.
+      {0x500000, 0x10000},
+  };
+
+  const std::vector<u8> mram = MakeData(0x500000, 2);
+  for (const bool mirror : {false, true})
+  {
+    for (const Transfer& transfer : transfers)
+    {
+      SCOPED_TRACE(fmt::format("{:#x} bytes to {:#x}, mirror {}", transfer.count,
+                               transfer.address, mirror));
+
+      std::vector<u8> expected = MakeData(ARAM_SIZE, 3);
+      ChunkedCopyToARAM({expected.data(), ARAM_SIZE, ARAM_MASK}, transfer.address, mram.data(),
+                        transfer.count, mirror);
+
+      std::vector<u8> actual = MakeData(ARAM_SIZE, 3);
+      ASSERT_TRUE(CopyToARAM({actual.data(), ARAM_SIZE, ARAM_MASK}, transfer.address,
+                             mram.data(), transfer.count, mirror));
+      EXPECT_TRUE(expected == actual);
+    }
+  }
+}
+
+TEST(ARAMDMA, WrappingCopyToARAMIsRejected)
+{
+  const std::vector<u8> mram = MakeData(0x1000, 4);
+  std::vector<u8> aram_data = MakeData(ARAM_SIZE, 5);
+  const std::vector<u8> before = aram_data;
+  const ARAMView aram{aram_data.data(), ARAM_SIZE, ARAM_MASK};
+
+  EXPECT_FALSE(CopyToARAM(aram, ARAM_SIZE - 0x800, mram.data(), 0x1000, false));
+  EXPECT_FALSE(CopyToARAM(aram, ARAM_SIZE - 0x800, mram.data(), 0x1000, true));
+  EXPECT_TRUE(aram_data == before);
+}
+
+TEST(ARAMDMA, Throughput)
+{
+  constexpr u32 TRANSFER_SIZE = 0x100000;
+  constexpr u32 NUM_TRANSFERS = 64;
+  const std::vector<u8> mram = MakeData(TRANSFER_SIZE, 6);
+  std::vector<u8> aram_data(ARAM_SIZE);
+  const ARAMView aram{aram_data.data(), ARAM_SIZE, ARAM_MASK};
+
+  const auto measure = [&](const auto& copy) {
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < NUM_TRANSFERS; ++i)
+      copy((i * TRANSFER_SIZE) & ARAM_MASK);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return double(TRANSFER_SIZE) * NUM_TRANSFERS / 0x100000 / elapsed.count();
+  };
+
+  const double bulk = measure([&](u32 address) {
+    ASSERT_TRUE(CopyToARAM(aram, address, mram.data(), TRANSFER_SIZE, true));
+  });
+  const double chunked = measure([&](u32 address) {
+    ChunkedCopyToARAM(aram, address, mram.data(), TRANSFER_SIZE, true);
+  });
+  fmt::print("MRAM -> ARAM: {:.0f} MB/s in bulk, {:.0f} MB/s in 8 byte chunks\n", bulk, chunked);
+}
@@ -0,0 +1,182 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceMath.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+constexpr u32 MAX_COUNT = 96;
+
+s16 RandomSample(std::mt19937& rng)
+{
+  // Favour the extremes, which is where overflows happen.
+  switch (rng() % 4)
+  {
+  case 0:
+    return -32768;
+  case 1:
+    return 32767;
+  default:
+    return static_cast<s16>(rng());
+  }
+}
+
+// Per-sample resampling loop, as done by the AX ucode.
+u32 ReferenceResample(const std::vector<s16>& input, s16* output, u32 count, s16* last_samples,
+                      u32 curr_pos, u32 ratio, const s16* coeffs)
+{
+  s16 temp[4];
+  u32 idx = 0;
+  u32 read = 0;
+  for (u32 i = 0; i < 4; ++i)
+    temp[idx++ & 3] = last_samples[i];
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos += ratio;
+    while (curr_pos >= 0x10000)
+    {
+      temp[idx++ & 3] = input[read++];
+      curr_pos -= 0x10000;
+    }
+
+    const s32 t0 = temp[idx++ & 3];
+    const s32 t1 = temp[idx++ & 3];
+    const s32 t2 = temp[idx++ & 3];
+    const s32 t3 = temp[idx++ & 3];
+    const u16 frac = curr_pos & 0xFFFF;
+    if (coeffs)
+    {
+      const s16* c = &coeffs[(frac >> 9) << 2];
+      const s64 sample = (s64(t0) * c[0] + s64(t1) * c[1] + s64(t2) * c[2] + s64(t3) * c[3]) >> 15;
+      output[i] = MathUtil::SaturatingCast<s16>(sample);
+    }
+    else if (frac)
+    {
+      output[i] = static_cast<s16>((t0 * u16(-frac) + t1 * frac) >> 16);
+    }
+    else
+    {
+      output[i] = static_cast<s16>(t0);
+    }
+  }
+
+  for (u32 i = 4; i > 0; --i)
+    last_samples[i - 1] = temp[--idx & 3];
+  return curr_pos;
+}
+
+void TestResample(bool polyphase)
+{
+  std::mt19937 rng(polyphase ? 1 : 2);
+  std::vector<s16> coeffs(0x200);
+
+  for (u32 test = 0; test < 2000; ++test)
+  {
+    for (s16& coeff : coeffs)
+      coeff = RandomSample(rng);
+
+    const u32 count = 1 + rng() % MAX_COUNT;
+    const u32 ratio = (rng() % 4 == 0) ? 0x10000 : rng() % 0x40000;
+    u32 curr_pos = rng() % 0x10000;
+
+    std::array<s16, 4> last_samples;
+    for (s16& sample : last_samples)
+      sample = RandomSample(rng);
+    std::vector<s16> new_samples(count * 4);
+    for (s16& sample : new_samples)
+      sample = RandomSample(rng);
+
+    std::array<s16, 4> expected_last = last_samples;
+    std::array<s16, MAX_COUNT> expected;
+    const u32 expected_pos = ReferenceResample(new_samples, expected.data(), count,
+                                               expected_last.data(), curr_pos, ratio,
+                                               polyphase ? coeffs.data() : nullptr);
+
+    std::array<u32, MAX_COUNT> positions;
+    std::array<u16, MAX_COUNT> fracs;
+    const u32 consumed = AXVoiceMath::ComputeResamplePositions(&curr_pos, ratio, count,
+                                                               positions.data(), fracs.data());
+    ASSERT_EQ(expected_pos, curr_pos);
+
+    std::vector<s16> input(last_samples.begin(), last_samples.end());
+    input.insert(input.end(), new_samples.begin(), new_samples.begin() + consumed);
+    std::array<s16, MAX_COUNT> actual;
+    if (polyphase)
+    {
+      AXVoiceMath::ResamplePolyphase(input.data(), actual.data(), count, positions.data(),
+                                     fracs.data(), coeffs.data());
+    }
+    else
+    {
+      AXVoiceMath::ResampleLinear(input.data(), actual.data(), count, positions.data(),
+                                  fracs.data());
+    }
+
+    for (u32 i = 0; i < count; ++i)
+      ASSERT_EQ(expected[i], actual[i]) << "test " << test << " sample " << i;
+    for (u32 i = 0; i < 4; ++i)
+      ASSERT_EQ(expected_last[i], input[consumed + i]);
+  }
+}
+}  // namespace
+
+TEST(AXVoiceMath, ResampleLinear)
+{
+  TestResample(false);
+}
+
+TEST(AXVoiceMath, ResamplePolyphase)
+{
+  TestResample(true);
+}
+
+TEST(AXVoiceMath, ApplyVolumeAndAddSamples)
+{
+  std::mt19937 rng(3);
+  for (u32 test = 0; test < 2000; ++test)
+  {
+    const u32 count = rng() % (MAX_COUNT + 1);
+    const u16 volume = static_cast<u16>(rng());
+    const u16 volume_delta = (rng() % 2) ? static_cast<u16>(rng()) : 0;
+
+    std::array<s16, MAX_COUNT> input;
+    std::array<int, MAX_COUNT> expected;
+    for (u32 i = 0; i < count; ++i)
+    {
+      input[i] = RandomSample(rng);
+      expected[i] = static_cast<int>(rng() % 0x100000) - 0x80000;
+    }
+    std::array<int, MAX_COUNT> actual = expected;
+
+    u16 current_volume = volume;
+    for (u32 i = 0; i < count; ++i)
+    {
+      const s32 sample = (s32(input[i]) * current_volume) >> 15;
+      expected[i] += std::clamp(sample, -32767, 32767);
+      current_volume += volume_delta;
+    }
+
+    std::array<s16, MAX_COUNT> scaled;
+    AXVoiceMath::ApplyVolume(input.data(), scaled.data(), count, volume, volume_delta);
+    AXVoiceMath::AddSamples(actual.data(), scaled.data(), count);
+    for (u32 i = 0; i < count; ++i)
+      ASSERT_EQ(expected[i], actual[i]) << "test " << test << " sample " << i;
+
+    // Scaling in place gives the same results.
+    AXVoiceMath::ApplyVolume(input.data(), input.data(), count, volume, volume_delta);
+    for (u32 i = 0; i < count; ++i)
+      ASSERT_EQ(scaled[i], input[i]);
+  }
+}
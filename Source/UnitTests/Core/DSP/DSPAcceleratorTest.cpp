@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <array>
+#include <random>
 
 #include <gtest/gtest.h>
 
@@ -185,3 +186,83 @@ TEST(DSPAccelerator, CurrentAddressSkips)
   accelerator.TestRead();
   EXPECT_EQ(accelerator.GetCurrentAddress(), 0x00000013u);
 }
+
+// Accelerator backed by random ADPCM data, for comparing ReadSamples against Read.
+class MemoryAccelerator : public DSP::Accelerator
+{
+public:
+  explicit MemoryAccelerator(u32 seed)
+  {
+    std::mt19937 rng(seed);
+    for (u8& byte : m_memory)
+      byte = static_cast<u8>(rng());
+  }
+
+  u32 GetEndExceptionCount() const { return m_end_exceptions; }
+  // Allow reading again after an end exception, like the AX ucode does when a voice loops.
+  void Restart() { SetYn2(GetYn2()); }
+
+protected:
+  void OnEndException() override { ++m_end_exceptions; }
+  u8 ReadMemory(u32 address) override { return m_memory[address % m_memory.size()]; }
+  void WriteMemory(u32 address, u8 value) override {}
+
+private:
+  std::array<u8, 0x100> m_memory{};
+  u32 m_end_exceptions = 0;
+};
+
+TEST(DSPAccelerator, ReadSamplesMatchesRead)
+{
+  std::mt19937 rng(1234);
+  std::array<s16, 16> coefs;
+  for (s16& coef : coefs)
+    coef = static_cast<s16>(rng());
+  coefs[2] = -32768;
+  coefs[3] = -32768;
+
+  for (u32 test = 0; test < 2000; ++test)
+  {
+    MemoryAccelerator expected(test);
+    MemoryAccelerator actual(test);
+    const u32 start = rng() % 0x40;
+    const u32 end = start + 1 + rng() % 0x60;
+    const u32 current = start + rng() % (end - start);
+    const u16 pred_scale = static_cast<u16>(rng());
+    const s16 yn1 = static_cast<s16>(rng());
+    const s16 yn2 = static_cast<s16>(rng());
+    for (MemoryAccelerator* accelerator : {&expected, &actual})
+    {
+      accelerator->SetStartAddress(start);
+      accelerator->SetEndAddress(end);
+      accelerator->SetCurrentAddress(current);
+      accelerator->SetPredScale(pred_scale);
+      accelerator->SetYn1(yn1);
+      accelerator->SetYn2(yn2);
+    }
+
+    for (u32 block = 0; block < 4; ++block)
+    {
+      const u32 count = 1 + rng() % 96;
+      std::array<s16, 96> expected_samples;
+      std::array<s16, 96> actual_samples;
+      for (u32 i = 0; i < count; ++i)
+        expected_samples[i] = static_cast<s16>(expected.Read(coefs.data()));
+      actual.ReadSamples(coefs.data(), actual_samples.data(), count);
+
+      for (u32 i = 0; i < count; ++i)
+        ASSERT_EQ(expected_samples[i], actual_samples[i]) << "test " << test << " sample " << i;
+      ASSERT_EQ(expected.GetCurrentAddress(), actual.GetCurrentAddress());
+      ASSERT_EQ(expected.GetPredScale(), actual.GetPredScale());
+      ASSERT_EQ(expected.GetYn1(), actual.GetYn1());
+      ASSERT_EQ(expected.GetYn2(), actual.GetYn2());
+      ASSERT_EQ(expected.GetEndExceptionCount(), actual.GetEndExceptionCount());
+
+      if (rng() % 2)
+      {
+        expected.Restart();
+        actual.Restart();
+      }
+    }
+  }
+}
@@ -0,0 +1,184 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/MemoryUtil.h"
+#include "Common/MsgHandler.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCodeUtil.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPTables.h"
+#include "Core/DSP/Interpreter/DSPInterpreter.h"
+
+using namespace DSP;
+
+namespace
+{
+// Inner loops like the ones audio ucodes spend most of their time in: a ramp is written to DRAM,
+// run through a multiply-accumulate loop and copied, hardware registers are read, and a few nested
+// loops run at the end.
+constexpr char LOOPS_UCODE[] = R"(
+	lri	$AR0, #0x0000
+	clr	$ACC0
+	lri	$AX0.L, #0x100
+	bloop	$AX0.L, fill_end
+	addis	$AC0.M, #0x13
+fill_end:
+	srri	@$AR0, $AC0.M
+
+	lri	$AR0, #0x0000
+	lri	$AX1.H, #0x2000
+	clr	$ACC1
+	bloopi	#0xc0, mac_end
+	lrri	$AX0.H, @$AR0
+	mulx	$AX0.H, $AX1.H
+mac_end:
+	addp	$ACC1
+
+	lri	$AR1, #0x0100
+	loopi	#0x80
+	srri	@$AR1, $AC1.M
+
+	lri	$AR2, #0xffc9
+	loopi	#0x4
+	addax'l	$ACC0, $AX0 : $AX1.H, @$AR2
+
+	lri	$AX0.L, #0x10
+	bloop	$AX0.L, outer_end
+	loopi	#0x8
+	addis	$AC0.M, #0x1
+	lrri	$AX1.L, @$AR0
+outer_end:
+	addax	$ACC1, $AX1
+
+	halt
+)";
+
+bool AnswerNo(const char*, const char*, bool, Common::MsgType)
+{
+  return false;
+}
+
+std::unique_ptr<DSPCore> CreateCore(DSPInitOptions::CoreType core_type,
+                                    const std::vector<u16>& code)
+{
+  // The DSP ROMs are empty, so refuse to stop when their hashes are checked.
+  Common::RegisterMsgAlertHandler(AnswerNo);
+  InitInstructionTable();
+
+  DSPInitOptions opts;
+  opts.core_type = core_type;
+  auto core = std::make_unique<DSPCore>();
+  if (!core->Initialize(opts))
+    return nullptr;
+
+  auto& state = core->DSPState();
+  Common::UnWriteProtectMemory(state.iram, DSP_IRAM_BYTE_SIZE, false);
+  std::copy(code.begin(), code.end(), state.iram);
+  Common::WriteProtectMemory(state.iram, DSP_IRAM_BYTE_SIZE, false);
+  core->ClearIRAM();
+  state.GetAnalyzer().Analyze(state);
+  return core;
+}
+
+void Restart(DSPCore& core)
+{
+  auto& state = core.DSPState();
+  state.pc = 0;
+  state.control_reg &= ~CR_HALT;
+}
+
+void RunUntilHalted(DSPCore& core, int cycles_per_slice)
+{
+  while ((core.DSPState().control_reg & CR_HALT) == 0)
+    core.RunCycles(cycles_per_slice);
+}
+
+std::vector<u16> Assemble(const char* text)
+{
+  std::vector<u16> code;
+  EXPECT_TRUE(DSP::Assemble(text, code));
+  return code;
+}
+
+void ExpectSameState(const SDSP& expected, const SDSP& actual)
+{
+  for (size_t reg = 0; reg < 32; ++reg)
+  {
+    // The call stack is left differently by HALT in the JIT and the interpreter.
+    if (reg >= DSP_REG_ST0 && reg <= DSP_REG_ST3)
+      continue;
+    EXPECT_EQ(expected.ReadRegister(reg), actual.ReadRegister(reg)) << "register " << reg;
+  }
+  EXPECT_TRUE(std::equal(expected.dram, expected.dram + DSP_DRAM_SIZE, actual.dram));
+}
+}  // namespace
+
+TEST(DSPJit, LoopsMatchInterpreter)
+{
+  const std::vector<u16> code = Assemble(LOOPS_UCODE);
+  auto interpreter = CreateCore(DSPInitOptions::CoreType::Interpreter, code);
+  ASSERT_NE(interpreter, nullptr);
+  Restart(*interpreter);
+  RunUntilHalted(*interpreter, 1000);
+
+  // Small slices make loops stop in the middle because they run out of cycles.
+  for (const int cycles_per_slice : {7, 100, 1000})
+  {
+    auto jit = CreateCore(DSPInitOptions::CoreType::JIT64, code);
+    ASSERT_NE(jit, nullptr);
+    // Run twice so that the second run uses already compiled blocks.
+    for (int run = 0; run < 2; ++run)
+    {
+      Restart(*jit);
+      RunUntilHalted(*jit, cycles_per_slice);
+      ExpectSameState(interpreter->DSPState(), jit->DSPState());
+    }
+    jit->Shutdown();
+  }
+  interpreter->Shutdown();
+}
+
+TEST(DSPJit, LoopThroughput)
+{
+  // Counts the cycles of one run of the ucode, to report how many DSP cycles per second the
+  // interpreter and the JIT emulate.
+  const std::vector<u16> code = Assemble(LOOPS_UCODE);
+  auto counter = CreateCore(DSPInitOptions::CoreType::Interpreter, code);
+  ASSERT_NE(counter, nullptr);
+  Restart(*counter);
+  u64 cycles_per_run = 0;
+  while ((counter->DSPState().control_reg & CR_HALT) == 0)
+  {
+    counter->GetInterpreter().Step();
+    ++cycles_per_run;
+  }
+  counter->Shutdown();
+
+  for (const auto core_type :
+       {DSPInitOptions::CoreType::Interpreter, DSPInitOptions::CoreType::JIT64})
+  {
+    auto core = CreateCore(core_type, code);
+    ASSERT_NE(core, nullptr);
+    constexpr u32 RUNS = 2000;
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 run = 0; run < RUNS; ++run)
+    {
+      Restart(*core);
+      RunUntilHalted(*core, 1000);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    fmt::print("{}: {:.1f} million DSP cycles per second\n",
+               core_type == DSPInitOptions::CoreType::JIT64 ? "JIT" : "Interpreter",
+               RUNS * cycles_per_run / elapsed.count() / 1e6);
+    core->Shutdown();
+  }
+}
@@ -0,0 +1,298 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/ZeldaAudioMath.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+// The size of the mixing buffers of the renderer.
+constexpr size_t BUFFER_SIZE = 0x50;
+
+s16 RandomSample(std::mt19937& rng)
+{
+  // Favour the extremes, which is where overflows happen.
+  switch (rng() % 4)
+  {
+  case 0:
+    return -32768;
+  case 1:
+    return 32767;
+  default:
+    return static_cast<s16>(rng());
+  }
+}
+
+template <size_t N>
+std::array<s16, N> RandomSamples(std::mt19937& rng)
+{
+  std::array<s16, N> samples;
+  for (s16& sample : samples)
+    sample = RandomSample(rng);
+  return samples;
+}
+
+// The per-sample AFC decoder of the renderer.
+void ReferenceDecodeAFCBlock(const u8* src, s16* dst, bool high_quality, const s16* afc_coeffs,
+                             s32* yn1, s32* yn2)
+{
+  s16 nibbles[16];
+  s16 delta = 1 << ((*src >> 4) & 0xF);
+  s16 idx = (*src & 0xF);
+  src++;
+
+  if (high_quality)
+  {
+    for (size_t i = 0; i < 16; i += 2)
+    {
+      nibbles[i + 0] = *src >> 4;
+      nibbles[i + 1] = *src & 0xF;
+      src++;
+    }
+    for (auto& nibble : nibbles)
+    {
+      if (nibble >= 8)
+        nibble -= 16;
+      nibble <<= 11;
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < 16; i += 4)
+    {
+      nibbles[i + 0] = (*src >> 6) & 3;
+      nibbles[i + 1] = (*src >> 4) & 3;
+      nibbles[i + 2] = (*src >> 2) & 3;
+      nibbles[i + 3] = (*src >> 0) & 3;
+      src++;
+    }
+    for (auto& nibble : nibbles)
+    {
+      if (nibble >= 2)
+        nibble -= 4;
+      nibble <<= 13;
+    }
+  }
+
+  for (s16 nibble : nibbles)
+  {
+    s32 sample = delta * nibble + *yn1 * afc_coeffs[idx * 2] + *yn2 * afc_coeffs[idx * 2 + 1];
+    sample >>= 11;
+    sample = std::clamp(sample, -0x8000, 0x7fff);
+    *dst++ = (s16)sample;
+    *yn2 = *yn1;
+    *yn1 = sample;
+  }
+}
+}  // namespace
+
+TEST(ZeldaAudioMath, ApplyVolume)
+{
+  std::mt19937 rng(1);
+  for (u32 test = 0; test < 1000; ++test)
+  {
+    const u16 volume = static_cast<u16>(rng());
+    const u32 shift = (rng() % 2) ? 15 : 12;
+    const size_t count = rng() % (BUFFER_SIZE + 1);
+    auto actual = RandomSamples<BUFFER_SIZE>(rng);
+    auto expected = actual;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      s32 tmp = (u32)expected[i] * (u32)volume;
+      tmp >>= shift;
+      expected[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
+    }
+    ZeldaAudioMath::ApplyVolume(actual.data(), count, volume, shift);
+    ASSERT_EQ(expected, actual) << "test " << test;
+  }
+}
+
+TEST(ZeldaAudioMath, AddWithVolume)
+{
+  std::mt19937 rng(2);
+  for (u32 test = 0; test < 1000; ++test)
+  {
+    const u16 volume = static_cast<u16>(rng());
+    const size_t count = rng() % (BUFFER_SIZE + 1);
+    const auto src = RandomSamples<BUFFER_SIZE>(rng);
+    auto actual = RandomSamples<BUFFER_SIZE>(rng);
+    auto expected = actual;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      s32 vol_src = ((s32)src[i] * (s32)volume) >> 15;
+      expected[i] += std::clamp(vol_src, -0x8000, 0x7FFF);
+    }
+    ZeldaAudioMath::AddWithVolume(actual.data(), src.data(), count, volume);
+    ASSERT_EQ(expected, actual) << "test " << test;
+  }
+}
+
+TEST(ZeldaAudioMath, AddWithVolumeRamp)
+{
+  std::mt19937 rng(3);
+  for (u32 test = 0; test < 1000; ++test)
+  {
+    // Volumes and steps as computed by the renderer.
+    const s16 current_volume = static_cast<s16>(rng());
+    const s16 target_volume = static_cast<s16>(rng());
+    const s32 step = ((target_volume - current_volume) << 16) / s32(BUFFER_SIZE);
+    const auto src = RandomSamples<BUFFER_SIZE>(rng);
+    auto actual = RandomSamples<BUFFER_SIZE>(rng);
+    auto expected = actual;
+
+    s32 expected_volume = current_volume << 16;
+    for (size_t i = 0; i < BUFFER_SIZE; ++i)
+    {
+      expected[i] += ((expected_volume >> 16) * src[i]) >> 16;
+      expected_volume += step;
+    }
+    const s32 actual_volume = ZeldaAudioMath::AddWithVolumeRamp(
+        actual.data(), src.data(), BUFFER_SIZE, current_volume << 16, step);
+    ASSERT_EQ(expected, actual) << "test " << test;
+    ASSERT_EQ(expected_volume, actual_volume);
+  }
+}
+
+TEST(ZeldaAudioMath, Resample)
+{
+  std::mt19937 rng(4);
+  for (u32 test = 0; test < 1000; ++test)
+  {
+    const auto coeffs = RandomSamples<0x100>(rng);
+    const auto src = RandomSamples<0x500 + 4>(rng);
+    // Ratios up to 0x4FFF, so that both the filtered and the nearest sample paths are used.
+    const u32 ratio = rng() % 0x5000;
+    const u32 start_pos = rng() % 0x1000;
+
+    std::array<s16, BUFFER_SIZE> expected;
+    u32 expected_pos = start_pos;
+    if ((ratio >> 12) >= 4)
+    {
+      for (s16& dst_sample : expected)
+      {
+        expected_pos += ratio;
+        dst_sample = src[expected_pos >> 12];
+      }
+    }
+    else
+    {
+      for (s16& dst_sample : expected)
+      {
+        const s16* c = &coeffs[((expected_pos & 0xFFF) >> 6) * 4];
+        const s16* input = &src[expected_pos >> 12];
+        s64 dst_sample_unclamped = 0;
+        for (size_t i = 0; i < 4; ++i)
+          dst_sample_unclamped += (s64)2 * c[i] * input[i];
+        dst_sample_unclamped >>= 16;
+        dst_sample = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
+        expected_pos += ratio;
+      }
+    }
+
+    std::array<s16, BUFFER_SIZE> actual;
+    const u32 actual_pos = ZeldaAudioMath::Resample(src.data(), actual.data(), BUFFER_SIZE,
+                                                    start_pos, ratio, coeffs.data());
+    ASSERT_EQ(expected, actual) << "test " << test;
+    ASSERT_EQ(expected_pos, actual_pos);
+  }
+}
+
+TEST(ZeldaAudioMath, FilterReverb)
+{
+  std::mt19937 rng(5);
+  for (u32 test = 0; test < 1000; ++test)
+  {
+    const auto coeffs = RandomSamples<8>(rng);
+    auto actual = RandomSamples<BUFFER_SIZE + 8>(rng);
+    auto expected = actual;
+
+    for (size_t i = 0; i < BUFFER_SIZE; ++i)
+    {
+      u32 sample = 0;
+      for (size_t j = 0; j < 8; ++j)
+        sample += static_cast<u32>((s32)expected[i + j] * coeffs[j]);
+      expected[i] = static_cast<s16>(std::clamp(static_cast<s32>(sample) >> 15, -0x8000, 0x7FFF));
+    }
+    ZeldaAudioMath::FilterReverb(actual.data(), BUFFER_SIZE, coeffs.data());
+    ASSERT_EQ(expected, actual) << "test " << test;
+  }
+}
+
+TEST(ZeldaAudioMath, DecodeAFCBlock)
+{
+  std::mt19937 rng(6);
+  for (u32 test = 0; test < 1000; ++test)
+  {
+    const bool high_quality = rng() % 2;
+    const auto afc_coeffs = RandomSamples<0x20>(rng);
+    // A stream of blocks, decoded one after the other like a voice does.
+    std::array<u8, 9 * 8> blocks;
+    for (u8& byte : blocks)
+      byte = static_cast<u8>(rng());
+
+    s32 expected_yn1 = RandomSample(rng), expected_yn2 = RandomSample(rng);
+    s32 actual_yn1 = expected_yn1, actual_yn2 = expected_yn2;
+    const size_t block_size = high_quality ? 9 : 5;
+    for (size_t offset = 0; offset + block_size <= blocks.size(); offset += block_size)
+    {
+      std::array<s16, 16> expected, actual;
+      ReferenceDecodeAFCBlock(&blocks[offset], expected.data(), high_quality, afc_coeffs.data(),
+                              &expected_yn1, &expected_yn2);
+      ZeldaAudioMath::DecodeAFCBlock(&blocks[offset], actual.data(), high_quality,
+                                     afc_coeffs.data(), &actual_yn1, &actual_yn2);
+      ASSERT_EQ(expected, actual) << "test " << test << " offset " << offset;
+      ASSERT_EQ(expected_yn1, actual_yn1);
+      ASSERT_EQ(expected_yn2, actual_yn2);
+    }
+  }
+}
+
+TEST(ZeldaAudioMath, VoiceThroughput)
+{
+  // Renders voices like an AFC voice mixed to 6 buffers does, to measure how many voices can be
+  // rendered per millisecond.
+  std::mt19937 rng(7);
+  const auto afc_coeffs = RandomSamples<0x20>(rng);
+  const auto resampling_coeffs = RandomSamples<0x100>(rng);
+  std::array<u8, 9 * 8> blocks;
+  for (u8& byte : blocks)
+    byte = static_cast<u8>(rng());
+  std::array<std::array<s16, BUFFER_SIZE>, 6> mixing_buffers{};
+
+  constexpr u32 VOICES = 100000;
+  const auto start = std::chrono::steady_clock::now();
+  s32 yn1 = 0, yn2 = 0;
+  for (u32 voice = 0; voice < VOICES; ++voice)
+  {
+    std::array<s16, 4 + 8 * 16> raw_samples{};
+    for (size_t b = 0; b < 6; ++b)
+    {
+      ZeldaAudioMath::DecodeAFCBlock(&blocks[b * 9], &raw_samples[4 + b * 16], true,
+                                     afc_coeffs.data(), &yn1, &yn2);
+    }
+
+    std::array<s16, BUFFER_SIZE> input;
+    ZeldaAudioMath::Resample(raw_samples.data(), input.data(), BUFFER_SIZE, voice & 0xFFF, 0x1234,
+                             resampling_coeffs.data());
+    for (auto& buffer : mixing_buffers)
+    {
+      ZeldaAudioMath::AddWithVolumeRamp(buffer.data(), input.data(), BUFFER_SIZE, 0x40000000,
+                                        -0x100);
+    }
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  fmt::print("{:.1f} voices per millisecond\n", VOICES / elapsed.count());
+}
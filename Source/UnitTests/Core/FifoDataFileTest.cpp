@@ -0,0 +1,150 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "UICommon/UICommon.h"
+
+class FifoDataFileTest : public testing::Test
+{
+protected:
+  FifoDataFileTest() : m_profile_path(File::CreateTempDir())
+  {
+    if (!m_profile_path.empty())
+      UICommon::SetUserDirectory(m_profile_path);
+  }
+
+  ~FifoDataFileTest() override
+  {
+    if (!m_profile_path.empty())
+      File::DeleteDirRecursively(m_profile_path);
+  }
+
+  void SetUp() override { ASSERT_FALSE(m_profile_path.empty()); }
+
+  static std::vector<FifoFrameInfo> MakeFrames(u32 count)
+  {
+    std::mt19937 rng(0);
+    std::vector<FifoFrameInfo> frames(count);
+    for (u32 i = 0; i < count; ++i)
+    {
+      FifoFrameInfo& frame = frames[i];
+      frame.fifoStart = 0x100000 * i;
+      frame.fifoEnd = frame.fifoStart + 0x40000;
+
+      // Repetitive command data, which compresses well.
+      for (u32 j = 0; j < 1000 + i; ++j)
+        frame.fifoData.insert(frame.fifoData.end(), {0x61, 0x28, 0x00, 0x00, u8(j)});
+
+      for (u32 j = 0; j < i; ++j)
+      {
+        MemoryUpdate update;
+        update.fifoPosition = j * 5;
+        update.address = 0x80000000 + 0x1000 * j;
+        update.type = MemoryUpdate::TEXTURE_MAP;
+        // Random texture data, which doesn't.
+        update.data.resize(0x800 * (j + 1));
+        for (u8& byte : update.data)
+          byte = static_cast<u8>(rng());
+        frame.memoryUpdates.push_back(std::move(update));
+      }
+    }
+    return frames;
+  }
+
+  static std::unique_ptr<FifoDataFile> Record(const std::vector<FifoFrameInfo>& frames)
+  {
+    std::unique_ptr<FifoDataFile> file = FifoDataFile::CreateForRecording();
+    if (!file)
+      return nullptr;
+
+    file->SetIsWii(true);
+    file->GetBPMem()[0x28] = 0x12345678;
+    file->GetTexMem()[0x1234] = 0x56;
+    for (const FifoFrameInfo& frame : frames)
+      file->AddFrame(frame);
+    return file;
+  }
+
+  static void ExpectSameFrames(const FifoDataFile& file, const std::vector<FifoFrameInfo>& frames)
+  {
+    ASSERT_EQ(file.GetFrameCount(), frames.size());
+    for (u32 i = 0; i < frames.size(); ++i)
+    {
+      const std::unique_ptr<FifoFrameInfo> frame = file.ReadFrame(i);
+      ASSERT_TRUE(frame);
+      EXPECT_EQ(frame->fifoData, frames[i].fifoData);
+      EXPECT_EQ(frame->fifoStart, frames[i].fifoStart);
+      EXPECT_EQ(frame->fifoEnd, frames[i].fifoEnd);
+
+      ASSERT_EQ(frame->memoryUpdates.size(), frames[i].memoryUpdates.size());
+      for (size_t j = 0; j < frames[i].memoryUpdates.size(); ++j)
+      {
+        EXPECT_EQ(frame->memoryUpdates[j].fifoPosition, frames[i].memoryUpdates[j].fifoPosition);
+        EXPECT_EQ(frame->memoryUpdates[j].address, frames[i].memoryUpdates[j].address);
+        EXPECT_EQ(frame->memoryUpdates[j].type, frames[i].memoryUpdates[j].type);
+        EXPECT_EQ(frame->memoryUpdates[j].data, frames[i].memoryUpdates[j].data);
+      }
+    }
+    EXPECT_FALSE(file.ReadFrame(static_cast<u32>(frames.size())));
+  }
+
+  std::string m_profile_path;
+};
+
+TEST_F(FifoDataFileTest, RecordAndLoad)
+{
+  const std::vector<FifoFrameInfo> frames = MakeFrames(5);
+  std::unique_ptr<FifoDataFile> recording = Record(frames);
+  ASSERT_TRUE(recording);
+
+  EXPECT_EQ(recording->GetFrameCount(), frames.size());
+  // Frames of a recording are only written to disk, and can't be read back until it is loaded.
+  EXPECT_FALSE(recording->ReadFrame(0));
+
+  const std::string path = m_profile_path + "/test.dff";
+  ASSERT_TRUE(recording->Save(path));
+
+  const std::unique_ptr<FifoDataFile> loaded = FifoDataFile::Load(path, false);
+  ASSERT_TRUE(loaded);
+  EXPECT_TRUE(loaded->GetIsWii());
+  EXPECT_EQ(loaded->GetBPMem()[0x28], 0x12345678u);
+  EXPECT_EQ(loaded->GetTexMem()[0x1234], 0x56);
+  EXPECT_EQ(loaded->GetFifoDataSize(), recording->GetFifoDataSize());
+  EXPECT_EQ(loaded->GetMemoryUpdateDataSize(), recording->GetMemoryUpdateDataSize());
+  ExpectSameFrames(*loaded, frames);
+
+  // Frames can be read in any order.
+  const std::unique_ptr<FifoFrameInfo> frame = loaded->ReadFrame(2);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->fifoData, frames[2].fifoData);
+}
+
+TEST_F(FifoDataFileTest, SaveTwice)
+{
+  const std::vector<FifoFrameInfo> frames = MakeFrames(3);
+  std::unique_ptr<FifoDataFile> recording = Record(frames);
+  ASSERT_TRUE(recording);
+
+  const std::string first_path = m_profile_path + "/first.dff";
+  const std::string second_path = m_profile_path + "/second.dff";
+  ASSERT_TRUE(recording->Save(first_path));
+  ASSERT_TRUE(recording->Save(second_path));
+  recording.reset();
+
+  // Neither file belongs to the recording anymore once it has been saved.
+  for (const std::string& path : {first_path, second_path})
+  {
+    const std::unique_ptr<FifoDataFile> loaded = FifoDataFile::Load(path, false);
+    ASSERT_TRUE(loaded);
+    ExpectSameFrames(*loaded, frames);
+  }
+}
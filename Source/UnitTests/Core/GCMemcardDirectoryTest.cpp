@@ -0,0 +1,149 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Swap.h"
+#include "Core/HW/EXI/EXI.h"
+#include "Core/HW/GCMemcard/GCMemcard.h"
+#include "Core/HW/GCMemcard/GCMemcardDirectory.h"
+
+namespace
+{
+constexpr u32 GAME_ID = 0x47414C45;  // GALE
+
+void WriteGCI(const std::string& path, u32 game_id, u16 block_count, u8 fill)
+{
+  Memcard::DEntry header;
+  const u32 gamecode = Common::swap32(game_id);
+  std::memcpy(header.m_gamecode.data(), &gamecode, sizeof(gamecode));
+  header.m_makercode = {'0', '1'};
+  header.m_filename = {};
+  std::memcpy(header.m_filename.data(), "save", 4);
+  header.m_block_count = block_count;
+
+  File::IOFile file(path, "wb");
+  file.WriteBytes(&header, Memcard::DENTRY_SIZE);
+  const std::vector<u8> data(block_count * Memcard::BLOCK_SIZE, fill);
+  file.WriteBytes(data.data(), data.size());
+}
+
+std::vector<u8> ReadFile(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  std::vector<u8> data(file.GetSize());
+  file.ReadBytes(data.data(), data.size());
+  return data;
+}
+}  // namespace
+
+class GCMemcardDirectoryTest : public testing::Test
+{
+protected:
+  GCMemcardDirectoryTest() : m_directory{File::CreateTempDir() + DIR_SEP}
+  {
+    Config::Init();
+    Memcard::InitializeHeaderData(&m_header_data, {}, Memcard::MBIT_SIZE_MEMORY_CARD_2043, false,
+                                  0, 0, 0);
+  }
+
+  ~GCMemcardDirectoryTest()
+  {
+    File::DeleteDirRecursively(m_directory);
+    Config::Shutdown();
+  }
+
+  std::optional<u16> FindFirstBlock(GCMemcardDirectory& card, u32 game_id)
+  {
+    Memcard::Directory directory;
+    card.Read(Memcard::BLOCK_SIZE, Memcard::BLOCK_SIZE, reinterpret_cast<u8*>(&directory));
+    for (const Memcard::DEntry& entry : directory.m_dir_entries)
+    {
+      if (Common::swap32(entry.m_gamecode.data()) == game_id)
+        return entry.m_first_block;
+    }
+    return std::nullopt;
+  }
+
+  std::string m_directory;
+  Memcard::HeaderData m_header_data;
+};
+
+TEST_F(GCMemcardDirectoryTest, OnlyModifiedBlocksAreWritten)
+{
+  constexpr u16 BLOCK_COUNT = 4;
+  const std::string path = m_directory + "01-GALE-save.gci";
+  WriteGCI(path, GAME_ID, BLOCK_COUNT, 0x11);
+
+  {
+    GCMemcardDirectory card(m_directory, ExpansionInterface::Slot::A, m_header_data, GAME_ID);
+    const std::optional<u16> first_block = FindFirstBlock(card, GAME_ID);
+    ASSERT_TRUE(first_block);
+
+    // Change the last block on disk behind the card's back. It must not be overwritten by the
+    // flush, as the game didn't write to it.
+    {
+      File::IOFile file(path, "r+b");
+      file.Seek(Memcard::DENTRY_SIZE + (BLOCK_COUNT - 1) * Memcard::BLOCK_SIZE,
+                File::SeekOrigin::Begin);
+      const std::vector<u8> block(Memcard::BLOCK_SIZE, 0x33);
+      file.WriteBytes(block.data(), block.size());
+    }
+
+    const std::array<u8, 0x80> data{0x22, 0x22, 0x22, 0x22};
+    card.Write(*first_block * Memcard::BLOCK_SIZE + 0x100, static_cast<s32>(data.size()),
+               data.data());
+  }
+
+  const std::vector<u8> contents = ReadFile(path);
+  ASSERT_EQ(Memcard::DENTRY_SIZE + BLOCK_COUNT * Memcard::BLOCK_SIZE, contents.size());
+  const u8* const first_block = &contents[Memcard::DENTRY_SIZE];
+  EXPECT_EQ(0x11, first_block[0xff]);
+  EXPECT_EQ(0x22, first_block[0x100]);
+  EXPECT_EQ(0x00, first_block[0x104]);
+  EXPECT_EQ(0x11, first_block[0x180]);
+  const u8* const last_block = first_block + (BLOCK_COUNT - 1) * Memcard::BLOCK_SIZE;
+  EXPECT_TRUE(std::all_of(last_block, last_block + Memcard::BLOCK_SIZE,
+                          [](u8 value) { return value == 0x33; }));
+}
+
+TEST_F(GCMemcardDirectoryTest, InitTime)
+{
+  // Saves of other games are only indexed when the card is created, and read when accessed.
+  constexpr u32 FILES = 300;
+  for (u32 i = 0; i < FILES; ++i)
+  {
+    WriteGCI(fmt::format("{}01-G{:03}-save.gci", m_directory, i), 0x47303030 + i, 2,
+             static_cast<u8>(i));
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  GCMemcardDirectory card(m_directory, ExpansionInterface::Slot::A, m_header_data, GAME_ID);
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  fmt::print("Creating a card from {} GCI files took {:.2f} ms\n", FILES, elapsed.count());
+
+  for (u32 i = 0; i < 10; ++i)
+  {
+    const std::optional<u16> first_block = FindFirstBlock(card, 0x47303030 + i);
+    if (!first_block)
+      continue;
+    std::array<u8, 0x200> data;
+    card.Read(*first_block * Memcard::BLOCK_SIZE, static_cast<s32>(data.size()), data.data());
+    EXPECT_TRUE(std::all_of(data.begin(), data.end(), [i](u8 value) { return value == i; }));
+  }
+}
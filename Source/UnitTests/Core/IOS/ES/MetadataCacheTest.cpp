@@ -0,0 +1,163 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Swap.h"
+#include "Core/IOS/ES/ES.h"
+#include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/IOS.h"
+#include "Core/IOS/IOSC.h"
+#include "UICommon/UICommon.h"
+
+#include "TestBinaryData.h"
+
+using IOS::HLE::ESDevice;
+
+namespace
+{
+// An unsigned ticket which only has what ES checks when signature checks are disabled.
+std::vector<u8> CreateTicket(u64 title_id)
+{
+  std::vector<u8> ticket(sizeof(IOS::ES::Ticket));
+  const u32 signature_type = Common::swap32(static_cast<u32>(IOS::SignatureType::RSA2048));
+  std::memcpy(ticket.data(), &signature_type, sizeof(signature_type));
+  const u64 swapped_title_id = Common::swap64(title_id);
+  std::memcpy(&ticket[offsetof(IOS::ES::Ticket, title_id)], &swapped_title_id,
+              sizeof(swapped_title_id));
+  return ticket;
+}
+
+std::vector<u8> CreateTMD(u64 title_id)
+{
+  std::vector<u8> tmd(soup01_tmd.cbegin(), soup01_tmd.cend());
+  const u64 swapped_title_id = Common::swap64(title_id);
+  std::memcpy(&tmd[offsetof(IOS::ES::TMDHeader, title_id)], &swapped_title_id,
+              sizeof(swapped_title_id));
+  return tmd;
+}
+
+bool Contains(const std::vector<u64>& titles, u64 title_id)
+{
+  return std::find(titles.begin(), titles.end(), title_id) != titles.end();
+}
+}  // namespace
+
+class ESMetadataCacheTest : public testing::Test
+{
+protected:
+  ESMetadataCacheTest() : m_profile_path{File::CreateTempDir()}
+  {
+    if (UserDirectoryCreationFailed())
+      return;
+    UICommon::SetUserDirectory(m_profile_path);
+    m_ios = std::make_unique<IOS::HLE::Kernel>();
+    m_es = m_ios->GetES();
+  }
+
+  virtual ~ESMetadataCacheTest()
+  {
+    if (UserDirectoryCreationFailed())
+      return;
+    m_es.reset();
+    m_ios.reset();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  void SetUp()
+  {
+    if (UserDirectoryCreationFailed())
+      FAIL();
+  }
+
+  bool UserDirectoryCreationFailed() const { return m_profile_path.empty(); }
+
+  void InstallTitle(u64 title_id)
+  {
+    ASSERT_EQ(IOS::HLE::IPC_SUCCESS,
+              m_es->ImportTicket(CreateTicket(title_id), {},
+                                 ESDevice::TicketImportType::Unpersonalised,
+                                 ESDevice::VerifySignature::No));
+    ESDevice::Context context;
+    ASSERT_EQ(IOS::HLE::IPC_SUCCESS, m_es->ImportTitleInit(context, CreateTMD(title_id), {},
+                                                           ESDevice::VerifySignature::No));
+    ASSERT_EQ(IOS::HLE::IPC_SUCCESS, m_es->ImportTitleDone(context));
+  }
+
+  std::unique_ptr<IOS::HLE::Kernel> m_ios;
+  std::shared_ptr<ESDevice> m_es;
+
+private:
+  std::string m_profile_path;
+};
+
+TEST_F(ESMetadataCacheTest, InstallAndDelete)
+{
+  constexpr u64 TITLE_ID = 0x0001000144454d4f;
+
+  // Fill the cache with the title being missing.
+  EXPECT_FALSE(Contains(m_es->GetInstalledTitles(), TITLE_ID));
+  EXPECT_FALSE(Contains(m_es->GetTitlesWithTickets(), TITLE_ID));
+  EXPECT_FALSE(m_es->FindInstalledTMD(TITLE_ID).IsValid());
+  EXPECT_FALSE(m_es->FindSignedTicket(TITLE_ID).IsValid());
+
+  InstallTitle(TITLE_ID);
+  EXPECT_TRUE(Contains(m_es->GetInstalledTitles(), TITLE_ID));
+  EXPECT_TRUE(Contains(m_es->GetTitlesWithTickets(), TITLE_ID));
+  const IOS::ES::TMDReader tmd = m_es->FindInstalledTMD(TITLE_ID);
+  ASSERT_TRUE(tmd.IsValid());
+  EXPECT_EQ(CreateTMD(TITLE_ID), tmd.GetBytes());
+  const IOS::ES::TicketReader ticket = m_es->FindSignedTicket(TITLE_ID);
+  ASSERT_TRUE(ticket.IsValid());
+  EXPECT_EQ(TITLE_ID, ticket.GetTitleId());
+
+  ASSERT_EQ(IOS::HLE::IPC_SUCCESS, m_es->DeleteTitle(TITLE_ID));
+  EXPECT_FALSE(Contains(m_es->GetInstalledTitles(), TITLE_ID));
+  EXPECT_FALSE(m_es->FindInstalledTMD(TITLE_ID).IsValid());
+
+  ASSERT_EQ(IOS::HLE::IPC_SUCCESS, m_es->DeleteTicket(ticket.GetRawTicketView(0).data()));
+  EXPECT_FALSE(Contains(m_es->GetTitlesWithTickets(), TITLE_ID));
+  EXPECT_FALSE(m_es->FindSignedTicket(TITLE_ID).IsValid());
+}
+
+TEST_F(ESMetadataCacheTest, EnumerationTime)
+{
+  // What the System Menu does for every title when it boots.
+  constexpr u64 FIRST_TITLE_ID = 0x0001000100000000;
+  constexpr u32 TITLES = 50;
+  for (u32 i = 0; i < TITLES; ++i)
+    InstallTitle(FIRST_TITLE_ID + i);
+
+  const auto enumerate = [&] {
+    const auto start = std::chrono::steady_clock::now();
+    u32 count = 0;
+    for (const u64 title_id : m_es->GetInstalledTitles())
+    {
+      const IOS::ES::TMDReader tmd = m_es->FindInstalledTMD(title_id);
+      if (tmd.IsValid() && m_es->FindSignedTicket(title_id).IsValid())
+      {
+        m_es->GetStoredContentsFromTMD(tmd);
+        ++count;
+      }
+    }
+    EXPECT_EQ(TITLES, count);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  };
+
+  const double cold = enumerate();
+  const double warm = enumerate();
+  fmt::print("Enumerating {} titles: {:.2f} ms uncached, {:.2f} ms cached\n", TITLES, cold, warm);
+}
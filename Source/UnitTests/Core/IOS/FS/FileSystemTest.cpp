@@ -3,15 +3,19 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <string>
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "Core/IOS/FS/FileSystem.h"
+#include "Core/IOS/FS/HostBackend/FS.h"
 #include "Core/IOS/IOS.h"
 #include "UICommon/UICommon.h"
 
@@ -417,6 +421,50 @@ TEST_F(FileSystemTest, MultipleHandles)
   EXPECT_EQ(TEST_DATA, read_buffer);
 }
 
+TEST_F(FileSystemTest, SmallReadsAndWritesAreCached)
+{
+  const std::string PATH = "/tmp/f";
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, PATH, 0, modes), ResultCode::Success);
+
+  std::vector<u8> data(0x20000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<u8>(i * 7);
+
+  {
+    const Result<FileHandle> writer = m_fs->OpenFile(Uid{0}, Gid{0}, PATH, Mode::Write);
+    const Result<FileHandle> reader = m_fs->OpenFile(Uid{0}, Gid{0}, PATH, Mode::Read);
+    ASSERT_TRUE(writer.Succeeded());
+    ASSERT_TRUE(reader.Succeeded());
+
+    // Data which has not been written back yet must be visible through the other handle.
+    std::array<u8, 0x10> buffer;
+    for (size_t offset = 0; offset < data.size(); offset += buffer.size())
+    {
+      for (size_t i = 0; i < buffer.size(); ++i)
+        ASSERT_TRUE(writer->Write(&data[offset + i], 1).Succeeded());
+      ASSERT_TRUE(reader->Read(buffer.data(), buffer.size()).Succeeded());
+      ASSERT_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin() + offset)) << offset;
+    }
+
+    const Result<Metadata> metadata = m_fs->GetMetadata(Uid{0}, Gid{0}, PATH);
+    ASSERT_TRUE(metadata.Succeeded());
+    EXPECT_EQ(metadata->size, data.size());
+  }
+
+  // Everything was written back when the file was closed.
+  std::string host_data;
+  ASSERT_TRUE(File::ReadFileToString(File::GetUserPath(D_SESSION_WIIROOT_IDX) + PATH, host_data));
+  EXPECT_TRUE(std::equal(host_data.begin(), host_data.end(), data.begin(), data.end(),
+                         [](char a, u8 b) { return static_cast<u8>(a) == b; }));
+
+  const auto* host_fs = dynamic_cast<HostFileSystem*>(m_fs.get());
+  ASSERT_NE(host_fs, nullptr);
+  const HostFileSystem::IOStats& stats = host_fs->GetIOStats();
+  EXPECT_EQ(stats.write_requests, data.size());
+  EXPECT_LE(stats.host_writes * 100, stats.write_requests);
+  EXPECT_LE(stats.host_reads * 100, stats.read_requests * 10);
+}
+
 // ReadDirectory is used by official titles to determine whether a path is a file.
 // If it is not a file, ResultCode::Invalid must be returned.
 TEST_F(FileSystemTest, ReadDirectoryOnFile)
@@ -469,3 +517,114 @@ TEST_F(FileSystemTest, CreateFullPath)
   EXPECT_EQ(m_fs->CreateFullPath(Uid{0x1000}, Gid{1}, "/shared2/wc24/mbox/Readme.txt", 0, modes),
             ResultCode::Success);
 }
+
+TEST_F(FileSystemTest, FstIsSavedAcrossInstances)
+{
+  constexpr Modes other_modes{Mode::Read, Mode::Read, Mode::None};
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/d", 0, modes), ResultCode::Success);
+  for (const std::string name : {"c", "a", "b"})
+    ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/d/" + name, 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->SetMetadata(Uid{0}, "/tmp/d/a", Uid{0x1000}, Gid{1}, 2, other_modes),
+            ResultCode::Success);
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/d/c"), ResultCode::Success);
+  ASSERT_EQ(m_fs->Rename(Uid{0}, Gid{0}, "/tmp/d", "/tmp/e"), ResultCode::Success);
+
+  const auto check = [&other_modes](FileSystem& fs) {
+    const Result<std::vector<std::string>> files = fs.ReadDirectory(Uid{0}, Gid{0}, "/tmp/e");
+    ASSERT_TRUE(files.Succeeded());
+    EXPECT_EQ(*files, (std::vector<std::string>{"b", "a"}));
+
+    const Result<Metadata> metadata = fs.GetMetadata(Uid{0}, Gid{0}, "/tmp/e/a");
+    ASSERT_TRUE(metadata.Succeeded());
+    EXPECT_EQ(metadata->uid, 0x1000u);
+    EXPECT_EQ(metadata->gid, 1);
+    EXPECT_EQ(metadata->attribute, 2);
+    EXPECT_EQ(metadata->modes, other_modes);
+  };
+
+  // Another instance sees the changes while this one is still alive...
+  check(*MakeFileSystem());
+  // ...and after this one is destroyed.
+  m_fs.reset();
+  m_fs = MakeFileSystem();
+  check(*m_fs);
+}
+
+TEST_F(FileSystemTest, FstJournalIsReplayedOverCorruptFst)
+{
+  constexpr Modes other_modes{Mode::Read, Mode::Read, Mode::None};
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/d", 0, modes), ResultCode::Success);
+  // Write the FST file, so that the following changes only go to the journal.
+  m_fs.reset();
+  m_fs = MakeFileSystem();
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/d/a", 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->SetMetadata(Uid{0}, "/tmp/d/a", Uid{0x1000}, Gid{1}, 2, other_modes),
+            ResultCode::Success);
+
+  // An entry with more children than there are entries.
+  {
+    File::IOFile fst(File::GetUserPath(D_SESSION_WIIROOT_IDX) + "/fst.bin", "wb");
+    const std::array<u8, 0x20> entry{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+    ASSERT_TRUE(fst.WriteArray(&entry, 1));
+  }
+
+  const auto check = [&other_modes](FileSystem& fs) {
+    const Result<Metadata> metadata = fs.GetMetadata(Uid{0}, Gid{0}, "/tmp/d/a");
+    ASSERT_TRUE(metadata.Succeeded());
+    EXPECT_EQ(metadata->uid, 0x1000u);
+    EXPECT_EQ(metadata->gid, 1);
+    EXPECT_EQ(metadata->attribute, 2);
+    EXPECT_EQ(metadata->modes, other_modes);
+  };
+
+  {
+    const std::unique_ptr<FileSystem> fs = MakeFileSystem();
+    check(*fs);
+    // New changes are appended to the journal rather than replacing it.
+    ASSERT_EQ(fs->CreateFile(Uid{0}, Gid{0}, "/tmp/d/b", 0, modes), ResultCode::Success);
+    check(*MakeFileSystem());
+  }
+  check(*MakeFileSystem());
+}
+
+TEST_F(FileSystemTest, MetadataStress)
+{
+  constexpr u32 NUM_DIRECTORIES = 20;
+  constexpr u32 NUM_FILES = 100;
+  for (u32 i = 0; i < NUM_DIRECTORIES; ++i)
+  {
+    ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, fmt::format("/tmp/{}", i), 0, modes),
+              ResultCode::Success);
+  }
+
+  // Games create, check and delete many files in their save directories.
+  u32 num_ops = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (u32 i = 0; i < NUM_DIRECTORIES; ++i)
+  {
+    for (u32 j = 0; j < NUM_FILES; ++j, ++num_ops)
+    {
+      ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, fmt::format("/tmp/{}/{}", i, j), 0, modes),
+                ResultCode::Success);
+    }
+    for (u32 j = 0; j < NUM_FILES; ++j, ++num_ops)
+      ASSERT_TRUE(m_fs->GetMetadata(Uid{0}, Gid{0}, fmt::format("/tmp/{}/{}", i, j)).Succeeded());
+    for (u32 j = 0; j < NUM_FILES; ++j, ++num_ops)
+    {
+      ASSERT_EQ(m_fs->SetMetadata(Uid{0}, fmt::format("/tmp/{}/{}", i, j), Uid{0}, Gid{1}, 0,
+                                  modes),
+                ResultCode::Success);
+    }
+  }
+  for (u32 i = 0; i < NUM_DIRECTORIES; ++i)
+  {
+    for (u32 j = 0; j < NUM_FILES; ++j, ++num_ops)
+    {
+      ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, fmt::format("/tmp/{}/{}", i, j)),
+                ResultCode::Success);
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  fmt::print("{} metadata operations: {:.0f} ops/s\n", num_ops, num_ops / elapsed.count());
+}
@@ -0,0 +1,206 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/Movie.h"
+#include "Core/MovieInputLog.h"
+
+using Movie::DTMHeader;
+using Movie::InputLog;
+
+class MovieInputLogTest : public testing::Test
+{
+protected:
+  MovieInputLogTest() : m_temp_path(File::CreateTempDir()) {}
+
+  ~MovieInputLogTest() override
+  {
+    if (!m_temp_path.empty())
+      File::DeleteDirRecursively(m_temp_path);
+  }
+
+  void SetUp() override { ASSERT_FALSE(m_temp_path.empty()); }
+
+  static DTMHeader MakeHeader()
+  {
+    DTMHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.frameCount = 1234;
+    return header;
+  }
+
+  // Records the given number of frames, with one byte of input per frame.
+  static void Record(InputLog& log, u64 first_frame, u64 frame_count, u8 value)
+  {
+    for (u64 frame = first_frame; frame < first_frame + frame_count; ++frame)
+    {
+      log.Truncate(frame, frame);
+      const u8 input = static_cast<u8>(value + frame);
+      log.Append(&input, 1);
+      log.MarkFrame(frame + 1, {frame + 1, frame + 1, 0});
+    }
+  }
+
+  static std::vector<u8> GetData(const InputLog& log)
+  {
+    return {log.GetData(), log.GetData() + log.GetSize()};
+  }
+
+  std::string m_temp_path;
+};
+
+TEST_F(MovieInputLogTest, FrameIndex)
+{
+  InputLog log;
+  Record(log, 0, 100, 0);
+  EXPECT_EQ(log.GetSize(), 100u);
+  EXPECT_EQ(log.GetIndexedFrameCount(), 101u);
+  EXPECT_EQ(log.GetFrame(0)->input_offset, 0u);
+  EXPECT_EQ(log.GetFrame(42)->input_offset, 42u);
+  EXPECT_FALSE(log.GetFrame(101));
+
+  // Rerecording from frame 50 drops everything after it.
+  Record(log, 50, 10, 100);
+  EXPECT_EQ(log.GetSize(), 60u);
+  EXPECT_EQ(log.GetIndexedFrameCount(), 61u);
+  EXPECT_EQ(log.GetData()[49], 49);
+  EXPECT_EQ(log.GetData()[50], 150);
+}
+
+TEST_F(MovieInputLogTest, Checkpoints)
+{
+  InputLog log;
+  Record(log, 0, 100, 0);
+  log.AddCheckpoint({30, 30});
+  log.AddCheckpoint({60, 60});
+
+  EXPECT_FALSE(log.FindCheckpoint(29));
+  EXPECT_EQ(log.FindCheckpoint(30)->frame, 30u);
+  EXPECT_EQ(log.FindCheckpoint(59)->frame, 30u);
+  EXPECT_EQ(log.FindCheckpoint(1000)->frame, 60u);
+
+  // Checkpoints after the point that is rerecorded from no longer belong to the movie.
+  Record(log, 45, 10, 100);
+  EXPECT_EQ(log.FindCheckpoint(1000)->frame, 30u);
+
+  // The same goes for checkpoints of frames that turn out to differ from the index.
+  log.MarkFrame(20, {19, 19, 1});
+  EXPECT_FALSE(log.FindCheckpoint(1000));
+  EXPECT_EQ(log.GetIndexedFrameCount(), 21u);
+}
+
+TEST_F(MovieInputLogTest, SaveAndLoad)
+{
+  InputLog log;
+  Record(log, 0, 100, 0);
+  log.AddCheckpoint({30, 30});
+
+  const std::string dti_path = m_temp_path + "/movie.dti";
+  const std::string dtm_path = m_temp_path + "/movie.dtm";
+  ASSERT_TRUE(log.SaveDTI(dti_path, MakeHeader()));
+  ASSERT_TRUE(log.SaveDTM(dtm_path, MakeHeader()));
+
+  DTMHeader header;
+  InputLog dti;
+  ASSERT_TRUE(dti.Load(dti_path, &header));
+  EXPECT_TRUE(InputLog::IsDTIHeader(header));
+  EXPECT_EQ(header.frameCount, 1234u);
+  EXPECT_EQ(GetData(dti), GetData(log));
+  EXPECT_EQ(dti.GetIndexedFrameCount(), 101u);
+  EXPECT_EQ(dti.GetFrame(77), log.GetFrame(77));
+  EXPECT_EQ(dti.GetCheckpoints(), log.GetCheckpoints());
+
+  // DTM files have the same input, but no index.
+  InputLog dtm;
+  ASSERT_TRUE(dtm.Load(dtm_path, &header));
+  EXPECT_TRUE(InputLog::IsDTMHeader(header));
+  EXPECT_EQ(File::GetSize(dtm_path), sizeof(DTMHeader) + 100);
+  EXPECT_EQ(GetData(dtm), GetData(log));
+  EXPECT_EQ(dtm.GetIndexedFrameCount(), 1u);
+  EXPECT_TRUE(dtm.GetCheckpoints().empty());
+}
+
+TEST_F(MovieInputLogTest, Streaming)
+{
+  const std::string path = m_temp_path + "/stream.dti";
+
+  InputLog log;
+  Record(log, 0, 10, 0);
+  ASSERT_TRUE(log.StartStreaming(path, MakeHeader()));
+  Record(log, 10, 90, 0);
+  Record(log, 80, 10, 100);
+
+  // A stream that was cut off before its footer was written can still be loaded, just without
+  // its index.
+  ASSERT_TRUE(log.StopStreaming(MakeHeader()));
+  {
+    File::IOFile file(path, "r+b");
+    ASSERT_TRUE(file.Resize(sizeof(DTMHeader) + log.GetSize()));
+  }
+  {
+    DTMHeader header;
+    InputLog unfinished;
+    ASSERT_TRUE(unfinished.Load(path, &header));
+    EXPECT_EQ(GetData(unfinished), GetData(log));
+    EXPECT_EQ(unfinished.GetIndexedFrameCount(), 1u);
+  }
+
+  ASSERT_TRUE(log.StartStreaming(path, MakeHeader()));
+  Record(log, 50, 20, 200);
+  ASSERT_TRUE(log.StopStreaming(MakeHeader()));
+  EXPECT_FALSE(log.IsStreaming());
+
+  DTMHeader header;
+  InputLog loaded;
+  ASSERT_TRUE(loaded.Load(path, &header));
+  EXPECT_EQ(header.frameCount, 1234u);
+  EXPECT_EQ(GetData(loaded), GetData(log));
+  EXPECT_EQ(loaded.GetIndexedFrameCount(), 71u);
+  EXPECT_EQ(loaded.GetFrame(70), log.GetFrame(70));
+}
+
+TEST_F(MovieInputLogTest, UpdateStreamHeader)
+{
+  const std::string path = m_temp_path + "/stream.dti";
+
+  InputLog log;
+  ASSERT_TRUE(log.StartStreaming(path, MakeHeader()));
+  Record(log, 0, 20, 0);
+
+  DTMHeader header = MakeHeader();
+  header.frameCount = 20;
+  ASSERT_TRUE(log.UpdateStreamHeader(header));
+
+  // The file can be read while it is still being streamed to, as if the emulator had crashed.
+  DTMHeader streamed_header;
+  InputLog streamed;
+  ASSERT_TRUE(streamed.Load(path, &streamed_header));
+  EXPECT_EQ(streamed_header.frameCount, 20u);
+  EXPECT_TRUE(InputLog::IsDTIHeader(streamed_header));
+  EXPECT_EQ(GetData(streamed), GetData(log));
+
+  ASSERT_TRUE(log.StopStreaming(MakeHeader()));
+  EXPECT_FALSE(log.UpdateStreamHeader(header));
+}
+
+TEST_F(MovieInputLogTest, AssignKeepsCommonPrefix)
+{
+  InputLog log;
+  Record(log, 0, 100, 0);
+
+  std::vector<u8> data = GetData(log);
+  data.resize(70);
+  data[60] = 0xFF;
+  log.Assign(data.data(), data.size());
+
+  EXPECT_EQ(GetData(log), data);
+  EXPECT_EQ(log.GetIndexedFrameCount(), 61u);
+}
@@ -0,0 +1,102 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/NetPlayCommon.h"
+#include "UICommon/UICommon.h"
+
+class NetPlayCommonTest : public testing::Test
+{
+protected:
+  NetPlayCommonTest() : m_profile_path(File::CreateTempDir())
+  {
+    if (!m_profile_path.empty())
+      UICommon::SetUserDirectory(m_profile_path);
+  }
+
+  ~NetPlayCommonTest() override
+  {
+    if (!m_profile_path.empty())
+      File::DeleteDirRecursively(m_profile_path);
+  }
+
+  void SetUp() override { ASSERT_FALSE(m_profile_path.empty()); }
+
+  // Random bytes followed by zeroes, spanning several compression chunks.
+  static std::vector<u8> MakeData(size_t size)
+  {
+    std::mt19937 rng(0);
+    std::vector<u8> data(size);
+    for (size_t i = 0; i < size / 2; ++i)
+      data[i] = static_cast<u8>(rng());
+    return data;
+  }
+
+  std::string m_profile_path;
+};
+
+TEST_F(NetPlayCommonTest, BufferRoundTrip)
+{
+  for (const size_t size : {size_t(0), size_t(1), size_t(1000), size_t(1234567)})
+  {
+    const std::vector<u8> data = MakeData(size);
+    sf::Packet packet;
+    ASSERT_TRUE(NetPlay::CompressBufferIntoPacket(data, packet));
+
+    const std::optional<std::vector<u8>> result = NetPlay::DecompressPacketIntoBuffer(packet);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(*result, data);
+    EXPECT_TRUE(packet.endOfPacket());
+  }
+}
+
+TEST_F(NetPlayCommonTest, CachedContentIsNotSentAgain)
+{
+  const std::vector<u8> data = MakeData(1000000);
+  EXPECT_TRUE(NetPlay::GetCachedContent().empty());
+
+  // Receiving the data stores it in the content cache.
+  sf::Packet first_packet;
+  ASSERT_TRUE(NetPlay::CompressBufferIntoPacket(data, first_packet));
+  ASSERT_TRUE(NetPlay::DecompressPacketIntoBuffer(first_packet));
+
+  const NetPlay::ContentHashSet cached_content = NetPlay::GetCachedContent();
+  EXPECT_EQ(cached_content.size(), 1u);
+
+  sf::Packet second_packet;
+  ASSERT_TRUE(NetPlay::CompressBufferIntoPacket(data, second_packet, cached_content));
+  EXPECT_LT(second_packet.getDataSize(), 100u);
+
+  const std::optional<std::vector<u8>> result = NetPlay::DecompressPacketIntoBuffer(second_packet);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(*result, data);
+}
+
+TEST_F(NetPlayCommonTest, SmallDataIsNotCached)
+{
+  const std::vector<u8> data = MakeData(NetPlay::CONTENT_CACHE_MIN_SIZE - 1);
+
+  sf::Packet packet;
+  ASSERT_TRUE(NetPlay::CompressBufferIntoPacket(data, packet));
+  ASSERT_TRUE(NetPlay::DecompressPacketIntoBuffer(packet));
+  EXPECT_TRUE(NetPlay::GetCachedContent().empty());
+}
+
+TEST_F(NetPlayCommonTest, ContentHashesRoundTrip)
+{
+  NetPlay::ContentHashSet hashes;
+  hashes.insert(NetPlay::ContentHash{1, 2, 3});
+  hashes.insert(NetPlay::ContentHash{4, 5, 6});
+
+  sf::Packet packet;
+  NetPlay::WriteContentHashes(hashes, packet);
+  EXPECT_EQ(NetPlay::ReadContentHashes(packet), hashes);
+}
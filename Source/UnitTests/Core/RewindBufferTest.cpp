@@ -0,0 +1,104 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Core/RewindBuffer.h"
+
+namespace
+{
+constexpr size_t STATE_SIZE = 64 * State::RewindBuffer::BLOCK_SIZE + 123;
+
+std::vector<u8> MakeRandomState(std::mt19937& rng, size_t size = STATE_SIZE)
+{
+  std::vector<u8> state(size);
+  for (u8& byte : state)
+    byte = static_cast<u8>(rng());
+  return state;
+}
+
+// Simulates a frame of emulation, which only touches a few bytes of the state.
+std::vector<u8> ModifyState(std::mt19937& rng, std::vector<u8> state)
+{
+  for (int i = 0; i < 5; i++)
+    state[rng() % state.size()] ^= 0xFF;
+  return state;
+}
+}  // namespace
+
+TEST(RewindBuffer, PopReturnsStatesInReverseOrder)
+{
+  std::mt19937 rng(0);
+  State::RewindBuffer buffer(256 * 1024 * 1024);
+
+  std::vector<std::vector<u8>> states;
+  states.push_back(MakeRandomState(rng));
+  for (int i = 0; i < 20; i++)
+    states.push_back(ModifyState(rng, states.back()));
+  // A state with a different size, which has to be stored in full.
+  states.push_back(MakeRandomState(rng, STATE_SIZE + 10));
+  states.push_back(ModifyState(rng, states.back()));
+
+  for (const std::vector<u8>& state : states)
+    buffer.Push(state);
+  EXPECT_EQ(buffer.GetStateCount(), states.size());
+
+  for (auto it = states.rbegin(); it != states.rend(); ++it)
+  {
+    std::vector<u8> state;
+    ASSERT_TRUE(buffer.Pop(&state));
+    EXPECT_EQ(state, *it);
+  }
+
+  std::vector<u8> state;
+  EXPECT_FALSE(buffer.Pop(&state));
+  EXPECT_EQ(buffer.GetStateCount(), 0u);
+}
+
+TEST(RewindBuffer, DeltasOnlyStoreChangedBlocks)
+{
+  std::mt19937 rng(1);
+  State::RewindBuffer buffer(256 * 1024 * 1024);
+
+  std::vector<u8> state = MakeRandomState(rng);
+  buffer.Push(state);
+  for (int i = 0; i < 10; i++)
+  {
+    state = ModifyState(rng, std::move(state));
+    buffer.Push(state);
+  }
+
+  // Each push changes at most 5 blocks. Compression can only make the deltas smaller.
+  EXPECT_LE(buffer.GetMemoryUsage(), STATE_SIZE + 10 * 5 * State::RewindBuffer::BLOCK_SIZE);
+}
+
+TEST(RewindBuffer, DropsOldestStatesOverBudget)
+{
+  std::mt19937 rng(2);
+  // Room for the newest state and a few deltas. Random data doesn't compress, so the deltas
+  // are never smaller than the blocks they contain.
+  State::RewindBuffer buffer(STATE_SIZE + 8 * State::RewindBuffer::BLOCK_SIZE);
+
+  std::vector<std::vector<u8>> states;
+  states.push_back(MakeRandomState(rng));
+  for (int i = 0; i < 50; i++)
+    states.push_back(ModifyState(rng, states.back()));
+  for (const std::vector<u8>& state : states)
+    buffer.Push(state);
+
+  EXPECT_LE(buffer.GetMemoryUsage(), buffer.GetMemoryBudget());
+  const size_t count = buffer.GetStateCount();
+  EXPECT_GE(count, 2u);
+  EXPECT_LT(count, states.size());
+
+  // The states that are left are the newest ones.
+  for (size_t i = 0; i < count; i++)
+  {
+    std::vector<u8> state;
+    ASSERT_TRUE(buffer.Pop(&state));
+    EXPECT_EQ(state, states[states.size() - 1 - i]);
+  }
+}
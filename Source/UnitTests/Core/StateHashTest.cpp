@@ -0,0 +1,87 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/StateHash.h"
+
+using StateHash::FrameHashes;
+using StateHash::Subsystem;
+
+namespace
+{
+std::vector<FrameHashes> MakeLog(u64 first_frame, u64 frame_count)
+{
+  std::vector<FrameHashes> log;
+  for (u64 frame = first_frame; frame < first_frame + frame_count; ++frame)
+  {
+    FrameHashes hashes;
+    hashes.frame = frame;
+    for (size_t i = 0; i < StateHash::NUM_SUBSYSTEMS; ++i)
+      hashes.hashes[i] = frame * StateHash::NUM_SUBSYSTEMS + i;
+    log.push_back(hashes);
+  }
+  return log;
+}
+}  // namespace
+
+TEST(StateHash, WriteAndReadLog)
+{
+  const std::string temp_dir = File::CreateTempDir();
+  ASSERT_FALSE(temp_dir.empty());
+  const std::string path = temp_dir + "/test.dsh";
+
+  const std::vector<FrameHashes> log = MakeLog(0, 100);
+  {
+    StateHash::LogWriter writer(path);
+    ASSERT_TRUE(writer.IsOpen());
+    for (const FrameHashes& hashes : log)
+      writer.Write(hashes);
+  }
+
+  const auto read = StateHash::ReadLog(path);
+  ASSERT_TRUE(read);
+  ASSERT_EQ(read->size(), log.size());
+  for (size_t i = 0; i < log.size(); ++i)
+  {
+    EXPECT_EQ((*read)[i].frame, log[i].frame);
+    EXPECT_EQ((*read)[i].hashes, log[i].hashes);
+  }
+
+  // A log that isn't a state hash log is rejected.
+  {
+    File::IOFile file(path, "wb");
+    file.WriteString("not a state hash log");
+  }
+  EXPECT_FALSE(StateHash::ReadLog(path));
+
+  File::DeleteDirRecursively(temp_dir);
+}
+
+TEST(StateHash, FindFirstDivergence)
+{
+  const std::vector<FrameHashes> a = MakeLog(0, 100);
+  std::vector<FrameHashes> b = MakeLog(10, 100);
+
+  // Only frames that are in both logs are compared.
+  EXPECT_FALSE(StateHash::FindFirstDivergence(a, b));
+
+  b[50].hashes[static_cast<size_t>(Subsystem::MEM1)] = 0;
+  b[50].hashes[static_cast<size_t>(Subsystem::DSP)] = 0;
+  b[70].hashes[static_cast<size_t>(Subsystem::PowerPC)] = 0;
+
+  const auto divergence = StateHash::FindFirstDivergence(a, b);
+  ASSERT_TRUE(divergence);
+  EXPECT_EQ(divergence->frame, 60u);
+  EXPECT_EQ(divergence->subsystems, (std::vector<Subsystem>{Subsystem::MEM1, Subsystem::DSP}));
+
+  // Frames past the end of one of the logs are ignored.
+  EXPECT_FALSE(StateHash::FindFirstDivergence(std::vector<FrameHashes>(a.begin(), a.begin() + 60),
+                                              b));
+}
@@ -0,0 +1,130 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/HiresTexturePack.h"
+#include "VideoCommon/HiresTextures.h"
+
+namespace
+{
+HiresTexture::Level MakeLevel(AbstractTextureFormat format, u32 width, u32 height, size_t size,
+                              u8 seed)
+{
+  HiresTexture::Level level;
+  level.format = format;
+  level.width = width;
+  level.height = height;
+  level.row_length = width;
+  level.data.resize(size);
+  for (size_t i = 0; i < size; ++i)
+    level.data[i] = static_cast<u8>(seed + i * 7);
+  return level;
+}
+
+void ExpectLevelsEqual(const std::vector<HiresTexture::Level>& expected,
+                       const std::vector<HiresTexture::Level>& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    EXPECT_EQ(expected[i].format, actual[i].format);
+    EXPECT_EQ(expected[i].width, actual[i].width);
+    EXPECT_EQ(expected[i].height, actual[i].height);
+    EXPECT_EQ(expected[i].row_length, actual[i].row_length);
+    EXPECT_EQ(expected[i].data, actual[i].data);
+  }
+}
+}  // namespace
+
+class HiresTexturePackTest : public testing::Test
+{
+protected:
+  HiresTexturePackTest()
+      : m_directory(File::CreateTempDir()), m_path(m_directory + "/GALE01.dtp")
+  {
+  }
+
+  ~HiresTexturePackTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override { ASSERT_FALSE(m_directory.empty()); }
+
+  const std::string m_directory;
+  const std::string m_path;
+};
+
+TEST_F(HiresTexturePackTest, RoundTrip)
+{
+  const std::vector<HiresTexture::Level> rgba_levels{
+      MakeLevel(AbstractTextureFormat::RGBA8, 8, 8, 8 * 8 * 4, 1),
+      MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 4 * 4 * 4, 2),
+  };
+  // Block-compressed payloads are stored as they are.
+  const std::vector<HiresTexture::Level> dxt1_levels{
+      MakeLevel(AbstractTextureFormat::DXT1, 8, 4, 2 * 8, 3),
+  };
+
+  {
+    HiresTexturePack::Writer writer;
+    ASSERT_TRUE(writer.Open(m_path));
+    ASSERT_TRUE(writer.AddTexture("tex1_8x8_0123456789abcdef_0", false, rgba_levels));
+    ASSERT_TRUE(writer.AddTexture("tex1_8x4_fedcba9876543210_14", true, dxt1_levels));
+    ASSERT_TRUE(writer.Finish());
+  }
+  EXPECT_FALSE(File::Exists(m_path + ".tmp"));
+
+  const std::unique_ptr<HiresTexturePack> pack = HiresTexturePack::Open(m_path);
+  ASSERT_TRUE(pack);
+  EXPECT_EQ(2u, pack->GetTextureCount());
+  EXPECT_FALSE(pack->Find("tex1_8x8_0000000000000000_0"));
+
+  const std::optional<u32> rgba_index = pack->Find("tex1_8x8_0123456789abcdef_0");
+  ASSERT_TRUE(rgba_index);
+  EXPECT_EQ("tex1_8x8_0123456789abcdef_0", pack->GetName(*rgba_index));
+  EXPECT_FALSE(pack->HasArbitraryMipmaps(*rgba_index));
+  std::vector<HiresTexture::Level> levels;
+  ASSERT_TRUE(pack->ReadLevels(*rgba_index, &levels));
+  ExpectLevelsEqual(rgba_levels, levels);
+
+  const std::optional<u32> dxt1_index = pack->Find("tex1_8x4_fedcba9876543210_14");
+  ASSERT_TRUE(dxt1_index);
+  EXPECT_TRUE(pack->HasArbitraryMipmaps(*dxt1_index));
+  ASSERT_TRUE(pack->ReadLevels(*dxt1_index, &levels));
+  ExpectLevelsEqual(dxt1_levels, levels);
+}
+
+TEST_F(HiresTexturePackTest, UnfinishedPackIsDeleted)
+{
+  {
+    HiresTexturePack::Writer writer;
+    ASSERT_TRUE(writer.Open(m_path));
+    ASSERT_TRUE(writer.AddTexture("tex1_4x4_0123456789abcdef_0", false,
+                                  {MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 4 * 4 * 4, 0)}));
+  }
+
+  EXPECT_FALSE(File::Exists(m_path));
+  EXPECT_FALSE(File::Exists(m_path + ".tmp"));
+}
+
+TEST_F(HiresTexturePackTest, RejectsInvalidFile)
+{
+  {
+    File::IOFile file(m_path, "wb");
+    const std::vector<u8> data(64, 0x55);
+    file.WriteBytes(data.data(), data.size());
+  }
+
+  EXPECT_FALSE(HiresTexturePack::Open(m_path));
+}
@@ -0,0 +1,138 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/PipelineUIDDatabase.h"
+
+using VideoCommon::PipelineUIDDatabase;
+using VideoCommon::SerializedGXPipelineUid;
+
+class PipelineUIDDatabaseTest : public testing::Test
+{
+protected:
+  PipelineUIDDatabaseTest()
+      : m_directory(File::CreateTempDir()), m_path(m_directory + "/GALE01.uiddb")
+  {
+  }
+
+  ~PipelineUIDDatabaseTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override { ASSERT_FALSE(m_directory.empty()); }
+
+  static SerializedGXPipelineUid MakeUid(u32 id)
+  {
+    SerializedGXPipelineUid uid;
+    std::memset(reinterpret_cast<u8*>(&uid), 0, sizeof(uid));
+    uid.blending_state_bits = id;
+    return uid;
+  }
+
+  static std::vector<u32> GetIdsByUseCount(const PipelineUIDDatabase& database)
+  {
+    std::vector<u32> ids;
+    for (const PipelineUIDDatabase::Entry& entry : database.GetEntriesByUseCount())
+      ids.push_back(entry.uid.blending_state_bits);
+    return ids;
+  }
+
+  const std::string m_directory;
+  const std::string m_path;
+};
+
+TEST_F(PipelineUIDDatabaseTest, DeduplicatesAndSortsByUseCount)
+{
+  PipelineUIDDatabase database;
+  database.Add(MakeUid(1), 5);
+  database.Add(MakeUid(2), 10);
+  database.Add(MakeUid(3), 5);
+  database.Add(MakeUid(1), 6);
+
+  EXPECT_EQ(database.GetSize(), 3u);
+  EXPECT_EQ(GetIdsByUseCount(database), (std::vector<u32>{1, 2, 3}));
+}
+
+TEST_F(PipelineUIDDatabaseTest, UseCountSaturates)
+{
+  PipelineUIDDatabase database;
+  database.Add(MakeUid(1), 0xFFFFFFF0);
+  database.Add(MakeUid(1), 0x100);
+
+  EXPECT_EQ(database.GetEntriesByUseCount()[0].use_count, 0xFFFFFFFFu);
+}
+
+TEST_F(PipelineUIDDatabaseTest, SaveLoadRoundTrip)
+{
+  PipelineUIDDatabase database;
+  database.Add(MakeUid(1), 3);
+  database.Add(MakeUid(2), 7);
+  ASSERT_TRUE(database.Save(m_path));
+
+  PipelineUIDDatabase loaded;
+  ASSERT_TRUE(loaded.Load(m_path));
+  EXPECT_EQ(GetIdsByUseCount(loaded), (std::vector<u32>{2, 1}));
+  EXPECT_EQ(loaded.GetEntriesByUseCount()[0].use_count, 7u);
+}
+
+TEST_F(PipelineUIDDatabaseTest, MergeSumsUseCounts)
+{
+  PipelineUIDDatabase a;
+  a.Add(MakeUid(1), 3);
+  a.Add(MakeUid(2), 4);
+
+  PipelineUIDDatabase b;
+  b.Add(MakeUid(2), 4);
+  b.Add(MakeUid(3), 5);
+
+  a.Merge(b);
+  EXPECT_EQ(a.GetSize(), 3u);
+  EXPECT_EQ(GetIdsByUseCount(a), (std::vector<u32>{2, 3, 1}));
+  EXPECT_EQ(a.GetEntriesByUseCount()[0].use_count, 8u);
+}
+
+TEST_F(PipelineUIDDatabaseTest, AppendedRecordsAreMerged)
+{
+  PipelineUIDDatabase database;
+  database.Add(MakeUid(1), 1);
+  ASSERT_TRUE(database.Save(m_path));
+
+  {
+    File::IOFile file(m_path, "ab");
+    ASSERT_TRUE(PipelineUIDDatabase::WriteRecord(file, MakeUid(2), 1));
+    ASSERT_TRUE(PipelineUIDDatabase::WriteRecord(file, MakeUid(1), 1));
+
+    // Simulate a crash in the middle of appending a record.
+    const u8 partial_record[5] = {};
+    ASSERT_TRUE(file.WriteBytes(partial_record, sizeof(partial_record)));
+  }
+
+  PipelineUIDDatabase loaded;
+  ASSERT_TRUE(loaded.Load(m_path));
+  EXPECT_EQ(GetIdsByUseCount(loaded), (std::vector<u32>{1, 2}));
+  EXPECT_EQ(loaded.GetEntriesByUseCount()[0].use_count, 2u);
+}
+
+TEST_F(PipelineUIDDatabaseTest, RejectsOtherFormats)
+{
+  {
+    File::IOFile file(m_path, "wb");
+    const u32 header[4] = {PipelineUIDDatabase::MAGIC, PipelineUIDDatabase::VERSION + 1,
+                           VideoCommon::GX_PIPELINE_UID_VERSION, sizeof(SerializedGXPipelineUid)};
+    ASSERT_TRUE(file.WriteBytes(header, sizeof(header)));
+  }
+
+  PipelineUIDDatabase database;
+  EXPECT_FALSE(database.Load(m_path));
+  EXPECT_FALSE(database.Load(m_directory + "/missing.uiddb"));
+  EXPECT_TRUE(database.IsEmpty());
+}
@@ -1,21 +1,31 @@
 // Copyright 2014 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <limits>
 #include <memory>
+#include <random>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include <gtest/gtest.h>  // NOLINT
 
 #include "Common/BitUtils.h"
+#include "Common/CPUDetect.h"
 #include "Common/Common.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VertexDecodeQueue.h"
+#include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderCache.h"
 #include "VideoCommon/VertexLoaderManager.h"
 
 TEST(VertexLoaderUID, UniqueEnough)
@@ -366,3 +376,446 @@ TEST_F(VertexLoaderTest, LargeFloatVertexSpeed)
   for (int i = 0; i < 100; ++i)
     RunVertices(100000);
 }
+
+class VertexLoaderCompareTest
+    : public VertexLoaderTest,
+      public ::testing::WithParamInterface<std::tuple<VertexComponentFormat, ComponentFormat>>
+{
+protected:
+  // Creates every variant of the vertex loader JIT that can run on this CPU.
+  std::vector<std::unique_ptr<VertexLoaderBase>> CreateJitLoaders()
+  {
+    std::vector<std::unique_ptr<VertexLoaderBase>> loaders;
+    loaders.push_back(VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr));
+#ifdef _M_X86_64
+    // Also check the loop that converts one vertex at a time when the AVX2 loop is used.
+    if (cpu_info.bAVX2)
+    {
+      cpu_info.bAVX2 = false;
+      loaders.push_back(VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr));
+      cpu_info.bAVX2 = true;
+    }
+#endif
+    return loaders;
+  }
+
+  static void ClearLoaderCaches()
+  {
+    VertexLoaderManager::position_matrix_index_cache = {};
+    VertexLoaderManager::position_cache = {};
+    VertexLoaderManager::tangent_cache = {};
+    VertexLoaderManager::binormal_cache = {};
+  }
+
+  // Expects the JIT to produce the same vertices and zfreeze caches as the software loader.
+  void CompareWithReference(int count)
+  {
+    const std::unique_ptr<VertexLoaderBase> reference =
+        std::make_unique<VertexLoader>(m_vtx_desc, m_vtx_attr);
+    const int stride = reference->m_native_vtx_decl.stride;
+
+    // Only the software loader ignores the upper bits of texture matrix indices, which games don't
+    // set anyway.
+    int texmatidx_count = 0;
+    for (auto texmatidx : m_vtx_desc.low.TexMatIdx)
+    {
+      if (texmatidx)
+        texmatidx_count++;
+    }
+    const int texmatidx_ofs = m_vtx_desc.low.PosMatIdx ? 1 : 0;
+    for (int i = 0; i < count; i++)
+    {
+      for (int j = 0; j < texmatidx_count; j++)
+        input_memory[i * reference->m_vertex_size + texmatidx_ofs + j] &= 0x3F;
+    }
+
+    ClearLoaderCaches();
+    ResetPointers();
+    const int expected_count = reference->RunVertices(m_src, m_dst, count);
+    const std::vector<u8> expected(output_memory, output_memory + expected_count * stride);
+    const auto expected_position_cache = VertexLoaderManager::position_cache;
+    const auto expected_position_matrix_index_cache =
+        VertexLoaderManager::position_matrix_index_cache;
+    const auto expected_tangent_cache = VertexLoaderManager::tangent_cache;
+    const auto expected_binormal_cache = VertexLoaderManager::binormal_cache;
+
+    const auto loaders = CreateJitLoaders();
+    for (size_t i = 0; i < loaders.size(); i++)
+    {
+      const auto& loader = loaders[i];
+      SCOPED_TRACE(fmt::format("JIT variant {}, {} vertices\n{}\n{}", i, count, m_vtx_desc,
+                               m_vtx_attr));
+      ASSERT_EQ(reference->m_vertex_size, loader->m_vertex_size);
+      ASSERT_EQ(stride, loader->m_native_vtx_decl.stride);
+
+      memset(output_memory, 0xFF, expected.size());
+      ClearLoaderCaches();
+      ResetPointers();
+      ASSERT_EQ(expected_count, loader->RunVertices(m_src, m_dst, count));
+
+      const auto mismatch = std::mismatch(expected.begin(), expected.end(), output_memory);
+      EXPECT_EQ(expected.end(), mismatch.first)
+          << "First difference in vertex " << (mismatch.first - expected.begin()) / stride
+          << " at offset " << (mismatch.first - expected.begin()) % stride;
+
+      if (m_vtx_desc.low.PosMatIdx)
+      {
+        EXPECT_EQ(expected_position_matrix_index_cache,
+                  VertexLoaderManager::position_matrix_index_cache);
+      }
+      EXPECT_EQ(0, memcmp(expected_position_cache.data(),
+                          VertexLoaderManager::position_cache.data(),
+                          sizeof(expected_position_cache)));
+      // The software loader only stores the tangent and binormal when they share one index, and it
+      // leaves the fourth component alone.
+      if (m_vtx_attr.g0.NormalElements == NormalComponentCount::NTB &&
+          !m_vtx_attr.g0.NormalIndex3)
+      {
+        EXPECT_EQ(0, memcmp(expected_tangent_cache.data(),
+                            VertexLoaderManager::tangent_cache.data(), 3 * sizeof(float)));
+        EXPECT_EQ(0, memcmp(expected_binormal_cache.data(),
+                            VertexLoaderManager::binormal_cache.data(), 3 * sizeof(float)));
+      }
+    }
+  }
+};
+INSTANTIATE_TEST_CASE_P(
+    AllFormats, VertexLoaderCompareTest,
+    ::testing::Combine(::testing::Values(VertexComponentFormat::Direct,
+                                         VertexComponentFormat::Index8,
+                                         VertexComponentFormat::Index16),
+                       ::testing::Values(ComponentFormat::UByte, ComponentFormat::Byte,
+                                         ComponentFormat::UShort, ComponentFormat::Short,
+                                         ComponentFormat::Float)));
+
+TEST_P(VertexLoaderCompareTest, MatchesSoftwareLoader)
+{
+  const auto [addr, format] = GetParam();
+
+  // Random vertex data at the start of the input, and random array data in the second half, which
+  // covers every element that a 16-bit index can reach. Random position indices occasionally skip
+  // a vertex, which also needs to match.
+  std::mt19937 rng(0x1234);
+  std::generate(std::begin(input_memory), std::end(input_memory),
+                [&rng] { return static_cast<u8>(rng()); });
+  for (int i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; i++)
+  {
+    VertexLoaderManager::cached_arraybases[static_cast<CPArray>(i)] =
+        input_memory + sizeof(input_memory) / 2;
+    g_main_cp_state.array_strides[static_cast<CPArray>(i)] = 37;
+  }
+
+  for (int variant = 0; variant < 8; variant++)
+  {
+    const bool all_elements = (variant & 1) != 0;
+    const bool matrix_indices = (variant & 2) != 0;
+    const bool normal_index3 = (variant & 4) != 0;
+    if (normal_index3 && !IsIndexed(addr))
+      continue;
+
+    for (u32 color_format = 0; color_format <= u32(ColorFormat::RGBA8888); color_format++)
+    {
+      m_vtx_desc.low.Hex = 0;
+      m_vtx_desc.high.Hex = 0;
+      m_vtx_attr.g0.Hex = 0;
+      m_vtx_attr.g1.Hex = 0;
+      m_vtx_attr.g2.Hex = 0;
+
+      m_vtx_desc.low.PosMatIdx = matrix_indices;
+      m_vtx_desc.low.Tex0MatIdx = matrix_indices;
+      m_vtx_desc.low.Tex2MatIdx = matrix_indices;
+      m_vtx_desc.low.Position = addr;
+      m_vtx_desc.low.Normal = addr;
+      m_vtx_desc.low.Color0 = addr;
+      m_vtx_desc.low.Color1 = VertexComponentFormat::Direct;
+      m_vtx_desc.high.Tex0Coord = addr;
+      m_vtx_desc.high.Tex1Coord = VertexComponentFormat::Direct;
+
+      m_vtx_attr.g0.ByteDequant = true;
+      m_vtx_attr.g0.PosElements =
+          all_elements ? CoordComponentCount::XYZ : CoordComponentCount::XY;
+      m_vtx_attr.g0.PosFormat = format;
+      m_vtx_attr.g0.PosFrac = 5;
+      m_vtx_attr.g0.NormalElements =
+          all_elements ? NormalComponentCount::NTB : NormalComponentCount::N;
+      m_vtx_attr.g0.NormalFormat = format;
+      m_vtx_attr.g0.NormalIndex3 = normal_index3;
+      m_vtx_attr.g0.Color0Comp = static_cast<ColorFormat>(color_format);
+      m_vtx_attr.g0.Color1Comp =
+          static_cast<ColorFormat>(u32(ColorFormat::RGBA8888) - color_format);
+      m_vtx_attr.g0.Tex0CoordElements =
+          all_elements ? TexComponentCount::ST : TexComponentCount::S;
+      m_vtx_attr.g0.Tex0CoordFormat = format;
+      m_vtx_attr.g0.Tex0Frac = 3;
+      m_vtx_attr.g1.Tex1CoordElements = TexComponentCount::ST;
+      m_vtx_attr.g1.Tex1CoordFormat = format;
+      m_vtx_attr.g1.Tex1Frac = 12;
+
+      for (int count : {1, 2, 3, 4, 5, 250})
+        CompareWithReference(count);
+    }
+  }
+}
+
+TEST_F(VertexLoaderTest, JitThroughput)
+{
+  // A typical format for fixed point models.
+  m_vtx_desc.low.PosMatIdx = 1;
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.PosFrac = 6;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Byte;
+  m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.Tex0Frac = 10;
+  m_vtx_attr.g0.ByteDequant = true;
+
+  const auto measure = [this](const char* name) {
+    CreateAndCheckSizes(1 + 6 + 3 + 4 + 4, 4 + 12 + 12 + 4 + 8);
+    // Small enough batches to stay in the cache, so that the conversion itself is measured.
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 2000; ++i)
+      RunVertices(5000);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    fmt::print("{}: {:.1f} million vertices per second\n", name,
+               2000 * 5000 / elapsed.count() / 1e6);
+  };
+
+#ifdef _M_X86_64
+  if (cpu_info.bAVX2)
+  {
+    cpu_info.bAVX2 = false;
+    measure("SSE");
+    cpu_info.bAVX2 = true;
+    measure("AVX2");
+    return;
+  }
+#endif
+  measure("JIT");
+}
+
+TEST_F(VertexLoaderTest, DecodeQueueMatchesInlineConversion)
+{
+  m_vtx_desc.low.PosMatIdx = 1;
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.PosFrac = 6;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Byte;
+  m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.Tex0Frac = 10;
+  CreateAndCheckSizes(1 + 6 + 3 + 4 + 4, 4 + 12 + 12 + 4 + 8);
+
+  std::mt19937 rng(0);
+  std::generate(std::begin(input_memory), std::end(input_memory), [&rng] { return u8(rng()); });
+
+  // Enough draws to wrap around the queue a few times, so that Push() has to wait for free slots.
+  static constexpr int draw_count = 3 * VertexDecodeQueue::QUEUE_SIZE;
+  static constexpr size_t output_half = sizeof(output_memory) / 2;
+  const auto run_draws = [this](u8* output, const auto& run) {
+    u8* src = input_memory;
+    u8* dst = output;
+    for (int i = 0; i < draw_count; i++)
+    {
+      const int count = 1 + i % 37;
+      run(DataReader(src, std::end(input_memory)), DataReader(dst, output + output_half), count);
+      src += count * m_loader->m_vertex_size;
+      dst += count * m_loader->m_native_vtx_decl.stride;
+    }
+    return static_cast<size_t>(dst - output);
+  };
+
+  const size_t inline_size =
+      run_draws(output_memory, [this](DataReader src, DataReader dst, int count) {
+        EXPECT_EQ(count, m_loader->RunVertices(src, dst, count));
+      });
+
+  VertexDecodeQueue queue;
+  const size_t queued_size =
+      run_draws(output_memory + output_half, [this, &queue](DataReader src, DataReader dst,
+                                                            int count) {
+        queue.Push(m_loader.get(), src, dst, count);
+      });
+  queue.Wait();
+  EXPECT_TRUE(queue.IsRunning());
+
+  ASSERT_EQ(inline_size, queued_size);
+  EXPECT_TRUE(std::equal(output_memory, output_memory + inline_size, output_memory + output_half));
+
+  queue.Stop();
+  EXPECT_FALSE(queue.IsRunning());
+}
+
+TEST(VertexDecodeQueue, MaySkipVertices)
+{
+  TVtxDesc vtx_desc;
+  vtx_desc.low.Hex = 0;
+  vtx_desc.high.Hex = 0;
+  std::array<u8, 6> data{};
+
+  // Direct positions are never skipped.
+  vtx_desc.low.Position = VertexComponentFormat::Direct;
+  data.fill(0xFF);
+  EXPECT_FALSE(VertexDecodeQueue::MaySkipVertices(vtx_desc, data.data(), 2, 3));
+
+  // Index8 after a position matrix index: only the second byte of each vertex is checked.
+  vtx_desc.low.PosMatIdx = 1;
+  vtx_desc.low.Position = VertexComponentFormat::Index8;
+  data = {0xFF, 0x00, 0xFF, 0x00, 0x00, 0xFF};
+  EXPECT_FALSE(VertexDecodeQueue::MaySkipVertices(vtx_desc, data.data(), 2, 2));
+  EXPECT_TRUE(VertexDecodeQueue::MaySkipVertices(vtx_desc, data.data(), 2, 3));
+
+  // Index16 needs both bytes to be 0xFF.
+  vtx_desc.low.PosMatIdx = 0;
+  vtx_desc.low.Position = VertexComponentFormat::Index16;
+  data = {0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF};
+  EXPECT_FALSE(VertexDecodeQueue::MaySkipVertices(vtx_desc, data.data(), 2, 2));
+  EXPECT_TRUE(VertexDecodeQueue::MaySkipVertices(vtx_desc, data.data(), 2, 3));
+}
+
+class VertexLoaderCacheTest : public VertexLoaderTest
+{
+protected:
+  void SetUp() override
+  {
+    VertexLoaderTest::SetUp();
+    VertexLoaderCache::Clear();
+  }
+
+  void TearDown() override { VertexLoaderCache::Clear(); }
+
+  // The cache reads the vertex format from the main CP state, so it has to match the loader.
+  void CreateCachedLoader(size_t input_size, size_t output_size)
+  {
+    CreateAndCheckSizes(input_size, output_size);
+    VertexLoaderManager::g_current_vat = 0;
+    g_main_cp_state.vtx_desc.low.Hex = m_vtx_desc.low.Hex;
+    g_main_cp_state.vtx_desc.high.Hex = m_vtx_desc.high.Hex;
+    g_main_cp_state.vtx_attr[0].g0.Hex = m_vtx_attr.g0.Hex;
+    g_main_cp_state.vtx_attr[0].g1.Hex = m_vtx_attr.g1.Hex;
+    g_main_cp_state.vtx_attr[0].g2.Hex = m_vtx_attr.g2.Hex;
+  }
+
+  // Places the position array after the vertex data.
+  u8* SetPositionArray(u32 stride, u32 size)
+  {
+    u8* array = input_memory + sizeof(input_memory) / 2;
+    VertexLoaderManager::cached_arraybases[CPArray::Position] = array;
+    VertexLoaderManager::cached_arraysizes[CPArray::Position] = size;
+    g_main_cp_state.array_bases[CPArray::Position] = 0x80100000;
+    g_main_cp_state.array_strides[CPArray::Position] = stride;
+    return array;
+  }
+
+  void RunCached(int count, bool expect_hit)
+  {
+    const int hits = g_stats.this_frame.num_vertex_cache_hits;
+    ResetPointers();
+    memset(output_memory, 0xFF, count * m_loader->m_native_vtx_decl.stride);
+    EXPECT_EQ(count, VertexLoaderCache::RunVertices(m_loader.get(), m_src, m_dst, count));
+    EXPECT_EQ(expect_hit, g_stats.this_frame.num_vertex_cache_hits != hits);
+  }
+};
+
+TEST_F(VertexLoaderCacheTest, DirectVertices)
+{
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  CreateCachedLoader(3 * sizeof(float), 3 * sizeof(float));
+  for (int i = 0; i < 12; i++)
+    Input(float(i));
+
+  RunCached(4, false);
+  RunCached(4, true);
+  for (int i = 0; i < 12; i++)
+    ExpectOut(float(i));
+
+  // Fewer vertices from the same data are a different draw.
+  RunCached(3, false);
+
+  // So is different vertex data.
+  ResetPointers();
+  Input(42.f);
+  RunCached(4, false);
+  ExpectOut(42.f);
+  RunCached(4, true);
+  ExpectOut(42.f);
+}
+
+TEST_F(VertexLoaderCacheTest, IndexedVertices)
+{
+  m_vtx_desc.low.Position = VertexComponentFormat::Index8;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  CreateCachedLoader(sizeof(u8), 3 * sizeof(float));
+  Input<u8>(2);
+  Input<u8>(3);
+
+  DataReader array(SetPositionArray(3 * sizeof(float), 1024), input_memory + sizeof(input_memory));
+  for (int i = 0; i < 32; i++)
+    array.Write<float, true>(float(i));
+
+  RunCached(2, false);
+  RunCached(2, true);
+  for (int i = 6; i < 12; i++)
+    ExpectOut(float(i));
+
+  // Changing an element that isn't referenced doesn't matter.
+  array = DataReader(SetPositionArray(3 * sizeof(float), 1024),
+                     input_memory + sizeof(input_memory));
+  array.Write<float, true>(100.f);
+  RunCached(2, true);
+
+  // Changing a referenced one does.
+  array.Skip(8 * sizeof(float));
+  array.Write<float, true>(100.f);
+  RunCached(2, false);
+  ExpectOut(6);
+  ExpectOut(7);
+  ExpectOut(8);
+  ExpectOut(100);
+  RunCached(2, true);
+
+  // As does changing the stride.
+  SetPositionArray(2 * sizeof(float), 1024);
+  RunCached(2, false);
+  ExpectOut(4);
+}
+
+TEST_F(VertexLoaderCacheTest, UncacheableIndexedVertices)
+{
+  m_vtx_desc.low.Position = VertexComponentFormat::Index16;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  CreateCachedLoader(sizeof(u16), 3 * sizeof(float));
+
+  // Indices that are far apart would need most of the array to be hashed.
+  Input<u16>(0);
+  Input<u16>(0xFFFE);
+  SetPositionArray(3 * sizeof(float), 0x100000);
+  RunCached(2, false);
+  RunCached(2, false);
+
+  // Arrays that aren't in RAM can't be hashed either.
+  ResetPointers();
+  Input<u16>(0);
+  Input<u16>(1);
+  SetPositionArray(3 * sizeof(float), 0);
+  RunCached(2, false);
+  RunCached(2, false);
+
+  SetPositionArray(3 * sizeof(float), 0x100000);
+  RunCached(2, false);
+  RunCached(2, true);
+}